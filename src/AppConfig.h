@@ -69,6 +69,22 @@ public:
         if (const char* key = std::getenv("GEMINI_API_KEY")) {
             geminiApiKey_ = key;
         }
+
+        // Local OpenStreetMap extract (served in-process instead of Overpass)
+        if (const char* path = std::getenv("OSM_EXTRACT_STORE")) {
+            osmExtractStorePath_ = path;
+        }
+        if (const char* path = std::getenv("OSM_EXTRACT_PBF")) {
+            osmExtractPbfPath_ = path;
+        }
+        if (const char* path = std::getenv("MARKET_HEATMAP")) {
+            marketHeatmapPath_ = path;
+        }
+
+        // Geocoding, Places and OSM tile cache kept across restarts
+        if (const char* path = std::getenv("CACHE_STORE")) {
+            cacheStorePath_ = path;
+        }
     }
 
     /**
@@ -121,6 +137,16 @@ public:
             } else if (key == "openai_model" && !value.empty() && openaiModel_.empty()) {
                 openaiModel_ = value;
             }
+            // Local OpenStreetMap extract
+            else if (key == "osm_extract_store" && !value.empty() && osmExtractStorePath_.empty()) {
+                osmExtractStorePath_ = value;
+            } else if (key == "osm_extract_pbf" && !value.empty() && osmExtractPbfPath_.empty()) {
+                osmExtractPbfPath_ = value;
+            } else if (key == "market_heatmap" && !value.empty() && marketHeatmapPath_.empty()) {
+                marketHeatmapPath_ = value;
+            } else if (key == "cache_store" && !value.empty() && cacheStorePath_.empty()) {
+                cacheStorePath_ = value;
+            }
             // Branding
             else if (key == "brand_logo_path" && !value.empty() && brandLogoPath_.empty()) {
                 brandLogoPath_ = value;
@@ -156,6 +182,18 @@ public:
         file << "  \"bbb_api_key\": \"" << bbbApiKey_ << "\",\n";
         file << "  \"census_api_key\": \"" << censusApiKey_ << "\",\n";
         file << "  \"gemini_api_key\": \"" << geminiApiKey_ << "\",\n";
+        if (!osmExtractStorePath_.empty()) {
+            file << "  \"osm_extract_store\": \"" << osmExtractStorePath_ << "\",\n";
+        }
+        if (!osmExtractPbfPath_.empty()) {
+            file << "  \"osm_extract_pbf\": \"" << osmExtractPbfPath_ << "\",\n";
+        }
+        if (!marketHeatmapPath_.empty()) {
+            file << "  \"market_heatmap\": \"" << marketHeatmapPath_ << "\",\n";
+        }
+        if (!cacheStorePath_.empty()) {
+            file << "  \"cache_store\": \"" << cacheStorePath_ << "\",\n";
+        }
         file << "  \"brand_logo_path\": \"" << brandLogoPath_ << "\"\n";
         file << "}\n";
 
@@ -285,6 +323,27 @@ public:
         return !geminiApiKey_.empty();
     }
 
+    // Getters - Local OpenStreetMap extract
+    std::string getOsmExtractStorePath() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return osmExtractStorePath_;
+    }
+
+    std::string getOsmExtractPbfPath() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return osmExtractPbfPath_;
+    }
+
+    std::string getMarketHeatmapPath() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return marketHeatmapPath_;
+    }
+
+    std::string getCacheStorePath() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cacheStorePath_;
+    }
+
     // Branding getters/setters
     std::string getBrandLogoPath() const {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -362,6 +421,12 @@ private:
     std::string geminiApiKey_;
     std::string configFilePath_;
 
+    // Local OpenStreetMap extract
+    std::string osmExtractStorePath_;   // POI store file (built from the PBF if missing)
+    std::string osmExtractPbfPath_;     // .osm.pbf extract to import
+    std::string marketHeatmapPath_;     // Market potential raster (built from the extract if missing)
+    std::string cacheStorePath_;        // On-disk API and tile cache (empty = memory only)
+
     // Branding
     std::string brandLogoPath_;  // Path to custom logo (local file or URL)
     static constexpr const char* DEFAULT_LOGO_URL = "https://media.licdn.com/dms/image/v2/D4E0BAQFNqqJ59i1lgQ/company-logo_200_200/company-logo_200_200/0/1733939002925/imagery_business_systems_llc_logo?e=1771459200&v=beta&t=uASbYiGNvSAkTxbpF0MxvSBGt74KHdfVxToiG4dmSGw";
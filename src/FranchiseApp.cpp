@@ -4,6 +4,9 @@
 #include "widgets/LoginDialog.h"
 #include "widgets/AuditTrailPage.h"
 #include "services/AuditLogger.h"
+#include "services/MarketHeatmap.h"
+#include "services/ThreadPool.h"
+#include <Wt/Core/observing_ptr.hpp>
 #include <Wt/WBootstrap5Theme.h>
 #include <Wt/WCssStyleSheet.h>
 #include <Wt/WText.h>
@@ -13,8 +16,10 @@
 #include <Wt/WBreak.h>
 #include <Wt/WComboBox.h>
 #include <Wt/WCheckBox.h>
+#include <Wt/WServer.h>
 #include <Wt/WSlider.h>
 #include <Wt/WTimer.h>
+#include <atomic>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -62,6 +67,17 @@ FranchiseApp::FranchiseApp(const Wt::WEnvironment& env)
         config.demographicsConfig.apiKey = appConfig.getCensusApiKey();
     }
 
+    // Serve covered metro areas from the local OSM extract
+    config.osmConfig.extractStorePath = appConfig.getOsmExtractStorePath();
+    config.osmConfig.extractPbfPath = appConfig.getOsmExtractPbfPath();
+
+    // Keep geocodes, Places results and OSM tiles on disk across restarts
+    std::string cacheStorePath = appConfig.getCacheStorePath();
+    config.osmConfig.cacheStorePath = cacheStorePath;
+    config.geocodingConfig.cacheStorePath = cacheStorePath;
+    config.googleGeocodingConfig.cacheStorePath = cacheStorePath;
+    config.googlePlacesConfig.cacheStorePath = cacheStorePath;
+
     searchService_ = std::make_unique<Services::AISearchService>(config);
 
     // Initialize Scoring Engine with default rules
@@ -509,31 +525,48 @@ void FranchiseApp::executeSearch(const Models::SearchQuery& query) {
 
     // Store the search context for syncing with Open Street Map page
     currentSearchLocation_ = searchQuery.location;
-    if (searchQuery.latitude != 0 && searchQuery.longitude != 0) {
-        Models::GeoLocation location(searchQuery.latitude, searchQuery.longitude);
-        location.formattedAddress = searchQuery.location;
-        currentSearchArea_ = Models::SearchArea::fromMiles(location, searchQuery.radiusMiles);
-    } else if (!searchQuery.location.empty()) {
-        Models::GeoLocation location = searchService_->geocodeAddress(searchQuery.location);
-        currentSearchArea_ = Models::SearchArea::fromMiles(location, searchQuery.radiusMiles);
+
+    if (!updatesEnabled()) {
+        enableUpdates(true);
     }
-    hasActiveSearch_ = true;
-
-    // Perform search with merged query
-    searchService_->search(
-        searchQuery,
-        [this](const Models::SearchResults& results) {
-            // This callback is called when search completes
-            onSearchComplete(results);
-        },
-        [this](const Services::SearchProgress& progress) {
-            // This callback is called for progress updates
-            onSearchProgress(progress);
-        }
-    );
+
+    // Geocode the location once, off the session thread. The resolved area
+    // becomes the shared search context and travels with the query, so the
+    // search itself does not geocode it again. A newer search or a cancel
+    // in the meantime discards the result.
+    unsigned generation = ++searchGeneration_;
+    std::string session = sessionId();
+    searchService_->resolveSearchAreaAsync(searchQuery,
+        [this, session, generation](Models::SearchQuery resolvedQuery) {
+            Wt::WServer::instance()->post(session, [this, generation, resolvedQuery]() {
+                if (generation != searchGeneration_ || !searchService_) {
+                    return;
+                }
+
+                currentSearchArea_ = resolvedQuery.searchArea;
+                hasActiveSearch_ = true;
+
+                // Perform search with merged query
+                searchService_->search(
+                    resolvedQuery,
+                    [this](const Models::SearchResults& results) {
+                        // This callback is called when search completes
+                        onSearchComplete(results);
+                    },
+                    [this](const Services::SearchProgress& progress) {
+                        // This callback is called for progress updates
+                        onSearchProgress(progress);
+                    }
+                );
+                triggerUpdate();
+            });
+        });
 }
 
 void FranchiseApp::onSearchCancelled() {
+    // Drop a search still waiting for its location to be geocoded
+    ++searchGeneration_;
+
     if (searchService_) {
         searchService_->cancelSearch();
     }
@@ -2138,9 +2171,11 @@ void FranchiseApp::showOpenStreetMapPage() {
         initialSearchArea = Models::SearchArea(denverLocation, 10.0);
     }
 
-    // Get initial stats
+    // Initial stats, if the extract or the cache has them; otherwise they
+    // are requested in the background once the page is built
     auto& osmAPI = searchService_->getOSMAPI();
-    auto stats = osmAPI.getAreaStatisticsSync(initialSearchArea);
+    Services::OSMAreaStats stats;
+    bool haveInitialStats = osmAPI.peekAreaStatistics(initialSearchArea, stats);
 
     // Set market score in navigation header
     navigation_->setMarketScore(stats.marketPotentialScore);
@@ -2282,6 +2317,51 @@ void FranchiseApp::showOpenStreetMapPage() {
 
     doJavaScript(initMapJs.str());
 
+    // Shade the precomputed market potential around the search area, if a
+    // heatmap is configured (it is built in the background on first use)
+    auto drawHeatmap = [this](const Models::SearchArea& searchArea) {
+        auto heatmap = Services::MarketHeatmap::shared(AppConfig::instance().getMarketHeatmapPath(),
+                                                       searchService_->getOSMAPI().getConfig());
+        if (!heatmap) return;
+
+        Models::SearchArea viewArea = searchArea;
+        viewArea.radiusKm *= 1.5;
+        auto surface = heatmap->surface(Models::GeoBoundingBox::fromSearchArea(viewArea));
+
+        std::ostringstream heatJs;
+        heatJs << std::fixed << std::setprecision(5);
+        heatJs << "(function() {"
+               << "  function drawHeatmap() {"
+               << "    if (typeof L === 'undefined' || !window.osmMap) { setTimeout(drawHeatmap, 200); return; }"
+               << "    if (window.osmHeatLayer) window.osmHeatLayer.remove();"
+               << "    var layer = L.layerGroup();"
+               << "    var cells = [";
+        for (int row = 0; row < surface.rows; ++row) {
+            for (int col = 0; col < surface.cols; ++col) {
+                int score = surface.at(row, col);
+                if (score == Services::MarketHeatmap::kNoData) continue;
+                double south = surface.south + row * surface.cellLat;
+                double west = surface.west + col * surface.cellLon;
+                heatJs << "[" << south << "," << west << "," << south + surface.cellLat << ","
+                       << west + surface.cellLon << "," << score << "],";
+            }
+        }
+        heatJs << "];"
+               << "    cells.forEach(function(c) {"
+               << "      var color = c[4] >= 80 ? '#22c55e' : c[4] >= 60 ? '#3b82f6' : c[4] >= 40 ? '#f59e0b' : '#94a3b8';"
+               << "      L.rectangle([[c[0], c[1]], [c[2], c[3]]], {"
+               << "        stroke: false, fillColor: color, fillOpacity: 0.25, interactive: false"
+               << "      }).addTo(layer);"
+               << "    });"
+               << "    layer.addTo(window.osmMap);"
+               << "    window.osmHeatLayer = layer;"
+               << "  }"
+               << "  drawHeatmap();"
+               << "})();";
+        doJavaScript(heatJs.str());
+    };
+    drawHeatmap(initialSearchArea);
+
     // Synchronize AI Search prospects to the map
     if (!lastResults_.items.empty()) {
         std::ostringstream addProspectsJs;
@@ -2468,19 +2548,18 @@ void FranchiseApp::showOpenStreetMapPage() {
         std::ostringstream popup;
 
         // Sanitize strings for JavaScript
-        auto sanitize = [](const std::string& str) -> std::string {
-            std::string result = str;
+        auto sanitize = [](std::string_view str) -> std::string {
+            std::string result(str);
             for (auto& c : result) {
                 if (c == '\'' || c == '"' || c == '\\' || c == '\n' || c == '\r') c = ' ';
             }
             return result;
         };
 
-        std::string safeName = sanitize(poi.name);
-        std::string safeAddress = sanitize(poi.street.empty() ? "" :
-            (poi.houseNumber.empty() ? poi.street : poi.houseNumber + " " + poi.street));
-        std::string safeCity = sanitize(poi.city);
-        std::string safeState = sanitize(poi.state);
+        std::string safeName = sanitize(poi.name());
+        std::string safeAddress = sanitize(poi.street().empty() ? "" : poi.streetAddress());
+        std::string safeCity = sanitize(poi.city());
+        std::string safeState = sanitize(poi.state());
 
         // Get score color based on catering potential
         std::string scoreColor;
@@ -2591,22 +2670,22 @@ void FranchiseApp::showOpenStreetMapPage() {
         popup << "</div>";
 
         // Contact info footer (if available) - simplified inline
-        if (!poi.phone.empty() || !poi.website.empty() || !poi.email.empty()) {
+        if (!poi.phone().empty() || !poi.website().empty() || !poi.email().empty()) {
             popup << "<div style=\"margin-top: 8px; font-size: 11px;\">";
             bool first = true;
-            if (!poi.phone.empty()) {
-                std::string safePhone = sanitize(poi.phone);
+            if (!poi.phone().empty()) {
+                std::string safePhone = sanitize(poi.phone());
                 popup << "<a href=\"tel:" << safePhone << "\" style=\"color: #1976d2; text-decoration: none;\">📞 " << safePhone << "</a>";
                 first = false;
             }
-            if (!poi.website.empty()) {
-                std::string safeWebsite = sanitize(poi.website);
+            if (!poi.website().empty()) {
+                std::string safeWebsite = sanitize(poi.website());
                 if (!first) popup << " &nbsp;•&nbsp; ";
                 popup << "<a href=\"" << safeWebsite << "\" target=\"_blank\" style=\"color: #1976d2; text-decoration: none;\">🌐 Website</a>";
                 first = false;
             }
-            if (!poi.email.empty()) {
-                std::string safeEmail = sanitize(poi.email);
+            if (!poi.email().empty()) {
+                std::string safeEmail = sanitize(poi.email());
                 if (!first) popup << " &nbsp;•&nbsp; ";
                 popup << "<a href=\"mailto:" << safeEmail << "\" style=\"color: #1976d2; text-decoration: none;\">✉️ Email</a>";
             }
@@ -2614,8 +2693,8 @@ void FranchiseApp::showOpenStreetMapPage() {
         }
 
         // Opening hours (if available)
-        if (!poi.openingHours.empty()) {
-            std::string safeHours = sanitize(poi.openingHours);
+        if (!poi.openingHours().empty()) {
+            std::string safeHours = sanitize(poi.openingHours());
             popup << "<div style=\"margin-top: 6px; font-size: 10px; color: #888;\">🕐 " << safeHours << "</div>";
         }
 
@@ -2624,31 +2703,25 @@ void FranchiseApp::showOpenStreetMapPage() {
         return popup.str();
     };
 
-    // Function to refresh all POI markers
-    auto refreshMarkers = std::make_shared<std::function<void()>>();
-    *refreshMarkers = [this, activePills, currentSearchAreaPtr, buildRichPopupHtml]() {
-        // Clear existing markers
-        std::ostringstream clearMarkersJs;
-        clearMarkersJs << "if (window.osmMarkers) {"
-                      << "  window.osmMarkers.forEach(function(m) { m.remove(); });"
-                      << "}"
-                      << "window.osmMarkers = [];";
-        doJavaScript(clearMarkersJs.str());
-
+    // Function to add markers for the active categories from fetched POIs.
+    // drawn counts the markers each category already has, so batches of one
+    // refresh stay within the pill's limit.
+    auto renderMarkers = [this, activePills, buildRichPopupHtml](
+        std::map<std::string, std::vector<Services::OSMPoi>>& poisByCategory,
+        std::map<std::string, int>& drawn) {
         // Add markers for each active category
         for (auto& pill : *activePills) {
             // Read current slider value directly
             int currentLimit = pill.limitSlider ? pill.limitSlider->value() : pill.poiLimit;
 
-            auto& osmAPI = searchService_->getOSMAPI();
-            auto pois = osmAPI.searchByCategorySync(*currentSearchAreaPtr, pill.apiName);
+            const auto& pois = poisByCategory[pill.apiName];
 
-            int markerCount = 0;
+            int& markerCount = drawn[pill.apiName];
             for (const auto& poi : pois) {
                 if (markerCount >= currentLimit) break;
 
                 // Convert POI to BusinessInfo for scoring and insights
-                Models::BusinessInfo bizInfo = osmAPI.poiToBusinessInfo(poi);
+                Models::BusinessInfo bizInfo = Services::OpenStreetMapAPI::poiToBusinessInfo(poi);
 
                 // Build rich popup HTML
                 std::string popupHtml = buildRichPopupHtml(poi, bizInfo, pill.displayName, pill.markerColor);
@@ -2687,6 +2760,76 @@ void FranchiseApp::showOpenStreetMapPage() {
         }
     };
 
+    // Function to refresh all POI markers. The fetch runs on the shared
+    // thread pool and markers are pushed to the browser in batches while
+    // the response downloads, so the session is never blocked on Overpass.
+    // Only the most recent refresh is rendered, and nothing is if the page
+    // has been left.
+    auto refreshGeneration = std::make_shared<std::atomic<unsigned>>(0);
+    Wt::Core::observing_ptr<Wt::WContainerWidget> pillTrayRef(pillTray);
+    auto refreshMarkers = std::make_shared<std::function<void()>>();
+    *refreshMarkers = [this, activePills, currentSearchAreaPtr, refreshGeneration, pillTrayRef, renderMarkers]() {
+        // Clear existing markers
+        std::ostringstream clearMarkersJs;
+        clearMarkersJs << "if (window.osmMarkers) {"
+                      << "  window.osmMarkers.forEach(function(m) { m.remove(); });"
+                      << "}"
+                      << "window.osmMarkers = [];";
+        doJavaScript(clearMarkersJs.str());
+
+        unsigned generation = ++*refreshGeneration;
+        std::vector<std::string> categories;
+        for (const auto& pill : *activePills) {
+            categories.push_back(pill.apiName);
+        }
+        if (categories.empty()) return;
+
+        if (!updatesEnabled()) {
+            enableUpdates(true);
+        }
+
+        // Fetch every active category in one request. The worker uses its own
+        // client; the extract and tile cache behind it are process-wide.
+        std::string session = sessionId();
+        Services::OSMAPIConfig osmConfig = searchService_->getOSMAPI().getConfig();
+        Models::SearchArea searchArea = *currentSearchAreaPtr;
+
+        Services::ThreadPool::shared().post(Services::TaskOptions::interactive(),
+            [this, session, osmConfig, searchArea, categories, generation,
+             refreshGeneration, pillTrayRef, renderMarkers]() {
+                Services::OpenStreetMapAPI osmAPI(osmConfig);
+                auto drawn = std::make_shared<std::map<std::string, int>>();
+                std::map<std::string, std::vector<Services::OSMPoi>> batch;
+                auto lastFlush = std::chrono::steady_clock::now();
+
+                auto flush = [&]() {
+                    if (batch.empty()) return;
+                    Wt::WServer::instance()->post(session,
+                        [this, pois = std::move(batch), drawn, generation, refreshGeneration,
+                         pillTrayRef, renderMarkers]() mutable {
+                            if (!pillTrayRef || generation != *refreshGeneration) {
+                                return;
+                            }
+                            renderMarkers(pois, *drawn);
+                            triggerUpdate();
+                        });
+                    batch.clear();
+                    lastFlush = std::chrono::steady_clock::now();
+                };
+
+                osmAPI.searchByCategoriesStreaming(searchArea, categories,
+                    [&](const std::string& category, const Services::OSMPoi& poi) {
+                        batch[category].push_back(poi);
+                        if (std::chrono::steady_clock::now() - lastFlush >= std::chrono::milliseconds(200)) {
+                            flush();
+                        }
+                        // A newer refresh has replaced this one; stop downloading
+                        return generation == *refreshGeneration;
+                    });
+                flush();
+            });
+    };
+
     // Function to update empty state visibility
     auto updateEmptyState = [emptyMessage, activePills]() {
         if (activePills->empty()) {
@@ -2938,6 +3081,81 @@ void FranchiseApp::showOpenStreetMapPage() {
     auto radiusText = radiusItem->addWidget(std::make_unique<Wt::WText>(radiusStr.str()));
     radiusText->setStyleClass("stat-value");
 
+    // Show area statistics in the summary, header and category dropdown
+    auto applyStats = [this, totalPoisText, densityText, categoryDropdown, categories](
+                          const Services::OSMAreaStats& newStats, const std::string& error) {
+        if (!error.empty()) {
+            // Leave the categories alone rather than showing an empty area
+            totalPoisText->setText("n/a");
+            densityText->setText("n/a");
+            return;
+        }
+
+        // Update market score in navigation header
+        navigation_->setMarketScore(newStats.marketPotentialScore);
+
+        // Update summary stats
+        totalPoisText->setText(std::to_string(newStats.totalPois));
+
+        std::ostringstream newDensityStr;
+        newDensityStr << std::fixed << std::setprecision(1) << newStats.businessDensityPerSqKm << "/km²";
+        densityText->setText(newDensityStr.str());
+
+        // Update category counts in shared data and dropdown
+        *categories = {
+            {"Offices", "offices", newStats.offices},
+            {"Hotels", "hotels", newStats.hotels},
+            {"Conference Venues", "conference", newStats.conferenceVenues},
+            {"Restaurants", "restaurants", newStats.restaurants},
+            {"Cafes", "cafes", newStats.cafes},
+            {"Hospitals", "hospitals", newStats.hospitals},
+            {"Universities", "universities", newStats.universities},
+            {"Schools", "schools", newStats.schools},
+            {"Industrial", "industrial", newStats.industrialBuildings},
+            {"Warehouses", "warehouses", newStats.warehouses},
+            {"Banks", "banks", newStats.banks},
+            {"Government", "government", newStats.governmentBuildings}
+        };
+
+        // Rebuild dropdown with new counts
+        categoryDropdown->clear();
+        categoryDropdown->addItem("-- Select a category --");
+        for (const auto& [displayName, apiName, count] : *categories) {
+            categoryDropdown->addItem(displayName + " (" + std::to_string(count) + ")");
+        }
+    };
+
+    // Request area statistics without blocking the session: an uncached
+    // area is an Overpass query, answered on the HttpClient reactor and
+    // posted back. Only the most recent request is rendered, and nothing
+    // is if the page has been left.
+    auto statsGeneration = std::make_shared<unsigned>(0);
+    Wt::Core::observing_ptr<Wt::WText> totalPoisRef(totalPoisText);
+    auto requestStats = [this, statsGeneration, totalPoisRef, applyStats](const Models::SearchArea& searchArea) {
+        unsigned generation = ++*statsGeneration;
+        if (!updatesEnabled()) {
+            enableUpdates(true);
+        }
+
+        std::string session = sessionId();
+        searchService_->getOSMAPI().getAreaStatistics(searchArea,
+            [this, session, generation, statsGeneration, totalPoisRef, applyStats](
+                Services::OSMAreaStats newStats, std::string error) {
+                Wt::WServer::instance()->post(session,
+                    [this, newStats, error, generation, statsGeneration, totalPoisRef, applyStats]() {
+                        if (!totalPoisRef || generation != *statsGeneration) {
+                            return;
+                        }
+                        applyStats(newStats, error);
+                        triggerUpdate();
+                    });
+            });
+    };
+
+    if (!haveInitialStats) {
+        requestStats(initialSearchArea);
+    }
+
     // Helper function to get radius from dropdown selection
     auto getRadiusFromSelect = [](int index) -> double {
         switch (index) {
@@ -2952,8 +3170,8 @@ void FranchiseApp::showOpenStreetMapPage() {
 
     // Connect analyze button
     analyzeBtn->clicked().connect([this, locationInput, radiusSelect, currentSearchAreaPtr,
-                                   totalPoisText, densityText, locationText,
-                                   radiusText, categoryDropdown, categories, refreshMarkers, getRadiusFromSelect]() {
+                                   locationText, radiusText, refreshMarkers, getRadiusFromSelect,
+                                   drawHeatmap, requestStats]() {
         std::string location = locationInput->text().toUTF8();
         double radiusKm = getRadiusFromSelect(radiusSelect->currentIndex());
 
@@ -2977,20 +3195,10 @@ void FranchiseApp::showOpenStreetMapPage() {
                  << "  window.osmMap.setView([" << geoLocation.latitude << ", " << geoLocation.longitude << "], 13);"
                  << "}";
         doJavaScript(panMapJs.str());
+        drawHeatmap(searchArea);
 
-        // Get new stats
-        auto& osmAPI = searchService_->getOSMAPI();
-        auto newStats = osmAPI.getAreaStatisticsSync(searchArea);
-
-        // Update market score in navigation header
-        navigation_->setMarketScore(newStats.marketPotentialScore);
-
-        // Update summary stats
-        totalPoisText->setText(std::to_string(newStats.totalPois));
-
-        std::ostringstream newDensityStr;
-        newDensityStr << std::fixed << std::setprecision(1) << newStats.businessDensityPerSqKm << "/km²";
-        densityText->setText(newDensityStr.str());
+        // Stats arrive asynchronously; location and radius update now
+        requestStats(searchArea);
 
         locationText->setText(location);
 
@@ -2998,35 +3206,13 @@ void FranchiseApp::showOpenStreetMapPage() {
         newRadiusStr << std::fixed << std::setprecision(0) << radiusKm << " km";
         radiusText->setText(newRadiusStr.str());
 
-        // Update category counts in shared data and dropdown
-        *categories = {
-            {"Offices", "offices", newStats.offices},
-            {"Hotels", "hotels", newStats.hotels},
-            {"Conference Venues", "conference", newStats.conferenceVenues},
-            {"Restaurants", "restaurants", newStats.restaurants},
-            {"Cafes", "cafes", newStats.cafes},
-            {"Hospitals", "hospitals", newStats.hospitals},
-            {"Universities", "universities", newStats.universities},
-            {"Schools", "schools", newStats.schools},
-            {"Industrial", "industrial", newStats.industrialBuildings},
-            {"Warehouses", "warehouses", newStats.warehouses},
-            {"Banks", "banks", newStats.banks},
-            {"Government", "government", newStats.governmentBuildings}
-        };
-
-        // Rebuild dropdown with new counts
-        categoryDropdown->clear();
-        categoryDropdown->addItem("-- Select a category --");
-        for (const auto& [displayName, apiName, count] : *categories) {
-            categoryDropdown->addItem(displayName + " (" + std::to_string(count) + ")");
-        }
-
         // Refresh POI markers for active category pills with new location
         (*refreshMarkers)();
     });
 
     // Add blur event to location input to recenter map and refresh POIs
-    locationInput->blurred().connect([this, locationInput, radiusSelect, currentSearchAreaPtr, refreshMarkers, getRadiusFromSelect]() {
+    locationInput->blurred().connect([this, locationInput, radiusSelect, currentSearchAreaPtr, refreshMarkers, getRadiusFromSelect,
+                                      drawHeatmap]() {
         std::string location = locationInput->text().toUTF8();
         if (location.empty()) return;
 
@@ -3046,6 +3232,7 @@ void FranchiseApp::showOpenStreetMapPage() {
                      << "  window.osmMap.setView([" << geoLocation.latitude << ", " << geoLocation.longitude << "], 13);"
                      << "}";
             doJavaScript(panMapJs.str());
+            drawHeatmap(searchArea);
 
             // Refresh POI markers for the new location
             (*refreshMarkers)();
@@ -178,6 +178,7 @@ private:
     Models::SearchArea currentSearchArea_;
     std::string currentSearchLocation_;
     bool hasActiveSearch_ = false;
+    unsigned searchGeneration_ = 0;   // Bumped per search and cancel; stale geocodes are ignored
 
     // Saved prospects list (AI analysis performed when added)
     std::vector<Models::SearchResultItem> savedProspects_;
@@ -7,6 +7,7 @@
 #include <chrono>
 #include "BusinessInfo.h"
 #include "DemographicData.h"
+#include "GeoLocation.h"
 
 namespace FranchiseAI {
 namespace Models {
@@ -92,6 +93,12 @@ struct SearchQuery {
     double longitude = 0.0;
     double radiusMiles = 25.0;
 
+    // Resolved search area. Set once before the search starts (see
+    // AISearchService::resolveSearchAreaAsync) so the location is geocoded
+    // only once; when unset the search resolves it itself.
+    SearchArea searchArea;
+    bool hasSearchArea = false;
+
     // Search filters
     std::string keywords;
     std::vector<BusinessType> businessTypes;
@@ -1,6 +1,7 @@
 #include "AISearchService.h"
 #include "OpenAIEngine.h"
 #include "GeminiEngine.h"
+#include "ThreadPool.h"
 #include <algorithm>
 #include <numeric>
 #include <sstream>
@@ -23,7 +24,7 @@ AISearchService::AISearchService() {
     );
 
     // Initialize Google APIs (will be used if API key is configured)
-    googleGeocodingAPI_.setConfig(config_.googleGeocodingConfig);
+    googleGeocodingAPI_ = std::make_shared<GoogleGeocodingAPI>(config_.googleGeocodingConfig);
     googlePlacesAPI_.setConfig(config_.googlePlacesConfig);
 
     // Initialize AI engine if configured
@@ -46,7 +47,7 @@ AISearchService::AISearchService(const AISearchConfig& config) : config_(config)
     );
 
     // Initialize Google APIs (will be used if API key is configured)
-    googleGeocodingAPI_.setConfig(config_.googleGeocodingConfig);
+    googleGeocodingAPI_ = std::make_shared<GoogleGeocodingAPI>(config_.googleGeocodingConfig);
     googlePlacesAPI_.setConfig(config_.googlePlacesConfig);
 
     // Initialize AI engine if configured
@@ -74,7 +75,7 @@ void AISearchService::setConfig(const AISearchConfig& config) {
     );
 
     // Update Google APIs
-    googleGeocodingAPI_.setConfig(config_.googleGeocodingConfig);
+    googleGeocodingAPI_->setConfig(config_.googleGeocodingConfig);
     googlePlacesAPI_.setConfig(config_.googlePlacesConfig);
 
     // Update AI engine if configuration changed
@@ -93,34 +94,13 @@ bool AISearchService::isGoogleAPIAvailable() const {
 void AISearchService::setGoogleAPIKey(const std::string& apiKey) {
     config_.googleGeocodingConfig.apiKey = apiKey;
     config_.googlePlacesConfig.apiKey = apiKey;
-    googleGeocodingAPI_.setConfig(config_.googleGeocodingConfig);
+    googleGeocodingAPI_->setConfig(config_.googleGeocodingConfig);
     googlePlacesAPI_.setConfig(config_.googlePlacesConfig);
 }
 
-void AISearchService::setGeocodingThreadPoolSize(int threadCount) {
-    config_.geocodingThreadPoolSize = std::max(1, threadCount);
-    config_.googleGeocodingConfig.threadPoolSize = config_.geocodingThreadPoolSize;
-    config_.googlePlacesConfig.threadPoolSize = config_.geocodingThreadPoolSize;
-
-    googleGeocodingAPI_.setThreadPoolSize(config_.geocodingThreadPoolSize);
-    googlePlacesAPI_.setThreadPoolSize(config_.geocodingThreadPoolSize);
-}
-
-int AISearchService::getGeocodingThreadPoolSize() const {
-    return config_.geocodingThreadPoolSize;
-}
-
-int AISearchService::getRecommendedMemoryMB() const {
-    return config_.getRecommendedMemoryMB();
-}
-
-std::string AISearchService::getThreadPoolDescription() const {
-    return ThreadPoolConfig::getThreadCountDescription(config_.geocodingThreadPoolSize);
-}
-
 void AISearchService::prewarmGeocodingCache(const std::vector<std::string>& addresses) {
     if (isGoogleAPIAvailable()) {
-        googleGeocodingAPI_.prewarmCache(addresses);
+        googleGeocodingAPI_->prewarmCache(addresses);
     }
 }
 
@@ -129,7 +109,7 @@ void AISearchService::geocodeBatch(
     std::function<void(BatchGeocodeResult)> callback
 ) {
     if (isGoogleAPIAvailable()) {
-        googleGeocodingAPI_.geocodeBatch(addresses, callback);
+        googleGeocodingAPI_->geocodeBatch(addresses, callback);
     } else if (callback) {
         // Fall back to sync geocoding
         BatchGeocodeResult result;
@@ -147,12 +127,20 @@ void AISearchService::geocodeBatch(
     }
 }
 
-Models::GeoLocation AISearchService::geocodeAddress(const std::string& address) {
+/**
+ * @brief Geocode with Google when preferred, then the configured service,
+ *        then fall back to Denver
+ */
+static Models::GeoLocation geocodeWithFallback(
+    GoogleGeocodingAPI* googleGeocoder,
+    IGeocodingService* geocodingService,
+    const std::string& address
+) {
     Models::GeoLocation result;
 
     // Use Google Geocoding API if configured (faster and more reliable)
-    if (config_.preferGoogleAPIs && isGoogleAPIAvailable()) {
-        result = googleGeocodingAPI_.geocodeSync(address);
+    if (googleGeocoder) {
+        result = googleGeocoder->geocodeSync(address);
         if (result.isValid) {
             return result;
         }
@@ -160,8 +148,8 @@ Models::GeoLocation AISearchService::geocodeAddress(const std::string& address)
     }
 
     // Try Nominatim or other configured service
-    if (geocodingService_) {
-        result = geocodingService_->geocodeSync(address);
+    if (geocodingService) {
+        result = geocodingService->geocodeSync(address);
         if (result.isValid) {
             return result;
         }
@@ -171,9 +159,7 @@ Models::GeoLocation AISearchService::geocodeAddress(const std::string& address)
     return Models::GeoLocation(39.7392, -104.9903, "Denver", "CO");
 }
 
-Models::SearchArea AISearchService::createSearchArea(const std::string& address, double radiusMiles) {
-    Models::GeoLocation location = geocodeAddress(address);
-
+static Models::SearchArea searchAreaFromLocation(Models::GeoLocation location, double radiusMiles) {
     // If geocoding completely failed (0,0 coordinates), use Denver as fallback
     if (location.latitude == 0.0 && location.longitude == 0.0) {
         location = Models::GeoLocation(39.7392, -104.9903, "Denver", "CO");
@@ -182,6 +168,74 @@ Models::SearchArea AISearchService::createSearchArea(const std::string& address,
     return Models::SearchArea::fromMiles(location, radiusMiles);
 }
 
+/**
+ * @brief Search area of a query; geocode is only called for a query with a
+ *        location and neither a resolved area nor coordinates
+ */
+static Models::SearchArea searchAreaForQuery(
+    const Models::SearchQuery& query,
+    const std::function<Models::GeoLocation(const std::string&)>& geocode
+) {
+    if (query.hasSearchArea) {
+        return query.searchArea;
+    }
+
+    if (query.latitude != 0 && query.longitude != 0) {
+        // Use provided coordinates
+        Models::GeoLocation location(query.latitude, query.longitude);
+        location.formattedAddress = query.location;
+        return Models::SearchArea::fromMiles(location, query.radiusMiles);
+    }
+
+    if (!query.location.empty()) {
+        return searchAreaFromLocation(geocode(query.location), query.radiusMiles);
+    }
+
+    // Default to Denver
+    Models::GeoLocation defaultLocation(39.7392, -104.9903, "Denver", "CO");
+    return Models::SearchArea::fromMiles(defaultLocation, query.radiusMiles);
+}
+
+Models::GeoLocation AISearchService::geocodeAddress(const std::string& address) {
+    bool useGoogle = config_.preferGoogleAPIs && isGoogleAPIAvailable();
+    return geocodeWithFallback(useGoogle ? googleGeocodingAPI_.get() : nullptr,
+                               geocodingService_.get(), address);
+}
+
+Models::SearchArea AISearchService::createSearchArea(const std::string& address, double radiusMiles) {
+    return searchAreaFromLocation(geocodeAddress(address), radiusMiles);
+}
+
+Models::SearchArea AISearchService::resolveSearchArea(const Models::SearchQuery& query) {
+    return searchAreaForQuery(query, [this](const std::string& address) {
+        return geocodeAddress(address);
+    });
+}
+
+void AISearchService::resolveSearchAreaAsync(
+    const Models::SearchQuery& query,
+    std::function<void(Models::SearchQuery)> callback
+) {
+    // The task shares ownership of this session's geocoders, so it can
+    // finish after the service is gone without building geocoders of its own
+    bool useGoogle = config_.preferGoogleAPIs && isGoogleAPIAvailable();
+    std::shared_ptr<GoogleGeocodingAPI> googleGeocoder = useGoogle ? googleGeocodingAPI_ : nullptr;
+    std::shared_ptr<IGeocodingService> geocodingService = geocodingService_;
+
+    ThreadPool::shared().post(TaskOptions::interactive(),
+        [query, callback, googleGeocoder, geocodingService]() {
+            Models::SearchQuery resolved = query;
+            resolved.searchArea = searchAreaForQuery(query, [&](const std::string& address) {
+                return geocodeWithFallback(googleGeocoder.get(), geocodingService.get(), address);
+            });
+            resolved.hasSearchArea = true;
+
+            if (callback) {
+                callback(std::move(resolved));
+            }
+        });
+}
+
 void AISearchService::setAIEngine(std::unique_ptr<AIEngine> engine) {
     aiEngine_ = std::move(engine);
 }
@@ -334,20 +388,9 @@ void AISearchService::executeSearch(
         progress.percentComplete = 20;
         if (progressCallback) progressCallback(progress);
 
-        // Create search area from location using geocoding service
-        Models::SearchArea searchArea;
-        if (query.latitude != 0 && query.longitude != 0) {
-            // Use provided coordinates
-            Models::GeoLocation location(query.latitude, query.longitude);
-            searchArea = Models::SearchArea::fromMiles(location, query.radiusMiles);
-        } else if (!query.location.empty()) {
-            // Geocode the address using the geocoding service
-            searchArea = createSearchArea(query.location, query.radiusMiles);
-        } else {
-            // Default to Denver
-            Models::GeoLocation defaultLocation(39.7392, -104.9903, "Denver", "CO");
-            searchArea = Models::SearchArea::fromMiles(defaultLocation, query.radiusMiles);
-        }
+        // Use the area resolved before the search started; geocode here
+        // only for callers that did not resolve it
+        Models::SearchArea searchArea = resolveSearchArea(query);
 
         // Use Google Places API if configured (faster, more reliable)
         // Fall back to OpenStreetMap if Google is not configured or returns no results
@@ -53,22 +53,12 @@ struct AISearchConfig {
     // Google API preference (use Google APIs when available for faster performance)
     bool preferGoogleAPIs = true;
 
-    // Thread pool settings for background geocoding
-    int geocodingThreadPoolSize = 4;
-
     /**
      * @brief Check if Google APIs are configured
      */
     bool isGoogleConfigured() const {
         return googleGeocodingConfig.isConfigured() && googlePlacesConfig.isConfigured();
     }
-
-    /**
-     * @brief Get recommended memory for current thread pool settings
-     */
-    int getRecommendedMemoryMB() const {
-        return ThreadPoolConfig::getRecommendedMemoryMB(geocodingThreadPoolSize);
-    }
 };
 
 /**
@@ -192,7 +182,7 @@ public:
     IGeocodingService& getGeocodingService() { return *geocodingService_; }
 
     // Google API access (high-performance)
-    GoogleGeocodingAPI& getGoogleGeocodingAPI() { return googleGeocodingAPI_; }
+    GoogleGeocodingAPI& getGoogleGeocodingAPI() { return *googleGeocodingAPI_; }
     GooglePlacesAPI& getGooglePlacesAPI() { return googlePlacesAPI_; }
 
     /**
@@ -206,27 +196,6 @@ public:
      */
     void setGoogleAPIKey(const std::string& apiKey);
 
-    /**
-     * @brief Set thread pool size for background geocoding
-     * @param threadCount Number of threads
-     */
-    void setGeocodingThreadPoolSize(int threadCount);
-
-    /**
-     * @brief Get current thread pool size
-     */
-    int getGeocodingThreadPoolSize() const;
-
-    /**
-     * @brief Get recommended memory for current thread pool size
-     */
-    int getRecommendedMemoryMB() const;
-
-    /**
-     * @brief Get thread pool description for current settings
-     */
-    std::string getThreadPoolDescription() const;
-
     /**
      * @brief Pre-warm geocoding cache with addresses (background)
      * @param addresses Addresses to pre-cache
@@ -245,6 +214,10 @@ public:
 
     /**
      * @brief Geocode an address to GeoLocation
+     *
+     * The geocoders' caches are process-wide: concurrent calls for one
+     * address from any session share a single upstream request, and
+     * repeat calls are answered from the cache.
      * @param address Address string (city, state or full address)
      * @return GeoLocation with coordinates
      */
@@ -258,6 +231,27 @@ public:
      */
     Models::SearchArea createSearchArea(const std::string& address, double radiusMiles);
 
+    /**
+     * @brief Search area of a query: its coordinates, its geocoded location,
+     *        or Denver when it has neither
+     * @return query.searchArea when the query already carries one
+     */
+    Models::SearchArea resolveSearchArea(const Models::SearchQuery& query);
+
+    /**
+     * @brief Resolve a query's search area on the shared thread pool
+     *
+     * Geocodes the location once, before the search starts, so neither the
+     * caller nor search() has to. The task shares ownership of the
+     * service's geocoders, so the service may be destroyed meanwhile.
+     * @param callback Called on a worker thread with the query, its
+     *        searchArea set and hasSearchArea true
+     */
+    void resolveSearchAreaAsync(
+        const Models::SearchQuery& query,
+        std::function<void(Models::SearchQuery)> callback
+    );
+
     // AI Engine access
     AIEngine* getAIEngine() { return aiEngine_.get(); }
     void setAIEngine(std::unique_ptr<AIEngine> engine);
@@ -275,10 +269,10 @@ private:
     BBBAPI bbbAPI_;
     DemographicsAPI demographicsAPI_;
     OpenStreetMapAPI osmAPI_;
-    std::unique_ptr<IGeocodingService> geocodingService_;
+    std::shared_ptr<IGeocodingService> geocodingService_;    // Shared with resolveSearchAreaAsync() tasks
 
     // Google high-performance APIs
-    GoogleGeocodingAPI googleGeocodingAPI_;
+    std::shared_ptr<GoogleGeocodingAPI> googleGeocodingAPI_;
     GooglePlacesAPI googlePlacesAPI_;
 
     // AI Engine for analysis
@@ -0,0 +1,522 @@
+#ifndef API_CACHE_H
+#define API_CACHE_H
+
+#include "PersistentCache.h"
+#include "ShardedCache.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Lifetimes of the entries of an ApiCache
+ */
+struct ApiCachePolicy {
+    int ttlSeconds = 0;             // Entries are fresh this long (0 = nothing is stored)
+    int staleSeconds = 0;           // Then served stale while one background load refreshes them
+    int negativeTtlSeconds = 0;     // Failed loads are remembered this long (0 = retried every call)
+    size_t maxBytes = 16u << 20;    // Memory budget; least valuable entries are evicted beyond it
+
+    /**
+     * @brief Policy from the cache settings of a service config
+     */
+    static ApiCachePolicy fromConfig(bool enableCaching, int durationMinutes,
+                                     int staleMinutes, int negativeSeconds,
+                                     int maxMegabytes) {
+        if (!enableCaching) {
+            return ApiCachePolicy();
+        }
+        return ApiCachePolicy{durationMinutes * 60, staleMinutes * 60, negativeSeconds,
+                              static_cast<size_t>(std::max(maxMegabytes, 1)) << 20};
+    }
+};
+
+/**
+ * @brief How an ApiCache call was answered
+ */
+enum class ApiCacheOutcome {
+    Hit,            // Fresh entry
+    StaleHit,       // Expired entry; a refresh was started or is running
+    NegativeHit,    // Remembered failure
+    Coalesced,      // Joined a load already in flight
+    Loaded          // Loaded from upstream by this call
+};
+
+/**
+ * @brief Whether a call was answered without waiting for the upstream
+ */
+inline bool answeredFromCache(ApiCacheOutcome outcome) {
+    return outcome != ApiCacheOutcome::Coalesced && outcome != ApiCacheOutcome::Loaded;
+}
+
+/**
+ * @brief Hit/miss counters for ApiCache, plus the size of its storage
+ */
+struct ApiCacheStats : ShardedCacheStats {
+    std::atomic<int> hits{0};           // Fresh entries served
+    std::atomic<int> staleHits{0};      // Expired entries served while refreshing
+    std::atomic<int> negativeHits{0};   // Calls answered by a remembered failure
+    std::atomic<int> misses{0};         // Calls that loaded from upstream
+    std::atomic<int> coalesced{0};      // Calls that joined a load already in flight
+    std::atomic<int> refreshes{0};      // Background refreshes started
+    std::atomic<int> diskHits{0};       // Entries restored from the on-disk cache
+
+    double getHitRate() const {
+        int served = hits.load() + staleHits.load() + negativeHits.load();
+        int total = served + misses.load() + coalesced.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(served) / total * 100.0;
+    }
+
+    void reset() {
+        hits = 0;
+        staleHits = 0;
+        negativeHits = 0;
+        misses = 0;
+        coalesced = 0;
+        refreshes = 0;
+        diskHits = 0;
+        resetCounters();
+    }
+};
+
+/**
+ * @brief Cache of upstream API results with a shared expiry policy
+ *
+ * Every API client caches its responses through this class, so they all
+ * behave the same way:
+ *  - Failed loads are cached as negative entries for negativeTtlSeconds,
+ *    so an address that does not geocode is not retried at full cost on
+ *    every call.
+ *  - An entry past ttlSeconds is still served for staleSeconds while a
+ *    single load refreshes it in the background, so a hot key never makes
+ *    a caller wait for the upstream.
+ *  - Concurrent misses for one key are coalesced: the first caller loads,
+ *    the others wait for its result.
+ *  - Entries live in a ShardedCache bounded by maxBytes, weighed by the
+ *    Weigher given to the constructor. Fresh hits only lock one shard.
+ *  - With persistTo(), successful results are also written to a
+ *    PersistentCache, and a key missing from memory is looked up there
+ *    before it is loaded, so results survive a restart.
+ *
+ * Loads are supplied by the caller as a Loader that completes through the
+ * Done callback it is given, on any thread, inline or later (for example
+ * from the HttpClient reactor). The destructor waits for loads still in
+ * flight, so a cache declared after the members its loaders use can be
+ * destroyed safely. Safe to use from any thread.
+ */
+template<typename Value>
+class ApiCache {
+public:
+    using Done = std::function<void(Value value, bool ok)>;
+    using Loader = std::function<void(Done done)>;
+    using Callback = std::function<void(const Value& value, bool ok)>;
+    using Scheduler = std::function<void(std::function<void()> task)>;
+
+    using Weigher = std::function<size_t(const Value& value)>;
+    using Encoder = std::function<std::string(const Value& value)>;
+    using Decoder = std::function<bool(const std::string& bytes, Value& value)>;
+
+    using Outcome = ApiCacheOutcome;
+
+    /**
+     * @param weigher Heap bytes held by a value (nullptr = sizeof(Value))
+     */
+    explicit ApiCache(const ApiCachePolicy& policy = {}, Weigher weigher = nullptr)
+        : policy_(policy),
+          entries_(policy.maxBytes,
+                   [weigher](const std::string& key, const Entry& entry) {
+                       return key.capacity() + sizeof(Entry) +
+                              (entry.ok && weigher ? weigher(entry.value) : 0);
+                   },
+                   &stats_) {}
+
+    ~ApiCache() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return loading_ == 0; });
+    }
+
+    // Non-copyable
+    ApiCache(const ApiCache&) = delete;
+    ApiCache& operator=(const ApiCache&) = delete;
+
+    void setPolicy(const ApiCachePolicy& policy) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            policy_ = policy;
+        }
+        entries_.setMaxBytes(policy.maxBytes);
+    }
+
+    /**
+     * @brief Keep successful results in store as well, under prefix + key
+     * @param store nullptr = memory only
+     */
+    void persistTo(std::shared_ptr<PersistentCache> store, const std::string& prefix,
+                   Encoder encode, Decoder decode) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        store_ = std::move(store);
+        storePrefix_ = prefix;
+        encode_ = std::move(encode);
+        decode_ = std::move(decode);
+    }
+
+    /**
+     * @brief Answer from the cache, or load once for all concurrent callers
+     *
+     * callback runs inline when the cache answers, otherwise on the thread
+     * that completes the load. A stale answer starts load() at most once
+     * per key to refresh the entry; load should then not block the caller.
+     */
+    Outcome fetch(const std::string& key, const Loader& load, const Callback& callback) {
+        Value value;
+        bool ok = false;
+        bool refresh = false;
+        Outcome outcome = begin(key, value, ok, refresh, callback);
+
+        if (outcome != Outcome::Loaded && outcome != Outcome::Coalesced) {
+            callback(value, ok);
+        }
+        if (outcome == Outcome::Loaded || refresh) {
+            runLoad(key, load);
+        }
+        return outcome;
+    }
+
+    /**
+     * @brief Blocking form of fetch() with a synchronous load
+     * @param load Runs on the calling thread for a miss; returns false on failure
+     * @param background Runs the refresh of a stale entry
+     * @return Whether value holds a successful result
+     */
+    bool fetchSync(const std::string& key, Value& value,
+                   const std::function<bool(Value&)>& load,
+                   const Scheduler& background,
+                   Outcome* outcome = nullptr) {
+        auto promise = std::make_shared<std::promise<std::pair<Value, bool>>>();
+        auto future = promise->get_future();
+
+        bool ok = false;
+        bool refresh = false;
+        Outcome result = begin(key, value, ok, refresh,
+            [promise](const Value& loaded, bool loadedOk) {
+                promise->set_value({loaded, loadedOk});
+            });
+        if (outcome) {
+            *outcome = result;
+        }
+
+        Loader loader = [load](Done done) {
+            Value loaded;
+            bool loadedOk = false;
+            try {
+                loadedOk = load(loaded);
+            } catch (...) {
+                // Release the callers waiting on this load before unwinding
+                done(Value(), false);
+                throw;
+            }
+            done(std::move(loaded), loadedOk);
+        };
+
+        if (refresh) {
+            try {
+                background([this, key, loader]() { runLoad(key, loader); });
+            } catch (const std::exception&) {
+                // Executor full or stopped: count it as a failed refresh
+                complete(key, Value(), false);
+            }
+        }
+        if (result == Outcome::Loaded) {
+            runLoad(key, loader);
+        }
+        if (result == Outcome::Loaded || result == Outcome::Coalesced) {
+            auto loaded = future.get();
+            value = std::move(loaded.first);
+            ok = loaded.second;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Fresh or stale entry without loading or counting
+     */
+    bool peek(const std::string& key, Value& value) const {
+        Entry entry;
+        if (!entries_.peek(key, entry) || !entry.ok) {
+            return false;
+        }
+        value = std::move(entry.value);
+        return true;
+    }
+
+    /**
+     * @brief Store a result loaded outside fetch()
+     */
+    void put(const std::string& key, Value value) {
+        PendingWrite write;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            storeLocked(key, value, true, std::time(nullptr), write);
+        }
+        persist(write, value);
+    }
+
+    void clear() {
+        std::shared_ptr<PersistentCache> store;
+        std::string prefix;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            store = store_;
+            prefix = storePrefix_;
+        }
+        entries_.clear();
+        if (store) {
+            store->eraseAll(prefix);
+        }
+    }
+
+    size_t size() const { return entries_.size(); }
+    size_t bytes() const { return entries_.bytes(); }
+
+    const ApiCacheStats& getStats() const { return stats_; }
+    void resetStats() { stats_.reset(); }
+
+private:
+    struct Entry {
+        Value value;
+        time_t storedAt = 0;
+        time_t retryAt = 0;     // A failed refresh is not retried before this
+        int ttlSeconds = 0;     // Fresh for this long; the cache drops it at expiry
+        bool ok = false;
+    };
+
+    struct Flight {
+        std::vector<Callback> waiters;
+    };
+
+    // A result to write to the store once mutex_ is released
+    struct PendingWrite {
+        std::shared_ptr<PersistentCache> store;
+        Encoder encode;
+        std::string key;
+        time_t storedAt = 0;
+        time_t expiresAt = 0;
+    };
+
+    /**
+     * @brief Classify a call; on Loaded/Coalesced the callback is queued
+     */
+    Outcome begin(const std::string& key, Value& value, bool& ok, bool& refresh,
+                  const Callback& callback) {
+        // Fresh and negative hits only take the entry's shard lock
+        Entry entry;
+        bool inMemory = entries_.get(key, entry);
+        if (inMemory) {
+            time_t age = std::time(nullptr) - entry.storedAt;
+            if (entry.ok && age < entry.ttlSeconds) {
+                value = std::move(entry.value);
+                ok = true;
+                stats_.hits++;
+                return Outcome::Hit;
+            }
+            if (!entry.ok) {
+                stats_.negativeHits++;
+                return Outcome::NegativeHit;
+            }
+        }
+
+        // A key missing from memory is read from the store before taking
+        // mutex_, so disk I/O never holds up other keys
+        Entry restored;
+        time_t restoredExpiresAt = 0;
+        bool onDisk = !inMemory && restore(key, restored, restoredExpiresAt);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        time_t now = std::time(nullptr);
+
+        // Entries are only stored under mutex_, so this sees any completed
+        // load; the disk copy is only used if none has arrived meanwhile
+        bool found = entries_.peek(key, entry);
+        if (!found && onDisk) {
+            entry = restored;
+            entries_.put(key, std::move(restored), restoredExpiresAt);
+            stats_.diskHits++;
+            found = true;
+        }
+        if (found) {
+            time_t age = now - entry.storedAt;
+
+            if (entry.ok && age < entry.ttlSeconds) {
+                value = std::move(entry.value);
+                ok = true;
+                stats_.hits++;
+                return Outcome::Hit;
+            }
+            if (!entry.ok) {
+                stats_.negativeHits++;
+                return Outcome::NegativeHit;
+            }
+            value = std::move(entry.value);
+            ok = true;
+            stats_.staleHits++;
+            if (now >= entry.retryAt && flights_.find(key) == flights_.end()) {
+                flights_.emplace(key, std::make_shared<Flight>());
+                ++loading_;
+                stats_.refreshes++;
+                refresh = true;
+            }
+            return Outcome::StaleHit;
+        }
+
+        auto flight = flights_.find(key);
+        if (flight != flights_.end()) {
+            flight->second->waiters.push_back(callback);
+            stats_.coalesced++;
+            return Outcome::Coalesced;
+        }
+
+        auto started = std::make_shared<Flight>();
+        started->waiters.push_back(callback);
+        flights_.emplace(key, std::move(started));
+        ++loading_;
+        stats_.misses++;
+        return Outcome::Loaded;
+    }
+
+    /**
+     * @brief Store a result or a failure with the current policy's lifetime
+     *
+     * A successful result is only kept in memory here; write is filled in
+     * for persist() to encode and store it after mutex_ is released.
+     */
+    void storeLocked(const std::string& key, Value value, bool ok, time_t now, PendingWrite& write) {
+        int lifetime = ok ? policy_.ttlSeconds + policy_.staleSeconds : policy_.negativeTtlSeconds;
+        if (lifetime <= 0 || (ok && policy_.ttlSeconds <= 0)) {
+            return;
+        }
+        if (ok && store_) {
+            write = PendingWrite{store_, encode_, storePrefix_ + key, now, now + lifetime};
+        }
+        entries_.put(key, Entry{std::move(value), now, 0, policy_.ttlSeconds, ok}, now + lifetime);
+    }
+
+    static void persist(const PendingWrite& write, const Value& value) {
+        if (write.store) {
+            write.store->put(write.key, write.encode(value), write.storedAt, write.expiresAt);
+        }
+    }
+
+    /**
+     * @brief Read a result stored by an earlier run; called without mutex_
+     */
+    bool restore(const std::string& key, Entry& entry, time_t& expiresAt) {
+        std::shared_ptr<PersistentCache> store;
+        std::string storeKey;
+        Decoder decode;
+        int ttlSeconds = 0;
+        int lifetime = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!store_ || policy_.ttlSeconds <= 0) {
+                return false;
+            }
+            store = store_;
+            storeKey = storePrefix_ + key;
+            decode = decode_;
+            ttlSeconds = policy_.ttlSeconds;
+            lifetime = policy_.ttlSeconds + policy_.staleSeconds;
+        }
+
+        std::string bytes;
+        time_t storedAt = 0;
+        Value value;
+        if (!store->get(storeKey, bytes, storedAt) ||
+            std::time(nullptr) - storedAt >= lifetime || !decode(bytes, value)) {
+            return false;
+        }
+        entry = Entry{std::move(value), storedAt, 0, ttlSeconds, true};
+        expiresAt = storedAt + lifetime;
+        return true;
+    }
+
+    void runLoad(const std::string& key, const Loader& load) {
+        load([this, key](Value value, bool ok) {
+            complete(key, std::move(value), ok);
+        });
+    }
+
+    void complete(const std::string& key, Value value, bool ok) {
+        std::shared_ptr<Flight> flight;
+        PendingWrite write;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = flights_.find(key);
+            if (it != flights_.end()) {
+                flight = std::move(it->second);
+                flights_.erase(it);
+            }
+
+            time_t now = std::time(nullptr);
+            time_t retryAt = now + std::max(policy_.negativeTtlSeconds, 1);
+            if (ok) {
+                storeLocked(key, value, true, now, write);
+            } else {
+                // A failed refresh keeps the stale value until it expires
+                bool stale = false;
+                entries_.update(key, [&](Entry& entry) {
+                    if (entry.ok) {
+                        entry.retryAt = retryAt;
+                        stale = true;
+                    }
+                });
+                if (!stale) {
+                    storeLocked(key, Value(), false, now, write);
+                }
+            }
+        }
+
+        if (flight) {
+            for (const auto& waiter : flight->waiters) {
+                waiter(value, ok);
+            }
+        }
+
+        // Written after the waiters are answered, and before the destructor
+        // can stop waiting for this load
+        persist(write, value);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--loading_ == 0) {
+            idle_.notify_all();
+        }
+    }
+
+    ApiCachePolicy policy_;
+    std::shared_ptr<PersistentCache> store_;
+    std::string storePrefix_;
+    Encoder encode_;
+    Decoder decode_;
+    ApiCacheStats stats_;
+    ShardedCache<std::string, Entry> entries_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+    int loading_ = 0;   // Loads started and not yet completed
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // API_CACHE_H
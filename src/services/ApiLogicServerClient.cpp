@@ -1,5 +1,6 @@
 #include "ApiLogicServerClient.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -130,102 +131,102 @@ std::string StoreLocationDTO::toJson() const {
     return json.str();
 }
 
-// Simple JSON string extraction helper
-static std::string extractJsonString(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) return "";
-
-    size_t valueStart = json.find_first_not_of(" \t\n\r", colonPos + 1);
-    if (valueStart == std::string::npos) return "";
-
-    if (json[valueStart] == '"') {
-        size_t valueEnd = json.find('"', valueStart + 1);
-        if (valueEnd != std::string::npos) {
-            return json.substr(valueStart + 1, valueEnd - valueStart - 1);
-        }
-    } else if (json[valueStart] == 'n' && json.substr(valueStart, 4) == "null") {
-        return "";
-    } else {
-        // Numeric or boolean value
-        size_t valueEnd = json.find_first_of(",}]", valueStart);
-        if (valueEnd != std::string::npos) {
-            std::string value = json.substr(valueStart, valueEnd - valueStart);
-            // Trim whitespace
-            size_t end = value.find_last_not_of(" \t\n\r");
-            if (end != std::string::npos) {
-                value = value.substr(0, end + 1);
-            }
-            return value;
+/**
+ * @brief Field access for one ApiLogicServer record
+ *
+ * Accepts a JSON:API document ({"data": {...}}), a resource object
+ * ({"attributes": {...}, "id": "..."}) or a flat object. The resource
+ * and its attributes are each indexed in one scan; attributes win when
+ * a key appears in both.
+ */
+class AlsRecord {
+public:
+    explicit AlsRecord(const JsonValue& json) {
+        JsonValue data = json["data"];
+        resource_ = JsonObject(data.isObject() ? data : json);
+
+        JsonValue attributes = resource_["attributes"];
+        if (attributes.isObject()) {
+            attributes_ = JsonObject(attributes);
         }
     }
-    return "";
-}
 
-StoreLocationDTO StoreLocationDTO::fromJson(const std::string& json) {
-    StoreLocationDTO dto;
+    JsonValue operator[](std::string_view key) const {
+        JsonValue value = attributes_[key];
+        return value.exists() ? value : resource_[key];
+    }
 
-    dto.id = extractJsonString(json, "id");
-    dto.franchiseeId = extractJsonString(json, "franchisee_id");
-    dto.storeName = extractJsonString(json, "store_name");
-    dto.storeCode = extractJsonString(json, "store_code");
-    dto.addressLine1 = extractJsonString(json, "address_line1");
-    dto.addressLine2 = extractJsonString(json, "address_line2");
-    dto.city = extractJsonString(json, "city");
-    dto.stateProvince = extractJsonString(json, "state_province");
-    dto.postalCode = extractJsonString(json, "postal_code");
-    dto.countryCode = extractJsonString(json, "country_code");
-    if (dto.countryCode.empty()) dto.countryCode = "US";
+private:
+    JsonObject resource_;
+    JsonObject attributes_;
+};
 
-    std::string latStr = extractJsonString(json, "latitude");
-    std::string lngStr = extractJsonString(json, "longitude");
-    if (!latStr.empty()) {
-        try { dto.latitude = std::stod(latStr); } catch (...) {}
-    }
-    if (!lngStr.empty()) {
-        try { dto.longitude = std::stod(lngStr); } catch (...) {}
+/**
+ * @brief Parse a collection response ({"data": [...]}, [...] or one record)
+ */
+template<typename DTO>
+static std::vector<DTO> parseRecords(const ApiResponse& response) {
+    std::vector<DTO> records;
+
+    if (!response.success || response.body.empty()) {
+        return records;
     }
 
-    dto.geocodeSource = extractJsonString(json, "geocode_source");
+    JsonValue root = JsonValue::parse(response.body);
+    JsonValue data = root.isObject() ? root["data"] : root;
 
-    std::string radiusStr = extractJsonString(json, "default_search_radius_miles");
-    if (!radiusStr.empty()) {
-        try { dto.defaultSearchRadiusMiles = std::stod(radiusStr); } catch (...) {}
+    if (data.isArray()) {
+        data.forEachElement([&records](const JsonValue& element) {
+            records.push_back(DTO::fromJson(element));
+        });
+    } else if (root.isObject()) {
+        records.push_back(DTO::fromJson(root));
     }
 
-    dto.phone = extractJsonString(json, "phone");
-    dto.email = extractJsonString(json, "email");
+    return records;
+}
 
-    std::string activeStr = extractJsonString(json, "is_active");
-    dto.isActive = (activeStr == "true" || activeStr == "1");
+StoreLocationDTO StoreLocationDTO::fromJson(const std::string& json) {
+    return fromJson(JsonValue::parse(json));
+}
 
-    std::string primaryStr = extractJsonString(json, "is_primary");
-    dto.isPrimary = (primaryStr == "true" || primaryStr == "1");
+StoreLocationDTO StoreLocationDTO::fromJson(const JsonValue& json) {
+    StoreLocationDTO dto;
+    AlsRecord record(json);
+
+    dto.id = record["id"].asString();
+    dto.franchiseeId = record["franchisee_id"].asString();
+    dto.storeName = record["store_name"].asString();
+    dto.storeCode = record["store_code"].asString();
+    dto.addressLine1 = record["address_line1"].asString();
+    dto.addressLine2 = record["address_line2"].asString();
+    dto.city = record["city"].asString();
+    dto.stateProvince = record["state_province"].asString();
+    dto.postalCode = record["postal_code"].asString();
+    dto.countryCode = record["country_code"].asString();
+    if (dto.countryCode.empty()) dto.countryCode = "US";
 
-    // Search criteria
-    dto.targetBusinessTypes = extractJsonString(json, "target_business_types");
+    dto.latitude = record["latitude"].asDouble(dto.latitude);
+    dto.longitude = record["longitude"].asDouble(dto.longitude);
 
-    std::string minEmpStr = extractJsonString(json, "min_employees");
-    if (!minEmpStr.empty()) {
-        try { dto.minEmployees = std::stoi(minEmpStr); } catch (...) {}
-    }
+    dto.geocodeSource = record["geocode_source"].asString();
 
-    std::string maxEmpStr = extractJsonString(json, "max_employees");
-    if (!maxEmpStr.empty()) {
-        try { dto.maxEmployees = std::stoi(maxEmpStr); } catch (...) {}
-    }
+    dto.defaultSearchRadiusMiles = record["default_search_radius_miles"].asDouble(dto.defaultSearchRadiusMiles);
+
+    dto.phone = record["phone"].asString();
+    dto.email = record["email"].asString();
 
-    std::string osmStr = extractJsonString(json, "include_openstreetmap");
-    dto.includeOpenStreetMap = (osmStr.empty() || osmStr == "true" || osmStr == "1");
+    dto.isActive = record["is_active"].asBool();
+    dto.isPrimary = record["is_primary"].asBool();
 
-    std::string googleStr = extractJsonString(json, "include_google_places");
-    dto.includeGooglePlaces = (googleStr == "true" || googleStr == "1");
+    // Search criteria
+    dto.targetBusinessTypes = record["target_business_types"].asString();
 
-    std::string bbbStr = extractJsonString(json, "include_bbb");
-    dto.includeBBB = (bbbStr == "true" || bbbStr == "1");
+    dto.minEmployees = record["min_employees"].asInt(dto.minEmployees);
+    dto.maxEmployees = record["max_employees"].asInt(dto.maxEmployees);
+    dto.includeOpenStreetMap = record["include_openstreetmap"].asBool(true);
+    dto.includeGooglePlaces = record["include_google_places"].asBool();
+    dto.includeBBB = record["include_bbb"].asBool();
 
     return dto;
 }
@@ -291,35 +292,32 @@ std::string FranchiseeDTO::toJson() const {
 }
 
 FranchiseeDTO FranchiseeDTO::fromJson(const std::string& json) {
-    FranchiseeDTO dto;
+    return fromJson(JsonValue::parse(json));
+}
 
-    dto.id = extractJsonString(json, "id");
-    dto.businessName = extractJsonString(json, "business_name");
-    dto.dbaName = extractJsonString(json, "dba_name");
-    dto.franchiseNumber = extractJsonString(json, "franchise_number");
-    dto.ownerFirstName = extractJsonString(json, "owner_first_name");
-    dto.ownerLastName = extractJsonString(json, "owner_last_name");
-    dto.email = extractJsonString(json, "email");
-    dto.phone = extractJsonString(json, "phone");
-    dto.addressLine1 = extractJsonString(json, "address_line1");
-    dto.addressLine2 = extractJsonString(json, "address_line2");
-    dto.city = extractJsonString(json, "city");
-    dto.stateProvince = extractJsonString(json, "state_province");
-    dto.postalCode = extractJsonString(json, "postal_code");
-    dto.countryCode = extractJsonString(json, "country_code");
+FranchiseeDTO FranchiseeDTO::fromJson(const JsonValue& json) {
+    FranchiseeDTO dto;
+    AlsRecord record(json);
+
+    dto.id = record["id"].asString();
+    dto.businessName = record["business_name"].asString();
+    dto.dbaName = record["dba_name"].asString();
+    dto.franchiseNumber = record["franchise_number"].asString();
+    dto.ownerFirstName = record["owner_first_name"].asString();
+    dto.ownerLastName = record["owner_last_name"].asString();
+    dto.email = record["email"].asString();
+    dto.phone = record["phone"].asString();
+    dto.addressLine1 = record["address_line1"].asString();
+    dto.addressLine2 = record["address_line2"].asString();
+    dto.city = record["city"].asString();
+    dto.stateProvince = record["state_province"].asString();
+    dto.postalCode = record["postal_code"].asString();
+    dto.countryCode = record["country_code"].asString();
     if (dto.countryCode.empty()) dto.countryCode = "US";
 
-    std::string latStr = extractJsonString(json, "latitude");
-    std::string lngStr = extractJsonString(json, "longitude");
-    if (!latStr.empty()) {
-        try { dto.latitude = std::stod(latStr); } catch (...) {}
-    }
-    if (!lngStr.empty()) {
-        try { dto.longitude = std::stod(lngStr); } catch (...) {}
-    }
-
-    std::string activeStr = extractJsonString(json, "is_active");
-    dto.isActive = (activeStr == "true" || activeStr == "1");
+    dto.latitude = record["latitude"].asDouble(dto.latitude);
+    dto.longitude = record["longitude"].asDouble(dto.longitude);
+    dto.isActive = record["is_active"].asBool();
 
     return dto;
 }
@@ -359,39 +357,25 @@ std::string ScoringRuleDTO::toJson() const {
 }
 
 ScoringRuleDTO ScoringRuleDTO::fromJson(const std::string& json) {
-    ScoringRuleDTO dto;
-
-    dto.id = extractJsonString(json, "id");
-    dto.ruleId = extractJsonString(json, "rule_id");
-    dto.name = extractJsonString(json, "name");
-    dto.description = extractJsonString(json, "description");
-    dto.franchiseeId = extractJsonString(json, "franchisee_id");
-
-    std::string penaltyStr = extractJsonString(json, "is_penalty");
-    dto.isPenalty = (penaltyStr == "true" || penaltyStr == "1");
-
-    std::string enabledStr = extractJsonString(json, "enabled");
-    dto.enabled = (enabledStr == "true" || enabledStr == "1");
-
-    std::string defaultPtsStr = extractJsonString(json, "default_points");
-    if (!defaultPtsStr.empty()) {
-        try { dto.defaultPoints = std::stoi(defaultPtsStr); } catch (...) {}
-    }
+    return fromJson(JsonValue::parse(json));
+}
 
-    std::string currentPtsStr = extractJsonString(json, "current_points");
-    if (!currentPtsStr.empty()) {
-        try { dto.currentPoints = std::stoi(currentPtsStr); } catch (...) {}
-    }
+ScoringRuleDTO ScoringRuleDTO::fromJson(const JsonValue& json) {
+    ScoringRuleDTO dto;
+    AlsRecord record(json);
 
-    std::string minPtsStr = extractJsonString(json, "min_points");
-    if (!minPtsStr.empty()) {
-        try { dto.minPoints = std::stoi(minPtsStr); } catch (...) {}
-    }
+    dto.id = record["id"].asString();
+    dto.ruleId = record["rule_id"].asString();
+    dto.name = record["name"].asString();
+    dto.description = record["description"].asString();
+    dto.franchiseeId = record["franchisee_id"].asString();
 
-    std::string maxPtsStr = extractJsonString(json, "max_points");
-    if (!maxPtsStr.empty()) {
-        try { dto.maxPoints = std::stoi(maxPtsStr); } catch (...) {}
-    }
+    dto.isPenalty = record["is_penalty"].asBool();
+    dto.enabled = record["enabled"].asBool();
+    dto.defaultPoints = record["default_points"].asInt(dto.defaultPoints);
+    dto.currentPoints = record["current_points"].asInt(dto.currentPoints);
+    dto.minPoints = record["min_points"].asInt(dto.minPoints);
+    dto.maxPoints = record["max_points"].asInt(dto.maxPoints);
 
     return dto;
 }
@@ -504,67 +488,48 @@ std::string SavedProspectDTO::toJson() const {
 }
 
 SavedProspectDTO SavedProspectDTO::fromJson(const std::string& json) {
-    SavedProspectDTO dto;
+    return fromJson(JsonValue::parse(json));
+}
 
-    dto.id = extractJsonString(json, "id");
-    dto.storeLocationId = extractJsonString(json, "store_location_id");
-    dto.businessName = extractJsonString(json, "business_name");
-    dto.businessCategory = extractJsonString(json, "business_category");
-    dto.addressLine1 = extractJsonString(json, "address_line1");
-    dto.addressLine2 = extractJsonString(json, "address_line2");
-    dto.city = extractJsonString(json, "city");
-    dto.stateProvince = extractJsonString(json, "state_province");
-    dto.postalCode = extractJsonString(json, "postal_code");
-    dto.countryCode = extractJsonString(json, "country_code");
+SavedProspectDTO SavedProspectDTO::fromJson(const JsonValue& json) {
+    SavedProspectDTO dto;
+    AlsRecord record(json);
+
+    dto.id = record["id"].asString();
+    dto.storeLocationId = record["store_location_id"].asString();
+    dto.businessName = record["business_name"].asString();
+    dto.businessCategory = record["business_category"].asString();
+    dto.addressLine1 = record["address_line1"].asString();
+    dto.addressLine2 = record["address_line2"].asString();
+    dto.city = record["city"].asString();
+    dto.stateProvince = record["state_province"].asString();
+    dto.postalCode = record["postal_code"].asString();
+    dto.countryCode = record["country_code"].asString();
     if (dto.countryCode.empty()) dto.countryCode = "US";
 
-    std::string latStr = extractJsonString(json, "latitude");
-    std::string lngStr = extractJsonString(json, "longitude");
-    if (!latStr.empty()) {
-        try { dto.latitude = std::stod(latStr); } catch (...) {}
-    }
-    if (!lngStr.empty()) {
-        try { dto.longitude = std::stod(lngStr); } catch (...) {}
-    }
+    dto.latitude = record["latitude"].asDouble(dto.latitude);
+    dto.longitude = record["longitude"].asDouble(dto.longitude);
 
-    dto.phone = extractJsonString(json, "phone");
-    dto.email = extractJsonString(json, "email");
-    dto.website = extractJsonString(json, "website");
+    dto.phone = record["phone"].asString();
+    dto.email = record["email"].asString();
+    dto.website = record["website"].asString();
 
-    std::string empStr = extractJsonString(json, "employee_count");
-    if (!empStr.empty()) {
-        try { dto.employeeCount = std::stoi(empStr); } catch (...) {}
-    }
-
-    std::string scoreStr = extractJsonString(json, "catering_potential_score");
-    if (!scoreStr.empty()) {
-        try { dto.cateringPotentialScore = std::stoi(scoreStr); } catch (...) {}
-    }
-
-    std::string relStr = extractJsonString(json, "relevance_score");
-    if (!relStr.empty()) {
-        try { dto.relevanceScore = std::stod(relStr); } catch (...) {}
-    }
-
-    std::string distStr = extractJsonString(json, "distance_miles");
-    if (!distStr.empty()) {
-        try { dto.distanceMiles = std::stod(distStr); } catch (...) {}
-    }
+    dto.employeeCount = record["employee_count"].asInt(dto.employeeCount);
+    dto.cateringPotentialScore = record["catering_potential_score"].asInt(dto.cateringPotentialScore);
+    dto.relevanceScore = record["relevance_score"].asDouble(dto.relevanceScore);
+    dto.distanceMiles = record["distance_miles"].asDouble(dto.distanceMiles);
 
-    dto.aiSummary = extractJsonString(json, "ai_summary");
-    dto.matchReason = extractJsonString(json, "match_reason");
-    dto.keyHighlights = extractJsonString(json, "key_highlights");
-    dto.recommendedActions = extractJsonString(json, "recommended_actions");
-    dto.dataSource = extractJsonString(json, "data_source");
-    dto.savedAt = extractJsonString(json, "saved_at");
+    dto.aiSummary = record["ai_summary"].asString();
+    dto.matchReason = record["match_reason"].asString();
+    dto.keyHighlights = record["key_highlights"].asString();
+    dto.recommendedActions = record["recommended_actions"].asString();
+    dto.dataSource = record["data_source"].asString();
+    dto.savedAt = record["saved_at"].asString();
 
-    std::string contactedStr = extractJsonString(json, "is_contacted");
-    dto.isContacted = (contactedStr == "true" || contactedStr == "1");
+    dto.isContacted = record["is_contacted"].asBool();
+    dto.isConverted = record["is_converted"].asBool();
 
-    std::string convertedStr = extractJsonString(json, "is_converted");
-    dto.isConverted = (convertedStr == "true" || convertedStr == "1");
-
-    dto.notes = extractJsonString(json, "notes");
+    dto.notes = record["notes"].asString();
 
     return dto;
 }
@@ -729,98 +694,74 @@ std::string ProspectDTO::toJson() const {
 }
 
 ProspectDTO ProspectDTO::fromJson(const std::string& json) {
-    ProspectDTO dto;
-
-    dto.id = extractJsonString(json, "id");
-    dto.territoryId = extractJsonString(json, "territory_id");
-    dto.franchiseeId = extractJsonString(json, "franchisee_id");
-    dto.assignedToUserId = extractJsonString(json, "assigned_to_user_id");
-    dto.businessName = extractJsonString(json, "business_name");
-    dto.dbaName = extractJsonString(json, "dba_name");
-    dto.legalName = extractJsonString(json, "legal_name");
-    dto.industryId = extractJsonString(json, "industry_id");
-    dto.industryNaics = extractJsonString(json, "industry_naics");
-    dto.businessType = extractJsonString(json, "business_type");
-
-    std::string empStr = extractJsonString(json, "employee_count");
-    if (!empStr.empty()) {
-        try { dto.employeeCount = std::stoi(empStr); } catch (...) {}
-    }
-    dto.employeeCountRange = extractJsonString(json, "employee_count_range");
-
-    std::string revStr = extractJsonString(json, "annual_revenue");
-    if (!revStr.empty()) {
-        try { dto.annualRevenue = std::stod(revStr); } catch (...) {}
-    }
-
-    std::string yearStr = extractJsonString(json, "year_established");
-    if (!yearStr.empty()) {
-        try { dto.yearEstablished = std::stoi(yearStr); } catch (...) {}
-    }
+    return fromJson(JsonValue::parse(json));
+}
 
-    dto.addressLine1 = extractJsonString(json, "address_line1");
-    dto.addressLine2 = extractJsonString(json, "address_line2");
-    dto.city = extractJsonString(json, "city");
-    dto.stateProvince = extractJsonString(json, "state_province");
-    dto.postalCode = extractJsonString(json, "postal_code");
-    dto.countryCode = extractJsonString(json, "country_code");
+ProspectDTO ProspectDTO::fromJson(const JsonValue& json) {
+    ProspectDTO dto;
+    AlsRecord record(json);
+
+    dto.id = record["id"].asString();
+    dto.territoryId = record["territory_id"].asString();
+    dto.franchiseeId = record["franchisee_id"].asString();
+    dto.assignedToUserId = record["assigned_to_user_id"].asString();
+    dto.businessName = record["business_name"].asString();
+    dto.dbaName = record["dba_name"].asString();
+    dto.legalName = record["legal_name"].asString();
+    dto.industryId = record["industry_id"].asString();
+    dto.industryNaics = record["industry_naics"].asString();
+    dto.businessType = record["business_type"].asString();
+
+    dto.employeeCount = record["employee_count"].asInt(dto.employeeCount);
+    dto.employeeCountRange = record["employee_count_range"].asString();
+
+    dto.annualRevenue = record["annual_revenue"].asDouble(dto.annualRevenue);
+    dto.yearEstablished = record["year_established"].asInt(dto.yearEstablished);
+
+    dto.addressLine1 = record["address_line1"].asString();
+    dto.addressLine2 = record["address_line2"].asString();
+    dto.city = record["city"].asString();
+    dto.stateProvince = record["state_province"].asString();
+    dto.postalCode = record["postal_code"].asString();
+    dto.countryCode = record["country_code"].asString();
     if (dto.countryCode.empty()) dto.countryCode = "US";
 
-    std::string latStr = extractJsonString(json, "latitude");
-    std::string lngStr = extractJsonString(json, "longitude");
-    if (!latStr.empty()) {
-        try { dto.latitude = std::stod(latStr); } catch (...) {}
-    }
-    if (!lngStr.empty()) {
-        try { dto.longitude = std::stod(lngStr); } catch (...) {}
-    }
-    dto.geocodeAccuracy = extractJsonString(json, "geocode_accuracy");
+    dto.latitude = record["latitude"].asDouble(dto.latitude);
+    dto.longitude = record["longitude"].asDouble(dto.longitude);
+    dto.geocodeAccuracy = record["geocode_accuracy"].asString();
 
-    dto.primaryPhone = extractJsonString(json, "primary_phone");
-    dto.secondaryPhone = extractJsonString(json, "secondary_phone");
-    dto.email = extractJsonString(json, "email");
-    dto.website = extractJsonString(json, "website");
-    dto.linkedinUrl = extractJsonString(json, "linkedin_url");
-    dto.facebookUrl = extractJsonString(json, "facebook_url");
+    dto.primaryPhone = record["primary_phone"].asString();
+    dto.secondaryPhone = record["secondary_phone"].asString();
+    dto.email = record["email"].asString();
+    dto.website = record["website"].asString();
+    dto.linkedinUrl = record["linkedin_url"].asString();
+    dto.facebookUrl = record["facebook_url"].asString();
 
-    dto.status = extractJsonString(json, "status");
+    dto.status = record["status"].asString();
     if (dto.status.empty()) dto.status = "new";
-    dto.statusChangedAt = extractJsonString(json, "status_changed_at");
-
-    dto.dataSource = extractJsonString(json, "data_source");
-    dto.sourceRecordId = extractJsonString(json, "source_record_id");
+    dto.statusChangedAt = record["status_changed_at"].asString();
 
-    std::string verifiedStr = extractJsonString(json, "is_verified");
-    dto.isVerified = (verifiedStr == "true" || verifiedStr == "1");
+    dto.dataSource = record["data_source"].asString();
+    dto.sourceRecordId = record["source_record_id"].asString();
 
-    std::string duplicateStr = extractJsonString(json, "is_duplicate");
-    dto.isDuplicate = (duplicateStr == "true" || duplicateStr == "1");
+    dto.isVerified = record["is_verified"].asBool();
+    dto.isDuplicate = record["is_duplicate"].asBool();
 
-    dto.duplicateOfId = extractJsonString(json, "duplicate_of_id");
+    dto.duplicateOfId = record["duplicate_of_id"].asString();
 
-    std::string dncStr = extractJsonString(json, "do_not_contact");
-    dto.doNotContact = (dncStr == "true" || dncStr == "1");
+    dto.doNotContact = record["do_not_contact"].asBool();
 
-    dto.createdAt = extractJsonString(json, "created_at");
-    dto.updatedAt = extractJsonString(json, "updated_at");
+    dto.createdAt = record["created_at"].asString();
+    dto.updatedAt = record["updated_at"].asString();
 
     // AI and scoring fields
-    std::string aiScoreStr = extractJsonString(json, "ai_score");
-    if (!aiScoreStr.empty()) {
-        try { dto.aiScore = std::stoi(aiScoreStr); } catch (...) {}
-    }
-    std::string optScoreStr = extractJsonString(json, "optimized_score");
-    if (!optScoreStr.empty()) {
-        try { dto.optimizedScore = std::stoi(optScoreStr); } catch (...) {}
-    }
-    std::string relScoreStr = extractJsonString(json, "relevance_score");
-    if (!relScoreStr.empty()) {
-        try { dto.relevanceScore = std::stod(relScoreStr); } catch (...) {}
-    }
-    dto.aiSummary = extractJsonString(json, "ai_summary");
-    dto.keyHighlights = extractJsonString(json, "key_highlights");
-    dto.recommendedActions = extractJsonString(json, "recommended_actions");
-    dto.dataSources = extractJsonString(json, "data_sources");
+    dto.aiScore = record["ai_score"].asInt(dto.aiScore);
+    dto.optimizedScore = record["optimized_score"].asInt(dto.optimizedScore);
+    dto.relevanceScore = record["relevance_score"].asDouble(dto.relevanceScore);
+    dto.aiSummary = record["ai_summary"].asString();
+    dto.keyHighlights = record["key_highlights"].asString();
+    dto.recommendedActions = record["recommended_actions"].asString();
+    dto.dataSources = record["data_sources"].asString();
 
     return dto;
 }
@@ -830,207 +771,118 @@ ProspectDTO ProspectDTO::fromJson(const std::string& json) {
 // ============================================================================
 
 ApiLogicServerClient::ApiLogicServerClient() {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
+    // libcurl is initialised once by the shared HttpClient
 }
 
 ApiLogicServerClient::~ApiLogicServerClient() {
-    // Note: Don't call curl_global_cleanup here as other services may use curl
-}
-
-size_t ApiLogicServerClient::writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    size_t totalSize = size * nmemb;
-    userp->append(static_cast<char*>(contents), totalSize);
-    return totalSize;
 }
 
 std::string ApiLogicServerClient::getEndpoint() const {
     return AppConfig::instance().getApiLogicServerEndpoint();
 }
 
-ApiResponse ApiLogicServerClient::httpGet(const std::string& path) {
-    ApiResponse response;
-    CURL* curl = curl_easy_init();
+/**
+ * @brief Send a request to ApiLogicServer over the shared HttpClient
+ */
+static ApiResponse performAlsRequest(HttpRequest& request) {
+    request.timeoutMs = 30000;
+
+    HttpResponse httpResponse = HttpClient::instance().perform(request);
 
-    if (!curl) {
-        response.errorMessage = "Failed to initialize CURL";
+    ApiResponse response;
+    if (!httpResponse.ok) {
+        response.errorMessage = httpResponse.error;
         return response;
     }
 
-    std::string url = getEndpoint() + path;
-    std::string responseBody;
-
-    std::cout << "  [ALS] GET " << url << std::endl;
+    response.statusCode = static_cast<int>(httpResponse.statusCode);
+    response.body = std::move(httpResponse.body);
+    response.success = httpResponse.isSuccess();
+    return response;
+}
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+ApiResponse ApiLogicServerClient::httpGet(const std::string& path) {
+    HttpRequest request;
+    request.url = getEndpoint() + path;
+    request.headers.push_back("Accept: application/json");
 
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Accept: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    std::cout << "  [ALS] GET " << request.url << std::endl;
 
-    CURLcode res = curl_easy_perform(curl);
+    ApiResponse response = performAlsRequest(request);
 
-    if (res != CURLE_OK) {
-        response.errorMessage = curl_easy_strerror(res);
+    if (!response.errorMessage.empty()) {
         std::cerr << "  [ALS] GET failed: " << response.errorMessage << std::endl;
     } else {
-        long httpCode;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-        response.statusCode = static_cast<int>(httpCode);
-        response.body = responseBody;
-        response.success = (httpCode >= 200 && httpCode < 300);
-        std::cout << "  [ALS] Response: " << httpCode << " (" << responseBody.length() << " bytes)" << std::endl;
-        std::cout << "  [ALS] Body: " << responseBody << std::endl;
+        std::cout << "  [ALS] Response: " << response.statusCode << " (" << response.body.length() << " bytes)" << std::endl;
+        std::cout << "  [ALS] Body: " << response.body << std::endl;
     }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
     return response;
 }
 
 ApiResponse ApiLogicServerClient::httpPost(const std::string& path, const std::string& body) {
-    ApiResponse response;
-    CURL* curl = curl_easy_init();
-
-    if (!curl) {
-        response.errorMessage = "Failed to initialize CURL";
-        return response;
-    }
-
-    std::string url = getEndpoint() + path;
-    std::string responseBody;
-
-    std::cout << "  [ALS] POST " << url << std::endl;
+    HttpRequest request;
+    request.url = getEndpoint() + path;
+    request.method = "POST";
+    request.body = body;
+    request.headers.push_back("Content-Type: application/vnd.api+json");
+    request.headers.push_back("Accept: application/vnd.api+json");
+
+    std::cout << "  [ALS] POST " << request.url << std::endl;
     std::cout << "  [ALS] Body: " << body << std::endl;
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/vnd.api+json");
-    headers = curl_slist_append(headers, "Accept: application/vnd.api+json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-    CURLcode res = curl_easy_perform(curl);
+    ApiResponse response = performAlsRequest(request);
 
-    if (res != CURLE_OK) {
-        response.errorMessage = curl_easy_strerror(res);
+    if (!response.errorMessage.empty()) {
         std::cerr << "  [ALS] POST failed: " << response.errorMessage << std::endl;
     } else {
-        long httpCode;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-        response.statusCode = static_cast<int>(httpCode);
-        response.body = responseBody;
-        response.success = (httpCode >= 200 && httpCode < 300);
-        std::cout << "  [ALS] Response: " << httpCode << std::endl;
+        std::cout << "  [ALS] Response: " << response.statusCode << std::endl;
         if (!response.success) {
-            std::cerr << "  [ALS] Error body: " << responseBody << std::endl;
+            std::cerr << "  [ALS] Error body: " << response.body << std::endl;
         } else {
-            std::cout << "  [ALS] Success body: " << responseBody << std::endl;
+            std::cout << "  [ALS] Success body: " << response.body << std::endl;
         }
     }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
     return response;
 }
 
 ApiResponse ApiLogicServerClient::httpPatch(const std::string& path, const std::string& body) {
-    ApiResponse response;
-    CURL* curl = curl_easy_init();
-
-    if (!curl) {
-        response.errorMessage = "Failed to initialize CURL";
-        return response;
-    }
-
-    std::string url = getEndpoint() + path;
-    std::string responseBody;
-
-    std::cout << "  [ALS] PATCH " << url << std::endl;
+    HttpRequest request;
+    request.url = getEndpoint() + path;
+    request.method = "PATCH";
+    request.body = body;
+    request.headers.push_back("Content-Type: application/vnd.api+json");
+    request.headers.push_back("Accept: application/vnd.api+json");
+
+    std::cout << "  [ALS] PATCH " << request.url << std::endl;
     std::cout << "  [ALS] Body: " << body << std::endl;
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    ApiResponse response = performAlsRequest(request);
 
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/vnd.api+json");
-    headers = curl_slist_append(headers, "Accept: application/vnd.api+json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-    CURLcode res = curl_easy_perform(curl);
-
-    if (res != CURLE_OK) {
-        response.errorMessage = curl_easy_strerror(res);
+    if (!response.errorMessage.empty()) {
         std::cerr << "  [ALS] PATCH failed: " << response.errorMessage << std::endl;
     } else {
-        long httpCode;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-        response.statusCode = static_cast<int>(httpCode);
-        response.body = responseBody;
-        response.success = (httpCode >= 200 && httpCode < 300);
-        std::cout << "  [ALS] Response: " << httpCode << std::endl;
+        std::cout << "  [ALS] Response: " << response.statusCode << std::endl;
         if (!response.success) {
-            std::cerr << "  [ALS] Error body: " << responseBody << std::endl;
+            std::cerr << "  [ALS] Error body: " << response.body << std::endl;
         } else {
-            std::cout << "  [ALS] Success body: " << responseBody << std::endl;
+            std::cout << "  [ALS] Success body: " << response.body << std::endl;
         }
     }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
     return response;
 }
 
 ApiResponse ApiLogicServerClient::httpDelete(const std::string& path) {
-    ApiResponse response;
-    CURL* curl = curl_easy_init();
-
-    if (!curl) {
-        response.errorMessage = "Failed to initialize CURL";
-        return response;
-    }
-
-    std::string url = getEndpoint() + path;
-    std::string responseBody;
+    HttpRequest request;
+    request.url = getEndpoint() + path;
+    request.method = "DELETE";
+    request.headers.push_back("Accept: application/json");
 
-    std::cout << "  [ALS] DELETE " << url << std::endl;
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Accept: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-    CURLcode res = curl_easy_perform(curl);
-
-    if (res != CURLE_OK) {
-        response.errorMessage = curl_easy_strerror(res);
-    } else {
-        long httpCode;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-        response.statusCode = static_cast<int>(httpCode);
-        response.body = responseBody;
-        response.success = (httpCode >= 200 && httpCode < 300);
-    }
+    std::cout << "  [ALS] DELETE " << request.url << std::endl;
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    return response;
+    return performAlsRequest(request);
 }
 
 ApiResponse ApiLogicServerClient::saveStoreLocation(const StoreLocationDTO& location) {
@@ -1074,53 +926,7 @@ ApiResponse ApiLogicServerClient::deleteStoreLocation(const std::string& id) {
 }
 
 std::vector<StoreLocationDTO> ApiLogicServerClient::parseStoreLocations(const ApiResponse& response) {
-    std::vector<StoreLocationDTO> locations;
-
-    if (!response.success || response.body.empty()) {
-        return locations;
-    }
-
-    // Simple parsing - look for objects in the response
-    // ApiLogicServer typically returns { "data": [...] } or just [...]
-    const std::string& json = response.body;
-
-    // Find the array start (could be after "data": or direct)
-    size_t arrayStart = json.find('[');
-    if (arrayStart == std::string::npos) {
-        // Single object?
-        if (json.find('{') != std::string::npos) {
-            locations.push_back(StoreLocationDTO::fromJson(json));
-        }
-        return locations;
-    }
-
-    // Parse array of objects
-    size_t pos = arrayStart + 1;
-    int braceCount = 0;
-    size_t objStart = std::string::npos;
-
-    while (pos < json.length()) {
-        char c = json[pos];
-
-        if (c == '{') {
-            if (braceCount == 0) {
-                objStart = pos;
-            }
-            braceCount++;
-        } else if (c == '}') {
-            braceCount--;
-            if (braceCount == 0 && objStart != std::string::npos) {
-                std::string objJson = json.substr(objStart, pos - objStart + 1);
-                locations.push_back(StoreLocationDTO::fromJson(objJson));
-                objStart = std::string::npos;
-            }
-        } else if (c == ']' && braceCount == 0) {
-            break;
-        }
-        pos++;
-    }
-
-    return locations;
+    return parseRecords<StoreLocationDTO>(response);
 }
 
 // ============================================================================
@@ -1168,51 +974,7 @@ ApiResponse ApiLogicServerClient::deleteFranchisee(const std::string& id) {
 }
 
 std::vector<FranchiseeDTO> ApiLogicServerClient::parseFranchisees(const ApiResponse& response) {
-    std::vector<FranchiseeDTO> franchisees;
-
-    if (!response.success || response.body.empty()) {
-        return franchisees;
-    }
-
-    const std::string& json = response.body;
-
-    // Find the array start
-    size_t arrayStart = json.find('[');
-    if (arrayStart == std::string::npos) {
-        // Single object?
-        if (json.find('{') != std::string::npos) {
-            franchisees.push_back(FranchiseeDTO::fromJson(json));
-        }
-        return franchisees;
-    }
-
-    // Parse array of objects
-    size_t pos = arrayStart + 1;
-    int braceCount = 0;
-    size_t objStart = std::string::npos;
-
-    while (pos < json.length()) {
-        char c = json[pos];
-
-        if (c == '{') {
-            if (braceCount == 0) {
-                objStart = pos;
-            }
-            braceCount++;
-        } else if (c == '}') {
-            braceCount--;
-            if (braceCount == 0 && objStart != std::string::npos) {
-                std::string objJson = json.substr(objStart, pos - objStart + 1);
-                franchisees.push_back(FranchiseeDTO::fromJson(objJson));
-                objStart = std::string::npos;
-            }
-        } else if (c == ']' && braceCount == 0) {
-            break;
-        }
-        pos++;
-    }
-
-    return franchisees;
+    return parseRecords<FranchiseeDTO>(response);
 }
 
 // ============================================================================
@@ -1227,9 +989,9 @@ ApiResponse ApiLogicServerClient::saveScoringRule(const ScoringRuleDTO& rule) {
         auto existingResponse = httpGet("/ScoringRule?filter[rule_id]=" + dto.ruleId);
         if (existingResponse.success && !existingResponse.body.empty()) {
             // Try to extract the ID from the response
-            std::string existingId = extractJsonString(existingResponse.body, "id");
-            if (!existingId.empty()) {
-                dto.id = existingId;
+            auto existing = parseScoringRules(existingResponse);
+            if (!existing.empty() && !existing.front().id.empty()) {
+                dto.id = existing.front().id;
                 std::cout << "  [ALS] Found existing rule with UUID: " << dto.id << std::endl;
             }
         }
@@ -1284,51 +1046,7 @@ ApiResponse ApiLogicServerClient::deleteScoringRule(const std::string& id) {
 }
 
 std::vector<ScoringRuleDTO> ApiLogicServerClient::parseScoringRules(const ApiResponse& response) {
-    std::vector<ScoringRuleDTO> rules;
-
-    if (!response.success || response.body.empty()) {
-        return rules;
-    }
-
-    const std::string& json = response.body;
-
-    // Find the array start
-    size_t arrayStart = json.find('[');
-    if (arrayStart == std::string::npos) {
-        // Single object?
-        if (json.find('{') != std::string::npos) {
-            rules.push_back(ScoringRuleDTO::fromJson(json));
-        }
-        return rules;
-    }
-
-    // Parse array of objects
-    size_t pos = arrayStart + 1;
-    int braceCount = 0;
-    size_t objStart = std::string::npos;
-
-    while (pos < json.length()) {
-        char c = json[pos];
-
-        if (c == '{') {
-            if (braceCount == 0) {
-                objStart = pos;
-            }
-            braceCount++;
-        } else if (c == '}') {
-            braceCount--;
-            if (braceCount == 0 && objStart != std::string::npos) {
-                std::string objJson = json.substr(objStart, pos - objStart + 1);
-                rules.push_back(ScoringRuleDTO::fromJson(objJson));
-                objStart = std::string::npos;
-            }
-        } else if (c == ']' && braceCount == 0) {
-            break;
-        }
-        pos++;
-    }
-
-    return rules;
+    return parseRecords<ScoringRuleDTO>(response);
 }
 
 // ============================================================================
@@ -1446,51 +1164,7 @@ ApiResponse ApiLogicServerClient::deleteProspect(const std::string& id) {
 }
 
 std::vector<ProspectDTO> ApiLogicServerClient::parseProspects(const ApiResponse& response) {
-    std::vector<ProspectDTO> prospects;
-
-    if (!response.success || response.body.empty()) {
-        return prospects;
-    }
-
-    const std::string& json = response.body;
-
-    // Find the array start
-    size_t arrayStart = json.find('[');
-    if (arrayStart == std::string::npos) {
-        // Single object?
-        if (json.find('{') != std::string::npos) {
-            prospects.push_back(ProspectDTO::fromJson(json));
-        }
-        return prospects;
-    }
-
-    // Parse array of objects
-    size_t pos = arrayStart + 1;
-    int braceCount = 0;
-    size_t objStart = std::string::npos;
-
-    while (pos < json.length()) {
-        char c = json[pos];
-
-        if (c == '{') {
-            if (braceCount == 0) {
-                objStart = pos;
-            }
-            braceCount++;
-        } else if (c == '}') {
-            braceCount--;
-            if (braceCount == 0 && objStart != std::string::npos) {
-                std::string objJson = json.substr(objStart, pos - objStart + 1);
-                prospects.push_back(ProspectDTO::fromJson(objJson));
-                objStart = std::string::npos;
-            }
-        } else if (c == ']' && braceCount == 0) {
-            break;
-        }
-        pos++;
-    }
-
-    return prospects;
+    return parseRecords<ProspectDTO>(response);
 }
 
 ApiResponse ApiLogicServerClient::getSavedProspect(const std::string& id) {
@@ -1516,51 +1190,7 @@ ApiResponse ApiLogicServerClient::deleteSavedProspect(const std::string& id) {
 }
 
 std::vector<SavedProspectDTO> ApiLogicServerClient::parseSavedProspects(const ApiResponse& response) {
-    std::vector<SavedProspectDTO> prospects;
-
-    if (!response.success || response.body.empty()) {
-        return prospects;
-    }
-
-    const std::string& json = response.body;
-
-    // Find the array start
-    size_t arrayStart = json.find('[');
-    if (arrayStart == std::string::npos) {
-        // Single object?
-        if (json.find('{') != std::string::npos) {
-            prospects.push_back(SavedProspectDTO::fromJson(json));
-        }
-        return prospects;
-    }
-
-    // Parse array of objects
-    size_t pos = arrayStart + 1;
-    int braceCount = 0;
-    size_t objStart = std::string::npos;
-
-    while (pos < json.length()) {
-        char c = json[pos];
-
-        if (c == '{') {
-            if (braceCount == 0) {
-                objStart = pos;
-            }
-            braceCount++;
-        } else if (c == '}') {
-            braceCount--;
-            if (braceCount == 0 && objStart != std::string::npos) {
-                std::string objJson = json.substr(objStart, pos - objStart + 1);
-                prospects.push_back(SavedProspectDTO::fromJson(objJson));
-                objStart = std::string::npos;
-            }
-        } else if (c == ']' && braceCount == 0) {
-            break;
-        }
-        pos++;
-    }
-
-    return prospects;
+    return parseRecords<SavedProspectDTO>(response);
 }
 
 bool ApiLogicServerClient::isAvailable() {
@@ -1578,51 +1208,15 @@ void ApiLogicServerClient::loadAppConfigs() {
         return;
     }
 
-    // Parse the JSON array of config entries
     // JSON:API format has: {"data": [{"attributes": {..., "config_key": "...", ...}, "id": "...", "type": "AppConfig"}, ...]}
-    // Important: In JSON:API, "attributes" comes BEFORE "id" in the JSON string (alphabetical order)
-    // So we need to find config_key first, then find the id that comes AFTER it in the same record
-    const std::string& json = response.body;
-    size_t pos = 0;
-
-    while (pos < json.length()) {
-        // Find next "config_key" field (indicates we're in an attributes block)
-        size_t keyPos = json.find("\"config_key\"", pos);
-        if (keyPos == std::string::npos) break;
+    JsonValue root = JsonValue::parse(response.body);
+    root["data"].forEachElement([this](const JsonValue& element) {
+        AlsRecord record(element);
 
         AppConfigEntry entry;
-
-        // Extract config_key
-        size_t ckStart = json.find("\"", keyPos + 12);
-        size_t ckEnd = json.find("\"", ckStart + 1);
-        if (ckStart != std::string::npos && ckEnd != std::string::npos) {
-            entry.configKey = json.substr(ckStart + 1, ckEnd - ckStart - 1);
-        }
-
-        // Extract config_value (comes after config_key in the same attributes block)
-        size_t cvPos = json.find("\"config_value\"", keyPos);
-        if (cvPos != std::string::npos && cvPos < keyPos + 500) {
-            size_t cvStart = json.find("\"", cvPos + 14);
-            size_t cvEnd = json.find("\"", cvStart + 1);
-            if (cvStart != std::string::npos && cvEnd != std::string::npos) {
-                entry.configValue = json.substr(cvStart + 1, cvEnd - cvStart - 1);
-            }
-        }
-
-        // Find the "id" field that comes AFTER the attributes block (same record)
-        // The "id" is at the same level as "attributes", so it comes after the attributes block closes
-        size_t idPos = json.find("\"id\"", keyPos);
-        if (idPos != std::string::npos) {
-            // Make sure we don't go past the next record's config_key
-            size_t nextKeyPos = json.find("\"config_key\"", keyPos + 1);
-            if (nextKeyPos == std::string::npos || idPos < nextKeyPos) {
-                size_t idStart = json.find("\"", idPos + 4);
-                size_t idEnd = json.find("\"", idStart + 1);
-                if (idStart != std::string::npos && idEnd != std::string::npos) {
-                    entry.id = json.substr(idStart + 1, idEnd - idStart - 1);
-                }
-            }
-        }
+        entry.configKey = record["config_key"].asString();
+        entry.configValue = record["config_value"].asString();
+        entry.id = record["id"].asString();
 
         // Add to cache if we got a valid key and id
         if (!entry.configKey.empty() && !entry.id.empty()) {
@@ -1630,9 +1224,7 @@ void ApiLogicServerClient::loadAppConfigs() {
             std::cout << "  [ALS] Cached: " << std::left << std::setw(25) << entry.configKey
                       << " = '" << entry.configValue << "'\t(id: " << entry.id << ")" << std::endl;
         }
-
-        pos = keyPos + 1;
-    }
+    });
 
     std::cout << "  [ALS] Loaded " << appConfigCache_.size() << " config entries" << std::endl;
 }
@@ -1683,7 +1275,7 @@ bool ApiLogicServerClient::setAppConfigValue(const std::string& key, const std::
 
     if (response.success) {
         // Add to cache - extract ID from response
-        std::string newId = extractJsonString(response.body, "id");
+        std::string newId = AlsRecord(JsonValue::parse(response.body))["id"].asString();
         if (!newId.empty()) {
             AppConfigEntry entry;
             entry.id = newId;
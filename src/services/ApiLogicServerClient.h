@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include "models/Franchisee.h"
 #include "AppConfig.h"
+#include "JsonReader.h"
 
 namespace FranchiseAI {
 namespace Services {
@@ -142,6 +143,7 @@ struct StoreLocationDTO {
 
     // Parse from JSON response
     static StoreLocationDTO fromJson(const std::string& json);
+    static StoreLocationDTO fromJson(const JsonValue& json);
 };
 
 /**
@@ -171,6 +173,7 @@ struct FranchiseeDTO {
 
     // Parse from JSON response
     static FranchiseeDTO fromJson(const std::string& json);
+    static FranchiseeDTO fromJson(const JsonValue& json);
 };
 
 /**
@@ -194,6 +197,7 @@ struct ScoringRuleDTO {
 
     // Parse from JSON response
     static ScoringRuleDTO fromJson(const std::string& json);
+    static ScoringRuleDTO fromJson(const JsonValue& json);
 };
 
 /**
@@ -235,6 +239,7 @@ struct SavedProspectDTO {
 
     // Parse from JSON response
     static SavedProspectDTO fromJson(const std::string& json);
+    static SavedProspectDTO fromJson(const JsonValue& json);
 };
 
 /**
@@ -295,6 +300,7 @@ struct ProspectDTO {
 
     // Parse from JSON response
     static ProspectDTO fromJson(const std::string& json);
+    static ProspectDTO fromJson(const JsonValue& json);
 };
 
 /**
@@ -605,11 +611,6 @@ private:
      */
     ApiResponse httpDelete(const std::string& path);
 
-    /**
-     * @brief CURL write callback
-     */
-    static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
-
     /**
      * @brief In-memory cache of app config entries
      * Key: config_key, Value: AppConfigEntry (includes ID for updates)
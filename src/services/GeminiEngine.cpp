@@ -1,5 +1,6 @@
 #include "GeminiEngine.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <sstream>
 #include <cstring>
 #include <algorithm>
@@ -10,13 +11,6 @@ namespace FranchiseAI {
 namespace Services {
 
 namespace {
-    // CURL write callback
-    size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* response) {
-        size_t totalSize = size * nmemb;
-        response->append(static_cast<char*>(contents), totalSize);
-        return totalSize;
-    }
-
     // Simple JSON string escaping
     std::string escapeJSON(const std::string& str) {
         std::ostringstream result;
@@ -38,53 +32,6 @@ namespace {
         }
         return result.str();
     }
-
-    // Extract JSON string value - handles nested objects
-    std::string extractJSONString(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = json.find(searchKey);
-        if (keyPos == std::string::npos) return "";
-
-        size_t colonPos = json.find(':', keyPos);
-        if (colonPos == std::string::npos) return "";
-
-        size_t startPos = json.find('"', colonPos + 1);
-        if (startPos == std::string::npos) return "";
-
-        std::string result;
-        bool escaped = false;
-        for (size_t i = startPos + 1; i < json.size(); ++i) {
-            char c = json[i];
-            if (escaped) {
-                switch (c) {
-                    case 'n': result += '\n'; break;
-                    case 'r': result += '\r'; break;
-                    case 't': result += '\t'; break;
-                    case '"': result += '"'; break;
-                    case '\\': result += '\\'; break;
-                    default: result += c;
-                }
-                escaped = false;
-            } else if (c == '\\') {
-                escaped = true;
-            } else if (c == '"') {
-                break;
-            } else {
-                result += c;
-            }
-        }
-        return result;
-    }
-
-    // Extract text content from Gemini response format
-    std::string extractGeminiText(const std::string& json) {
-        // Gemini returns: candidates[0].content.parts[0].text
-        // Look for "text" field within the parts array
-        size_t textPos = json.find("\"text\"");
-        if (textPos == std::string::npos) return "";
-
-        return extractJSONString(json, "text");
-    }
 }
 
 GeminiEngine::GeminiEngine() {
@@ -158,35 +105,19 @@ std::string GeminiEngine::buildRequestJSON(
 }
 
 std::string GeminiEngine::makeAPIRequest(const std::string& requestBody) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "{\"error\":{\"message\":\"Failed to initialize CURL\"}}";
-    }
-
-    std::string response;
-    std::string url = buildAPIUrl();
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, requestBody.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.timeoutMs);
-
-    CURLcode res = curl_easy_perform(curl);
+    HttpRequest request;
+    request.url = buildAPIUrl();
+    request.method = "POST";
+    request.body = requestBody;
+    request.headers.push_back("Content-Type: application/json");
+    request.timeoutMs = config_.timeoutMs;
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-        return "{\"error\":{\"message\":\"CURL error: " +
-               std::string(curl_easy_strerror(res)) + "\"}}";
+    HttpResponse response = HttpClient::instance().perform(request);
+    if (!response.ok) {
+        return "{\"error\":{\"message\":\"CURL error: " + response.error + "\"}}";
     }
 
-    return response;
+    return response.body;
 }
 
 AIAnalysisResponse GeminiEngine::parseAPIResponse(const std::string& jsonResponse) {
@@ -194,10 +125,13 @@ AIAnalysisResponse GeminiEngine::parseAPIResponse(const std::string& jsonRespons
     response.provider = "Google Gemini";
     response.model = config_.model;
 
+    JsonValue root = JsonValue::parse(jsonResponse);
+
     // Check for error
-    if (jsonResponse.find("\"error\"") != std::string::npos) {
+    JsonValue error = root["error"];
+    if (error.exists()) {
         response.success = false;
-        response.error = extractJSONString(jsonResponse, "message");
+        response.error = error.isString() ? error.asString() : error["message"].asString();
         if (response.error.empty()) {
             response.error = "Unknown API error";
         }
@@ -205,7 +139,13 @@ AIAnalysisResponse GeminiEngine::parseAPIResponse(const std::string& jsonRespons
     }
 
     // Extract content from Gemini format: candidates[0].content.parts[0].text
-    response.content = extractGeminiText(jsonResponse);
+    root["candidates"].forEachElement([&response](const JsonValue& candidate) {
+        candidate["content"]["parts"].forEachElement([&response](const JsonValue& part) {
+            response.content = part["text"].asString();
+            return false;
+        });
+        return false;
+    });
     response.success = !response.content.empty();
 
     // Gemini doesn't return token counts in the same way, estimate based on response length
@@ -1,12 +1,98 @@
 #include "GeocodingService.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <ctime>
+#include <future>
 
 namespace FranchiseAI {
 namespace Services {
 
+size_t weighGeoLocation(const Models::GeoLocation& location) {
+    return heapBytes(location.formattedAddress) + heapBytes(location.street) +
+           heapBytes(location.city) + heapBytes(location.state) +
+           heapBytes(location.postalCode) + heapBytes(location.country) +
+           heapBytes(location.source);
+}
+
+std::string normalizeAddressKey(const std::string& address) {
+    // Spelled-out street words and their USPS abbreviations
+    static const std::unordered_map<std::string, std::string> kAbbreviations = {
+        {"street", "st"}, {"avenue", "ave"}, {"av", "ave"}, {"road", "rd"},
+        {"boulevard", "blvd"}, {"drive", "dr"}, {"lane", "ln"}, {"court", "ct"},
+        {"place", "pl"}, {"parkway", "pkwy"}, {"highway", "hwy"}, {"suite", "ste"},
+        {"square", "sq"}, {"terrace", "ter"}, {"circle", "cir"}, {"apartment", "apt"}
+    };
+
+    std::string key;
+    key.reserve(address.size());
+    std::string word;
+    auto endWord = [&key, &word]() {
+        if (word.empty()) {
+            return;
+        }
+        if (!key.empty()) {
+            key += ' ';
+        }
+        auto abbreviation = kAbbreviations.find(word);
+        key += (abbreviation != kAbbreviations.end()) ? abbreviation->second : word;
+        word.clear();
+    };
+
+    for (unsigned char c : address) {
+        if (std::isalnum(c) || c == '-' || c >= 0x80) {
+            word += static_cast<char>(std::tolower(c));
+        } else if (c != '\'') {
+            // Whitespace, commas, periods, '#' ... separate words;
+            // apostrophes do not ("O'Hare" = "OHare")
+            endWord();
+        }
+    }
+    endWord();
+    return key;
+}
+
+// Bump when the encoding below changes; older records then fail to decode
+static const uint8_t kGeoLocationEncoding = 1;
+
+std::string encodeGeoLocation(const Models::GeoLocation& location) {
+    ByteWriter writer;
+    writer.put(kGeoLocationEncoding);
+    writer.put(location.latitude);
+    writer.put(location.longitude);
+    writer.putString(location.formattedAddress);
+    writer.putString(location.street);
+    writer.putString(location.city);
+    writer.putString(location.state);
+    writer.putString(location.postalCode);
+    writer.putString(location.country);
+    writer.putString(location.source);
+    writer.put(location.accuracy);
+    writer.put(static_cast<uint8_t>(location.isValid));
+    return std::move(writer.bytes());
+}
+
+bool decodeGeoLocation(const std::string& bytes, Models::GeoLocation& location) {
+    ByteReader reader(bytes);
+    if (reader.get<uint8_t>() != kGeoLocationEncoding) {
+        return false;
+    }
+    location.latitude = reader.get<double>();
+    location.longitude = reader.get<double>();
+    location.formattedAddress = reader.getString();
+    location.street = reader.getString();
+    location.city = reader.getString();
+    location.state = reader.getString();
+    location.postalCode = reader.getString();
+    location.country = reader.getString();
+    location.source = reader.getString();
+    location.accuracy = reader.get<double>();
+    location.isValid = reader.get<uint8_t>() != 0;
+    return reader.ok() && reader.atEnd();
+}
+
 // Known locations for demo/fallback (when API is unavailable)
 const std::unordered_map<std::string, Models::GeoLocation> NominatimGeocodingService::knownLocations_ = {
     {"new york", Models::GeoLocation(40.7128, -74.0060, "New York", "NY")},
@@ -64,22 +150,27 @@ const std::unordered_map<std::string, Models::GeoLocation> NominatimGeocodingSer
     {"dc", Models::GeoLocation(38.9072, -77.0369, "Washington", "DC")}
 };
 
-// CURL write callback
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
+NominatimGeocodingService::NominatimGeocodingService()
+    : cache_(sharedCache()) {
+    GeocodingConfig config;
+    config.provider = GeocodingProvider::NOMINATIM;
+    setConfig(config);
 }
 
-NominatimGeocodingService::NominatimGeocodingService() {
-    config_.provider = GeocodingProvider::NOMINATIM;
-    config_.endpoint = "https://nominatim.openstreetmap.org";
+NominatimGeocodingService::NominatimGeocodingService(const GeocodingConfig& config)
+    : cache_(sharedCache()) {
+    setConfig(config);
 }
 
-NominatimGeocodingService::NominatimGeocodingService(const GeocodingConfig& config)
-    : config_(config) {
-    if (config_.endpoint.empty()) {
-        config_.endpoint = "https://nominatim.openstreetmap.org";
-    }
+NominatimGeocodingService::~NominatimGeocodingService() {
+    // Reactor requests call back into this instance
+    std::unique_lock<std::mutex> lock(requestMutex_);
+    requestIdle_.wait(lock, [this] { return requestsInFlight_ == 0; });
+}
+
+std::shared_ptr<ApiCache<Models::GeoLocation>> NominatimGeocodingService::sharedCache() {
+    static auto cache = std::make_shared<ApiCache<Models::GeoLocation>>(ApiCachePolicy(), weighGeoLocation);
+    return cache;
 }
 
 void NominatimGeocodingService::setConfig(const GeocodingConfig& config) {
@@ -87,35 +178,25 @@ void NominatimGeocodingService::setConfig(const GeocodingConfig& config) {
     if (config_.endpoint.empty()) {
         config_.endpoint = "https://nominatim.openstreetmap.org";
     }
-}
-
-std::string NominatimGeocodingService::normalizeAddress(const std::string& address) {
-    std::string normalized = address;
-    // Convert to lowercase
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
-                   [](unsigned char c) { return std::tolower(c); });
-    // Remove extra whitespace
-    normalized.erase(std::unique(normalized.begin(), normalized.end(),
-                                  [](char a, char b) { return a == ' ' && b == ' '; }),
-                      normalized.end());
-    // Trim
-    size_t start = normalized.find_first_not_of(" \t");
-    size_t end = normalized.find_last_not_of(" \t");
-    if (start != std::string::npos && end != std::string::npos) {
-        normalized = normalized.substr(start, end - start + 1);
+    cache_->setPolicy(ApiCachePolicy::fromConfig(config_.enableCaching, config_.cacheDurationMinutes,
+                                                config_.cacheStaleMinutes, config_.negativeCacheSeconds,
+                                                config_.cacheMaxMegabytes));
+    // The cache is shared; an instance without a store path keeps the
+    // store another instance attached
+    if (auto store = PersistentCache::shared(config_.cacheStorePath,
+                                             static_cast<size_t>(std::max(config_.cacheStoreMaxMegabytes, 1)) << 20)) {
+        cache_->persistTo(store, "geocode:nominatim:", encodeGeoLocation, decodeGeoLocation);
     }
-    // Remove common punctuation
-    normalized.erase(std::remove_if(normalized.begin(), normalized.end(),
-                                     [](char c) { return c == ',' || c == '.'; }),
-                      normalized.end());
-    return normalized;
+    rateLimiter_ = RateLimiter::shared(RateLimiter::hostOf(config_.endpoint), config_.maxRequestsPerSecond);
 }
 
 void NominatimGeocodingService::geocode(const std::string& address, GeocodeCallback callback) {
-    auto result = geocodeSync(address);
-    if (callback) {
-        callback(result, result.isValid ? "" : "Geocoding failed");
-    }
+    // Runs on the reactor; no pool thread waits for the response
+    geocodeAsync(address, [callback](const Models::GeoLocation& result) {
+        if (callback) {
+            callback(result, result.isValid ? "" : "Geocoding failed");
+        }
+    });
 }
 
 void NominatimGeocodingService::reverseGeocode(double latitude, double longitude, ReverseGeocodeCallback callback) {
@@ -126,191 +207,140 @@ void NominatimGeocodingService::reverseGeocode(double latitude, double longitude
 }
 
 Models::GeoLocation NominatimGeocodingService::geocodeSync(const std::string& address) {
-    // Check cache first
-    std::string cacheKey = normalizeAddress(address);
-    if (config_.enableCaching) {
-        auto it = cache_.find(cacheKey);
-        if (it != cache_.end()) {
-            time_t now = std::time(nullptr);
-            if (now - it->second.second < config_.cacheDurationMinutes * 60) {
-                return it->second.first;
-            }
-        }
-    }
+    // Blocks only the caller
+    std::promise<Models::GeoLocation> promise;
+    auto future = promise.get_future();
+    geocodeAsync(address, [&promise](const Models::GeoLocation& result) {
+        promise.set_value(result);
+    });
+    return future.get();
+}
 
-    // Check known locations first (fast path for common cities)
+void NominatimGeocodingService::geocodeAsync(const std::string& address, GeocodeDone done) {
+    std::string cacheKey = normalizeAddressKey(address);
+
+    // Known locations first (fast path for common cities)
     auto known = knownLocations_.find(cacheKey);
     if (known != knownLocations_.end()) {
         Models::GeoLocation result = known->second;
         result.source = "local";
         result.formattedAddress = result.city + ", " + result.state;
-
-        // Cache the result
-        if (config_.enableCaching) {
-            cache_[cacheKey] = {result, std::time(nullptr)};
-        }
-        return result;
+        done(result);
+        return;
     }
 
-    // Call Nominatim API for any address not in known locations
-    Models::GeoLocation result = callNominatimAPI(address);
-
-    // Cache the result (even if invalid, to avoid repeated failed calls)
-    if (config_.enableCaching) {
-        cache_[cacheKey] = {result, std::time(nullptr)};
-    }
-
-    return result;
+    // Call Nominatim for any other address. A failure is remembered for
+    // negativeCacheSeconds; concurrent calls share one request, and a
+    // stale hit is refreshed by another reactor request.
+    cache_->fetch(cacheKey,
+        [this, address](ApiCache<Models::GeoLocation>::Done loaded) {
+            sendNominatimRequest(address, 0, std::chrono::milliseconds(0), [loaded](const Models::GeoLocation& location) {
+                loaded(location, location.isValid);
+            });
+        },
+        [done](const Models::GeoLocation& location, bool) {
+            done(location);
+        });
 }
 
-Models::GeoLocation NominatimGeocodingService::callNominatimAPI(const std::string& address) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        // Return invalid location on CURL init failure
-        Models::GeoLocation invalid;
-        invalid.isValid = false;
-        return invalid;
-    }
-
+void NominatimGeocodingService::sendNominatimRequest(const std::string& address, int attempt,
+                                                     std::chrono::milliseconds backoff, GeocodeDone done) {
     // Build URL with URL-encoded address
-    std::string url = config_.endpoint + "/search?format=json&limit=1&q=";
-    char* encoded = curl_easy_escape(curl, address.c_str(), static_cast<int>(address.length()));
-    if (encoded) {
-        url += encoded;
-        curl_free(encoded);
-    } else {
-        curl_easy_cleanup(curl);
-        Models::GeoLocation invalid;
-        invalid.isValid = false;
-        return invalid;
+    std::string url = config_.endpoint + "/search?format=json&limit=1&q=" +
+                      HttpClient::urlEncode(address);
+
+    // Set up request with fast timeouts
+    HttpRequest request;
+    request.url = url;
+    request.userAgent = config_.userAgent;
+    request.timeoutMs = config_.requestTimeoutMs;
+    request.connectTimeoutMs = config_.connectTimeoutMs;
+    request.followRedirects = true;
+
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        requestsInFlight_++;
     }
 
-    // Set up CURL request with fast timeouts
-    std::string response;
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.userAgent.c_str());
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.requestTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connectTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
-
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-        // Network error - return invalid location
-        Models::GeoLocation invalid;
-        invalid.isValid = false;
-        return invalid;
-    }
+    // The reactor holds the request until the limiter has a token for it
+    HttpClient::instance().performAsync(request,
+        [this, address, attempt, done](HttpResponse httpResponse) {
+            bool rateLimited = httpResponse.isRateLimited();
+            auto retryDelay = RateLimiter::retryDelay(httpResponse, attempt,
+                                                      std::chrono::milliseconds(config_.retryDelayMs));
+            if (rateLimited) {
+                // Every request to the host waits out Retry-After
+                rateLimiter_->pause(retryDelay);
+            }
+
+            if ((rateLimited || httpResponse.statusCode >= 500) && attempt < config_.maxRetries) {
+                // A rate-limited retry waits out the limiter's pause instead
+                sendNominatimRequest(address, attempt + 1,
+                                     rateLimited ? std::chrono::milliseconds(0) : retryDelay, done);
+            } else {
+                Models::GeoLocation result;
+                result.isValid = false;
+                if (httpResponse.isSuccess()) {
+                    // Nominatim returns: [{"lat":"40.7127281","lon":"-74.0060152","display_name":"...","address":{"city":"...",...}}]
+                    result = parseNominatimResponse(httpResponse.body, address);
+                }
+                done(result);
+            }
 
-    // Parse JSON response
-    // Nominatim returns: [{"lat":"40.7127281","lon":"-74.0060152","display_name":"...","address":{"city":"...",...}}]
-    return parseNominatimResponse(response, address);
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            if (--requestsInFlight_ == 0) {
+                requestIdle_.notify_all();
+            }
+        }, std::max(backoff, rateLimiter_->reserve()));
 }
 
 Models::GeoLocation NominatimGeocodingService::parseNominatimResponse(const std::string& json, const std::string& originalAddress) {
     Models::GeoLocation result;
     result.isValid = false;
 
-    // Check if response is empty or not a valid array
-    if (json.empty() || json[0] != '[') {
+    // Check if response is a non-empty array; use the first match
+    JsonValue match;
+    JsonValue::parse(json).forEachElement([&match](const JsonValue& first) {
+        match = first;
+        return false;
+    });
+    if (!match.isObject()) {
         return result;
     }
 
-    // Check for empty array
-    if (json == "[]") {
-        return result;
-    }
+    JsonObject fields(match);
 
-    // Extract latitude
-    size_t latPos = json.find("\"lat\"");
-    if (latPos == std::string::npos) {
-        return result;
-    }
-    size_t latStart = json.find("\"", latPos + 5);
-    size_t latEnd = json.find("\"", latStart + 1);
-    if (latStart == std::string::npos || latEnd == std::string::npos) {
+    // Nominatim sends coordinates as strings
+    JsonValue lat = fields["lat"];
+    JsonValue lon = fields["lon"];
+    if (!lat.exists() || !lon.exists()) {
         return result;
     }
-    std::string latStr = json.substr(latStart + 1, latEnd - latStart - 1);
 
-    // Extract longitude
-    size_t lonPos = json.find("\"lon\"");
-    if (lonPos == std::string::npos) {
-        return result;
-    }
-    size_t lonStart = json.find("\"", lonPos + 5);
-    size_t lonEnd = json.find("\"", lonStart + 1);
-    if (lonStart == std::string::npos || lonEnd == std::string::npos) {
+    result.latitude = lat.asDouble(NAN);
+    result.longitude = lon.asDouble(NAN);
+    if (std::isnan(result.latitude) || std::isnan(result.longitude)) {
         return result;
     }
-    std::string lonStr = json.substr(lonStart + 1, lonEnd - lonStart - 1);
+
+    result.isValid = true;
+    result.source = "nominatim";
 
     // Extract display_name for formatted address
-    std::string displayName = originalAddress;
-    size_t displayPos = json.find("\"display_name\"");
-    if (displayPos != std::string::npos) {
-        size_t displayStart = json.find("\"", displayPos + 14);
-        size_t displayEnd = json.find("\"", displayStart + 1);
-        if (displayStart != std::string::npos && displayEnd != std::string::npos) {
-            displayName = json.substr(displayStart + 1, displayEnd - displayStart - 1);
-        }
+    result.formattedAddress = fields["display_name"].asString(originalAddress);
+
+    // Try to extract city and state from address object
+    JsonObject address(fields["address"]);
+    result.city = address["city"].asString();
+    // Try town if city not found
+    if (result.city.empty()) {
+        result.city = address["town"].asString();
     }
-
-    // Parse coordinates
-    try {
-        result.latitude = std::stod(latStr);
-        result.longitude = std::stod(lonStr);
-        result.isValid = true;
-        result.source = "nominatim";
-        result.formattedAddress = displayName;
-
-        // Try to extract city and state from address object
-        size_t cityPos = json.find("\"city\"");
-        if (cityPos != std::string::npos) {
-            size_t cityStart = json.find("\"", cityPos + 6);
-            size_t cityEnd = json.find("\"", cityStart + 1);
-            if (cityStart != std::string::npos && cityEnd != std::string::npos) {
-                result.city = json.substr(cityStart + 1, cityEnd - cityStart - 1);
-            }
-        }
-        // Try town if city not found
-        if (result.city.empty()) {
-            size_t townPos = json.find("\"town\"");
-            if (townPos != std::string::npos) {
-                size_t townStart = json.find("\"", townPos + 6);
-                size_t townEnd = json.find("\"", townStart + 1);
-                if (townStart != std::string::npos && townEnd != std::string::npos) {
-                    result.city = json.substr(townStart + 1, townEnd - townStart - 1);
-                }
-            }
-        }
-        // Try village if town not found
-        if (result.city.empty()) {
-            size_t villagePos = json.find("\"village\"");
-            if (villagePos != std::string::npos) {
-                size_t villageStart = json.find("\"", villagePos + 9);
-                size_t villageEnd = json.find("\"", villageStart + 1);
-                if (villageStart != std::string::npos && villageEnd != std::string::npos) {
-                    result.city = json.substr(villageStart + 1, villageEnd - villageStart - 1);
-                }
-            }
-        }
-
-        size_t statePos = json.find("\"state\"");
-        if (statePos != std::string::npos) {
-            size_t stateStart = json.find("\"", statePos + 7);
-            size_t stateEnd = json.find("\"", stateStart + 1);
-            if (stateStart != std::string::npos && stateEnd != std::string::npos) {
-                result.state = json.substr(stateStart + 1, stateEnd - stateStart - 1);
-            }
-        }
-    } catch (...) {
-        result.isValid = false;
+    // Try village if town not found
+    if (result.city.empty()) {
+        result.city = address["village"].asString();
     }
+    result.state = address["state"].asString();
 
     return result;
 }
@@ -330,19 +360,7 @@ Models::GeoLocation NominatimGeocodingService::reverseGeocodeSync(double latitud
 
 std::string NominatimGeocodingService::buildGeocodeUrl(const std::string& address) {
     // URL encode the address
-    CURL* curl = curl_easy_init();
-    std::string url = config_.endpoint + "/search?format=json&q=";
-
-    if (curl) {
-        char* encoded = curl_easy_escape(curl, address.c_str(), static_cast<int>(address.length()));
-        if (encoded) {
-            url += encoded;
-            curl_free(encoded);
-        }
-        curl_easy_cleanup(curl);
-    }
-
-    return url;
+    return config_.endpoint + "/search?format=json&q=" + HttpClient::urlEncode(address);
 }
 
 std::string NominatimGeocodingService::buildReverseGeocodeUrl(double lat, double lon) {
@@ -351,11 +369,11 @@ std::string NominatimGeocodingService::buildReverseGeocodeUrl(double lat, double
 }
 
 void NominatimGeocodingService::clearCache() {
-    cache_.clear();
+    cache_->clear();
 }
 
 int NominatimGeocodingService::getCacheSize() const {
-    return static_cast<int>(cache_.size());
+    return static_cast<int>(cache_->size());
 }
 
 // Factory implementation
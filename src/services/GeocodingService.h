@@ -6,6 +6,11 @@
 #include <functional>
 #include <memory>
 #include <unordered_map>
+#include <condition_variable>
+#include <mutex>
+#include <chrono>
+#include "ApiCache.h"
+#include "RateLimiter.h"
 #include "models/GeoLocation.h"
 
 namespace FranchiseAI {
@@ -33,12 +38,39 @@ struct GeocodingConfig {
     int connectTimeoutMs = 2000;      // 2 seconds connection timeout
     bool enableCaching = true;
     int cacheDurationMinutes = 1440;  // 24 hours
+    int cacheStaleMinutes = 10080;    // Then served for up to 7 days while refreshed in the background
+    int negativeCacheSeconds = 300;   // A failed lookup is not retried for 5 minutes
+    int cacheMaxMegabytes = 8;        // Memory budget of the result cache (shared by all instances)
+    std::string cacheStorePath;       // On-disk cache kept across restarts (empty = memory only)
+    int cacheStoreMaxMegabytes = 512; // Size budget of that file (shared; the largest setting wins)
     std::string userAgent = "FranchiseAI/1.0";
 
-    // Rate limiting
+    // Rate limiting, shared with every client of the same host in the process
     int maxRequestsPerSecond = 1;  // Nominatim requires max 1 req/sec
+    int maxRetries = 2;            // Retries of a lookup answered 429 or 5xx
+    int retryDelayMs = 1000;       // Base of the jittered backoff when there is no Retry-After
 };
 
+/**
+ * @brief Heap bytes held by a geocoding result, for ApiCache budgets
+ */
+size_t weighGeoLocation(const Models::GeoLocation& location);
+
+/**
+ * @brief Cache key of an address, shared by every geocoder
+ *
+ * Lowercase, with punctuation dropped, whitespace collapsed and common
+ * street words abbreviated, so "123 Main Street, Denver" and
+ * "123 main st denver" share one cache entry and one request in flight.
+ */
+std::string normalizeAddressKey(const std::string& address);
+
+/**
+ * @brief Geocoding result as stored in a PersistentCache, and back
+ */
+std::string encodeGeoLocation(const Models::GeoLocation& location);
+bool decodeGeoLocation(const std::string& bytes, Models::GeoLocation& location);
+
 /**
  * @brief Abstract geocoding service interface
  *
@@ -88,13 +120,14 @@ public:
  * @brief Nominatim (OpenStreetMap) geocoding implementation
  *
  * Free geocoding service with no API key required.
- * Rate limited to 1 request per second.
+ * Rate limited to maxRequestsPerSecond (1 by default) per host across
+ * the process.
  */
 class NominatimGeocodingService : public IGeocodingService {
 public:
     NominatimGeocodingService();
     explicit NominatimGeocodingService(const GeocodingConfig& config);
-    ~NominatimGeocodingService() override = default;
+    ~NominatimGeocodingService() override;
 
     void setConfig(const GeocodingConfig& config);
     GeocodingConfig getConfig() const { return config_; }
@@ -107,22 +140,37 @@ public:
     std::string getProviderName() const override { return "Nominatim (OpenStreetMap)"; }
     bool isConfigured() const override { return true; }  // No API key needed
 
-    // Cache management
+    // Cache management (the cache is shared by all instances)
     void clearCache();
     int getCacheSize() const;
+    const ApiCacheStats& getCacheStats() const { return cache_->getStats(); }
 
 private:
     GeocodingConfig config_;
-    std::unordered_map<std::string, std::pair<Models::GeoLocation, time_t>> cache_;
+
+    // Cache: normalized address -> location, shared by every instance so
+    // concurrent sessions geocoding one address send a single request.
+    // Lookups and stale refreshes are reactor requests; the destructor
+    // waits for the ones this instance started.
+    std::shared_ptr<ApiCache<Models::GeoLocation>> cache_;
+    static std::shared_ptr<ApiCache<Models::GeoLocation>> sharedCache();
+
+    std::mutex requestMutex_;
+    std::condition_variable requestIdle_;
+    int requestsInFlight_ = 0;
+
+    std::shared_ptr<RateLimiter> rateLimiter_;    // Per host, shared with OpenStreetMapAPI
 
     // Demo data for common cities (used when API unavailable)
     static const std::unordered_map<std::string, Models::GeoLocation> knownLocations_;
 
     std::string buildGeocodeUrl(const std::string& address);
     std::string buildReverseGeocodeUrl(double lat, double lon);
-    Models::GeoLocation callNominatimAPI(const std::string& address);
+    using GeocodeDone = std::function<void(const Models::GeoLocation&)>;
+    void geocodeAsync(const std::string& address, GeocodeDone done);
+    void sendNominatimRequest(const std::string& address, int attempt, std::chrono::milliseconds backoff,
+                              GeocodeDone done);
     Models::GeoLocation parseNominatimResponse(const std::string& json, const std::string& originalAddress);
-    std::string normalizeAddress(const std::string& address);
 };
 
 /**
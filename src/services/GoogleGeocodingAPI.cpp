@@ -1,119 +1,67 @@
 #include "GoogleGeocodingAPI.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <algorithm>
 #include <cctype>
 #include <ctime>
 #include <chrono>
+#include <future>
 #include <sstream>
 #include <iomanip>
 
 namespace FranchiseAI {
 namespace Services {
 
-// CURL write callback
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
-}
-
-GoogleGeocodingAPI::GoogleGeocodingAPI() {
-    initializeThreadPool();
+GoogleGeocodingAPI::GoogleGeocodingAPI()
+    : cache_(sharedCache()) {
+    setConfig(config_);
 }
 
 GoogleGeocodingAPI::GoogleGeocodingAPI(const GoogleGeocodingConfig& config)
-    : config_(config) {
-    initializeThreadPool();
+    : config_(config), cache_(sharedCache()) {
+    setConfig(config_);
 }
 
 GoogleGeocodingAPI::~GoogleGeocodingAPI() {
-    if (threadPool_) {
-        threadPool_->shutdown(true);
-    }
+    // Reactor callbacks capture this; let outstanding batches finish
+    std::unique_lock<std::mutex> lock(asyncMutex_);
+    asyncIdle_.wait(lock, [this] { return asyncInFlight_ == 0; });
 }
 
-void GoogleGeocodingAPI::initializeThreadPool() {
-    ThreadPoolConfig poolConfig;
-    poolConfig.threadCount = config_.threadPoolSize;
-    poolConfig.maxQueueSize = config_.maxQueuedRequests;
-    poolConfig.enableMetrics = true;
-
-    threadPool_ = std::make_unique<ThreadPool>(poolConfig);
+std::shared_ptr<ApiCache<Models::GeoLocation>> GoogleGeocodingAPI::sharedCache() {
+    static auto cache = std::make_shared<ApiCache<Models::GeoLocation>>(ApiCachePolicy(), weighGeoLocation);
+    return cache;
 }
 
 void GoogleGeocodingAPI::setConfig(const GoogleGeocodingConfig& config) {
     config_ = config;
-
-    // Resize thread pool if needed
-    if (threadPool_ && threadPool_->getThreadCount() != config_.threadPoolSize) {
-        std::lock_guard<std::mutex> lock(threadPoolMutex_);
-        threadPool_->resize(config_.threadPoolSize);
-    }
+    cache_->setPolicy(ApiCachePolicy::fromConfig(config_.enableCaching, config_.cacheDurationMinutes,
+                                                config_.cacheStaleMinutes, config_.negativeCacheSeconds,
+                                                config_.cacheMaxMegabytes));
+    // The cache is shared; an instance without a store path keeps the
+    // store another instance attached
+    if (auto store = PersistentCache::shared(config_.cacheStorePath,
+                                             static_cast<size_t>(std::max(config_.cacheStoreMaxMegabytes, 1)) << 20)) {
+        cache_->persistTo(store, "geocode:google:", encodeGeoLocation, decodeGeoLocation);
+    }
+    rateLimiter_ = RateLimiter::shared(RateLimiter::hostOf(config_.endpoint) + "/geocode",
+                                       config_.maxRequestsPerSecond);
 }
 
 std::string GoogleGeocodingAPI::normalizeAddress(const std::string& address) {
-    std::string normalized = address;
-
-    // Convert to lowercase
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
-                   [](unsigned char c) { return std::tolower(c); });
-
-    // Remove extra whitespace
-    normalized.erase(std::unique(normalized.begin(), normalized.end(),
-                                  [](char a, char b) { return a == ' ' && b == ' '; }),
-                      normalized.end());
-
-    // Trim
-    size_t start = normalized.find_first_not_of(" \t");
-    size_t end = normalized.find_last_not_of(" \t");
-    if (start != std::string::npos && end != std::string::npos) {
-        normalized = normalized.substr(start, end - start + 1);
-    }
-
-    return normalized;
-}
-
-Models::GeoLocation GoogleGeocodingAPI::getCachedResult(const std::string& normalizedAddress) {
-    if (!config_.enableCaching) {
-        return Models::GeoLocation();
-    }
-
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    auto it = cache_.find(normalizedAddress);
-    if (it != cache_.end()) {
-        time_t now = std::time(nullptr);
-        if (now - it->second.second < config_.cacheDurationMinutes * 60) {
-            stats_.cacheHits++;
-            return it->second.first;
-        }
-    }
-
-    stats_.cacheMisses++;
-    return Models::GeoLocation();
+    return normalizeAddressKey(address);
 }
 
-void GoogleGeocodingAPI::cacheResult(const std::string& normalizedAddress, const Models::GeoLocation& location) {
-    if (!config_.enableCaching) {
-        return;
+void GoogleGeocodingAPI::recordOutcome(ApiCacheOutcome outcome) {
+    (answeredFromCache(outcome) ? stats_.cacheHits : stats_.cacheMisses)++;
+    if (outcome == ApiCacheOutcome::Coalesced) {
+        stats_.coalescedRequests++;
     }
-
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    cache_[normalizedAddress] = {location, std::time(nullptr)};
 }
 
 std::string GoogleGeocodingAPI::buildGeocodeUrl(const std::string& address) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "";
-    }
-
-    char* encoded = curl_easy_escape(curl, address.c_str(), static_cast<int>(address.length()));
-    std::string url = config_.endpoint + "?address=" + std::string(encoded) +
-                      "&key=" + config_.apiKey;
-
-    curl_free(encoded);
-    curl_easy_cleanup(curl);
-
-    return url;
+    return config_.endpoint + "?address=" + HttpClient::urlEncode(address) +
+           "&key=" + config_.apiKey;
 }
 
 std::string GoogleGeocodingAPI::buildReverseGeocodeUrl(double lat, double lon) {
@@ -124,276 +72,213 @@ std::string GoogleGeocodingAPI::buildReverseGeocodeUrl(double lat, double lon) {
     return url.str();
 }
 
-std::string GoogleGeocodingAPI::executeHttpRequest(const std::string& url) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "";
-    }
-
-    std::string response;
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.userAgent.c_str());
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.requestTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connectTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
-
-    // SSL settings
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-        return "";
-    }
-
-    return response;
+HttpRequest GoogleGeocodingAPI::buildHttpRequest(const std::string& url) const {
+    HttpRequest request;
+    request.url = url;
+    request.userAgent = config_.userAgent;
+    request.timeoutMs = config_.requestTimeoutMs;
+    request.connectTimeoutMs = config_.connectTimeoutMs;
+    request.followRedirects = true;
+    request.http2 = config_.enableHttp2;
+    return request;
 }
 
-// Helper to extract JSON string value
-static std::string extractJsonValue(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-
-    size_t colonPos = json.find(':', keyPos + searchKey.length());
-    if (colonPos == std::string::npos) return "";
-
-    // Skip whitespace
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && std::isspace(json[valueStart])) valueStart++;
-
-    if (valueStart >= json.length()) return "";
-
-    if (json[valueStart] == '"') {
-        // String value
-        size_t valueEnd = json.find('"', valueStart + 1);
-        if (valueEnd == std::string::npos) return "";
-        return json.substr(valueStart + 1, valueEnd - valueStart - 1);
-    } else if (json[valueStart] == '-' || std::isdigit(json[valueStart])) {
-        // Numeric value
-        size_t valueEnd = valueStart;
-        while (valueEnd < json.length() &&
-               (std::isdigit(json[valueEnd]) || json[valueEnd] == '.' || json[valueEnd] == '-')) {
-            valueEnd++;
-        }
-        return json.substr(valueStart, valueEnd - valueStart);
+bool GoogleGeocodingAPI::noteRateLimit(const HttpResponse& response, bool overQueryLimit, int attempt) {
+    if (!response.isRateLimited() && !overQueryLimit) {
+        return false;
     }
 
-    return "";
+    // Every instance shares the limiter, so all of them back off
+    stats_.rateLimitHits++;
+    rateLimiter_->pause(RateLimiter::retryDelay(response, attempt,
+                                                std::chrono::milliseconds(config_.retryDelayMs)));
+    return true;
 }
 
 Models::GeoLocation GoogleGeocodingAPI::parseGeocodeResponse(
     const std::string& json,
-    const std::string& originalAddress
+    const std::string& originalAddress,
+    bool* overQueryLimit
 ) {
     Models::GeoLocation result;
     result.isValid = false;
 
+    JsonValue response = JsonValue::parse(json);
+
     // Check status
-    std::string status = extractJsonValue(json, "status");
+    std::string status = response["status"].asString();
     if (status != "OK") {
-        if (status == "OVER_QUERY_LIMIT") {
-            stats_.rateLimitHits++;
+        // Google answers an exceeded quota with HTTP 200 and this status
+        if (overQueryLimit) {
+            *overQueryLimit = (status == "OVER_QUERY_LIMIT");
         }
         return result;
     }
 
-    // Find geometry.location
-    size_t locationPos = json.find("\"location\"");
-    if (locationPos == std::string::npos) {
-        return result;
-    }
-
-    // Extract lat/lng from location object
-    size_t locStart = json.find('{', locationPos);
-    size_t locEnd = json.find('}', locStart);
-    if (locStart == std::string::npos || locEnd == std::string::npos) {
+    // Use the first (best) match
+    JsonValue match;
+    response["results"].forEachElement([&match](const JsonValue& first) {
+        match = first;
+        return false;
+    });
+    if (!match.isObject()) {
         return result;
     }
 
-    std::string locationJson = json.substr(locStart, locEnd - locStart + 1);
+    JsonObject fields(match);
 
-    std::string latStr = extractJsonValue(locationJson, "lat");
-    std::string lngStr = extractJsonValue(locationJson, "lng");
-
-    if (latStr.empty() || lngStr.empty()) {
+    // Find geometry.location
+    JsonValue location = fields["geometry"]["location"];
+    JsonValue lat = location["lat"];
+    JsonValue lng = location["lng"];
+    if (!lat.isNumber() || !lng.isNumber()) {
         return result;
     }
 
-    try {
-        result.latitude = std::stod(latStr);
-        result.longitude = std::stod(lngStr);
-        result.isValid = true;
-        result.source = "google";
-    } catch (...) {
-        return result;
-    }
+    result.latitude = lat.asDouble();
+    result.longitude = lng.asDouble();
+    result.isValid = true;
+    result.source = "google";
 
     // Extract formatted address
-    result.formattedAddress = extractJsonValue(json, "formatted_address");
+    result.formattedAddress = fields["formatted_address"].asString();
     if (result.formattedAddress.empty()) {
         result.formattedAddress = originalAddress;
     }
 
-    // Extract address components
-    size_t componentsPos = json.find("\"address_components\"");
-    if (componentsPos != std::string::npos) {
-        // Parse address components array
-        size_t arrayStart = json.find('[', componentsPos);
-        size_t arrayEnd = json.find(']', arrayStart);
-
-        if (arrayStart != std::string::npos && arrayEnd != std::string::npos) {
-            std::string componentsJson = json.substr(arrayStart, arrayEnd - arrayStart + 1);
-
-            // Extract locality (city)
-            size_t localityPos = componentsJson.find("\"locality\"");
-            if (localityPos != std::string::npos) {
-                // Find the long_name for this component
-                size_t objStart = componentsJson.rfind('{', localityPos);
-                if (objStart != std::string::npos) {
-                    std::string objJson = componentsJson.substr(objStart, localityPos - objStart + 20);
-                    result.city = extractJsonValue(objJson, "long_name");
-                }
+    // Extract address components; the first component of each type wins
+    fields["address_components"].forEachElement([&result](const JsonValue& component) {
+        JsonObject parts(component);
+        parts["types"].forEachElement([&](const JsonValue& typeValue) {
+            std::string_view type = typeValue.asStringView();
+            if (type == "locality" && result.city.empty()) {
+                result.city = parts["long_name"].asString();
+            } else if (type == "administrative_area_level_1" && result.state.empty()) {
+                result.state = parts["short_name"].asString();
+            } else if (type == "postal_code" && result.postalCode.empty()) {
+                result.postalCode = parts["long_name"].asString();
+            } else if (type == "country" && result.country.empty()) {
+                result.country = parts["short_name"].asString();
+            } else if (type == "route" && result.street.empty()) {
+                result.street = parts["long_name"].asString();
             }
+        });
+    });
 
-            // Extract administrative_area_level_1 (state)
-            size_t statePos = componentsJson.find("\"administrative_area_level_1\"");
-            if (statePos != std::string::npos) {
-                size_t objStart = componentsJson.rfind('{', statePos);
-                if (objStart != std::string::npos) {
-                    std::string objJson = componentsJson.substr(objStart, statePos - objStart + 50);
-                    result.state = extractJsonValue(objJson, "short_name");
-                }
-            }
+    return result;
+}
 
-            // Extract postal_code
-            size_t postalPos = componentsJson.find("\"postal_code\"");
-            if (postalPos != std::string::npos) {
-                size_t objStart = componentsJson.rfind('{', postalPos);
-                if (objStart != std::string::npos) {
-                    std::string objJson = componentsJson.substr(objStart, postalPos - objStart + 30);
-                    result.postalCode = extractJsonValue(objJson, "long_name");
-                }
-            }
+void GoogleGeocodingAPI::geocodeAsync(const std::string& address, GeocodeDone done) {
+    loadAsync(normalizeAddress(address), buildGeocodeUrl(address), address, std::move(done));
+}
 
-            // Extract country
-            size_t countryPos = componentsJson.find("\"country\"");
-            if (countryPos != std::string::npos) {
-                size_t objStart = componentsJson.rfind('{', countryPos);
-                if (objStart != std::string::npos) {
-                    std::string objJson = componentsJson.substr(objStart, countryPos - objStart + 20);
-                    result.country = extractJsonValue(objJson, "short_name");
-                }
-            }
+void GoogleGeocodingAPI::reverseGeocodeAsync(double latitude, double longitude, GeocodeDone done) {
+    std::ostringstream cacheKey;
+    cacheKey << std::fixed << std::setprecision(6) << latitude << "," << longitude;
+    std::string coordinates = std::to_string(latitude) + ", " + std::to_string(longitude);
 
-            // Extract street
-            size_t routePos = componentsJson.find("\"route\"");
-            if (routePos != std::string::npos) {
-                size_t objStart = componentsJson.rfind('{', routePos);
-                if (objStart != std::string::npos) {
-                    std::string objJson = componentsJson.substr(objStart, routePos - objStart + 20);
-                    result.street = extractJsonValue(objJson, "long_name");
-                }
+    loadAsync(cacheKey.str(), buildReverseGeocodeUrl(latitude, longitude), coordinates,
+        [latitude, longitude, done](const Models::GeoLocation& location) {
+            if (location.isValid) {
+                done(location);
+                return;
             }
-        }
-    }
-
-    return result;
+            Models::GeoLocation invalid(latitude, longitude);
+            invalid.isValid = false;
+            done(invalid);
+        });
 }
 
-Models::GeoLocation GoogleGeocodingAPI::callGoogleAPI(const std::string& address) {
+void GoogleGeocodingAPI::loadAsync(const std::string& key, const std::string& url,
+                                   const std::string& description, GeocodeDone done) {
     if (!config_.isConfigured()) {
         Models::GeoLocation invalid;
         invalid.isValid = false;
-        return invalid;
-    }
-
-    stats_.totalRequests++;
-
-    auto startTime = std::chrono::high_resolution_clock::now();
-
-    std::string url = buildGeocodeUrl(address);
-    std::string response;
-
-    // Retry logic
-    for (int attempt = 0; attempt <= config_.maxRetries; ++attempt) {
-        response = executeHttpRequest(url);
-
-        if (!response.empty()) {
-            break;
-        }
-
-        if (attempt < config_.maxRetries) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(
-                config_.retryDelayMs * (attempt + 1)));
-        }
+        done(invalid);
+        return;
     }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
-        endTime - startTime).count();
+    // The load also refreshes a stale entry; it only starts a reactor request
+    auto outcome = cache_->fetch(key,
+        [this, url, description](ApiCache<Models::GeoLocation>::Done loaded) {
+            {
+                std::lock_guard<std::mutex> lock(asyncMutex_);
+                asyncInFlight_++;
+            }
 
-    if (response.empty()) {
-        stats_.failedRequests++;
-        Models::GeoLocation invalid;
-        invalid.isValid = false;
-        return invalid;
-    }
+            stats_.totalRequests++;
 
-    Models::GeoLocation result = parseGeocodeResponse(response, address);
+            sendGeocodeRequest(url, description, 0, std::chrono::high_resolution_clock::now(),
+                [this, loaded](const Models::GeoLocation& result) {
+                    loaded(result, result.isValid);
 
-    if (result.isValid) {
-        stats_.successfulRequests++;
-        stats_.totalLatencyMs += latency;
-    } else {
-        stats_.failedRequests++;
-    }
+                    std::lock_guard<std::mutex> lock(asyncMutex_);
+                    if (--asyncInFlight_ == 0) {
+                        asyncIdle_.notify_all();
+                    }
+                });
+        },
+        [done](const Models::GeoLocation& location, bool) {
+            done(location);
+        });
 
-    return result;
+    recordOutcome(outcome);
 }
 
-Models::GeoLocation GoogleGeocodingAPI::callGoogleReverseAPI(double lat, double lon) {
-    if (!config_.isConfigured()) {
-        Models::GeoLocation invalid(lat, lon);
-        invalid.isValid = false;
-        return invalid;
-    }
-
-    stats_.totalRequests++;
-
-    std::string url = buildReverseGeocodeUrl(lat, lon);
-    std::string response = executeHttpRequest(url);
+void GoogleGeocodingAPI::sendGeocodeRequest(
+    const std::string& url,
+    const std::string& description,
+    int attempt,
+    std::chrono::high_resolution_clock::time_point startTime,
+    GeocodeDone done,
+    std::chrono::milliseconds backoff
+) {
+    // Queued on the reactor until the upstream's limiter has a token and
+    // any backoff has passed; no thread sleeps
+    auto delay = std::max(backoff, rateLimiter_->reserve());
+
+    HttpClient::instance().performAsync(buildHttpRequest(url),
+        [this, url, description, attempt, startTime, done](HttpResponse response) {
+            bool overQueryLimit = false;
+            Models::GeoLocation result;
+            result.isValid = false;
+            if (response.isSuccess() && !response.body.empty()) {
+                result = parseGeocodeResponse(response.body, description, &overQueryLimit);
+            }
 
-    if (response.empty()) {
-        stats_.failedRequests++;
-        Models::GeoLocation invalid(lat, lon);
-        invalid.isValid = false;
-        return invalid;
-    }
+            // Transport errors, server errors and quota rejections are
+            // worth another try; a definite answer (ZERO_RESULTS) is not
+            bool rateLimited = noteRateLimit(response, overQueryLimit, attempt);
+            bool transient = rateLimited || !response.ok || response.body.empty() ||
+                             response.statusCode >= 500;
+            if (!result.isValid && transient && attempt < config_.maxRetries) {
+                // A rate-limited retry waits out the limiter's pause instead
+                stats_.retries++;
+                auto retryBackoff = rateLimited ? std::chrono::milliseconds(0)
+                                                : RateLimiter::retryDelay(response, attempt,
+                                                      std::chrono::milliseconds(config_.retryDelayMs));
+                sendGeocodeRequest(url, description, attempt + 1, startTime, done, retryBackoff);
+                return;
+            }
 
-    std::string coordStr = std::to_string(lat) + ", " + std::to_string(lon);
-    Models::GeoLocation result = parseGeocodeResponse(response, coordStr);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                endTime - startTime).count();
 
-    if (result.isValid) {
-        stats_.successfulRequests++;
-    } else {
-        stats_.failedRequests++;
-        result.latitude = lat;
-        result.longitude = lon;
-    }
+            if (result.isValid) {
+                stats_.successfulRequests++;
+                stats_.totalLatencyMs += latency;
+            } else {
+                stats_.failedRequests++;
+            }
 
-    return result;
+            done(result);
+        }, delay);
 }
 
 void GoogleGeocodingAPI::geocode(const std::string& address, GeocodeCallback callback) {
-    // Submit to thread pool for async execution
-    threadPool_->execute([this, address, callback]() {
-        auto result = geocodeSync(address);
+    // Runs on the reactor; no pool thread waits for the response
+    geocodeAsync(address, [callback](const Models::GeoLocation& result) {
         if (callback) {
             callback(result, result.isValid ? "" : "Geocoding failed");
         }
@@ -401,8 +286,7 @@ void GoogleGeocodingAPI::geocode(const std::string& address, GeocodeCallback cal
 }
 
 void GoogleGeocodingAPI::reverseGeocode(double latitude, double longitude, ReverseGeocodeCallback callback) {
-    threadPool_->execute([this, latitude, longitude, callback]() {
-        auto result = reverseGeocodeSync(latitude, longitude);
+    reverseGeocodeAsync(latitude, longitude, [callback](const Models::GeoLocation& result) {
         if (callback) {
             callback(result, result.isValid ? "" : "Reverse geocoding failed");
         }
@@ -410,46 +294,23 @@ void GoogleGeocodingAPI::reverseGeocode(double latitude, double longitude, Rever
 }
 
 Models::GeoLocation GoogleGeocodingAPI::geocodeSync(const std::string& address) {
-    std::string normalizedAddr = normalizeAddress(address);
-
-    // Check cache first
-    Models::GeoLocation cached = getCachedResult(normalizedAddr);
-    if (cached.isValid) {
-        return cached;
-    }
-
-    // Call Google API
-    Models::GeoLocation result = callGoogleAPI(address);
-
-    // Cache result
-    if (result.isValid) {
-        cacheResult(normalizedAddr, result);
-    }
-
-    return result;
+    // Blocks only the caller; concurrent calls for one address share a
+    // single request, and a stale hit is refreshed on the reactor
+    std::promise<Models::GeoLocation> promise;
+    auto future = promise.get_future();
+    geocodeAsync(address, [&promise](const Models::GeoLocation& result) {
+        promise.set_value(result);
+    });
+    return future.get();
 }
 
 Models::GeoLocation GoogleGeocodingAPI::reverseGeocodeSync(double latitude, double longitude) {
-    // Build cache key from coordinates
-    std::ostringstream cacheKey;
-    cacheKey << std::fixed << std::setprecision(6) << latitude << "," << longitude;
-    std::string key = cacheKey.str();
-
-    // Check cache
-    Models::GeoLocation cached = getCachedResult(key);
-    if (cached.isValid) {
-        return cached;
-    }
-
-    // Call Google API
-    Models::GeoLocation result = callGoogleReverseAPI(latitude, longitude);
-
-    // Cache result
-    if (result.isValid) {
-        cacheResult(key, result);
-    }
-
-    return result;
+    std::promise<Models::GeoLocation> promise;
+    auto future = promise.get_future();
+    reverseGeocodeAsync(latitude, longitude, [&promise](const Models::GeoLocation& result) {
+        promise.set_value(result);
+    });
+    return future.get();
 }
 
 void GoogleGeocodingAPI::geocodeBatch(
@@ -459,25 +320,32 @@ void GoogleGeocodingAPI::geocodeBatch(
 ) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
+    int total = static_cast<int>(addresses.size());
+    if (total == 0) {
+        if (callback) {
+            callback(BatchGeocodeResult());
+        }
+        return;
+    }
+
     // Use shared state for collecting results
     auto results = std::make_shared<std::vector<Models::GeoLocation>>(addresses.size());
     auto errors = std::make_shared<std::vector<std::string>>(addresses.size());
     auto completed = std::make_shared<std::atomic<int>>(0);
     auto successCount = std::make_shared<std::atomic<int>>(0);
 
-    int total = static_cast<int>(addresses.size());
-
-    // Submit all geocoding tasks
+    // Start every lookup at once; the reactor caps connections per host
+    // and queues the rest inside libcurl
     for (size_t i = 0; i < addresses.size(); ++i) {
-        threadPool_->execute([this, i, addresses, results, errors, completed,
-                              successCount, total, progressCallback, callback, startTime]() {
-            auto result = geocodeSync(addresses[i]);
-
+        std::string address = addresses[i];
+        geocodeAsync(address, [i, address, results, errors, completed, successCount,
+                               total, progressCallback, callback, startTime](
+                                  const Models::GeoLocation& result) {
             (*results)[i] = result;
             if (result.isValid) {
                 (*successCount)++;
             } else {
-                (*errors)[i] = "Geocoding failed for: " + addresses[i];
+                (*errors)[i] = "Geocoding failed for: " + address;
             }
 
             int done = ++(*completed);
@@ -512,84 +380,30 @@ void GoogleGeocodingAPI::geocodeBatch(
 }
 
 BatchGeocodeResult GoogleGeocodingAPI::geocodeBatchSync(const std::vector<std::string>& addresses) {
-    auto startTime = std::chrono::high_resolution_clock::now();
-
-    BatchGeocodeResult result;
-    result.results.reserve(addresses.size());
-
-    // Submit all tasks and collect futures
-    std::vector<std::future<Models::GeoLocation>> futures;
-    futures.reserve(addresses.size());
-
-    for (const auto& address : addresses) {
-        futures.push_back(threadPool_->submit([this, address]() {
-            return geocodeSync(address);
-        }));
-    }
-
-    // Collect results
-    for (size_t i = 0; i < futures.size(); ++i) {
-        try {
-            auto location = futures[i].get();
-            result.results.push_back(location);
-
-            if (location.isValid) {
-                result.successCount++;
-            } else {
-                result.failureCount++;
-                result.errors.push_back("Geocoding failed for: " + addresses[i]);
-            }
-        } catch (const std::exception& e) {
-            result.failureCount++;
-            result.errors.push_back(std::string("Exception: ") + e.what());
-            result.results.push_back(Models::GeoLocation());
-        }
-    }
+    std::promise<BatchGeocodeResult> promise;
+    auto future = promise.get_future();
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    result.totalTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-        endTime - startTime).count();
+    // Blocks only the calling thread; the lookups run on the reactor
+    geocodeBatch(addresses, [&promise](BatchGeocodeResult result) {
+        promise.set_value(std::move(result));
+    });
 
-    return result;
+    return future.get();
 }
 
 void GoogleGeocodingAPI::prewarmCache(const std::vector<std::string>& addresses) {
+    // The limiter spaces the requests out on the reactor
     for (const auto& address : addresses) {
-        threadPool_->execute([this, address]() {
-            geocodeSync(address);
-        });
-    }
-}
-
-void GoogleGeocodingAPI::setThreadPoolSize(int threadCount) {
-    std::lock_guard<std::mutex> lock(threadPoolMutex_);
-    config_.threadPoolSize = std::max(1, threadCount);
-
-    if (threadPool_) {
-        threadPool_->resize(config_.threadPoolSize);
+        geocodeAsync(address, [](const Models::GeoLocation&) {});
     }
 }
 
-int GoogleGeocodingAPI::getThreadPoolSize() const {
-    return config_.threadPoolSize;
-}
-
-int GoogleGeocodingAPI::getRecommendedMemoryMB() const {
-    return ThreadPoolConfig::getRecommendedMemoryMB(config_.threadPoolSize);
-}
-
-const ThreadPoolMetrics& GoogleGeocodingAPI::getThreadPoolMetrics() const {
-    return threadPool_->getMetrics();
-}
-
 void GoogleGeocodingAPI::clearCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    cache_.clear();
+    cache_->clear();
 }
 
 int GoogleGeocodingAPI::getCacheSize() const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    return static_cast<int>(cache_.size());
+    return static_cast<int>(cache_->size());
 }
 
 } // namespace Services
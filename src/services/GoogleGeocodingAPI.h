@@ -8,8 +8,12 @@
 #include <unordered_map>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "ApiCache.h"
 #include "GeocodingService.h"
-#include "ThreadPool.h"
+#include "HttpClient.h"
+#include "RateLimiter.h"
 #include "models/GeoLocation.h"
 
 namespace FranchiseAI {
@@ -25,18 +29,21 @@ struct GoogleGeocodingConfig {
     int connectTimeoutMs = 3000;           // 3 seconds connection timeout
     bool enableCaching = true;
     int cacheDurationMinutes = 1440;       // 24 hours
+    int cacheStaleMinutes = 10080;         // Then served for up to 7 days while refreshed in the background
+    int negativeCacheSeconds = 300;        // A failed lookup is not retried for 5 minutes
+    int cacheMaxMegabytes = 16;            // Memory budget of the result cache (shared by all instances)
+    std::string cacheStorePath;            // On-disk cache kept across restarts (empty = memory only)
+    int cacheStoreMaxMegabytes = 512;      // Size budget of that file (shared; the largest setting wins)
     std::string userAgent = "FranchiseAI/1.0";
+    bool enableHttp2 = true;               // Multiplex batch requests over one connection
 
-    // Thread pool settings for background geocoding
-    int threadPoolSize = 4;                // Number of concurrent geocoding threads
-    int maxQueuedRequests = 100;           // Maximum pending requests
-
-    // Rate limiting (Google allows 50 QPS for paid tier)
+    // Rate limiting (Google allows 50 QPS for paid tier); shared by all
+    // instances in the process
     int maxRequestsPerSecond = 50;
 
     // Retry settings
     int maxRetries = 2;                    // Reduced retries for faster feedback
-    int retryDelayMs = 100;
+    int retryDelayMs = 100;                // Base of the jittered exponential backoff
 
     /**
      * @brief Check if API key is configured
@@ -44,13 +51,6 @@ struct GoogleGeocodingConfig {
     bool isConfigured() const {
         return !apiKey.empty();
     }
-
-    /**
-     * @brief Get recommended memory for thread pool
-     */
-    int getRecommendedMemoryMB() const {
-        return ThreadPoolConfig::getRecommendedMemoryMB(threadPoolSize);
-    }
 };
 
 /**
@@ -62,7 +62,9 @@ struct GoogleGeocodingStats {
     std::atomic<int> failedRequests{0};
     std::atomic<int> cacheHits{0};
     std::atomic<int> cacheMisses{0};
-    std::atomic<int> rateLimitHits{0};
+    std::atomic<int> coalescedRequests{0};     // Misses that joined a request already in flight
+    std::atomic<int> rateLimitHits{0};         // Responses rejected for exceeding the quota
+    std::atomic<int> retries{0};               // Requests sent again after a failure
     std::atomic<int64_t> totalLatencyMs{0};
 
     double getAverageLatencyMs() const {
@@ -84,13 +86,24 @@ struct GoogleGeocodingStats {
         return static_cast<double>(successfulRequests.load()) / total * 100.0;
     }
 
+    /**
+     * @brief Share of misses that did not need a request of their own
+     */
+    double getCoalescedRate() const {
+        int misses = cacheMisses.load();
+        if (misses == 0) return 0.0;
+        return static_cast<double>(coalescedRequests.load()) / misses * 100.0;
+    }
+
     void reset() {
         totalRequests = 0;
         successfulRequests = 0;
         failedRequests = 0;
         cacheHits = 0;
         cacheMisses = 0;
+        coalescedRequests = 0;
         rateLimitHits = 0;
+        retries = 0;
         totalLatencyMs = 0;
     }
 };
@@ -135,7 +148,13 @@ public:
     bool isConfigured() const override { return config_.isConfigured(); }
 
     /**
-     * @brief Geocode multiple addresses concurrently using thread pool
+     * @brief Geocode multiple addresses concurrently
+     *
+     * Uncached addresses are all sent at once through the HttpClient
+     * reactor, which multiplexes them over a few pooled connections
+     * without holding a thread per request. Both callbacks run on the
+     * reactor thread and should return quickly.
+     *
      * @param addresses List of addresses to geocode
      * @param callback Callback with batch results
      * @param progressCallback Optional progress callback
@@ -159,60 +178,60 @@ public:
      */
     void prewarmCache(const std::vector<std::string>& addresses);
 
-    /**
-     * @brief Set thread pool size for background geocoding
-     * @param threadCount Number of threads
-     */
-    void setThreadPoolSize(int threadCount);
-
-    /**
-     * @brief Get current thread pool size
-     */
-    int getThreadPoolSize() const;
-
-    /**
-     * @brief Get recommended memory for current thread pool size
-     */
-    int getRecommendedMemoryMB() const;
+    // Cache management (the cache is shared by all instances)
+    void clearCache();
+    int getCacheSize() const;
 
     /**
-     * @brief Get thread pool metrics
+     * @brief Stale, negative and coalesced counts of the process-wide geocode cache
      */
-    const ThreadPoolMetrics& getThreadPoolMetrics() const;
-
-    // Cache management
-    void clearCache();
-    int getCacheSize() const;
+    const ApiCacheStats& getCacheStats() const { return cache_->getStats(); }
 
     // Statistics
     const GoogleGeocodingStats& getStats() const { return stats_; }
-    void resetStats() { stats_.reset(); }
+    void resetStats() { stats_.reset(); cache_->resetStats(); }
 
-    // Utility
+    // Utility (see normalizeAddressKey)
     static std::string normalizeAddress(const std::string& address);
 
 private:
     GoogleGeocodingConfig config_;
     GoogleGeocodingStats stats_;
 
-    std::unique_ptr<ThreadPool> threadPool_;
-    std::mutex threadPoolMutex_;
-
-    // Cache: address -> (location, timestamp)
-    std::unordered_map<std::string, std::pair<Models::GeoLocation, time_t>> cache_;
-    mutable std::mutex cacheMutex_;
+    std::shared_ptr<RateLimiter> rateLimiter_;    // Shared with every instance in the process
 
     // Internal methods
-    Models::GeoLocation callGoogleAPI(const std::string& address);
-    Models::GeoLocation callGoogleReverseAPI(double lat, double lon);
     std::string buildGeocodeUrl(const std::string& address);
     std::string buildReverseGeocodeUrl(double lat, double lon);
-    Models::GeoLocation parseGeocodeResponse(const std::string& json, const std::string& originalAddress);
-    std::string executeHttpRequest(const std::string& url);
-
-    void initializeThreadPool();
-    Models::GeoLocation getCachedResult(const std::string& normalizedAddress);
-    void cacheResult(const std::string& normalizedAddress, const Models::GeoLocation& location);
+    Models::GeoLocation parseGeocodeResponse(const std::string& json, const std::string& originalAddress,
+                                             bool* overQueryLimit = nullptr);
+    bool noteRateLimit(const HttpResponse& response, bool overQueryLimit, int attempt);
+    HttpRequest buildHttpRequest(const std::string& url) const;
+
+    // Geocoding driven by the HttpClient reactor; the sync forms wait on these
+    using GeocodeDone = std::function<void(const Models::GeoLocation&)>;
+    void geocodeAsync(const std::string& address, GeocodeDone done);
+    void reverseGeocodeAsync(double latitude, double longitude, GeocodeDone done);
+    void loadAsync(const std::string& key, const std::string& url,
+                   const std::string& description, GeocodeDone done);
+    void sendGeocodeRequest(const std::string& url, const std::string& description, int attempt,
+                            std::chrono::high_resolution_clock::time_point startTime,
+                            GeocodeDone done,
+                            std::chrono::milliseconds backoff = std::chrono::milliseconds(0));
+
+    // Reactor requests still referring to this instance
+    std::mutex asyncMutex_;
+    std::condition_variable asyncIdle_;
+    int asyncInFlight_ = 0;
+
+    // Cache: normalized address or "lat,lon" -> location, shared by every
+    // instance so concurrent sessions geocoding one address send a single
+    // request. Every load, refreshes included, is a reactor request counted
+    // in asyncInFlight_, and finishes before the instance is destroyed.
+    std::shared_ptr<ApiCache<Models::GeoLocation>> cache_;
+    static std::shared_ptr<ApiCache<Models::GeoLocation>> sharedCache();
+
+    void recordOutcome(ApiCacheOutcome outcome);
 };
 
 } // namespace Services
@@ -1,92 +1,155 @@
 #include "GooglePlacesAPI.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <algorithm>
 #include <cctype>
 #include <ctime>
 #include <chrono>
 #include <sstream>
+#include <future>
 #include <iomanip>
-#include <thread>
 
 namespace FranchiseAI {
 namespace Services {
 
-// CURL write callback
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
+// Helper to read a JSON array of strings
+static std::vector<std::string> readStringArray(const JsonValue& array) {
+    std::vector<std::string> result;
+    array.forEachElement([&result](const JsonValue& value) {
+        result.push_back(value.asString());
+    });
+    return result;
 }
 
-// Helper to extract JSON string value
-static std::string extractJsonValue(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-
-    size_t colonPos = json.find(':', keyPos + searchKey.length());
-    if (colonPos == std::string::npos) return "";
-
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && std::isspace(json[valueStart])) valueStart++;
-
-    if (valueStart >= json.length()) return "";
+// Helper to read geometry.location into a place
+static void readLocation(const JsonValue& geometry, GooglePlace& place) {
+    JsonValue location = geometry["location"];
+    if (location.isObject()) {
+        place.latitude = location["lat"].asDouble();
+        place.longitude = location["lng"].asDouble();
+    }
+}
 
-    if (json[valueStart] == '"') {
-        size_t valueEnd = json.find('"', valueStart + 1);
-        if (valueEnd == std::string::npos) return "";
-        return json.substr(valueStart + 1, valueEnd - valueStart - 1);
-    } else if (json[valueStart] == '-' || std::isdigit(json[valueStart])) {
-        size_t valueEnd = valueStart;
-        while (valueEnd < json.length() &&
-               (std::isdigit(json[valueEnd]) || json[valueEnd] == '.' || json[valueEnd] == '-')) {
-            valueEnd++;
-        }
-        return json.substr(valueStart, valueEnd - valueStart);
+// Google answers an exceeded quota with HTTP 200 and OVER_QUERY_LIMIT in the
+// body; the substring check skips the parse for ordinary responses
+static bool isOverQueryLimit(const std::string& body) {
+    if (body.find("OVER_QUERY_LIMIT") == std::string::npos) {
+        return false;
     }
+    return JsonValue::parse(body)["status"].asString() == "OVER_QUERY_LIMIT";
+}
 
-    return "";
+// Helpers to weigh cached places against the cache budget
+static size_t weighPlace(const GooglePlace& place) {
+    return heapBytes(place.placeId) + heapBytes(place.name) +
+           heapBytes(place.formattedAddress) + heapBytes(place.vicinity) +
+           heapBytes(place.types) + heapBytes(place.businessStatus) +
+           heapBytes(place.phoneNumber) + heapBytes(place.website) +
+           heapBytes(place.formattedPhoneNumber) + heapBytes(place.weekdayText);
 }
 
-// Helper to extract JSON number
-static double extractJsonNumber(const std::string& json, const std::string& key) {
-    std::string value = extractJsonValue(json, key);
-    if (value.empty()) return 0.0;
-    try {
-        return std::stod(value);
-    } catch (...) {
-        return 0.0;
+static size_t weighPlaces(const std::vector<GooglePlace>& places) {
+    size_t bytes = places.capacity() * sizeof(GooglePlace);
+    for (const auto& place : places) {
+        bytes += weighPlace(place);
     }
+    return bytes;
 }
 
-// Helper to extract JSON array of strings
-static std::vector<std::string> extractJsonStringArray(const std::string& json, const std::string& key) {
-    std::vector<std::string> result;
+// Helpers to store places in the on-disk cache; bump the encoding when the layout changes
+static const uint8_t kPlaceEncoding = 1;
 
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return result;
+static void writeStrings(ByteWriter& writer, const std::vector<std::string>& texts) {
+    writer.put(static_cast<uint32_t>(texts.size()));
+    for (const auto& text : texts) {
+        writer.putString(text);
+    }
+}
 
-    size_t arrayStart = json.find('[', keyPos);
-    if (arrayStart == std::string::npos) return result;
+static std::vector<std::string> readStrings(ByteReader& reader) {
+    std::vector<std::string> texts(std::min<uint32_t>(reader.get<uint32_t>(), 1024));
+    for (auto& text : texts) {
+        text = reader.getString();
+    }
+    return texts;
+}
 
-    size_t arrayEnd = json.find(']', arrayStart);
-    if (arrayEnd == std::string::npos) return result;
+static void writePlace(ByteWriter& writer, const GooglePlace& place) {
+    writer.putString(place.placeId);
+    writer.putString(place.name);
+    writer.putString(place.formattedAddress);
+    writer.putString(place.vicinity);
+    writer.put(place.latitude);
+    writer.put(place.longitude);
+    writer.put(place.rating);
+    writer.put(static_cast<int32_t>(place.userRatingsTotal));
+    writeStrings(writer, place.types);
+    writer.putString(place.businessStatus);
+    writer.put(static_cast<uint8_t>(place.permanentlyClosed));
+    writer.putString(place.phoneNumber);
+    writer.putString(place.website);
+    writer.putString(place.formattedPhoneNumber);
+    writeStrings(writer, place.weekdayText);
+    writer.put(static_cast<int32_t>(place.priceLevel));
+}
 
-    std::string arrayJson = json.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
+static void readPlace(ByteReader& reader, GooglePlace& place) {
+    place.placeId = reader.getString();
+    place.name = reader.getString();
+    place.formattedAddress = reader.getString();
+    place.vicinity = reader.getString();
+    place.latitude = reader.get<double>();
+    place.longitude = reader.get<double>();
+    place.rating = reader.get<float>();
+    place.userRatingsTotal = reader.get<int32_t>();
+    place.types = readStrings(reader);
+    place.businessStatus = reader.getString();
+    place.permanentlyClosed = reader.get<uint8_t>() != 0;
+    place.phoneNumber = reader.getString();
+    place.website = reader.getString();
+    place.formattedPhoneNumber = reader.getString();
+    place.weekdayText = readStrings(reader);
+    place.priceLevel = reader.get<int32_t>();
+}
 
-    size_t pos = 0;
-    while (pos < arrayJson.length()) {
-        size_t quoteStart = arrayJson.find('"', pos);
-        if (quoteStart == std::string::npos) break;
+static std::string encodePlace(const GooglePlace& place) {
+    ByteWriter writer;
+    writer.put(kPlaceEncoding);
+    writePlace(writer, place);
+    return std::move(writer.bytes());
+}
 
-        size_t quoteEnd = arrayJson.find('"', quoteStart + 1);
-        if (quoteEnd == std::string::npos) break;
+static bool decodePlace(const std::string& bytes, GooglePlace& place) {
+    ByteReader reader(bytes);
+    if (reader.get<uint8_t>() != kPlaceEncoding) {
+        return false;
+    }
+    readPlace(reader, place);
+    return reader.ok() && reader.atEnd();
+}
 
-        result.push_back(arrayJson.substr(quoteStart + 1, quoteEnd - quoteStart - 1));
-        pos = quoteEnd + 1;
+static std::string encodePlaces(const std::vector<GooglePlace>& places) {
+    ByteWriter writer;
+    writer.put(kPlaceEncoding);
+    writer.put(static_cast<uint32_t>(places.size()));
+    for (const auto& place : places) {
+        writePlace(writer, place);
     }
+    return std::move(writer.bytes());
+}
 
-    return result;
+static bool decodePlaces(const std::string& bytes, std::vector<GooglePlace>& places) {
+    ByteReader reader(bytes);
+    if (reader.get<uint8_t>() != kPlaceEncoding) {
+        return false;
+    }
+    uint32_t count = reader.get<uint32_t>();
+    places.clear();
+    while (reader.ok() && places.size() < count) {
+        places.emplace_back();
+        readPlace(reader, places.back());
+    }
+    return reader.ok() && reader.atEnd();
 }
 
 Models::BusinessType GooglePlace::inferBusinessType() const {
@@ -142,65 +205,114 @@ Models::BusinessType GooglePlace::inferBusinessType() const {
     return Models::BusinessType::CORPORATE_OFFICE;
 }
 
-GooglePlacesAPI::GooglePlacesAPI() {
-    initializeThreadPool();
+GooglePlacesAPI::GooglePlacesAPI()
+    : searchCache_(ApiCachePolicy(), weighPlaces),
+      detailsCache_(ApiCachePolicy(), weighPlace) {
+    setConfig(config_);
 }
 
 GooglePlacesAPI::GooglePlacesAPI(const GooglePlacesConfig& config)
-    : config_(config) {
-    initializeThreadPool();
+    : config_(config),
+      searchCache_(ApiCachePolicy(), weighPlaces),
+      detailsCache_(ApiCachePolicy(), weighPlace) {
+    setConfig(config_);
 }
 
 GooglePlacesAPI::~GooglePlacesAPI() {
-    if (threadPool_) {
-        threadPool_->shutdown(true);
-    }
+    // Reactor requests call back into this instance
+    std::unique_lock<std::mutex> lock(requestMutex_);
+    requestIdle_.wait(lock, [this] { return requestsInFlight_ == 0; });
 }
 
-void GooglePlacesAPI::initializeThreadPool() {
-    ThreadPoolConfig poolConfig;
-    poolConfig.threadCount = config_.threadPoolSize;
-    poolConfig.maxQueueSize = config_.maxQueuedRequests;
-    poolConfig.enableMetrics = true;
+void GooglePlacesAPI::setConfig(const GooglePlacesConfig& config) {
+    config_ = config;
+
+    ApiCachePolicy policy = ApiCachePolicy::fromConfig(config_.enableCaching, config_.cacheDurationMinutes,
+                                                       config_.cacheStaleMinutes, config_.negativeCacheSeconds,
+                                                       config_.cacheMaxMegabytes);
+    searchCache_.setPolicy(policy);
+    detailsCache_.setPolicy(policy);
 
-    threadPool_ = std::make_unique<ThreadPool>(poolConfig);
+    auto store = PersistentCache::shared(config_.cacheStorePath,
+                                         static_cast<size_t>(std::max(config_.cacheStoreMaxMegabytes, 1)) << 20);
+    searchCache_.persistTo(store, "places:search:", encodePlaces, decodePlaces);
+    detailsCache_.persistTo(store, "places:details:", encodePlace, decodePlace);
+    rateLimiter_ = RateLimiter::shared(RateLimiter::hostOf(config_.nearbySearchEndpoint) + "/place",
+                                       config_.maxRequestsPerSecond);
 }
 
-void GooglePlacesAPI::setConfig(const GooglePlacesConfig& config) {
-    config_ = config;
+HttpRequest GooglePlacesAPI::buildHttpRequest(const std::string& url) const {
+    HttpRequest request;
+    request.url = url;
+    request.userAgent = config_.userAgent;
+    request.timeoutMs = config_.requestTimeoutMs;
+    request.connectTimeoutMs = config_.connectTimeoutMs;
+    request.followRedirects = true;
+    request.http2 = config_.enableHttp2;
+    return request;
+}
 
-    if (threadPool_ && threadPool_->getThreadCount() != config_.threadPoolSize) {
-        std::lock_guard<std::mutex> lock(threadPoolMutex_);
-        threadPool_->resize(config_.threadPoolSize);
+void GooglePlacesAPI::recordConnection(const HttpResponse& response) {
+    if (!response.ok) {
+        return;
     }
-}
 
-std::string GooglePlacesAPI::executeHttpRequest(const std::string& url) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "";
+    if (response.connectionReused) {
+        stats_.connectionsReused++;
+    } else {
+        stats_.connectionsOpened++;
+    }
+    if (response.http2) {
+        stats_.http2Requests++;
     }
+}
 
-    std::string response;
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.userAgent.c_str());
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.requestTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connectTimeoutMs);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+void GooglePlacesAPI::sendRequest(const std::string& url, int attempt,
+                                  std::chrono::milliseconds backoff, BodyDone done) {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        requestsInFlight_++;
+    }
+
+    // The reactor holds the request until the limiter has a token and any
+    // backoff has passed; no thread waits for the response
+    auto delay = std::max(backoff, rateLimiter_->reserve());
+
+    HttpClient::instance().performAsync(buildHttpRequest(url),
+        [this, url, attempt, done](HttpResponse response) {
+            recordConnection(response);
+
+            bool overQueryLimit = response.isSuccess() && isOverQueryLimit(response.body);
+            bool rateLimited = noteRateLimit(response, overQueryLimit, attempt);
+            bool transient = rateLimited || !response.ok || response.statusCode >= 500;
+            if (transient && attempt < config_.maxRetries) {
+                // A rate-limited retry waits out the limiter's pause instead
+                stats_.retries++;
+                auto retryBackoff = rateLimited ? std::chrono::milliseconds(0)
+                                                : RateLimiter::retryDelay(response, attempt,
+                                                      std::chrono::milliseconds(config_.retryDelayMs));
+                sendRequest(url, attempt + 1, retryBackoff, done);
+            } else {
+                done(response.ok && !overQueryLimit ? response.body : "");
+            }
 
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            if (--requestsInFlight_ == 0) {
+                requestIdle_.notify_all();
+            }
+        }, delay);
+}
 
-    if (res != CURLE_OK) {
-        return "";
+bool GooglePlacesAPI::noteRateLimit(const HttpResponse& response, bool overQueryLimit, int attempt) {
+    if (!response.isRateLimited() && !overQueryLimit) {
+        return false;
     }
 
-    return response;
+    // Every instance shares the limiter, so all of them back off
+    stats_.rateLimitHits++;
+    rateLimiter_->pause(RateLimiter::retryDelay(response, attempt,
+                                                std::chrono::milliseconds(config_.retryDelayMs)));
+    return true;
 }
 
 std::string GooglePlacesAPI::buildNearbySearchUrl(
@@ -229,18 +341,11 @@ std::string GooglePlacesAPI::buildNearbySearchUrl(
 }
 
 std::string GooglePlacesAPI::buildTextSearchUrl(const std::string& query, const std::string& pageToken) {
-    CURL* curl = curl_easy_init();
-    if (!curl) return "";
-
-    char* encoded = curl_easy_escape(curl, query.c_str(), static_cast<int>(query.length()));
     std::ostringstream url;
     url << config_.textSearchEndpoint
-        << "?query=" << encoded
+        << "?query=" << HttpClient::urlEncode(query)
         << "&key=" << config_.apiKey;
 
-    curl_free(encoded);
-    curl_easy_cleanup(curl);
-
     if (!pageToken.empty()) {
         url << "&pagetoken=" << pageToken;
     }
@@ -257,151 +362,99 @@ std::string GooglePlacesAPI::buildDetailsUrl(const std::string& placeId) {
 
 std::vector<GooglePlace> GooglePlacesAPI::parseNearbySearchResponse(
     const std::string& json,
-    std::string& nextPageToken
+    std::string& nextPageToken,
+    bool* overQueryLimit
 ) {
     std::vector<GooglePlace> places;
     nextPageToken.clear();
 
-    // Check status
-    std::string status = extractJsonValue(json, "status");
+    JsonObject response(JsonValue::parse(json));
+
+    // Check status; Google answers an exceeded quota with HTTP 200 and
+    // OVER_QUERY_LIMIT
+    std::string status = response["status"].asString();
     if (status != "OK" && status != "ZERO_RESULTS") {
+        if (overQueryLimit) {
+            *overQueryLimit = (status == "OVER_QUERY_LIMIT");
+        }
         return places;
     }
 
     // Extract next_page_token if present
-    nextPageToken = extractJsonValue(json, "next_page_token");
-
-    // Find results array
-    size_t resultsPos = json.find("\"results\"");
-    if (resultsPos == std::string::npos) {
-        return places;
-    }
-
-    size_t arrayStart = json.find('[', resultsPos);
-    if (arrayStart == std::string::npos) {
-        return places;
-    }
-
-    // Parse each result object
-    size_t pos = arrayStart + 1;
-    while (pos < json.length()) {
-        size_t objStart = json.find('{', pos);
-        if (objStart == std::string::npos || objStart > json.length() - 10) break;
-
-        // Find matching closing brace
-        int braceCount = 1;
-        size_t objEnd = objStart + 1;
-        while (objEnd < json.length() && braceCount > 0) {
-            if (json[objEnd] == '{') braceCount++;
-            else if (json[objEnd] == '}') braceCount--;
-            objEnd++;
-        }
-
-        if (braceCount != 0) break;
+    nextPageToken = response["next_page_token"].asString();
 
-        std::string objJson = json.substr(objStart, objEnd - objStart);
+    // Parse each result object in one pass over its members
+    response["results"].forEachElement([&places](const JsonValue& result) {
+        JsonObject fields(result);
 
         GooglePlace place;
-        place.placeId = extractJsonValue(objJson, "place_id");
-        place.name = extractJsonValue(objJson, "name");
-        place.vicinity = extractJsonValue(objJson, "vicinity");
-        place.formattedAddress = extractJsonValue(objJson, "formatted_address");
+        place.placeId = fields["place_id"].asString();
+        place.name = fields["name"].asString();
+        place.vicinity = fields["vicinity"].asString();
+        place.formattedAddress = fields["formatted_address"].asString();
         if (place.formattedAddress.empty()) {
             place.formattedAddress = place.vicinity;
         }
 
-        place.rating = static_cast<float>(extractJsonNumber(objJson, "rating"));
-        place.userRatingsTotal = static_cast<int>(extractJsonNumber(objJson, "user_ratings_total"));
-        place.businessStatus = extractJsonValue(objJson, "business_status");
+        place.rating = static_cast<float>(fields["rating"].asDouble());
+        place.userRatingsTotal = fields["user_ratings_total"].asInt();
+        place.businessStatus = fields["business_status"].asString();
         place.permanentlyClosed = (place.businessStatus == "CLOSED_PERMANENTLY");
 
-        // Extract geometry.location
-        size_t geomPos = objJson.find("\"geometry\"");
-        if (geomPos != std::string::npos) {
-            size_t locPos = objJson.find("\"location\"", geomPos);
-            if (locPos != std::string::npos) {
-                size_t locStart = objJson.find('{', locPos);
-                size_t locEnd = objJson.find('}', locStart);
-                if (locStart != std::string::npos && locEnd != std::string::npos) {
-                    std::string locJson = objJson.substr(locStart, locEnd - locStart + 1);
-                    place.latitude = extractJsonNumber(locJson, "lat");
-                    place.longitude = extractJsonNumber(locJson, "lng");
-                }
-            }
-        }
-
-        // Extract types array
-        place.types = extractJsonStringArray(objJson, "types");
+        readLocation(fields["geometry"], place);
+        place.types = readStringArray(fields["types"]);
 
         // Only add valid places
         if (!place.placeId.empty() && !place.name.empty() && !place.permanentlyClosed) {
-            places.push_back(place);
+            places.push_back(std::move(place));
         }
-
-        pos = objEnd;
-        if (pos < json.length() && json[pos] == ']') break;
-    }
+    });
 
     stats_.totalPlacesFound += static_cast<int>(places.size());
     return places;
 }
 
-GooglePlace GooglePlacesAPI::parseDetailsResponse(const std::string& json) {
+GooglePlace GooglePlacesAPI::parseDetailsResponse(const std::string& json, bool* overQueryLimit) {
     GooglePlace place;
 
-    std::string status = extractJsonValue(json, "status");
+    JsonValue response = JsonValue::parse(json);
+
+    std::string status = response["status"].asString();
     if (status != "OK") {
+        if (overQueryLimit) {
+            *overQueryLimit = (status == "OVER_QUERY_LIMIT");
+        }
         return place;
     }
 
     // Find result object
-    size_t resultPos = json.find("\"result\"");
-    if (resultPos == std::string::npos) {
+    JsonValue result = response["result"];
+    if (!result.isObject()) {
         return place;
     }
 
-    size_t objStart = json.find('{', resultPos);
-    size_t objEnd = json.rfind('}');
-    if (objStart == std::string::npos) {
-        return place;
-    }
+    JsonObject fields(result);
 
-    std::string objJson = json.substr(objStart, objEnd - objStart + 1);
-
-    place.name = extractJsonValue(objJson, "name");
-    place.formattedAddress = extractJsonValue(objJson, "formatted_address");
-    place.formattedPhoneNumber = extractJsonValue(objJson, "formatted_phone_number");
-    place.phoneNumber = extractJsonValue(objJson, "international_phone_number");
+    place.name = fields["name"].asString();
+    place.formattedAddress = fields["formatted_address"].asString();
+    place.formattedPhoneNumber = fields["formatted_phone_number"].asString();
+    place.phoneNumber = fields["international_phone_number"].asString();
     if (place.phoneNumber.empty()) {
         place.phoneNumber = place.formattedPhoneNumber;
     }
-    place.website = extractJsonValue(objJson, "website");
-    place.rating = static_cast<float>(extractJsonNumber(objJson, "rating"));
-    place.userRatingsTotal = static_cast<int>(extractJsonNumber(objJson, "user_ratings_total"));
-    place.priceLevel = static_cast<int>(extractJsonNumber(objJson, "price_level"));
-    place.businessStatus = extractJsonValue(objJson, "business_status");
-
-    // Extract geometry
-    size_t geomPos = objJson.find("\"geometry\"");
-    if (geomPos != std::string::npos) {
-        size_t locPos = objJson.find("\"location\"", geomPos);
-        if (locPos != std::string::npos) {
-            size_t locStart = objJson.find('{', locPos);
-            size_t locEnd = objJson.find('}', locStart);
-            if (locStart != std::string::npos && locEnd != std::string::npos) {
-                std::string locJson = objJson.substr(locStart, locEnd - locStart + 1);
-                place.latitude = extractJsonNumber(locJson, "lat");
-                place.longitude = extractJsonNumber(locJson, "lng");
-            }
-        }
-    }
+    place.website = fields["website"].asString();
+    place.rating = static_cast<float>(fields["rating"].asDouble());
+    place.userRatingsTotal = fields["user_ratings_total"].asInt();
+    place.priceLevel = fields["price_level"].asInt();
+    place.businessStatus = fields["business_status"].asString();
 
-    place.types = extractJsonStringArray(objJson, "types");
+    readLocation(fields["geometry"], place);
+    place.types = readStringArray(fields["types"]);
 
     // Extract opening hours weekday_text
-    size_t hoursPos = objJson.find("\"opening_hours\"");
-    if (hoursPos != std::string::npos) {
-        place.weekdayText = extractJsonStringArray(objJson, "weekday_text");
+    JsonValue hours = fields["opening_hours"];
+    if (hours.isObject()) {
+        place.weekdayText = readStringArray(hours["weekday_text"]);
     }
 
     return place;
@@ -429,8 +482,8 @@ void GooglePlacesAPI::searchNearby(
     const std::vector<std::string>& types,
     PlacesCallback callback
 ) {
-    threadPool_->execute([this, latitude, longitude, radiusMeters, types, callback]() {
-        auto results = searchNearbySync(latitude, longitude, radiusMeters, types);
+    searchNearbyAsync(latitude, longitude, radiusMeters, types,
+                      [callback](std::vector<GooglePlace> results) {
         if (callback) {
             callback(results, results.empty() ? "No places found" : "");
         }
@@ -443,67 +496,134 @@ std::vector<GooglePlace> GooglePlacesAPI::searchNearbySync(
     int radiusMeters,
     const std::vector<std::string>& types
 ) {
-    if (!config_.isConfigured()) {
-        return {};
-    }
+    std::promise<std::vector<GooglePlace>> promise;
+    auto future = promise.get_future();
 
-    // Check cache
-    std::string cacheKey = buildCacheKey(latitude, longitude, radiusMeters, types);
-    {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        auto it = searchCache_.find(cacheKey);
-        if (it != searchCache_.end()) {
-            time_t now = std::time(nullptr);
-            if (now - it->second.second < config_.cacheDurationMinutes * 60) {
-                stats_.cacheHits++;
-                return it->second.first;
-            }
-        }
-        stats_.cacheMisses++;
-    }
+    searchNearbyAsync(latitude, longitude, radiusMeters, types,
+                      [&promise](std::vector<GooglePlace> places) {
+        promise.set_value(std::move(places));
+    });
 
-    stats_.totalRequests++;
-    auto startTime = std::chrono::high_resolution_clock::now();
+    return future.get();
+}
 
-    std::vector<GooglePlace> allPlaces;
-    std::string pageToken;
+struct GooglePlacesAPI::NearbySearch {
+    double latitude;
+    double longitude;
+    int radiusMeters;
+    std::vector<std::string> types;
+    std::chrono::high_resolution_clock::time_point startTime;
     int page = 0;
+    int attempt = 0;                    // Retries of the current page
+    std::vector<GooglePlace> places;
+    NearbyDone done;
+};
+
+void GooglePlacesAPI::searchNearbyAsync(
+    double lat,
+    double lon,
+    int radiusMeters,
+    const std::vector<std::string>& types,
+    NearbyDone done
+) {
+    if (!config_.isConfigured()) {
+        done({});
+        return;
+    }
+
+    // A miss or a stale hit starts one reactor search; concurrent callers
+    // for the same key wait for it
+    auto outcome = searchCache_.fetch(buildCacheKey(lat, lon, radiusMeters, types),
+        [this, lat, lon, radiusMeters, types](ApiCache<std::vector<GooglePlace>>::Done loaded) {
+            stats_.totalRequests++;
+
+            auto search = std::make_shared<NearbySearch>();
+            search->latitude = lat;
+            search->longitude = lon;
+            search->radiusMeters = radiusMeters;
+            search->types = types;
+            search->startTime = std::chrono::high_resolution_clock::now();
+            search->done = [loaded](std::vector<GooglePlace> places) {
+                bool found = !places.empty();
+                loaded(std::move(places), found);
+            };
+
+            fetchNearbyPage(std::move(search), "", std::chrono::milliseconds(0));
+        },
+        [done](const std::vector<GooglePlace>& places, bool) {
+            done(places);
+        });
 
-    do {
-        std::string url = buildNearbySearchUrl(latitude, longitude, radiusMeters, types, pageToken);
-        std::string response = executeHttpRequest(url);
+    (answeredFromCache(outcome) ? stats_.cacheHits : stats_.cacheMisses)++;
+}
 
-        if (response.empty()) {
-            stats_.failedRequests++;
-            break;
+void GooglePlacesAPI::fetchNearbyPage(
+    std::shared_ptr<NearbySearch> search,
+    const std::string& pageToken,
+    std::chrono::milliseconds delay
+) {
+    std::string url = buildNearbySearchUrl(search->latitude, search->longitude,
+                                           search->radiusMeters, search->types, pageToken);
+
+    // Also held back until the limiter has a token for it
+    delay = std::max(delay, rateLimiter_->reserve());
+
+    HttpClient::instance().performAsync(buildHttpRequest(url), [this, search, pageToken](HttpResponse response) {
+        recordConnection(response);
+
+        bool overQueryLimit = false;
+        std::string nextPageToken;
+        std::vector<GooglePlace> places;
+        if (response.isSuccess() && !response.body.empty()) {
+            places = parseNearbySearchResponse(response.body, nextPageToken, &overQueryLimit);
         }
 
-        auto places = parseNearbySearchResponse(response, pageToken);
-        allPlaces.insert(allPlaces.end(), places.begin(), places.end());
+        // Retry the page after a transport error, server error or quota
+        // rejection; a rate-limited retry waits out the limiter's pause
+        bool rateLimited = noteRateLimit(response, overQueryLimit, search->attempt);
+        bool transient = rateLimited || !response.ok || response.body.empty() ||
+                         response.statusCode >= 500;
+        if (transient && search->attempt < config_.maxRetries) {
+            stats_.retries++;
+            auto backoff = rateLimited ? std::chrono::milliseconds(0)
+                                       : RateLimiter::retryDelay(response, search->attempt,
+                                             std::chrono::milliseconds(config_.retryDelayMs));
+            search->attempt++;
+            fetchNearbyPage(search, pageToken, backoff);
+            return;
+        }
+        if (transient) {
+            stats_.failedRequests++;
+            finishNearbySearch(*search);
+            return;
+        }
 
-        page++;
+        search->attempt = 0;
+        search->places.insert(search->places.end(), places.begin(), places.end());
+        search->page++;
 
-        // Google requires a short delay before requesting next page
-        if (!pageToken.empty() && page < config_.maxPages) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (!nextPageToken.empty() && search->page < config_.maxPages) {
+            // Google requires a short delay before requesting next page;
+            // the reactor holds the request back instead of a thread sleeping
+            fetchNearbyPage(search, nextPageToken, std::chrono::milliseconds(200));
+            return;
         }
 
-    } while (!pageToken.empty() && page < config_.maxPages);
+        finishNearbySearch(*search);
+    }, delay);
+}
 
+void GooglePlacesAPI::finishNearbySearch(NearbySearch& search) {
     auto endTime = std::chrono::high_resolution_clock::now();
     auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
-        endTime - startTime).count();
+        endTime - search.startTime).count();
 
-    if (!allPlaces.empty()) {
+    if (!search.places.empty()) {
         stats_.successfulRequests++;
         stats_.totalLatencyMs += latency;
-
-        // Cache results
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        searchCache_[cacheKey] = {allPlaces, std::time(nullptr)};
     }
 
-    return allPlaces;
+    search.done(std::move(search.places));
 }
 
 std::vector<std::string> GooglePlacesAPI::getCateringProspectTypes() {
@@ -531,8 +651,8 @@ void GooglePlacesAPI::searchCateringProspects(
     double radiusMiles,
     BusinessCallback callback
 ) {
-    threadPool_->execute([this, latitude, longitude, radiusMiles, callback]() {
-        auto results = searchCateringProspectsSync(latitude, longitude, radiusMiles);
+    searchCateringProspectsAsync(latitude, longitude, radiusMiles,
+                                 [callback](std::vector<Models::BusinessInfo> results) {
         if (callback) {
             callback(results, results.empty() ? "No prospects found" : "");
         }
@@ -543,36 +663,63 @@ std::vector<Models::BusinessInfo> GooglePlacesAPI::searchCateringProspectsSync(
     double latitude,
     double longitude,
     double radiusMiles
+) {
+    std::promise<std::vector<Models::BusinessInfo>> promise;
+    auto future = promise.get_future();
+
+    searchCateringProspectsAsync(latitude, longitude, radiusMiles,
+                                 [&promise](std::vector<Models::BusinessInfo> results) {
+        promise.set_value(std::move(results));
+    });
+
+    return future.get();
+}
+
+void GooglePlacesAPI::searchCateringProspectsAsync(
+    double latitude,
+    double longitude,
+    double radiusMiles,
+    BusinessesDone done
 ) {
     int radiusMeters = static_cast<int>(radiusMiles * 1609.34);
 
     // Search for multiple place types relevant to catering
     auto types = getCateringProspectTypes();
 
-    std::vector<Models::BusinessInfo> allBusinesses;
-    std::mutex resultsMutex;
-
-    // Submit search tasks for each type in parallel
-    std::vector<std::future<std::vector<GooglePlace>>> futures;
+    // Start every type search at once on the HTTP reactor; the last one to
+    // finish ranks the combined results
+    struct FanOut {
+        std::mutex mutex;
+        std::vector<GooglePlace> places;
+        size_t remaining;
+        BusinessesDone done;
+    };
+    auto fanOut = std::make_shared<FanOut>();
+    fanOut->remaining = types.size();
+    fanOut->done = std::move(done);
 
     for (const auto& type : types) {
-        futures.push_back(threadPool_->submit([this, latitude, longitude, radiusMeters, type]() {
-            return searchNearbySync(latitude, longitude, radiusMeters, {type});
-        }));
-    }
-
-    // Collect results
-    for (auto& future : futures) {
-        try {
-            auto places = future.get();
-            for (const auto& place : places) {
-                auto business = placeToBusinessInfo(place);
-                std::lock_guard<std::mutex> lock(resultsMutex);
-                allBusinesses.push_back(business);
+        searchNearbyAsync(latitude, longitude, radiusMeters, {type},
+                          [fanOut](std::vector<GooglePlace> places) {
+            std::vector<GooglePlace> allPlaces;
+            {
+                std::lock_guard<std::mutex> lock(fanOut->mutex);
+                fanOut->places.insert(fanOut->places.end(), places.begin(), places.end());
+                if (--fanOut->remaining > 0) {
+                    return;
+                }
+                allPlaces = std::move(fanOut->places);
             }
-        } catch (...) {
-            // Continue with other types
-        }
+            fanOut->done(rankProspects(allPlaces));
+        });
+    }
+}
+
+std::vector<Models::BusinessInfo> GooglePlacesAPI::rankProspects(const std::vector<GooglePlace>& places) {
+    std::vector<Models::BusinessInfo> allBusinesses;
+    allBusinesses.reserve(places.size());
+    for (const auto& place : places) {
+        allBusinesses.push_back(placeToBusinessInfo(place));
     }
 
     // Remove duplicates based on place ID
@@ -621,8 +768,7 @@ std::vector<Models::BusinessInfo> GooglePlacesAPI::searchBusinessesSync(
 }
 
 void GooglePlacesAPI::textSearch(const std::string& query, PlacesCallback callback) {
-    threadPool_->execute([this, query, callback]() {
-        auto results = textSearchSync(query);
+    textSearchAsync(query, [callback](std::vector<GooglePlace> results) {
         if (callback) {
             callback(results, results.empty() ? "No places found" : "");
         }
@@ -630,33 +776,45 @@ void GooglePlacesAPI::textSearch(const std::string& query, PlacesCallback callba
 }
 
 std::vector<GooglePlace> GooglePlacesAPI::textSearchSync(const std::string& query) {
+    std::promise<std::vector<GooglePlace>> promise;
+    auto future = promise.get_future();
+
+    textSearchAsync(query, [&promise](std::vector<GooglePlace> places) {
+        promise.set_value(std::move(places));
+    });
+
+    return future.get();
+}
+
+void GooglePlacesAPI::textSearchAsync(const std::string& query, NearbyDone done) {
     if (!config_.isConfigured()) {
-        return {};
+        done({});
+        return;
     }
 
     stats_.totalRequests++;
 
-    std::string url = buildTextSearchUrl(query);
-    std::string response = executeHttpRequest(url);
-
-    if (response.empty()) {
-        stats_.failedRequests++;
-        return {};
-    }
+    sendRequest(buildTextSearchUrl(query), 0, std::chrono::milliseconds(0),
+        [this, done](const std::string& response) {
+            if (response.empty()) {
+                stats_.failedRequests++;
+                done({});
+                return;
+            }
 
-    std::string nextPageToken;
-    auto places = parseNearbySearchResponse(response, nextPageToken);
+            std::string nextPageToken;
+            auto places = parseNearbySearchResponse(response, nextPageToken);
 
-    if (!places.empty()) {
-        stats_.successfulRequests++;
-    }
+            if (!places.empty()) {
+                stats_.successfulRequests++;
+            }
 
-    return places;
+            done(std::move(places));
+        });
 }
 
 void GooglePlacesAPI::getPlaceDetails(const std::string& placeId, PlaceDetailsCallback callback) {
-    threadPool_->execute([this, placeId, callback]() {
-        auto result = getPlaceDetailsSync(placeId);
+    getPlaceDetailsAsync(placeId, [callback](const GooglePlace& result) {
         if (callback) {
             callback(result, result.name.empty() ? "Place not found" : "");
         }
@@ -664,46 +822,57 @@ void GooglePlacesAPI::getPlaceDetails(const std::string& placeId, PlaceDetailsCa
 }
 
 GooglePlace GooglePlacesAPI::getPlaceDetailsSync(const std::string& placeId) {
-    if (!config_.isConfigured()) {
-        return GooglePlace();
-    }
+    std::promise<GooglePlace> promise;
+    auto future = promise.get_future();
 
-    // Check cache
-    {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        auto it = detailsCache_.find(placeId);
-        if (it != detailsCache_.end()) {
-            time_t now = std::time(nullptr);
-            if (now - it->second.second < config_.cacheDurationMinutes * 60) {
-                stats_.cacheHits++;
-                return it->second.first;
-            }
-        }
-        stats_.cacheMisses++;
-    }
+    getPlaceDetailsAsync(placeId, [&promise](const GooglePlace& place) {
+        promise.set_value(place);
+    });
 
-    stats_.totalRequests++;
+    return future.get();
+}
+
+void GooglePlacesAPI::getPlaceDetailsAsync(const std::string& placeId, DetailsDone done) {
+    if (!config_.isConfigured()) {
+        done(GooglePlace());
+        return;
+    }
+
+    // A miss or a stale hit starts one reactor request; concurrent callers
+    // for the same place wait for it
+    auto outcome = detailsCache_.fetch(placeId,
+        [this, placeId](ApiCache<GooglePlace>::Done loaded) {
+            fetchPlaceDetails(placeId, [loaded](const GooglePlace& place) {
+                loaded(place, !place.name.empty());
+            });
+        },
+        [done](const GooglePlace& place, bool) {
+            done(place);
+        });
 
-    std::string url = buildDetailsUrl(placeId);
-    std::string response = executeHttpRequest(url);
+    (answeredFromCache(outcome) ? stats_.cacheHits : stats_.cacheMisses)++;
+}
 
-    if (response.empty()) {
-        stats_.failedRequests++;
-        return GooglePlace();
-    }
+void GooglePlacesAPI::fetchPlaceDetails(const std::string& placeId, DetailsDone done) {
+    stats_.totalRequests++;
 
-    auto place = parseDetailsResponse(response);
-    place.placeId = placeId;
+    sendRequest(buildDetailsUrl(placeId), 0, std::chrono::milliseconds(0),
+        [this, placeId, done](const std::string& response) {
+            if (response.empty()) {
+                stats_.failedRequests++;
+                done(GooglePlace());
+                return;
+            }
 
-    if (!place.name.empty()) {
-        stats_.successfulRequests++;
+            auto place = parseDetailsResponse(response);
+            place.placeId = placeId;
 
-        // Cache result
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        detailsCache_[placeId] = {place, std::time(nullptr)};
-    }
+            if (!place.name.empty()) {
+                stats_.successfulRequests++;
+            }
 
-    return place;
+            done(place);
+        });
 }
 
 Models::BusinessInfo GooglePlacesAPI::placeToBusinessInfo(const GooglePlace& place) {
@@ -762,35 +931,12 @@ Models::BusinessInfo GooglePlacesAPI::placeToBusinessInfo(const GooglePlace& pla
     return business;
 }
 
-void GooglePlacesAPI::setThreadPoolSize(int threadCount) {
-    std::lock_guard<std::mutex> lock(threadPoolMutex_);
-    config_.threadPoolSize = std::max(1, threadCount);
-
-    if (threadPool_) {
-        threadPool_->resize(config_.threadPoolSize);
-    }
-}
-
-int GooglePlacesAPI::getThreadPoolSize() const {
-    return config_.threadPoolSize;
-}
-
-int GooglePlacesAPI::getRecommendedMemoryMB() const {
-    return ThreadPoolConfig::getRecommendedMemoryMB(config_.threadPoolSize);
-}
-
-const ThreadPoolMetrics& GooglePlacesAPI::getThreadPoolMetrics() const {
-    return threadPool_->getMetrics();
-}
-
 void GooglePlacesAPI::clearCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
     searchCache_.clear();
     detailsCache_.clear();
 }
 
 int GooglePlacesAPI::getCacheSize() const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
     return static_cast<int>(searchCache_.size() + detailsCache_.size());
 }
 
@@ -7,8 +7,11 @@
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
-#include "ThreadPool.h"
+#include "ApiCache.h"
+#include "HttpClient.h"
+#include "RateLimiter.h"
 #include "models/BusinessInfo.h"
 #include "models/GeoLocation.h"
 #include "models/SearchResult.h"
@@ -29,15 +32,22 @@ struct GooglePlacesConfig {
     int connectTimeoutMs = 3000;           // 3 seconds connection timeout
     bool enableCaching = true;
     int cacheDurationMinutes = 60;         // 1 hour for place data
+    int cacheStaleMinutes = 1440;          // Then served for up to a day while refreshed in the background
+    int negativeCacheSeconds = 120;        // An empty search or missing place is not re-requested for 2 minutes
+    int cacheMaxMegabytes = 64;            // Memory budget of each of the search and details caches
+    std::string cacheStorePath;            // On-disk cache kept across restarts (empty = memory only)
+    int cacheStoreMaxMegabytes = 512;      // Size budget of that file (shared; the largest setting wins)
     std::string userAgent = "FranchiseAI/1.0";
+    bool enableHttp2 = true;               // Multiplex concurrent requests over one connection
 
-    // Thread pool settings
-    int threadPoolSize = 4;
-    int maxQueuedRequests = 100;
-
-    // Rate limiting (Google allows high QPS for paid tier)
+    // Rate limiting (Google allows high QPS for paid tier); shared by all
+    // instances in the process
     int maxRequestsPerSecond = 100;
 
+    // Retry settings
+    int maxRetries = 2;                    // Retries of a failed or rate-limited request
+    int retryDelayMs = 100;                // Base of the jittered exponential backoff
+
     // Search settings
     int maxResultsPerPage = 20;            // Google Places returns max 20 per page
     int maxPages = 2;                      // Reduced to 2 pages (40 results) for faster response
@@ -48,13 +58,6 @@ struct GooglePlacesConfig {
     bool isConfigured() const {
         return !apiKey.empty();
     }
-
-    /**
-     * @brief Get recommended memory for thread pool
-     */
-    int getRecommendedMemoryMB() const {
-        return ThreadPoolConfig::getRecommendedMemoryMB(threadPoolSize);
-    }
 };
 
 /**
@@ -130,6 +133,11 @@ struct GooglePlacesStats {
     std::atomic<int> cacheMisses{0};
     std::atomic<int64_t> totalLatencyMs{0};
     std::atomic<int> totalPlacesFound{0};
+    std::atomic<int> connectionsReused{0};     // HTTP requests sent on an open connection
+    std::atomic<int> connectionsOpened{0};     // HTTP requests that had to connect
+    std::atomic<int> http2Requests{0};         // HTTP requests served over HTTP/2
+    std::atomic<int> rateLimitHits{0};         // Responses rejected for exceeding the quota
+    std::atomic<int> retries{0};               // Requests sent again after a failure
 
     double getAverageLatencyMs() const {
         int successful = successfulRequests.load();
@@ -137,6 +145,19 @@ struct GooglePlacesStats {
         return static_cast<double>(totalLatencyMs.load()) / successful;
     }
 
+    double getCacheHitRate() const {
+        int hits = cacheHits.load();
+        int total = hits + cacheMisses.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(hits) / total * 100.0;
+    }
+
+    double getConnectionReuseRate() const {
+        int total = connectionsReused.load() + connectionsOpened.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(connectionsReused.load()) / total * 100.0;
+    }
+
     void reset() {
         totalRequests = 0;
         successfulRequests = 0;
@@ -145,6 +166,11 @@ struct GooglePlacesStats {
         cacheMisses = 0;
         totalLatencyMs = 0;
         totalPlacesFound = 0;
+        connectionsReused = 0;
+        connectionsOpened = 0;
+        http2Requests = 0;
+        rateLimitHits = 0;
+        retries = 0;
     }
 };
 
@@ -171,6 +197,11 @@ public:
 
     /**
      * @brief Search for places near a location (async)
+     *
+     * Driven by the HttpClient reactor; the callback runs on the reactor
+     * thread, or inline on a cache hit. The other async methods behave
+     * the same way.
+     *
      * @param latitude Center latitude
      * @param longitude Center longitude
      * @param radiusMeters Search radius in meters
@@ -211,6 +242,10 @@ public:
 
     /**
      * @brief Search for businesses suitable for catering (sync)
+     *
+     * All type searches (and their result pages) are driven concurrently
+     * by the HttpClient reactor; the calling thread blocks once for the
+     * whole fan-out, and the async form blocks no thread at all.
      */
     std::vector<Models::BusinessInfo> searchCateringProspectsSync(
         double latitude,
@@ -273,31 +308,40 @@ public:
      */
     static std::vector<std::string> getCateringProspectTypes();
 
-    // Thread pool management
-    void setThreadPoolSize(int threadCount);
-    int getThreadPoolSize() const;
-    int getRecommendedMemoryMB() const;
-    const ThreadPoolMetrics& getThreadPoolMetrics() const;
-
     // Cache management
     void clearCache();
     int getCacheSize() const;
 
+    /**
+     * @brief Stale, negative and coalesced counts of the search and details caches
+     */
+    const ApiCacheStats& getSearchCacheStats() const { return searchCache_.getStats(); }
+    const ApiCacheStats& getDetailsCacheStats() const { return detailsCache_.getStats(); }
+
     // Statistics
     const GooglePlacesStats& getStats() const { return stats_; }
-    void resetStats() { stats_.reset(); }
+    void resetStats() {
+        stats_.reset();
+        searchCache_.resetStats();
+        detailsCache_.resetStats();
+    }
 
 private:
     GooglePlacesConfig config_;
     GooglePlacesStats stats_;
 
-    std::unique_ptr<ThreadPool> threadPool_;
-    std::mutex threadPoolMutex_;
+    std::shared_ptr<RateLimiter> rateLimiter_;    // Shared with every instance in the process
 
-    // Cache: cache key -> (places, timestamp)
-    std::unordered_map<std::string, std::pair<std::vector<GooglePlace>, time_t>> searchCache_;
-    std::unordered_map<std::string, std::pair<GooglePlace, time_t>> detailsCache_;
-    mutable std::mutex cacheMutex_;
+    // Caches: search key -> places, place id -> details. Their destructors
+    // wait for searches still running on the reactor.
+    ApiCache<std::vector<GooglePlace>> searchCache_;
+    ApiCache<GooglePlace> detailsCache_;
+
+    // Text search and details requests on the reactor; the destructor
+    // waits for them
+    std::mutex requestMutex_;
+    std::condition_variable requestIdle_;
+    int requestsInFlight_ = 0;
 
     // Internal methods
     std::string buildNearbySearchUrl(double lat, double lon, int radiusMeters,
@@ -305,12 +349,38 @@ private:
                                      const std::string& pageToken = "");
     std::string buildTextSearchUrl(const std::string& query, const std::string& pageToken = "");
     std::string buildDetailsUrl(const std::string& placeId);
-    std::string executeHttpRequest(const std::string& url);
-    std::vector<GooglePlace> parseNearbySearchResponse(const std::string& json, std::string& nextPageToken);
-    GooglePlace parseDetailsResponse(const std::string& json);
+    HttpRequest buildHttpRequest(const std::string& url) const;
+    void recordConnection(const HttpResponse& response);
+    std::vector<GooglePlace> parseNearbySearchResponse(const std::string& json, std::string& nextPageToken,
+                                                       bool* overQueryLimit = nullptr);
+    GooglePlace parseDetailsResponse(const std::string& json, bool* overQueryLimit = nullptr);
+    bool noteRateLimit(const HttpResponse& response, bool overQueryLimit, int attempt);
 
-    void initializeThreadPool();
     std::string buildCacheKey(double lat, double lon, int radius, const std::vector<std::string>& types);
+
+    // Nearby search driven by the HttpClient reactor; done runs on the
+    // reactor thread (or inline on a cache hit)
+    using NearbyDone = std::function<void(std::vector<GooglePlace>)>;
+    struct NearbySearch;
+    void searchNearbyAsync(double lat, double lon, int radiusMeters,
+                           const std::vector<std::string>& types, NearbyDone done);
+    void fetchNearbyPage(std::shared_ptr<NearbySearch> search, const std::string& pageToken,
+                         std::chrono::milliseconds delay);
+    void finishNearbySearch(NearbySearch& search);
+
+    // Single requests (text search, details) retried on the reactor after a
+    // transport error, 5xx, 429 or OVER_QUERY_LIMIT; done gets the body, or
+    // "" once the retries are spent
+    using BodyDone = std::function<void(const std::string&)>;
+    using DetailsDone = std::function<void(const GooglePlace&)>;
+    using BusinessesDone = std::function<void(std::vector<Models::BusinessInfo>)>;
+    void sendRequest(const std::string& url, int attempt, std::chrono::milliseconds backoff, BodyDone done);
+    void textSearchAsync(const std::string& query, NearbyDone done);
+    void getPlaceDetailsAsync(const std::string& placeId, DetailsDone done);
+    void fetchPlaceDetails(const std::string& placeId, DetailsDone done);
+    void searchCateringProspectsAsync(double latitude, double longitude, double radiusMiles,
+                                      BusinessesDone done);
+    static std::vector<Models::BusinessInfo> rankProspects(const std::vector<GooglePlace>& places);
 };
 
 } // namespace Services
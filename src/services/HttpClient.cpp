@@ -0,0 +1,394 @@
+#include "HttpClient.h"
+#include <curl/curl.h>
+#include <algorithm>
+
+namespace FranchiseAI {
+namespace Services {
+
+static_assert(CURL_LOCK_DATA_LAST <= 8, "HttpClient::shareLocks_ too small");
+
+// Where a transfer's body goes: the response, or the request's onData
+struct BodySink {
+    const HttpRequest* request = nullptr;
+    HttpResponse* response = nullptr;
+};
+
+// CURL write callback
+static size_t WriteCallback(void* contents, size_t size, size_t nmemb, BodySink* sink) {
+    size_t bytes = size * nmemb;
+    if (sink->request->onData) {
+        if (!sink->request->onData(std::string_view(static_cast<char*>(contents), bytes))) {
+            // Returning short makes curl abort with CURLE_WRITE_ERROR
+            sink->response->stoppedEarly = true;
+            return 0;
+        }
+        return bytes;
+    }
+    sink->response->body.append(static_cast<char*>(contents), bytes);
+    return bytes;
+}
+
+// CURLSH lock callbacks; userptr is HttpClient::shareLocks_
+static void lockShareData(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].lock();
+}
+
+static void unlockShareData(CURL*, curl_lock_data data, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].unlock();
+}
+
+HttpClient& HttpClient::instance() {
+    // Intentionally leaked: pool workers may still be finishing requests
+    // while static destructors run at exit
+    static HttpClient* client = new HttpClient();
+    return *client;
+}
+
+HttpClient::HttpClient() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    CURLSH* share = curl_share_init();
+    if (share) {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShareData);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShareData);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, shareLocks_);
+        // Not the connection cache: libcurl does not support sharing it
+        // between easy handles on pool threads and the reactor's multi
+        // handle. Blocking requests reuse the connections their pooled
+        // handle keeps; reactor requests reuse the multi handle's.
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+    }
+    share_ = share;
+}
+
+void* HttpClient::acquireHandle() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        if (!idleHandles_.empty()) {
+            void* handle = idleHandles_.back();
+            idleHandles_.pop_back();
+            return handle;
+        }
+    }
+
+    CURL* curl = curl_easy_init();
+    if (curl) {
+        stats_.handlesCreated++;
+    }
+    return curl;
+}
+
+void HttpClient::releaseHandle(void* handle) {
+    CURL* curl = static_cast<CURL*>(handle);
+
+    // Reset clears per-request options but keeps the handle's buffers and
+    // open connections; DNS and TLS session caches live in the share
+    curl_easy_reset(curl);
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        if (idleHandles_.size() < kMaxIdleHandles) {
+            idleHandles_.push_back(curl);
+            return;
+        }
+    }
+
+    curl_easy_cleanup(curl);
+}
+
+/**
+ * @brief Apply a request to a pooled handle
+ * @return Header list owned by the caller until the transfer ends
+ */
+static struct curl_slist* prepareHandle(CURL* curl, CURLSH* share,
+                                        const HttpRequest& request, BodySink* sink) {
+    if (share) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, sink);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);  // Required for multi-threaded use
+
+    if (request.method == "POST") {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    } else if (request.method != "GET") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+    }
+    if (request.method == "POST" || request.method == "PATCH") {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+    }
+
+    struct curl_slist* headers = nullptr;
+    for (const auto& header : request.headers) {
+        headers = curl_slist_append(headers, header.c_str());
+    }
+    if (headers) {
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    }
+
+    if (!request.userAgent.empty()) {
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, request.userAgent.c_str());
+    }
+    if (request.timeoutMs > 0) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, request.timeoutMs);
+    }
+    if (request.connectTimeoutMs > 0) {
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, request.connectTimeoutMs);
+    }
+    if (request.followRedirects) {
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+    if (request.acceptCompressed) {
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip, deflate");
+    }
+    if (request.http2) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+        // Queue behind a connection still negotiating instead of opening a
+        // second one, so the request can be multiplexed onto it
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
+    // Keep pooled connections healthy and send small requests immediately
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+    return headers;
+}
+
+/**
+ * @brief Fill in the result of a finished transfer and update stats
+ */
+static void finishTransfer(CURL* curl, CURLcode res, HttpResponse& response,
+                           HttpClientStats& stats) {
+    // A transfer the caller stopped on purpose still completed for it
+    if (res == CURLE_WRITE_ERROR && response.stoppedEarly) {
+        res = CURLE_OK;
+    }
+    if (res != CURLE_OK) {
+        response.error = curl_easy_strerror(res);
+        stats.failures++;
+        return;
+    }
+
+    response.ok = true;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
+
+    long newConnections = 0;
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+    response.connectionReused = (newConnections == 0);
+    if (response.connectionReused) {
+        stats.connectionsReused++;
+    }
+
+    long httpVersion = 0;
+    curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &httpVersion);
+    response.http2 = (httpVersion == CURL_HTTP_VERSION_2_0);
+    if (response.http2) {
+        stats.http2Requests++;
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x074200
+    // Seconds or an HTTP date; libcurl converts both
+    curl_off_t retryAfter = 0;
+    if (curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retryAfter) == CURLE_OK && retryAfter > 0) {
+        response.retryAfterSeconds = static_cast<long>(retryAfter);
+    }
+#endif
+}
+
+HttpResponse HttpClient::perform(const HttpRequest& request) {
+    HttpResponse response;
+    stats_.requests++;
+
+    CURL* curl = static_cast<CURL*>(acquireHandle());
+    if (!curl) {
+        response.error = "Failed to initialize CURL";
+        stats_.failures++;
+        return response;
+    }
+
+    BodySink sink{&request, &response};
+    struct curl_slist* headers =
+        prepareHandle(curl, static_cast<CURLSH*>(share_), request, &sink);
+
+    CURLcode res = curl_easy_perform(curl);
+    finishTransfer(curl, res, response, stats_);
+
+    if (headers) {
+        curl_slist_free_all(headers);
+    }
+    releaseHandle(curl);
+
+    return response;
+}
+
+// ============================================================================
+// Reactor
+// ============================================================================
+
+struct HttpClient::AsyncTransfer {
+    HttpRequest request;
+    HttpResponse response;
+    BodySink sink{&request, &response};
+    Callback callback;
+    std::chrono::steady_clock::time_point notBefore;
+    CURL* handle = nullptr;
+    struct curl_slist* headers = nullptr;
+};
+
+void HttpClient::performAsync(const HttpRequest& request, Callback callback,
+                              std::chrono::milliseconds delay) {
+    std::call_once(reactorStarted_, [this] {
+        CURLM* multi = curl_multi_init();
+        // Queue excess transfers inside curl rather than opening a
+        // connection each; finished connections are reused by the next
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, kMaxHostConnections);
+        // HTTP/2 requests share one connection per host as parallel streams
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        multi_ = multi;
+        // Detached: lives as long as the (leaked) client
+        std::thread(&HttpClient::reactorLoop, this).detach();
+    });
+
+    auto* transfer = new AsyncTransfer();
+    transfer->request = request;
+    transfer->callback = std::move(callback);
+    transfer->notBefore = std::chrono::steady_clock::now() + delay;
+
+    stats_.requests++;
+    stats_.asyncRequests++;
+    stats_.activeTransfers++;
+
+    {
+        std::lock_guard<std::mutex> lock(submitMutex_);
+        submitted_.push_back(transfer);
+    }
+
+    curl_multi_wakeup(static_cast<CURLM*>(multi_));
+}
+
+std::future<HttpResponse> HttpClient::performAsync(const HttpRequest& request,
+                                               std::chrono::milliseconds delay) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = promise->get_future();
+
+    performAsync(request, [promise](HttpResponse response) {
+        promise->set_value(std::move(response));
+    }, delay);
+
+    return future;
+}
+
+void HttpClient::reactorLoop() {
+    CURLM* multi = static_cast<CURLM*>(multi_);
+    std::vector<AsyncTransfer*> delayed;
+
+    auto complete = [this](AsyncTransfer* transfer) {
+        stats_.activeTransfers--;
+        if (transfer->callback) {
+            try {
+                transfer->callback(std::move(transfer->response));
+            } catch (...) {
+                // A failing callback must not take the reactor down
+            }
+        }
+        delete transfer;
+    };
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(submitMutex_);
+            delayed.insert(delayed.end(), submitted_.begin(), submitted_.end());
+            submitted_.clear();
+        }
+
+        // Start every transfer whose delay has elapsed
+        auto now = std::chrono::steady_clock::now();
+        auto nextDue = now + std::chrono::seconds(1);
+        for (size_t i = 0; i < delayed.size();) {
+            AsyncTransfer* transfer = delayed[i];
+            if (transfer->notBefore > now) {
+                nextDue = std::min(nextDue, transfer->notBefore);
+                ++i;
+                continue;
+            }
+
+            delayed[i] = delayed.back();
+            delayed.pop_back();
+
+            transfer->handle = static_cast<CURL*>(acquireHandle());
+            if (!transfer->handle) {
+                transfer->response.error = "Failed to initialize CURL";
+                stats_.failures++;
+                complete(transfer);
+                continue;
+            }
+
+            transfer->headers = prepareHandle(transfer->handle, static_cast<CURLSH*>(share_),
+                                              transfer->request, &transfer->sink);
+            curl_easy_setopt(transfer->handle, CURLOPT_PRIVATE, transfer);
+            curl_multi_add_handle(multi, transfer->handle);
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            CURL* handle = message->easy_handle;
+            CURLcode result = message->data.result;
+
+            AsyncTransfer* transfer = nullptr;
+            curl_easy_getinfo(handle, CURLINFO_PRIVATE, &transfer);
+
+            finishTransfer(handle, result, transfer->response, stats_);
+            curl_multi_remove_handle(multi, handle);
+
+            if (transfer->headers) {
+                curl_slist_free_all(transfer->headers);
+            }
+            releaseHandle(handle);
+            complete(transfer);
+        }
+
+        auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            nextDue - std::chrono::steady_clock::now()).count();
+        curl_multi_poll(multi, nullptr, 0, static_cast<int>(std::max<int64_t>(0, waitMs)), nullptr);
+    }
+}
+
+std::string HttpClient::urlEncode(const std::string& value) {
+    static const char* hex = "0123456789ABCDEF";
+
+    std::string encoded;
+    encoded.reserve(value.size() * 3);
+
+    for (unsigned char c : value) {
+        bool unreserved = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                          (c >= '0' && c <= '9') ||
+                          c == '-' || c == '.' || c == '_' || c == '~';
+        if (unreserved) {
+            encoded += static_cast<char>(c);
+        } else {
+            encoded += '%';
+            encoded += hex[c >> 4];
+            encoded += hex[c & 0x0F];
+        }
+    }
+
+    return encoded;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,192 @@
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Options for a single HTTP request
+ *
+ * Zero timeouts leave libcurl's defaults in place.
+ */
+struct HttpRequest {
+    std::string url;
+    std::string method = "GET";            // GET, POST, PATCH, DELETE
+    std::string body;                      // Sent for POST/PATCH
+    std::vector<std::string> headers;      // "Name: value"
+    std::string userAgent;
+    long timeoutMs = 0;
+    long connectTimeoutMs = 0;
+    bool followRedirects = false;
+    bool acceptCompressed = false;         // Accept gzip/deflate
+    bool http2 = false;                    // Negotiate HTTP/2 over TLS and multiplex
+
+    // Streaming: when set, each chunk of the body is passed here as it
+    // arrives instead of being collected in HttpResponse::body. Return
+    // false to stop the transfer. Called on the thread running the
+    // transfer (the reactor for performAsync), so keep it short.
+    std::function<bool(std::string_view)> onData;
+};
+
+/**
+ * @brief Result of an HTTP request
+ */
+struct HttpResponse {
+    bool ok = false;                       // Transfer completed (any status)
+    long statusCode = 0;
+    std::string body;
+    std::string error;                     // Transport error if !ok
+    bool connectionReused = false;         // No new connection was opened
+    bool http2 = false;                    // Served over HTTP/2
+    bool stoppedEarly = false;             // onData ended the transfer (still ok)
+    long retryAfterSeconds = 0;            // Retry-After header of a 429/503 (0 if absent)
+
+    bool isSuccess() const { return ok && statusCode >= 200 && statusCode < 300; }
+    bool isRateLimited() const { return ok && statusCode == 429; }
+};
+
+/**
+ * @brief HTTP client statistics
+ */
+struct HttpClientStats {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> failures{0};            // Transport errors
+    std::atomic<uint64_t> connectionsReused{0};   // Requests that opened no connection
+    std::atomic<uint64_t> handlesCreated{0};      // curl easy handles allocated
+    std::atomic<uint64_t> asyncRequests{0};       // Requests driven by the reactor
+    std::atomic<uint64_t> http2Requests{0};       // Responses served over HTTP/2
+    std::atomic<int> activeTransfers{0};          // Reactor transfers in flight
+
+    double getReuseRate() const {
+        uint64_t total = requests.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(connectionsReused.load()) / total * 100.0;
+    }
+
+    void reset() {
+        requests = 0;
+        failures = 0;
+        connectionsReused = 0;
+        handlesCreated = 0;
+        asyncRequests = 0;
+        http2Requests = 0;
+    }
+};
+
+/**
+ * @brief Process-wide blocking HTTP client over pooled libcurl handles
+ *
+ * Easy handles are kept in a pool and reset between requests instead of
+ * being created and destroyed per call, and all handles share one CURLSH
+ * holding the DNS cache, TLS session cache and cookies. Connections are
+ * not shared (libcurl does not support that across threads and a multi
+ * handle): a blocking request reuses the keep-alive connections of its
+ * pooled handle, and reactor requests reuse those of the multi handle,
+ * where most traffic goes. A resumed TLS session still skips most of
+ * the handshake when a new connection is needed.
+ *
+ * Safe to call from any number of threads; each request borrows its own
+ * handle for the duration of the transfer.
+ *
+ * performAsync() hands the request to a single reactor thread driving a
+ * curl_multi handle, so hundreds of transfers can be in flight without a
+ * thread each. Completion callbacks run on the reactor thread and must
+ * stay short: parse, record, and hand anything heavy to a ThreadPool.
+ *
+ * Requests with http2 set negotiate HTTP/2 via ALPN (falling back to
+ * HTTP/1.1). On the reactor they wait for an existing connection to the
+ * host rather than opening another, so concurrent requests become
+ * streams multiplexed over one connection.
+ */
+class HttpClient {
+public:
+    static HttpClient& instance();
+
+    // Non-copyable
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    /**
+     * @brief Perform a request, blocking the calling thread
+     */
+    HttpResponse perform(const HttpRequest& request);
+
+    using Callback = std::function<void(HttpResponse)>;
+
+    /**
+     * @brief Start a request on the reactor thread and return immediately
+     * @param request Request to send
+     * @param callback Invoked on the reactor thread when the transfer ends
+     * @param delay Hold the request back this long before starting it
+     */
+    void performAsync(const HttpRequest& request, Callback callback,
+                      std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Start a request on the reactor thread
+     * @param delay Hold the request back this long before starting it
+     * @return Future that becomes ready when the transfer ends
+     */
+    std::future<HttpResponse> performAsync(const HttpRequest& request,
+                                           std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Percent-encode a string for use in a URL query
+     *
+     * Same output as curl_easy_escape() without needing a handle.
+     */
+    static std::string urlEncode(const std::string& value);
+
+    const HttpClientStats& getStats() const { return stats_; }
+    void resetStats() { stats_.reset(); }
+
+    /**
+     * @brief Maximum idle handles kept for reuse
+     */
+    static constexpr size_t kMaxIdleHandles = 32;
+
+    /**
+     * @brief Maximum concurrent reactor connections per host
+     */
+    static constexpr long kMaxHostConnections = 8;
+
+private:
+    HttpClient();
+    ~HttpClient() = default;  // Never destroyed; see instance()
+
+    // libcurl types are kept out of the header (CURLSH* / CURL*)
+    void* share_ = nullptr;
+    std::mutex shareLocks_[8];             // One per curl_lock_data kind
+
+    std::mutex poolMutex_;
+    std::vector<void*> idleHandles_;
+
+    HttpClientStats stats_;
+
+    void* acquireHandle();
+    void releaseHandle(void* handle);
+
+    // Reactor (curl_multi) state
+    struct AsyncTransfer;
+    void* multi_ = nullptr;
+    std::once_flag reactorStarted_;
+    std::mutex submitMutex_;
+    std::vector<AsyncTransfer*> submitted_;
+
+    void reactorLoop();
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // HTTP_CLIENT_H
@@ -0,0 +1,405 @@
+#include "JsonReader.h"
+#include <charconv>
+#include <cstring>
+
+namespace FranchiseAI {
+namespace Services {
+
+static const size_t npos = std::string_view::npos;
+
+static bool isJsonSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static size_t skipSpace(std::string_view text, size_t pos) {
+    while (pos < text.size() && isJsonSpace(text[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+/**
+ * @brief End of the string starting at pos (one past the closing quote)
+ */
+static size_t skipString(std::string_view text, size_t pos) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* p = begin + pos + 1;
+
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (!quote) {
+            return npos;
+        }
+
+        // The quote is escaped if preceded by an odd number of backslashes
+        const char* back = quote;
+        while (back > p && back[-1] == '\\') {
+            --back;
+        }
+        if (((quote - back) & 1) == 0) {
+            return static_cast<size_t>(quote - begin) + 1;
+        }
+        p = quote + 1;
+    }
+    return npos;
+}
+
+/**
+ * @brief End of the object or array starting at pos
+ */
+static size_t skipContainer(std::string_view text, size_t pos) {
+    // Only quotes and brackets matter while skipping; everything else is
+    // passed over by the table lookup
+    static const struct StructuralTable {
+        bool value[256] = {};
+        StructuralTable() {
+            for (char c : {'"', '{', '}', '[', ']'}) {
+                value[static_cast<unsigned char>(c)] = true;
+            }
+        }
+    } structural;
+
+    const char* data = text.data();
+    size_t size = text.size();
+    int depth = 0;
+
+    for (size_t i = pos; i < size; ++i) {
+        char c = data[i];
+        if (!structural.value[static_cast<unsigned char>(c)]) {
+            continue;
+        }
+        if (c == '"') {
+            i = skipString(text, i);
+            if (i == npos) {
+                return npos;
+            }
+            --i;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (--depth == 0) {
+            return i + 1;
+        }
+    }
+    return npos;
+}
+
+/**
+ * @brief End of a number, true, false or null starting at pos
+ */
+static size_t skipScalar(std::string_view text, size_t pos) {
+    size_t i = pos;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c == ',' || c == '}' || c == ']' || c == ':' || isJsonSpace(c)) {
+            break;
+        }
+        ++i;
+    }
+    return i == pos ? npos : i;
+}
+
+static JsonValue::Type typeOf(char c) {
+    switch (c) {
+        case '{': return JsonValue::Type::Object;
+        case '[': return JsonValue::Type::Array;
+        case '"': return JsonValue::Type::String;
+        case 't':
+        case 'f': return JsonValue::Type::Bool;
+        case 'n': return JsonValue::Type::Null;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                return JsonValue::Type::Number;
+            }
+            return JsonValue::Type::Missing;
+    }
+}
+
+JsonValue JsonValue::valueAt(std::string_view text, size_t& pos) {
+    pos = skipSpace(text, pos);
+    if (pos >= text.size()) {
+        return JsonValue();
+    }
+
+    Type type = typeOf(text[pos]);
+    size_t end = npos;
+
+    switch (type) {
+        case Type::Missing:
+            return JsonValue();
+        case Type::Object:
+        case Type::Array:
+            end = skipContainer(text, pos);
+            if (end == npos) {
+                // Truncated: keep what is there so complete leading
+                // members/elements can still be read
+                end = text.size();
+            }
+            break;
+        case Type::String:
+            end = skipString(text, pos);
+            break;
+        default:
+            end = skipScalar(text, pos);
+            break;
+    }
+
+    if (end == npos) {
+        pos = text.size();
+        return JsonValue();
+    }
+
+    JsonValue value(text.substr(pos, end - pos), type);
+    pos = end;
+    return value;
+}
+
+JsonValue JsonValue::parse(std::string_view json) {
+    size_t pos = skipSpace(json, 0);
+    if (pos < json.size() && (json[pos] == '{' || json[pos] == '[')) {
+        // The document root spans the rest of the buffer; skipping it here
+        // would cost a full extra pass over a large response
+        return JsonValue(json.substr(pos), typeOf(json[pos]));
+    }
+    return valueAt(json, pos);
+}
+
+bool JsonValue::nextMember(size_t& pos, std::string_view& key, JsonValue& value) const {
+    if (type_ != Type::Object) {
+        return false;
+    }
+
+    pos = skipSpace(text_, pos == 0 ? 1 : pos);
+    if (pos < text_.size() && text_[pos] == ',') {
+        pos = skipSpace(text_, pos + 1);
+    }
+    if (pos >= text_.size() || text_[pos] != '"') {
+        return false;
+    }
+
+    size_t keyEnd = skipString(text_, pos);
+    if (keyEnd == npos) {
+        return false;
+    }
+    key = text_.substr(pos + 1, keyEnd - pos - 2);
+
+    pos = skipSpace(text_, keyEnd);
+    if (pos >= text_.size() || text_[pos] != ':') {
+        return false;
+    }
+    ++pos;
+
+    value = valueAt(text_, pos);
+    return value.exists();
+}
+
+bool JsonValue::nextElement(size_t& pos, JsonValue& value) const {
+    if (type_ != Type::Array) {
+        return false;
+    }
+
+    pos = skipSpace(text_, pos == 0 ? 1 : pos);
+    if (pos < text_.size() && text_[pos] == ',') {
+        ++pos;
+    }
+    if (pos >= text_.size() || text_[pos] == ']') {
+        return false;
+    }
+
+    value = valueAt(text_, pos);
+    return value.exists();
+}
+
+JsonValue JsonValue::operator[](std::string_view key) const {
+    JsonValue found;
+    forEachMember([&](std::string_view name, const JsonValue& value) {
+        if (name == key) {
+            found = value;
+            return false;
+        }
+        return true;
+    });
+    return found;
+}
+
+size_t JsonValue::size() const {
+    size_t count = 0;
+    if (type_ == Type::Object) {
+        forEachMember([&](std::string_view, const JsonValue&) { ++count; });
+    } else if (type_ == Type::Array) {
+        forEachElement([&](const JsonValue&) { ++count; });
+    }
+    return count;
+}
+
+std::string_view JsonValue::asStringView() const {
+    switch (type_) {
+        case Type::String:
+            return text_.substr(1, text_.size() - 2);
+        case Type::Number:
+        case Type::Bool:
+            return text_;
+        default:
+            return std::string_view();
+    }
+}
+
+std::string JsonValue::asString(const std::string& fallback) const {
+    switch (type_) {
+        case Type::String:
+            return jsonUnescape(asStringView());
+        case Type::Number:
+        case Type::Bool:
+            return std::string(text_);
+        default:
+            return fallback;
+    }
+}
+
+double JsonValue::asDouble(double fallback) const {
+    if (type_ != Type::Number && type_ != Type::String) {
+        return fallback;
+    }
+
+    std::string_view digits = asStringView();
+    double result = 0.0;
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+    if (error != std::errc() || end == digits.data()) {
+        return fallback;
+    }
+    return result;
+}
+
+int64_t JsonValue::asInt64(int64_t fallback) const {
+    if (type_ != Type::Number && type_ != Type::String) {
+        return fallback;
+    }
+
+    std::string_view digits = asStringView();
+    int64_t result = 0;
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+    if (error != std::errc() || end == digits.data()) {
+        return fallback;
+    }
+    if (end != digits.data() + digits.size() && (*end == '.' || *end == 'e' || *end == 'E')) {
+        // Fractional or exponent form: truncate the double value
+        return static_cast<int64_t>(asDouble(static_cast<double>(fallback)));
+    }
+    return result;
+}
+
+int JsonValue::asInt(int fallback) const {
+    return static_cast<int>(asInt64(fallback));
+}
+
+bool JsonValue::asBool(bool fallback) const {
+    switch (type_) {
+        case Type::Bool:
+            return text_[0] == 't';
+        case Type::Number:
+            return asDouble() != 0.0;
+        case Type::String: {
+            std::string_view value = asStringView();
+            if (value == "true" || value == "1") return true;
+            if (value == "false" || value == "0") return false;
+            return fallback;
+        }
+        default:
+            return fallback;
+    }
+}
+
+JsonObject::JsonObject(const JsonValue& object) {
+    object.forEachMember([this](std::string_view key, const JsonValue& value) {
+        members_.emplace_back(key, value);
+    });
+}
+
+JsonValue JsonObject::operator[](std::string_view key) const {
+    for (const auto& member : members_) {
+        if (member.first == key) {
+            return member.second;
+        }
+    }
+    return JsonValue();
+}
+
+static void appendUtf8(std::string& out, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        out += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codepoint >> 6));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codepoint >> 12));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codepoint >> 18));
+        out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+static bool readHex4(std::string_view text, size_t pos, uint32_t& value) {
+    if (pos + 4 > text.size()) {
+        return false;
+    }
+    auto [end, error] = std::from_chars(text.data() + pos, text.data() + pos + 4, value, 16);
+    return error == std::errc() && end == text.data() + pos + 4;
+}
+
+std::string jsonUnescape(std::string_view text) {
+    size_t backslash = text.find('\\');
+    if (backslash == npos) {
+        return std::string(text);
+    }
+
+    std::string out(text.substr(0, backslash));
+    out.reserve(text.size());
+
+    for (size_t i = backslash; i < text.size(); ++i) {
+        char c = text[i];
+        if (c != '\\' || i + 1 >= text.size()) {
+            out += c;
+            continue;
+        }
+
+        char escaped = text[++i];
+        switch (escaped) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                uint32_t codepoint = 0;
+                if (!readHex4(text, i + 1, codepoint)) {
+                    out += "\\u";
+                    break;
+                }
+                i += 4;
+
+                // Surrogate pair
+                uint32_t low = 0;
+                if (codepoint >= 0xD800 && codepoint < 0xDC00 &&
+                    i + 2 < text.size() && text[i + 1] == '\\' && text[i + 2] == 'u' &&
+                    readHex4(text, i + 3, low) && low >= 0xDC00 && low < 0xE000) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(out, codepoint);
+                break;
+            }
+            default:
+                out += escaped;  // \" \\ \/
+                break;
+        }
+    }
+
+    return out;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,194 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Read-only view of one JSON value inside a response buffer
+ *
+ * Nothing is parsed or copied up front: a JsonValue is a string_view
+ * over the value's source text plus its type. Member lookup and
+ * iteration scan only the object or array being opened, skipping over
+ * nested values without looking inside them, so a response is walked
+ * once from top to bottom instead of being re-searched per key.
+ * Strings are unescaped only when asked for with asString().
+ *
+ * The viewed buffer must outlive every JsonValue taken from it.
+ *
+ * Malformed or truncated input never throws: lookups return a missing
+ * value, and iteration stops at the first value that cannot be skipped,
+ * so a cut-off array still yields every complete element before the cut.
+ */
+class JsonValue {
+public:
+    enum class Type { Missing, Null, Bool, Number, String, Array, Object };
+
+    JsonValue() = default;
+
+    /**
+     * @brief View the top-level value of a JSON document
+     */
+    static JsonValue parse(std::string_view json);
+
+    Type type() const { return type_; }
+    bool exists() const { return type_ != Type::Missing; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isBool() const { return type_ == Type::Bool; }
+    bool isNumber() const { return type_ == Type::Number; }
+    bool isString() const { return type_ == Type::String; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    /**
+     * @brief Source text of the value, including quotes and brackets
+     */
+    std::string_view raw() const { return text_; }
+
+    /**
+     * @brief Look up an object member (missing if absent or not an object)
+     */
+    JsonValue operator[](std::string_view key) const;
+
+    /**
+     * @brief Text of a string, number or bool (strings unescaped)
+     * @return fallback for null, missing, arrays and objects
+     */
+    std::string asString(const std::string& fallback = "") const;
+
+    /**
+     * @brief Raw characters between a string's quotes, without copying
+     *
+     * Escape sequences are left as-is; use asString() when they matter.
+     */
+    std::string_view asStringView() const;
+
+    /**
+     * @brief Numeric value of a number or numeric string
+     */
+    double asDouble(double fallback = 0.0) const;
+    int64_t asInt64(int64_t fallback = 0) const;
+    int asInt(int fallback = 0) const;
+
+    /**
+     * @brief true/false, or 1/0 and "true"/"false" as sent by some APIs
+     */
+    bool asBool(bool fallback = false) const;
+
+    /**
+     * @brief Call fn(std::string_view key, JsonValue value) for each member
+     *
+     * Keys are raw (not unescaped). If fn returns bool, returning false
+     * stops the iteration.
+     */
+    template<typename F>
+    void forEachMember(F&& fn) const;
+
+    /**
+     * @brief Call fn(JsonValue value) for each array element
+     */
+    template<typename F>
+    void forEachElement(F&& fn) const;
+
+    /**
+     * @brief Number of members or elements (0 for scalars)
+     */
+    size_t size() const;
+
+    /**
+     * @brief Cursor-style iteration used by the templates above
+     * @param pos Scan position; start at 0
+     * @return false when there are no more members/elements
+     */
+    bool nextMember(size_t& pos, std::string_view& key, JsonValue& value) const;
+    bool nextElement(size_t& pos, JsonValue& value) const;
+
+private:
+    JsonValue(std::string_view text, Type type) : text_(text), type_(type) {}
+
+    static JsonValue valueAt(std::string_view text, size_t& pos);
+
+    std::string_view text_;
+    Type type_ = Type::Missing;
+};
+
+/**
+ * @brief Member index of one JSON object, built in a single scan
+ *
+ * For records with many fields (DTOs, Places results) this replaces
+ * one scan per field with one scan per object; lookups then compare
+ * keys only.
+ */
+class JsonObject {
+public:
+    using Member = std::pair<std::string_view, JsonValue>;
+
+    JsonObject() = default;
+    explicit JsonObject(const JsonValue& object);
+
+    JsonValue operator[](std::string_view key) const;
+    bool contains(std::string_view key) const { return (*this)[key].exists(); }
+
+    size_t size() const { return members_.size(); }
+    std::vector<Member>::const_iterator begin() const { return members_.begin(); }
+    std::vector<Member>::const_iterator end() const { return members_.end(); }
+
+private:
+    std::vector<Member> members_;
+};
+
+/**
+ * @brief Decode JSON string escapes (\n, \", \uXXXX, ...) to UTF-8
+ */
+std::string jsonUnescape(std::string_view text);
+
+// Template implementation
+
+namespace detail {
+
+template<typename F, typename... Args>
+bool invokeContinue(F& fn, Args&&... args) {
+    if constexpr (std::is_same<decltype(fn(std::forward<Args>(args)...)), bool>::value) {
+        return fn(std::forward<Args>(args)...);
+    } else {
+        fn(std::forward<Args>(args)...);
+        return true;
+    }
+}
+
+} // namespace detail
+
+template<typename F>
+void JsonValue::forEachMember(F&& fn) const {
+    size_t pos = 0;
+    std::string_view key;
+    JsonValue value;
+    while (nextMember(pos, key, value)) {
+        if (!detail::invokeContinue(fn, key, value)) {
+            return;
+        }
+    }
+}
+
+template<typename F>
+void JsonValue::forEachElement(F&& fn) const {
+    size_t pos = 0;
+    JsonValue value;
+    while (nextElement(pos, value)) {
+        if (!detail::invokeContinue(fn, value)) {
+            return;
+        }
+    }
+}
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // JSON_READER_H
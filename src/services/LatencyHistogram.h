@@ -0,0 +1,134 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Lock-free log-linear latency histogram (HDR-style)
+ *
+ * Values are recorded in microseconds. Each power-of-two range is split
+ * into 16 linear sub-buckets, so any reported percentile is within ~6%
+ * of the true value while the whole histogram stays a fixed array of
+ * atomic counters. Recording is wait-free apart from the max update.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxMagnitude = 40;  // Values clamp at 2^41 us (~25 days)
+    static constexpr int kBucketCount = (kMaxMagnitude - kSubBucketBits + 2) * kSubBucketCount;
+
+    LatencyHistogram() { reset(); }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one sample
+     * @param micros Latency in microseconds
+     */
+    void record(uint64_t micros) {
+        buckets_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(micros, std::memory_order_relaxed);
+
+        uint64_t currentMax = max_.load(std::memory_order_relaxed);
+        while (micros > currentMax &&
+               !max_.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t getMaxMicros() const { return max_.load(std::memory_order_relaxed); }
+
+    double getMeanMicros() const {
+        uint64_t count = getCount();
+        if (count == 0) return 0.0;
+        return static_cast<double>(sum_.load(std::memory_order_relaxed)) / count;
+    }
+
+    /**
+     * @brief Get the value at a percentile
+     * @param percentile Percentile in [0, 100], e.g. 99.0
+     * @return Upper bound of the bucket holding that rank, in microseconds
+     */
+    uint64_t getPercentileMicros(double percentile) const {
+        uint64_t count = getCount();
+        if (count == 0) return 0;
+
+        if (percentile < 0.0) percentile = 0.0;
+        if (percentile > 100.0) percentile = 100.0;
+
+        uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+        if (rank == 0) rank = 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                uint64_t value = bucketUpperBound(i);
+                uint64_t maxValue = getMaxMicros();
+                return value < maxValue ? value : maxValue;
+            }
+        }
+
+        return getMaxMicros();
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+
+    static int magnitude(uint64_t value) {
+        int m = 0;
+        while (value >>= 1) ++m;
+        return m;
+    }
+
+    static int bucketIndex(uint64_t value) {
+        const uint64_t limit = (uint64_t(1) << (kMaxMagnitude + 1)) - 1;
+        if (value > limit) value = limit;
+
+        // Values below 16us get one exact bucket each
+        if (value < static_cast<uint64_t>(kSubBucketCount)) {
+            return static_cast<int>(value);
+        }
+
+        int m = magnitude(value);
+        int sub = static_cast<int>((value >> (m - kSubBucketBits)) & (kSubBucketCount - 1));
+        return (m - kSubBucketBits + 1) * kSubBucketCount + sub;
+    }
+
+    static uint64_t bucketUpperBound(int index) {
+        if (index < kSubBucketCount) {
+            return static_cast<uint64_t>(index);
+        }
+
+        int m = index / kSubBucketCount + kSubBucketBits - 1;
+        int sub = index % kSubBucketCount;
+        uint64_t width = uint64_t(1) << (m - kSubBucketBits);
+        uint64_t lower = static_cast<uint64_t>(kSubBucketCount + sub) << (m - kSubBucketBits);
+        return lower + width - 1;
+    }
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,323 @@
+#include "MarketHeatmap.h"
+#include "OSMExtractStore.h"
+#include "QuotaExecutor.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace FranchiseAI {
+namespace Services {
+
+// ============================================================================
+// Raster file layout
+//
+//   HeatmapHeader
+//   uint8_t scores[rows * cols]   row-major from the south-west corner
+// ============================================================================
+
+static const char kHeatmapMagic[8] = {'F', 'A', 'H', 'E', 'A', 'T', 'M', 'P'};
+static const uint32_t kHeatmapVersion = 1;
+
+struct HeatmapHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t reserved;
+    double south;
+    double west;
+    double cellLat;
+    double cellLon;
+    double sampleRadiusKm;
+    int64_t builtAt;
+};
+
+static const double kKmPerDegree = 111.32;
+static const size_t kMaxCells = 1 << 22;
+
+static double lonDegreesPerKm(double latitude) {
+    return 1.0 / (kKmPerDegree * std::max(std::cos(latitude * M_PI / 180.0), 0.01));
+}
+
+// ============================================================================
+// Build
+// ============================================================================
+
+std::shared_ptr<const MarketHeatmap> MarketHeatmap::build(const OSMAPIConfig& osmConfig,
+                                                          const Models::GeoBoundingBox& metro,
+                                                          const MarketHeatmapConfig& config,
+                                                          std::string& error) {
+    if (metro.maxLat <= metro.minLat || metro.maxLon <= metro.minLon || config.cellKm <= 0.0) {
+        error = "empty heatmap area";
+        return nullptr;
+    }
+
+    std::shared_ptr<MarketHeatmap> heatmap(new MarketHeatmap());
+    heatmap->south_ = metro.minLat;
+    heatmap->west_ = metro.minLon;
+    heatmap->cellLat_ = config.cellKm / kKmPerDegree;
+    heatmap->cellLon_ = config.cellKm * lonDegreesPerKm((metro.minLat + metro.maxLat) / 2.0);
+    heatmap->rows_ = std::max(1, static_cast<int>(std::ceil((metro.maxLat - metro.minLat) / heatmap->cellLat_)));
+    heatmap->cols_ = std::max(1, static_cast<int>(std::ceil((metro.maxLon - metro.minLon) / heatmap->cellLon_)));
+    heatmap->sampleRadiusKm_ = config.sampleRadiusKm;
+
+    size_t cellCount = static_cast<size_t>(heatmap->rows_) * heatmap->cols_;
+    if (cellCount > kMaxCells) {
+        error = "heatmap grid too large (" + std::to_string(cellCount) + " cells)";
+        return nullptr;
+    }
+    heatmap->scores_.assign(cellCount, kNoData);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // One task per row, each with its own API client (clients are not
+    // shared between threads); the extract and caches behind them are.
+    // Background tasks may hold quota - 1 slots, hence the extra one.
+    QuotaExecutor executor(ThreadPool::shared(), std::max(1, config.maxParallelRows) + 1, 0, "heatmap");
+    std::vector<std::future<int>> rows;
+    rows.reserve(heatmap->rows_);
+
+    for (int row = 0; row < heatmap->rows_; ++row) {
+        rows.push_back(executor.submit(TaskOptions::background(), [&osmConfig, &heatmap, row]() {
+            OpenStreetMapAPI api(osmConfig);
+            double latitude = heatmap->south_ + (row + 0.5) * heatmap->cellLat_;
+            uint8_t* scores = heatmap->scores_.data() + static_cast<size_t>(row) * heatmap->cols_;
+            int computed = 0;
+
+            for (int col = 0; col < heatmap->cols_; ++col) {
+                double longitude = heatmap->west_ + (col + 0.5) * heatmap->cellLon_;
+                std::string cellError;
+                OSMAreaStats stats = api.getAreaStatisticsSync(latitude, longitude,
+                                                               heatmap->sampleRadiusKm_, &cellError);
+                if (cellError.empty()) {
+                    scores[col] = static_cast<uint8_t>(std::clamp(stats.marketPotentialScore, 0, 100));
+                    ++computed;
+                }
+            }
+            return computed;
+        }));
+    }
+
+    size_t computed = 0;
+    for (auto& row : rows) {
+        executor.waitHelp(row);
+        try {
+            computed += static_cast<size_t>(row.get());
+        } catch (const std::exception& e) {
+            std::cerr << "[Heatmap] Row failed: " << e.what() << std::endl;
+        }
+    }
+
+    if (computed == 0) {
+        error = "no heatmap cell could be computed";
+        return nullptr;
+    }
+
+    heatmap->builtAt_ = std::time(nullptr);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "[Heatmap] Built " << heatmap->rows_ << "x" << heatmap->cols_ << " cells ("
+              << computed << " with data) in " << seconds << " s" << std::endl;
+    return heatmap;
+}
+
+// ============================================================================
+// File I/O
+// ============================================================================
+
+bool MarketHeatmap::save(const std::string& path, std::string& error) const {
+    HeatmapHeader header = {};
+    std::memcpy(header.magic, kHeatmapMagic, sizeof(kHeatmapMagic));
+    header.version = kHeatmapVersion;
+    header.rows = static_cast<uint32_t>(rows_);
+    header.cols = static_cast<uint32_t>(cols_);
+    header.south = south_;
+    header.west = west_;
+    header.cellLat = cellLat_;
+    header.cellLon = cellLon_;
+    header.sampleRadiusKm = sampleRadiusKm_;
+    header.builtAt = static_cast<int64_t>(builtAt_);
+
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot create " + tempPath;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(scores_.data()), scores_.size());
+    out.close();
+
+    if (!out) {
+        error = "write failed: " + tempPath;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        error = "cannot replace " + path;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const MarketHeatmap> MarketHeatmap::load(const std::string& path, std::string* error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return nullptr;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    HeatmapHeader header = {};
+    if (data.size() >= sizeof(header)) {
+        std::memcpy(&header, data.data(), sizeof(header));
+    }
+    uint64_t cellCount = uint64_t(header.rows) * header.cols;
+    bool valid = data.size() >= sizeof(header) &&
+                 std::memcmp(header.magic, kHeatmapMagic, sizeof(kHeatmapMagic)) == 0 &&
+                 header.version == kHeatmapVersion && cellCount > 0 && cellCount <= kMaxCells &&
+                 header.cellLat > 0.0 && header.cellLon > 0.0 &&
+                 data.size() == sizeof(header) + cellCount;
+    if (!valid) {
+        if (error) *error = "not a heatmap file (or wrong version): " + path;
+        return nullptr;
+    }
+
+    std::shared_ptr<MarketHeatmap> heatmap(new MarketHeatmap());
+    heatmap->rows_ = static_cast<int>(header.rows);
+    heatmap->cols_ = static_cast<int>(header.cols);
+    heatmap->south_ = header.south;
+    heatmap->west_ = header.west;
+    heatmap->cellLat_ = header.cellLat;
+    heatmap->cellLon_ = header.cellLon;
+    heatmap->sampleRadiusKm_ = header.sampleRadiusKm;
+    heatmap->builtAt_ = static_cast<time_t>(header.builtAt);
+    heatmap->scores_.assign(data.begin() + sizeof(header), data.end());
+    return heatmap;
+}
+
+// ============================================================================
+// Shared instances
+// ============================================================================
+
+static std::mutex sharedHeatmapsMutex;
+static std::unordered_map<std::string, std::shared_ptr<const MarketHeatmap>> sharedHeatmaps;
+static std::unordered_set<std::string> heatmapAttempts;   // Loaded or built once per path, never retried
+
+std::shared_ptr<const MarketHeatmap> MarketHeatmap::shared(const std::string& path,
+                                                           const OSMAPIConfig& osmConfig) {
+    if (path.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(sharedHeatmapsMutex);
+    auto it = sharedHeatmaps.find(path);
+    if (it != sharedHeatmaps.end()) {
+        return it->second;
+    }
+    // Called on every page render: while a build runs, or after the load
+    // and build failed, answer from memory instead of trying the file again
+    if (!heatmapAttempts.insert(path).second) {
+        return nullptr;
+    }
+    if (auto heatmap = load(path)) {
+        sharedHeatmaps[path] = heatmap;
+        return heatmap;
+    }
+    if (osmConfig.extractStorePath.empty()) {
+        return nullptr;
+    }
+
+    ThreadPool::shared().post(TaskOptions::background(), [path, osmConfig]() {
+        std::string error;
+        std::shared_ptr<const MarketHeatmap> heatmap;
+        MarketHeatmapConfig config;
+
+        auto extract = OSMExtractStore::openOrImport(osmConfig.extractStorePath,
+                                                     osmConfig.extractPbfPath, &error);
+        if (extract) {
+            // Inset by the sample radius plus the cell that may overhang the
+            // north and east edges, so every circle stays inside the extract
+            // and no cell falls back to Overpass
+            Models::GeoBoundingBox metro = extract->bounds();
+            double insetKm = config.sampleRadiusKm + config.cellKm;
+            double dLat = insetKm / kKmPerDegree;
+            double dLon = insetKm * lonDegreesPerKm((metro.minLat + metro.maxLat) / 2.0);
+            metro.minLat += dLat;
+            metro.maxLat -= dLat;
+            metro.minLon += dLon;
+            metro.maxLon -= dLon;
+            heatmap = build(osmConfig, metro, config, error);
+        }
+        if (heatmap && !heatmap->save(path, error)) {
+            std::cerr << "[Heatmap] Not saved, kept in memory: " << error << std::endl;
+        }
+        if (!heatmap) {
+            std::cerr << "[Heatmap] Build failed: " << error << std::endl;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(sharedHeatmapsMutex);
+        sharedHeatmaps[path] = heatmap;
+    });
+    return nullptr;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+MarketHeatmap::Surface MarketHeatmap::surface(const Models::GeoBoundingBox& viewport) const {
+    Surface surface;
+
+    auto cellIndex = [](double degrees, double origin, double cell, int limit) {
+        return std::max(0, std::min(static_cast<int>(std::floor((degrees - origin) / cell)), limit - 1));
+    };
+
+    double north = south_ + rows_ * cellLat_;
+    double east = west_ + cols_ * cellLon_;
+    if (viewport.maxLat < south_ || viewport.minLat > north ||
+        viewport.maxLon < west_ || viewport.minLon > east) {
+        return surface;
+    }
+
+    int rowMin = cellIndex(viewport.minLat, south_, cellLat_, rows_);
+    int rowMax = cellIndex(viewport.maxLat, south_, cellLat_, rows_);
+    int colMin = cellIndex(viewport.minLon, west_, cellLon_, cols_);
+    int colMax = cellIndex(viewport.maxLon, west_, cellLon_, cols_);
+
+    surface.south = south_ + rowMin * cellLat_;
+    surface.west = west_ + colMin * cellLon_;
+    surface.cellLat = cellLat_;
+    surface.cellLon = cellLon_;
+    surface.rows = rowMax - rowMin + 1;
+    surface.cols = colMax - colMin + 1;
+    surface.scores.reserve(static_cast<size_t>(surface.rows) * surface.cols);
+    for (int row = rowMin; row <= rowMax; ++row) {
+        const uint8_t* scores = scores_.data() + static_cast<size_t>(row) * cols_;
+        surface.scores.insert(surface.scores.end(), scores + colMin, scores + colMax + 1);
+    }
+    return surface;
+}
+
+int MarketHeatmap::scoreAt(double latitude, double longitude) const {
+    double row = std::floor((latitude - south_) / cellLat_);
+    double col = std::floor((longitude - west_) / cellLon_);
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+        return -1;
+    }
+    uint8_t score = scores_[static_cast<size_t>(row) * cols_ + static_cast<size_t>(col)];
+    return score == kNoData ? -1 : score;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
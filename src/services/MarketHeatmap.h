@@ -0,0 +1,128 @@
+#ifndef MARKET_HEATMAP_H
+#define MARKET_HEATMAP_H
+
+#include "OpenStreetMapAPI.h"
+#include "models/GeoLocation.h"
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Grid and sampling settings for MarketHeatmap::build()
+ */
+struct MarketHeatmapConfig {
+    double cellKm = 1.0;                // Grid spacing
+    double sampleRadiusKm = 2.0;        // Area statistics circle around each cell center
+    int maxParallelRows = 8;            // Rows computed at once on the shared pool
+};
+
+/**
+ * @brief Market potential scores of a metro area on a regular lat/lon grid
+ *
+ * build() is a batch job: it computes OSMAreaStats for the circle around
+ * every cell center, one task per grid row on ThreadPool::shared() at
+ * background priority, and keeps one byte per cell - the
+ * marketPotentialScore (0-100), or kNoData where the statistics could
+ * not be fetched. Inside a local extract each cell is a few in-memory
+ * counts; elsewhere each cell is one Overpass count query, so the job is
+ * meant to run ahead of time, not per request.
+ *
+ * save() writes the raster as one small binary file and load() reads it
+ * back. surface() returns the cells of a map viewport, so the UI can
+ * show where to search without any live query. A heatmap is immutable
+ * once built and may be read from any thread.
+ */
+class MarketHeatmap {
+public:
+    static constexpr uint8_t kNoData = 255;
+
+    /**
+     * @brief Scores of the cells overlapping a viewport
+     */
+    struct Surface {
+        double south = 0.0;             // Corner of the first cell
+        double west = 0.0;
+        double cellLat = 0.0;           // Cell size in degrees
+        double cellLon = 0.0;
+        int rows = 0;
+        int cols = 0;
+        std::vector<uint8_t> scores;    // Row-major from the south-west corner
+
+        bool empty() const { return scores.empty(); }
+        uint8_t at(int row, int col) const { return scores[static_cast<size_t>(row) * cols + col]; }
+    };
+
+    /**
+     * @brief Compute the heatmap of a metro area
+     * @param osmConfig Configuration for the OpenStreetMapAPI of each task
+     * @param metro Area to cover; cells start at its south-west corner
+     * @param config Grid spacing, sample radius and parallelism
+     * @param error Set when no cell could be computed
+     * @return nullptr on failure
+     */
+    static std::shared_ptr<const MarketHeatmap> build(const OSMAPIConfig& osmConfig,
+                                                      const Models::GeoBoundingBox& metro,
+                                                      const MarketHeatmapConfig& config,
+                                                      std::string& error);
+
+    /**
+     * @brief Write the raster; the file is replaced atomically
+     */
+    bool save(const std::string& path, std::string& error) const;
+
+    /**
+     * @brief Read a raster written by save()
+     * @return nullptr (and error set) if the file is missing or invalid
+     */
+    static std::shared_ptr<const MarketHeatmap> load(const std::string& path,
+                                                     std::string* error = nullptr);
+
+    /**
+     * @brief Heatmap at path, loaded once per process
+     *
+     * If the file does not exist and osmConfig names a local extract, one
+     * background build over the extract's bounds is started; nullptr is
+     * returned until it has finished. The file is read at most once per
+     * path, so a missing or failed heatmap costs no disk I/O per call.
+     */
+    static std::shared_ptr<const MarketHeatmap> shared(const std::string& path,
+                                                       const OSMAPIConfig& osmConfig);
+
+    /**
+     * @brief Cells overlapping the viewport (empty if it misses the grid)
+     */
+    Surface surface(const Models::GeoBoundingBox& viewport) const;
+
+    /**
+     * @brief Score of the cell containing a point, or -1 outside the grid or without data
+     */
+    int scoreAt(double latitude, double longitude) const;
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    double sampleRadiusKm() const { return sampleRadiusKm_; }
+    time_t builtAt() const { return builtAt_; }
+
+private:
+    MarketHeatmap() = default;
+
+    int rows_ = 0;
+    int cols_ = 0;
+    double south_ = 0.0;
+    double west_ = 0.0;
+    double cellLat_ = 0.0;
+    double cellLon_ = 0.0;
+    double sampleRadiusKm_ = 0.0;
+    time_t builtAt_ = 0;
+    std::vector<uint8_t> scores_;       // rows_ * cols_, row-major from the south-west
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // MARKET_HEATMAP_H
@@ -0,0 +1,1357 @@
+#include "OSMExtractStore.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace FranchiseAI {
+namespace Services {
+
+// ============================================================================
+// Store file layout
+//
+//   StoreHeader
+//   uint32_t cellStart[cols * rows + 1]   first record of each grid cell
+//   StoreRecord records[poiCount]         sorted by cell
+//   StoreTag tags[tagCount]               each record's tags are contiguous
+//   char pool[poolSize]                   NUL-terminated, deduplicated strings
+//   StoreCellCounts counts[countedCells]  area statistic counts of each
+//                                         non-empty cell, sorted by cell
+//
+// Sections start on 8-byte boundaries. Coordinates are fixed-point 1e-7°.
+// ============================================================================
+
+static const char kStoreMagic[8] = {'F', 'A', 'O', 'S', 'M', 'P', 'O', 'I'};
+static const uint32_t kStoreVersion = 2;
+static const double kCoordScale = 1e7;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t cellE7;            // Grid cell size
+    int32_t minLatE7;           // Extract bounds (grid origin is min)
+    int32_t minLonE7;
+    int32_t maxLatE7;
+    int32_t maxLonE7;
+    uint32_t cols;
+    uint32_t rows;
+    uint64_t poiCount;
+    uint64_t tagCount;
+    uint64_t poolSize;
+    uint64_t recordsOffset;
+    uint64_t tagsOffset;
+    uint64_t poolOffset;
+    uint64_t countedCells;
+    uint64_t countsOffset;
+    uint32_t statCount;         // OSMAreaStat::Count at import
+    uint32_t reserved;
+};
+
+struct StoreRecord {
+    int64_t osmId;
+    int32_t latE7;
+    int32_t lonE7;
+    uint32_t firstTag;
+    uint16_t tagCount;
+    uint8_t type;               // 0 = node, 1 = way
+    uint8_t reserved;
+};
+
+struct StoreTag {
+    uint32_t key;               // Offsets into the string pool
+    uint32_t value;
+};
+
+struct StoreCellCounts {
+    uint32_t cell;
+    OSMAreaCounts counts;
+};
+
+static uint64_t alignTo8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+// ============================================================================
+// Which elements and tags are kept
+// ============================================================================
+
+// Tags that classify an element as a POI; an empty value matches any value
+static const std::pair<std::string_view, std::string_view> kPoiTags[] = {
+    {"office", ""},
+    {"shop", ""},
+    {"healthcare", ""},
+    {"tourism", "hotel"},
+    {"tourism", "motel"},
+    {"tourism", "hostel"},
+    {"amenity", "conference_centre"},
+    {"amenity", "events_venue"},
+    {"amenity", "hospital"},
+    {"amenity", "clinic"},
+    {"amenity", "university"},
+    {"amenity", "college"},
+    {"amenity", "school"},
+    {"amenity", "coworking_space"},
+    {"amenity", "bank"},
+    {"amenity", "restaurant"},
+    {"amenity", "cafe"},
+    {"amenity", "fast_food"},
+    {"amenity", "parking"},
+    {"building", "office"},
+    {"building", "commercial"},
+    {"building", "industrial"},
+    {"building", "warehouse"},
+    {"building", "hotel"},
+    {"building", "hospital"},
+    {"building", "university"},
+    {"building", "school"},
+    {"building", "government"},
+    {"landuse", "industrial"},
+    {"landuse", "commercial"},
+    {"highway", "bus_stop"},
+    {"railway", "station"},
+};
+
+static void addCounts(OSMAreaCounts& counts, uint32_t statMask) {
+    for (size_t stat = 0; stat < counts.size(); ++stat) {
+        if (statMask & (1u << stat)) {
+            ++counts[stat];
+        }
+    }
+}
+
+static bool isPoiTag(std::string_view key, std::string_view value) {
+    for (const auto& poiTag : kPoiTags) {
+        if (poiTag.first == key && (poiTag.second.empty() || poiTag.second == value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tags stored with each POI (everything OSMPoi and the filters read)
+static bool isStoredKey(std::string_view key) {
+    static const std::string_view keys[] = {
+        "name", "office", "shop", "healthcare", "tourism", "amenity", "building",
+        "landuse", "highway", "railway", "phone", "website", "email", "opening_hours"
+    };
+    if (key.compare(0, 5, "addr:") == 0) {
+        return true;
+    }
+    return std::find(std::begin(keys), std::end(keys), key) != std::end(keys);
+}
+
+// ============================================================================
+// Minimal protobuf reader for the OSM PBF format
+// ============================================================================
+
+namespace {
+
+class ProtoReader {
+public:
+    explicit ProtoReader(std::string_view data)
+        : p_(reinterpret_cast<const uint8_t*>(data.data())), end_(p_ + data.size()) {}
+
+    bool atEnd() const { return p_ >= end_ || failed_; }
+    bool failed() const { return failed_; }
+
+    bool next(uint32_t& field, uint32_t& wireType) {
+        if (atEnd()) {
+            return false;
+        }
+        uint64_t key = varint();
+        field = static_cast<uint32_t>(key >> 3);
+        wireType = static_cast<uint32_t>(key & 7);
+        return !failed_;
+    }
+
+    uint64_t varint() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p_ >= end_) {
+                failed_ = true;
+                return 0;
+            }
+            uint8_t byte = *p_++;
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        failed_ = true;
+        return 0;
+    }
+
+    int64_t svarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    std::string_view bytes() {
+        uint64_t length = varint();
+        if (failed_ || length > static_cast<uint64_t>(end_ - p_)) {
+            failed_ = true;
+            return {};
+        }
+        std::string_view result(reinterpret_cast<const char*>(p_), length);
+        p_ += length;
+        return result;
+    }
+
+    void skip(uint32_t wireType) {
+        switch (wireType) {
+            case 0: varint(); break;
+            case 1: advance(8); break;
+            case 2: bytes(); break;
+            case 5: advance(4); break;
+            default: failed_ = true; break;
+        }
+    }
+
+private:
+    void advance(size_t count) {
+        if (count > static_cast<size_t>(end_ - p_)) {
+            failed_ = true;
+            return;
+        }
+        p_ += count;
+    }
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool failed_ = false;
+};
+
+template<typename Fn>
+void forEachPackedVarint(std::string_view packed, Fn fn) {
+    ProtoReader reader(packed);
+    while (!reader.atEnd()) {
+        fn(reader.varint());
+    }
+}
+
+template<typename Fn>
+void forEachPackedSVarint(std::string_view packed, Fn fn) {
+    ProtoReader reader(packed);
+    while (!reader.atEnd()) {
+        fn(reader.svarint());
+    }
+}
+
+/**
+ * @brief Reads the blob sequence of a PBF file, inflating each blob
+ */
+class PbfBlobReader {
+public:
+    explicit PbfBlobReader(const std::string& path) : in_(path, std::ios::binary) {}
+
+    bool isOpen() const { return in_.is_open(); }
+    const std::string& error() const { return error_; }
+
+    /**
+     * @return false at end of file or on error (error() is set)
+     */
+    bool next(std::string& type, std::string& data) {
+        unsigned char lengthBytes[4];
+        if (!in_.read(reinterpret_cast<char*>(lengthBytes), 4)) {
+            return false;
+        }
+        uint32_t headerLength = (uint32_t(lengthBytes[0]) << 24) | (uint32_t(lengthBytes[1]) << 16) |
+                                (uint32_t(lengthBytes[2]) << 8) | uint32_t(lengthBytes[3]);
+        if (headerLength > 64 * 1024) {
+            return fail("BlobHeader too large");
+        }
+
+        std::string header(headerLength, '\0');
+        if (!in_.read(&header[0], headerLength)) {
+            return fail("truncated BlobHeader");
+        }
+
+        uint64_t dataSize = 0;
+        type.clear();
+        ProtoReader headerReader(header);
+        uint32_t field, wire;
+        while (headerReader.next(field, wire)) {
+            if (field == 1 && wire == 2) type = std::string(headerReader.bytes());
+            else if (field == 3 && wire == 0) dataSize = headerReader.varint();
+            else headerReader.skip(wire);
+        }
+        if (headerReader.failed() || dataSize > 64 * 1024 * 1024) {
+            return fail("invalid BlobHeader");
+        }
+
+        blob_.resize(dataSize);
+        if (dataSize > 0 && !in_.read(&blob_[0], dataSize)) {
+            return fail("truncated Blob");
+        }
+
+        std::string_view raw, zlibData;
+        uint64_t rawSize = 0;
+        bool unsupported = false;
+        ProtoReader blobReader(blob_);
+        while (blobReader.next(field, wire)) {
+            if (field == 1 && wire == 2) raw = blobReader.bytes();
+            else if (field == 2 && wire == 0) rawSize = blobReader.varint();
+            else if (field == 3 && wire == 2) zlibData = blobReader.bytes();
+            else if (wire == 2 && field >= 4) { blobReader.skip(wire); unsupported = true; }
+            else blobReader.skip(wire);
+        }
+
+        if (!raw.empty()) {
+            data.assign(raw.data(), raw.size());
+        } else if (!zlibData.empty()) {
+            if (rawSize > 64 * 1024 * 1024) {
+                return fail("Blob too large");
+            }
+            data.resize(rawSize);
+            uLongf destLength = static_cast<uLongf>(rawSize);
+            int status = uncompress(reinterpret_cast<Bytef*>(&data[0]), &destLength,
+                                    reinterpret_cast<const Bytef*>(zlibData.data()),
+                                    static_cast<uLong>(zlibData.size()));
+            if (status != Z_OK || destLength != rawSize) {
+                return fail("zlib inflate failed");
+            }
+        } else if (unsupported) {
+            return fail("unsupported Blob compression (only raw and zlib are supported)");
+        } else {
+            data.clear();
+        }
+        return true;
+    }
+
+private:
+    bool fail(const std::string& message) {
+        error_ = message;
+        return false;
+    }
+
+    std::ifstream in_;
+    std::string blob_;
+    std::string error_;
+};
+
+/**
+ * @brief Decoded view of one PrimitiveBlock's string table and offsets
+ */
+struct PrimitiveBlock {
+    std::vector<std::string_view> strings;
+    std::vector<std::string_view> groups;
+    int64_t granularity = 100;
+    int64_t latOffset = 0;
+    int64_t lonOffset = 0;
+
+    bool parse(std::string_view data) {
+        ProtoReader reader(data);
+        uint32_t field, wire;
+        while (reader.next(field, wire)) {
+            if (field == 1 && wire == 2) {
+                ProtoReader table(reader.bytes());
+                uint32_t tableField, tableWire;
+                while (table.next(tableField, tableWire)) {
+                    if (tableField == 1 && tableWire == 2) strings.push_back(table.bytes());
+                    else table.skip(tableWire);
+                }
+            } else if (field == 2 && wire == 2) {
+                groups.push_back(reader.bytes());
+            } else if (field == 17 && wire == 0) {
+                granularity = static_cast<int64_t>(reader.varint());
+            } else if (field == 19 && wire == 0) {
+                latOffset = static_cast<int64_t>(reader.varint());
+            } else if (field == 20 && wire == 0) {
+                lonOffset = static_cast<int64_t>(reader.varint());
+            } else {
+                reader.skip(wire);
+            }
+        }
+        return !reader.failed();
+    }
+
+    std::string_view string(uint64_t index) const {
+        return index < strings.size() ? strings[index] : std::string_view();
+    }
+
+    // Fixed-point 1e-7° from the block's nanodegree encoding
+    int32_t latE7(int64_t lat) const { return static_cast<int32_t>((latOffset + granularity * lat) / 100); }
+    int32_t lonE7(int64_t lon) const { return static_cast<int32_t>((lonOffset + granularity * lon) / 100); }
+};
+
+/**
+ * @brief POI collected during import, before it is placed in the grid
+ */
+struct PendingPoi {
+    int64_t osmId = 0;
+    int32_t latE7 = 0;
+    int32_t lonE7 = 0;
+    uint8_t type = 0;
+    std::vector<StoreTag> tags;
+};
+
+struct PendingWay {
+    size_t poiIndex;            // Index into the POI list
+    std::vector<int64_t> refs;
+};
+
+/**
+ * @brief Collects POIs and builds the store file
+ */
+class StoreBuilder {
+public:
+    // Keep the element if any tag classifies it as a POI
+    template<typename TagList>
+    bool collect(int64_t osmId, uint8_t type, int32_t latE7, int32_t lonE7, const TagList& tagList) {
+        bool isPoi = false;
+        for (const auto& tag : tagList) {
+            if (isPoiTag(tag.first, tag.second)) {
+                isPoi = true;
+                break;
+            }
+        }
+        if (!isPoi) {
+            return false;
+        }
+
+        PendingPoi poi;
+        poi.osmId = osmId;
+        poi.type = type;
+        poi.latE7 = latE7;
+        poi.lonE7 = lonE7;
+        for (const auto& tag : tagList) {
+            if (isStoredKey(tag.first)) {
+                poi.tags.push_back({intern(tag.first), intern(tag.second)});
+            }
+        }
+        pois_.push_back(std::move(poi));
+        return true;
+    }
+
+    std::vector<PendingPoi>& pois() { return pois_; }
+
+    void setBounds(int32_t minLatE7, int32_t minLonE7, int32_t maxLatE7, int32_t maxLonE7) {
+        hasBounds_ = true;
+        minLatE7_ = minLatE7;
+        minLonE7_ = minLonE7;
+        maxLatE7_ = maxLatE7;
+        maxLonE7_ = maxLonE7;
+    }
+
+    bool write(const std::string& path, std::string& error);
+
+private:
+    uint32_t intern(std::string_view text) {
+        auto it = offsets_.find(std::string(text));
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(pool_.size());
+        pool_.append(text.data(), text.size());
+        pool_.push_back('\0');
+        offsets_.emplace(std::string(text), offset);
+        return offset;
+    }
+
+    std::vector<PendingPoi> pois_;
+    std::string pool_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+
+    bool hasBounds_ = false;
+    int32_t minLatE7_ = 0, minLonE7_ = 0, maxLatE7_ = 0, maxLonE7_ = 0;
+};
+
+bool StoreBuilder::write(const std::string& path, std::string& error) {
+    // Drop elements whose location could not be resolved
+    pois_.erase(std::remove_if(pois_.begin(), pois_.end(), [](const PendingPoi& poi) {
+        return poi.latE7 == 0 && poi.lonE7 == 0;
+    }), pois_.end());
+
+    if (!hasBounds_) {
+        // No header bbox: cover exactly the imported POIs
+        minLatE7_ = minLonE7_ = INT32_MAX;
+        maxLatE7_ = maxLonE7_ = INT32_MIN;
+        for (const auto& poi : pois_) {
+            minLatE7_ = std::min(minLatE7_, poi.latE7);
+            maxLatE7_ = std::max(maxLatE7_, poi.latE7);
+            minLonE7_ = std::min(minLonE7_, poi.lonE7);
+            maxLonE7_ = std::max(maxLonE7_, poi.lonE7);
+        }
+        if (pois_.empty()) {
+            minLatE7_ = minLonE7_ = maxLatE7_ = maxLonE7_ = 0;
+        }
+    }
+
+    StoreHeader header = {};
+    std::memcpy(header.magic, kStoreMagic, sizeof(kStoreMagic));
+    header.version = kStoreVersion;
+    header.cellE7 = static_cast<uint32_t>(OSMExtractStore::kCellDegrees * kCoordScale);
+    header.minLatE7 = minLatE7_;
+    header.minLonE7 = minLonE7_;
+    header.maxLatE7 = maxLatE7_;
+    header.maxLonE7 = maxLonE7_;
+    header.cols = static_cast<uint32_t>((int64_t(maxLonE7_) - minLonE7_) / header.cellE7 + 1);
+    header.rows = static_cast<uint32_t>((int64_t(maxLatE7_) - minLatE7_) / header.cellE7 + 1);
+
+    auto cellOf = [&header](const PendingPoi& poi) -> uint32_t {
+        int64_t col = (int64_t(poi.lonE7) - header.minLonE7) / header.cellE7;
+        int64_t row = (int64_t(poi.latE7) - header.minLatE7) / header.cellE7;
+        col = std::max<int64_t>(0, std::min<int64_t>(col, header.cols - 1));
+        row = std::max<int64_t>(0, std::min<int64_t>(row, header.rows - 1));
+        return static_cast<uint32_t>(row * header.cols + col);
+    };
+
+    // Elements outside a header bbox are clipped to the edge cells; drop them
+    // so the store only answers for the area it claims to cover
+    pois_.erase(std::remove_if(pois_.begin(), pois_.end(), [&header](const PendingPoi& poi) {
+        return poi.latE7 < header.minLatE7 || poi.latE7 > header.maxLatE7 ||
+               poi.lonE7 < header.minLonE7 || poi.lonE7 > header.maxLonE7;
+    }), pois_.end());
+
+    std::vector<uint32_t> cells(pois_.size());
+    std::vector<size_t> order(pois_.size());
+    for (size_t i = 0; i < pois_.size(); ++i) {
+        cells[i] = cellOf(pois_[i]);
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (cells[a] != cells[b]) return cells[a] < cells[b];
+        return pois_[a].osmId < pois_[b].osmId;
+    });
+
+    size_t cellCount = size_t(header.cols) * header.rows;
+    std::vector<uint32_t> cellStart(cellCount + 1, 0);
+    std::vector<StoreRecord> records;
+    std::vector<StoreTag> tags;
+    records.reserve(pois_.size());
+
+    for (size_t index : order) {
+        const PendingPoi& poi = pois_[index];
+        StoreRecord record = {};
+        record.osmId = poi.osmId;
+        record.latE7 = poi.latE7;
+        record.lonE7 = poi.lonE7;
+        record.type = poi.type;
+        record.firstTag = static_cast<uint32_t>(tags.size());
+        record.tagCount = static_cast<uint16_t>(std::min<size_t>(poi.tags.size(), UINT16_MAX));
+        tags.insert(tags.end(), poi.tags.begin(), poi.tags.begin() + record.tagCount);
+        records.push_back(record);
+        ++cellStart[cells[index] + 1];
+    }
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    // Area statistics of each non-empty cell, summed by countWithin()
+    std::vector<StoreCellCounts> cellCounts;
+    for (size_t index : order) {
+        const PendingPoi& poi = pois_[index];
+        if (cellCounts.empty() || cellCounts.back().cell != cells[index]) {
+            cellCounts.push_back(StoreCellCounts{cells[index], {}});
+        }
+        addCounts(cellCounts.back().counts, OSMAreaStats::classify([this, &poi](std::string_view key) {
+            for (const auto& tag : poi.tags) {
+                if (key == pool_.c_str() + tag.key) {
+                    return std::string_view(pool_.c_str() + tag.value);
+                }
+            }
+            return std::string_view();
+        }));
+    }
+
+    header.poiCount = records.size();
+    header.tagCount = tags.size();
+    header.poolSize = pool_.size();
+    header.recordsOffset = alignTo8(sizeof(StoreHeader) + cellStart.size() * sizeof(uint32_t));
+    header.tagsOffset = alignTo8(header.recordsOffset + records.size() * sizeof(StoreRecord));
+    header.poolOffset = alignTo8(header.tagsOffset + tags.size() * sizeof(StoreTag));
+    header.countedCells = cellCounts.size();
+    header.countsOffset = alignTo8(header.poolOffset + pool_.size());
+    header.statCount = static_cast<uint32_t>(OSMAreaStat::Count);
+
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot create " + tempPath;
+        return false;
+    }
+
+    auto pad = [&out]() {
+        static const char zeros[8] = {};
+        uint64_t position = static_cast<uint64_t>(out.tellp());
+        out.write(zeros, alignTo8(position) - position);
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(cellStart.data()), cellStart.size() * sizeof(uint32_t));
+    pad();
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(StoreRecord));
+    pad();
+    out.write(reinterpret_cast<const char*>(tags.data()), tags.size() * sizeof(StoreTag));
+    pad();
+    out.write(pool_.data(), pool_.size());
+    pad();
+    out.write(reinterpret_cast<const char*>(cellCounts.data()), cellCounts.size() * sizeof(StoreCellCounts));
+    out.close();
+
+    if (!out) {
+        error = "write failed: " + tempPath;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        error = "cannot replace " + path;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+using TagPairs = std::vector<std::pair<std::string_view, std::string_view>>;
+
+/**
+ * @brief Call fn(id, latE7, lonE7, tags) for every node in a group
+ */
+template<typename Fn>
+void forEachNode(const PrimitiveBlock& block, std::string_view group, bool withTags, Fn fn) {
+    TagPairs tags;
+    ProtoReader reader(group);
+    uint32_t field, wire;
+
+    while (reader.next(field, wire)) {
+        if (field == 1 && wire == 2) {
+            // Node
+            ProtoReader node(reader.bytes());
+            int64_t id = 0, lat = 0, lon = 0;
+            std::vector<uint64_t> keys, values;
+            uint32_t nodeField, nodeWire;
+            while (node.next(nodeField, nodeWire)) {
+                if (nodeField == 1 && nodeWire == 0) id = node.svarint();
+                else if (nodeField == 2 && nodeWire == 2 && withTags) forEachPackedVarint(node.bytes(), [&](uint64_t k) { keys.push_back(k); });
+                else if (nodeField == 3 && nodeWire == 2 && withTags) forEachPackedVarint(node.bytes(), [&](uint64_t v) { values.push_back(v); });
+                else if (nodeField == 8 && nodeWire == 0) lat = node.svarint();
+                else if (nodeField == 9 && nodeWire == 0) lon = node.svarint();
+                else node.skip(nodeWire);
+            }
+            tags.clear();
+            for (size_t i = 0; i < keys.size() && i < values.size(); ++i) {
+                tags.emplace_back(block.string(keys[i]), block.string(values[i]));
+            }
+            fn(id, block.latE7(lat), block.lonE7(lon), tags);
+        } else if (field == 2 && wire == 2) {
+            // DenseNodes: delta-coded parallel arrays, tags as key,value,...,0
+            ProtoReader dense(reader.bytes());
+            std::string_view ids, lats, lons, keysVals;
+            uint32_t denseField, denseWire;
+            while (dense.next(denseField, denseWire)) {
+                if (denseField == 1 && denseWire == 2) ids = dense.bytes();
+                else if (denseField == 8 && denseWire == 2) lats = dense.bytes();
+                else if (denseField == 9 && denseWire == 2) lons = dense.bytes();
+                else if (denseField == 10 && denseWire == 2) keysVals = dense.bytes();
+                else dense.skip(denseWire);
+            }
+
+            ProtoReader idReader(ids), latReader(lats), lonReader(lons), tagReader(keysVals);
+            int64_t id = 0, lat = 0, lon = 0;
+            while (!idReader.atEnd() && !latReader.atEnd() && !lonReader.atEnd()) {
+                id += idReader.svarint();
+                lat += latReader.svarint();
+                lon += lonReader.svarint();
+
+                tags.clear();
+                while (!tagReader.atEnd()) {
+                    uint64_t key = tagReader.varint();
+                    if (key == 0) break;
+                    uint64_t value = tagReader.varint();
+                    if (withTags) {
+                        tags.emplace_back(block.string(key), block.string(value));
+                    }
+                }
+                fn(id, block.latE7(lat), block.lonE7(lon), tags);
+            }
+        } else {
+            reader.skip(wire);
+        }
+    }
+}
+
+/**
+ * @brief Call fn(id, tags, refs) for every way in a group
+ */
+template<typename Fn>
+void forEachWay(const PrimitiveBlock& block, std::string_view group, Fn fn) {
+    TagPairs tags;
+    ProtoReader reader(group);
+    uint32_t field, wire;
+
+    while (reader.next(field, wire)) {
+        if (field != 3 || wire != 2) {
+            reader.skip(wire);
+            continue;
+        }
+
+        ProtoReader way(reader.bytes());
+        int64_t id = 0;
+        std::vector<uint64_t> keys, values;
+        std::string_view refs;
+        uint32_t wayField, wayWire;
+        while (way.next(wayField, wayWire)) {
+            if (wayField == 1 && wayWire == 0) id = static_cast<int64_t>(way.varint());
+            else if (wayField == 2 && wayWire == 2) forEachPackedVarint(way.bytes(), [&](uint64_t k) { keys.push_back(k); });
+            else if (wayField == 3 && wayWire == 2) forEachPackedVarint(way.bytes(), [&](uint64_t v) { values.push_back(v); });
+            else if (wayField == 8 && wayWire == 2) refs = way.bytes();
+            else way.skip(wayWire);
+        }
+
+        tags.clear();
+        for (size_t i = 0; i < keys.size() && i < values.size(); ++i) {
+            tags.emplace_back(block.string(keys[i]), block.string(values[i]));
+        }
+        fn(id, tags, refs);
+    }
+}
+
+/**
+ * @brief Read the HeaderBlock: reject unsupported features, take the bbox
+ */
+bool readHeaderBlock(std::string_view data, StoreBuilder& builder, std::string& error) {
+    ProtoReader reader(data);
+    uint32_t field, wire;
+    while (reader.next(field, wire)) {
+        if (field == 1 && wire == 2) {
+            // HeaderBBox in nanodegrees
+            ProtoReader bbox(reader.bytes());
+            int64_t left = 0, right = 0, top = 0, bottom = 0;
+            uint32_t bboxField, bboxWire;
+            while (bbox.next(bboxField, bboxWire)) {
+                if (bboxWire != 0) { bbox.skip(bboxWire); continue; }
+                int64_t value = bbox.svarint();
+                if (bboxField == 1) left = value;
+                else if (bboxField == 2) right = value;
+                else if (bboxField == 3) top = value;
+                else if (bboxField == 4) bottom = value;
+            }
+            builder.setBounds(static_cast<int32_t>(bottom / 100), static_cast<int32_t>(left / 100),
+                              static_cast<int32_t>(top / 100), static_cast<int32_t>(right / 100));
+        } else if (field == 4 && wire == 2) {
+            std::string_view feature = reader.bytes();
+            if (feature != "OsmSchema-V0.6" && feature != "DenseNodes") {
+                error = "unsupported PBF feature: " + std::string(feature);
+                return false;
+            }
+        } else {
+            reader.skip(wire);
+        }
+    }
+    return !reader.failed();
+}
+
+} // namespace
+
+// ============================================================================
+// Import
+// ============================================================================
+
+bool OSMExtractStore::importPbf(const std::string& pbfPath, const std::string& storePath,
+                                std::string& error) {
+    StoreBuilder builder;
+    std::vector<PendingWay> ways;
+
+    // Pass 1: tagged nodes become POIs directly; tagged ways are kept with
+    // their node refs until the node locations are known
+    {
+        PbfBlobReader blobs(pbfPath);
+        if (!blobs.isOpen()) {
+            error = "cannot open " + pbfPath;
+            return false;
+        }
+
+        std::string type, data;
+        while (blobs.next(type, data)) {
+            if (type == "OSMHeader") {
+                if (!readHeaderBlock(data, builder, error)) return false;
+                continue;
+            }
+            if (type != "OSMData") continue;
+
+            PrimitiveBlock block;
+            if (!block.parse(data)) {
+                error = "malformed PrimitiveBlock in " + pbfPath;
+                return false;
+            }
+            for (std::string_view group : block.groups) {
+                forEachNode(block, group, true,
+                    [&builder](int64_t id, int32_t latE7, int32_t lonE7, const TagPairs& tags) {
+                        if (!tags.empty()) builder.collect(id, 0, latE7, lonE7, tags);
+                    });
+                forEachWay(block, group,
+                    [&builder, &ways](int64_t id, const TagPairs& tags, std::string_view refs) {
+                        if (!builder.collect(id, 1, 0, 0, tags)) return;
+                        PendingWay way;
+                        way.poiIndex = builder.pois().size() - 1;
+                        int64_t ref = 0;
+                        forEachPackedSVarint(refs, [&](int64_t delta) {
+                            ref += delta;
+                            way.refs.push_back(ref);
+                        });
+                        ways.push_back(std::move(way));
+                    });
+            }
+        }
+        if (!blobs.error().empty()) {
+            error = blobs.error();
+            return false;
+        }
+    }
+
+    // Pass 2: resolve the nodes those ways reference and place each way at
+    // the center of its bounding box
+    if (!ways.empty()) {
+        std::vector<int64_t> needed;
+        for (const auto& way : ways) {
+            needed.insert(needed.end(), way.refs.begin(), way.refs.end());
+        }
+        std::sort(needed.begin(), needed.end());
+        needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+
+        std::vector<std::pair<int32_t, int32_t>> locations(needed.size(), {0, 0});
+        std::vector<bool> found(needed.size(), false);
+
+        PbfBlobReader blobs(pbfPath);
+        if (!blobs.isOpen()) {
+            error = "cannot open " + pbfPath;
+            return false;
+        }
+        std::string type, data;
+        while (blobs.next(type, data)) {
+            if (type != "OSMData") continue;
+            PrimitiveBlock block;
+            if (!block.parse(data)) {
+                error = "malformed PrimitiveBlock in " + pbfPath;
+                return false;
+            }
+            for (std::string_view group : block.groups) {
+                forEachNode(block, group, false,
+                    [&](int64_t id, int32_t latE7, int32_t lonE7, const TagPairs&) {
+                        auto it = std::lower_bound(needed.begin(), needed.end(), id);
+                        if (it != needed.end() && *it == id) {
+                            size_t index = it - needed.begin();
+                            locations[index] = {latE7, lonE7};
+                            found[index] = true;
+                        }
+                    });
+            }
+        }
+        if (!blobs.error().empty()) {
+            error = blobs.error();
+            return false;
+        }
+
+        for (const auto& way : ways) {
+            int32_t minLat = INT32_MAX, maxLat = INT32_MIN, minLon = INT32_MAX, maxLon = INT32_MIN;
+            for (int64_t ref : way.refs) {
+                size_t index = std::lower_bound(needed.begin(), needed.end(), ref) - needed.begin();
+                if (!found[index]) continue;
+                minLat = std::min(minLat, locations[index].first);
+                maxLat = std::max(maxLat, locations[index].first);
+                minLon = std::min(minLon, locations[index].second);
+                maxLon = std::max(maxLon, locations[index].second);
+            }
+            if (minLat <= maxLat) {
+                PendingPoi& poi = builder.pois()[way.poiIndex];
+                poi.latE7 = static_cast<int32_t>((int64_t(minLat) + maxLat) / 2);
+                poi.lonE7 = static_cast<int32_t>((int64_t(minLon) + maxLon) / 2);
+            }
+        }
+    }
+
+    return builder.write(storePath, error);
+}
+
+// ============================================================================
+// Mapping and queries
+// ============================================================================
+
+static std::mutex openStoresMutex;
+static std::unordered_map<std::string, std::weak_ptr<const OSMExtractStore>> openStores;
+
+std::shared_ptr<const OSMExtractStore> OSMExtractStore::open(const std::string& storePath,
+                                                             std::string* error) {
+    {
+        std::lock_guard<std::mutex> lock(openStoresMutex);
+        auto it = openStores.find(storePath);
+        if (it != openStores.end()) {
+            if (auto existing = it->second.lock()) {
+                return existing;
+            }
+        }
+    }
+
+    // Mapped without the lock; a racing caller's mapping wins below
+    std::shared_ptr<OSMExtractStore> store(new OSMExtractStore());
+    std::string mapError;
+    if (!store->map(storePath, mapError)) {
+        if (error) *error = mapError;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(openStoresMutex);
+    auto& slot = openStores[storePath];
+    if (auto existing = slot.lock()) {
+        return existing;
+    }
+    slot = store;
+    return store;
+}
+
+// ============================================================================
+// Background import
+// ============================================================================
+
+enum class ImportPhase { Queued, Running, Done, Failed };
+
+struct ImportState {
+    ImportPhase phase = ImportPhase::Queued;
+    std::string pbfPath;
+    int64_t pbfMtime = 0;                           // Extract a failure belongs to
+    int64_t pbfSize = 0;
+    std::string error;
+    std::shared_ptr<const OSMExtractStore> store;   // Kept once imported
+};
+
+static std::mutex importsMutex;
+static std::condition_variable importFinished;
+static std::unordered_map<std::string, ImportState> imports;   // By store path
+
+static bool statFile(const std::string& path, int64_t& mtime, int64_t& size) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    mtime = static_cast<int64_t>(info.st_mtime);
+    size = static_cast<int64_t>(info.st_size);
+    return true;
+}
+
+/**
+ * @brief The store if it is open or imported; otherwise queue its import
+ * @param queued Set when this call queued the import
+ * @param importing Set while an import of storePath is queued or running
+ *
+ * A failed import is remembered and only queued again once the .osm.pbf
+ * file changes (path, mtime or size).
+ */
+static std::shared_ptr<const OSMExtractStore> findOrQueueImport(const std::string& storePath,
+                                                                const std::string& pbfPath,
+                                                                std::string* error,
+                                                                bool& queued, bool& importing) {
+    queued = false;
+    importing = false;
+
+    bool known = false;
+    {
+        std::lock_guard<std::mutex> lock(importsMutex);
+        auto it = imports.find(storePath);
+        if (it != imports.end()) {
+            known = true;
+            const ImportState& state = it->second;
+            if (state.phase == ImportPhase::Done) {
+                return state.store;
+            }
+            if (state.phase != ImportPhase::Failed) {
+                importing = true;
+                if (error) *error = "importing " + state.pbfPath + " in the background";
+                return nullptr;
+            }
+        }
+    }
+
+    std::string openError;
+    if (!known) {
+        if (auto store = OSMExtractStore::open(storePath, &openError)) {
+            return store;
+        }
+    }
+    if (pbfPath.empty()) {
+        if (error) *error = openError;
+        return nullptr;
+    }
+
+    int64_t mtime = 0, size = 0;
+    if (!statFile(pbfPath, mtime, size)) {
+        if (error) *error = "cannot open " + pbfPath;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(importsMutex);
+    ImportState& state = imports[storePath];
+    if (!state.pbfPath.empty()) {
+        // Another caller got here first, or this extract already failed
+        if (state.phase == ImportPhase::Done) {
+            return state.store;
+        }
+        if (state.phase != ImportPhase::Failed) {
+            importing = true;
+            if (error) *error = "importing " + state.pbfPath + " in the background";
+            return nullptr;
+        }
+        if (state.pbfPath == pbfPath && state.pbfMtime == mtime && state.pbfSize == size) {
+            if (error) *error = state.error;
+            return nullptr;
+        }
+    }
+
+    state.phase = ImportPhase::Queued;
+    state.pbfPath = pbfPath;
+    state.pbfMtime = mtime;
+    state.pbfSize = size;
+    state.error.clear();
+    queued = true;
+    importing = true;
+    if (error) *error = "importing " + pbfPath + " in the background";
+    return nullptr;
+}
+
+/**
+ * @brief Run a queued import on the calling thread
+ *
+ * Does nothing if the import is not queued (another thread claimed it).
+ */
+static void runImport(const std::string& storePath) {
+    std::string pbfPath;
+    {
+        std::lock_guard<std::mutex> lock(importsMutex);
+        auto it = imports.find(storePath);
+        if (it == imports.end() || it->second.phase != ImportPhase::Queued) {
+            return;
+        }
+        it->second.phase = ImportPhase::Running;
+        pbfPath = it->second.pbfPath;
+    }
+
+    std::string error;
+    std::shared_ptr<const OSMExtractStore> store;
+    if (OSMExtractStore::importPbf(pbfPath, storePath, error)) {
+        store = OSMExtractStore::open(storePath, &error);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(importsMutex);
+        ImportState& state = imports[storePath];
+        state.phase = store ? ImportPhase::Done : ImportPhase::Failed;
+        state.store = store;
+        state.error = store ? std::string() : error;
+    }
+    importFinished.notify_all();
+}
+
+std::shared_ptr<const OSMExtractStore> OSMExtractStore::openOrStartImport(const std::string& storePath,
+                                                                          const std::string& pbfPath,
+                                                                          std::string* error,
+                                                                          bool* importing) {
+    bool queued = false, pending = false;
+    auto store = findOrQueueImport(storePath, pbfPath, error, queued, pending);
+    if (queued) {
+        ThreadPool::shared().post(TaskOptions::background(), [storePath]() { runImport(storePath); });
+    }
+    if (importing) *importing = pending;
+    return store;
+}
+
+std::shared_ptr<const OSMExtractStore> OSMExtractStore::openOrImport(const std::string& storePath,
+                                                                     const std::string& pbfPath,
+                                                                     std::string* error) {
+    bool queued = false, pending = false;
+    auto store = findOrQueueImport(storePath, pbfPath, error, queued, pending);
+    if (store || !pending) {
+        return store;
+    }
+
+    // Run the import here unless a pool task already started it, so a
+    // caller on the pool never waits for a task queued behind it
+    runImport(storePath);
+
+    std::unique_lock<std::mutex> lock(importsMutex);
+    const ImportState& state = imports[storePath];
+    importFinished.wait(lock, [&state]() {
+        return state.phase == ImportPhase::Done || state.phase == ImportPhase::Failed;
+    });
+    if (!state.store && error) *error = state.error;
+    return state.store;
+}
+
+bool OSMExtractStore::map(const std::string& storePath, std::string& error) {
+    int fd = ::open(storePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + storePath;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StoreHeader)) {
+        ::close(fd);
+        error = "not an extract store: " + storePath;
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        error = "mmap failed: " + storePath;
+        return false;
+    }
+
+    data_ = mapping;
+    size_ = static_cast<size_t>(info.st_size);
+
+    const char* base = static_cast<const char*>(data_);
+    header_ = reinterpret_cast<const StoreHeader*>(base);
+
+    const StoreHeader& h = *header_;
+    uint64_t cellCount = uint64_t(h.cols) * h.rows;
+    bool valid = std::memcmp(h.magic, kStoreMagic, sizeof(kStoreMagic)) == 0 &&
+                 h.version == kStoreVersion && h.cellE7 > 0 &&
+                 sizeof(StoreHeader) + (cellCount + 1) * sizeof(uint32_t) <= h.recordsOffset &&
+                 h.recordsOffset + h.poiCount * sizeof(StoreRecord) <= h.tagsOffset &&
+                 h.tagsOffset + h.tagCount * sizeof(StoreTag) <= h.poolOffset &&
+                 h.poolOffset + h.poolSize <= h.countsOffset &&
+                 h.statCount == static_cast<uint32_t>(OSMAreaStat::Count) &&
+                 h.countsOffset + h.countedCells * sizeof(StoreCellCounts) <= size_;
+    if (!valid) {
+        error = "not an extract store (or wrong version): " + storePath;
+        return false;
+    }
+
+    cellStart_ = reinterpret_cast<const uint32_t*>(base + sizeof(StoreHeader));
+    records_ = reinterpret_cast<const StoreRecord*>(base + h.recordsOffset);
+    tags_ = reinterpret_cast<const StoreTag*>(base + h.tagsOffset);
+    pool_ = base + h.poolOffset;
+    cellCounts_ = reinterpret_cast<const StoreCellCounts*>(base + h.countsOffset);
+    return true;
+}
+
+OSMExtractStore::~OSMExtractStore() {
+    if (data_) {
+        munmap(const_cast<void*>(data_), size_);
+    }
+}
+
+size_t OSMExtractStore::size() const {
+    return static_cast<size_t>(header_->poiCount);
+}
+
+// Degrees of latitude/longitude spanned by a distance around a latitude
+static double latDegrees(double meters) {
+    return meters / 111320.0;
+}
+
+static double lonDegrees(double meters, double latitude) {
+    double scale = std::cos(latitude * M_PI / 180.0);
+    return meters / (111320.0 * std::max(scale, 0.01));
+}
+
+static double distanceMeters(double lat1, double lon1, double lat2, double lon2) {
+    const double earthRadius = 6371000.0;
+    double dLat = (lat2 - lat1) * M_PI / 180.0;
+    double dLon = (lon2 - lon1) * M_PI / 180.0;
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+               std::cos(lat1 * M_PI / 180.0) * std::cos(lat2 * M_PI / 180.0) *
+               std::sin(dLon / 2) * std::sin(dLon / 2);
+    return earthRadius * 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+}
+
+// Grid cells overlapping a bounding box, clamped to the grid
+struct CellRange {
+    int64_t rowMin, rowMax, colMin, colMax;
+};
+
+static CellRange cellRange(const StoreHeader& h, double latitude, double longitude,
+                           double dLat, double dLon) {
+    auto cellIndex = [&h](double degrees, int32_t originE7, uint32_t limit) -> int64_t {
+        int64_t index = static_cast<int64_t>(std::floor((degrees * kCoordScale - originE7) / h.cellE7));
+        return std::max<int64_t>(0, std::min<int64_t>(index, int64_t(limit) - 1));
+    };
+
+    CellRange range;
+    range.rowMin = cellIndex(latitude - dLat, h.minLatE7, h.rows);
+    range.rowMax = cellIndex(latitude + dLat, h.minLatE7, h.rows);
+    range.colMin = cellIndex(longitude - dLon, h.minLonE7, h.cols);
+    range.colMax = cellIndex(longitude + dLon, h.minLonE7, h.cols);
+    return range;
+}
+
+bool OSMExtractStore::covers(double latitude, double longitude, double radiusMeters) const {
+    double dLat = latDegrees(radiusMeters);
+    double dLon = lonDegrees(radiusMeters, latitude);
+    return (latitude - dLat) * kCoordScale >= header_->minLatE7 &&
+           (latitude + dLat) * kCoordScale <= header_->maxLatE7 &&
+           (longitude - dLon) * kCoordScale >= header_->minLonE7 &&
+           (longitude + dLon) * kCoordScale <= header_->maxLonE7;
+}
+
+Models::GeoBoundingBox OSMExtractStore::bounds() const {
+    Models::GeoBoundingBox box;
+    box.minLat = header_->minLatE7 / kCoordScale;
+    box.maxLat = header_->maxLatE7 / kCoordScale;
+    box.minLon = header_->minLonE7 / kCoordScale;
+    box.maxLon = header_->maxLonE7 / kCoordScale;
+    return box;
+}
+
+void OSMExtractStore::forEachWithin(double latitude, double longitude, double radiusMeters,
+                                    const std::function<void(const OSMPoiView&)>& fn) const {
+    const StoreHeader& h = *header_;
+    if (h.poiCount == 0) {
+        return;
+    }
+
+    double dLat = latDegrees(radiusMeters);
+    double dLon = lonDegrees(radiusMeters, latitude);
+    CellRange range = cellRange(h, latitude, longitude, dLat, dLon);
+
+    for (int64_t row = range.rowMin; row <= range.rowMax; ++row) {
+        // Cells of a row are contiguous, so one record range per row
+        uint32_t begin = cellStart_[row * h.cols + range.colMin];
+        uint32_t end = cellStart_[row * h.cols + range.colMax + 1];
+        for (uint32_t i = begin; i < end; ++i) {
+            const StoreRecord& record = records_[i];
+            double lat = record.latE7 / kCoordScale;
+            double lon = record.lonE7 / kCoordScale;
+            if (std::abs(lat - latitude) > dLat || std::abs(lon - longitude) > dLon) {
+                continue;
+            }
+            if (distanceMeters(latitude, longitude, lat, lon) <= radiusMeters) {
+                fn(OSMPoiView(this, &record));
+            }
+        }
+    }
+}
+
+OSMAreaCounts OSMExtractStore::countWithin(double latitude, double longitude,
+                                           double radiusMeters) const {
+    OSMAreaCounts counts = {};
+    const StoreHeader& h = *header_;
+    if (h.poiCount == 0) {
+        return counts;
+    }
+
+    double dLat = latDegrees(radiusMeters);
+    double dLon = lonDegrees(radiusMeters, latitude);
+    CellRange range = cellRange(h, latitude, longitude, dLat, dLon);
+
+    // A cell is inside the circle when all four of its corners are
+    auto cellInside = [&](int64_t row, int64_t col) {
+        double south = (h.minLatE7 + row * int64_t(h.cellE7)) / kCoordScale;
+        double west = (h.minLonE7 + col * int64_t(h.cellE7)) / kCoordScale;
+        double north = south + h.cellE7 / kCoordScale;
+        double east = west + h.cellE7 / kCoordScale;
+        return distanceMeters(latitude, longitude, south, west) <= radiusMeters &&
+               distanceMeters(latitude, longitude, south, east) <= radiusMeters &&
+               distanceMeters(latitude, longitude, north, west) <= radiusMeters &&
+               distanceMeters(latitude, longitude, north, east) <= radiusMeters;
+    };
+
+    const StoreCellCounts* countsEnd = cellCounts_ + h.countedCells;
+    for (int64_t row = range.rowMin; row <= range.rowMax; ++row) {
+        uint32_t firstCell = static_cast<uint32_t>(row * h.cols + range.colMin);
+        const StoreCellCounts* cellCounts = std::lower_bound(cellCounts_, countsEnd, firstCell,
+            [](const StoreCellCounts& c, uint32_t cell) { return c.cell < cell; });
+
+        for (int64_t col = range.colMin; col <= range.colMax; ++col) {
+            uint32_t cell = static_cast<uint32_t>(row * h.cols + col);
+            uint32_t begin = cellStart_[cell];
+            uint32_t end = cellStart_[cell + 1];
+            if (begin == end) {
+                continue;
+            }
+
+            if (cellInside(row, col)) {
+                while (cellCounts != countsEnd && cellCounts->cell < cell) {
+                    ++cellCounts;
+                }
+                if (cellCounts != countsEnd && cellCounts->cell == cell) {
+                    for (size_t stat = 0; stat < counts.size(); ++stat) {
+                        counts[stat] += cellCounts->counts[stat];
+                    }
+                }
+                continue;
+            }
+
+            // Cells on the edge of the circle are counted POI by POI
+            for (uint32_t i = begin; i < end; ++i) {
+                const StoreRecord& record = records_[i];
+                double lat = record.latE7 / kCoordScale;
+                double lon = record.lonE7 / kCoordScale;
+                if (std::abs(lat - latitude) > dLat || std::abs(lon - longitude) > dLon ||
+                    distanceMeters(latitude, longitude, lat, lon) > radiusMeters) {
+                    continue;
+                }
+                OSMPoiView poi(this, &record);
+                addCounts(counts, OSMAreaStats::classify([&poi](std::string_view key) {
+                    return poi.tag(key);
+                }));
+            }
+        }
+    }
+    return counts;
+}
+
+// ============================================================================
+// OSMPoiView
+// ============================================================================
+
+static const StoreRecord& recordOf(const void* record) {
+    return *static_cast<const StoreRecord*>(record);
+}
+
+int64_t OSMPoiView::osmId() const {
+    return recordOf(record_).osmId;
+}
+
+const char* OSMPoiView::osmType() const {
+    return recordOf(record_).type == 1 ? "way" : "node";
+}
+
+double OSMPoiView::latitude() const {
+    return recordOf(record_).latE7 / kCoordScale;
+}
+
+double OSMPoiView::longitude() const {
+    return recordOf(record_).lonE7 / kCoordScale;
+}
+
+std::string_view OSMPoiView::tag(std::string_view key) const {
+    const StoreRecord& record = recordOf(record_);
+    const StoreTag* tag = store_->tags_ + record.firstTag;
+    for (uint16_t i = 0; i < record.tagCount; ++i, ++tag) {
+        if (key == store_->pool_ + tag->key) {
+            return store_->pool_ + tag->value;
+        }
+    }
+    return std::string_view();
+}
+
+OSMPoi OSMPoiView::toPoi() const {
+    const StoreRecord& record = recordOf(record_);
+    OSMPoi poi;
+    poi.osmId = record.osmId;
+    poi.osmType = osmType();
+    poi.latitude = latitude();
+    poi.longitude = longitude();
+
+    const StoreTag* tag = store_->tags_ + record.firstTag;
+    for (uint16_t i = 0; i < record.tagCount; ++i, ++tag) {
+        poi.tags.set(store_->pool_ + tag->key, store_->pool_ + tag->value);
+    }
+    poi.tags.shrinkToFit();
+    return poi;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
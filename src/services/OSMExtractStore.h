@@ -0,0 +1,176 @@
+#ifndef OSM_EXTRACT_STORE_H
+#define OSM_EXTRACT_STORE_H
+
+#include "OpenStreetMapAPI.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace FranchiseAI {
+namespace Services {
+
+class OSMExtractStore;
+
+// Store file structures (defined in OSMExtractStore.cpp)
+struct StoreHeader;
+struct StoreRecord;
+struct StoreTag;
+struct StoreCellCounts;
+
+/**
+ * @brief One POI inside an OSMExtractStore, read in place from the mapping
+ *
+ * Only valid while the store it came from is alive.
+ */
+class OSMPoiView {
+public:
+    int64_t osmId() const;
+    const char* osmType() const;         // "node" or "way"
+    double latitude() const;
+    double longitude() const;
+
+    /**
+     * @brief Value of a tag, or an empty view if the POI does not have it
+     */
+    std::string_view tag(std::string_view key) const;
+    bool hasTag(std::string_view key) const { return !tag(key).empty(); }
+    bool hasTag(std::string_view key, std::string_view value) const { return tag(key) == value; }
+
+    /**
+     * @brief Copy into an OSMPoi (id, type, coordinates and tags)
+     */
+    OSMPoi toPoi() const;
+
+private:
+    friend class OSMExtractStore;
+    OSMPoiView(const OSMExtractStore* store, const void* record)
+        : store_(store), record_(record) {}
+
+    const OSMExtractStore* store_;
+    const void* record_;
+};
+
+/**
+ * @brief Read-only POI store imported from an OpenStreetMap .osm.pbf extract
+ *
+ * importPbf() reads a PBF extract once and keeps only elements a search
+ * or area statistic can match (offices, hotels, amenities, shops, ...)
+ * with the tags OSMPoi uses. Ways are reduced to the center of their
+ * bounding box, as Overpass "out center" does. The result is written as a
+ * single file: POI records bucketed into a fixed lat/lon grid, a tag
+ * table, a deduplicated string pool and the area statistic counts of
+ * each grid cell.
+ *
+ * open() memory-maps that file; nothing is parsed or copied at load, and
+ * a radius query visits only the grid cells overlapping its bounding box.
+ * Stores are shared per path, so every OpenStreetMapAPI instance in the
+ * process reads the same mapping. A store is immutable once open and may
+ * be queried from any thread.
+ */
+class OSMExtractStore {
+public:
+    ~OSMExtractStore();
+
+    // Non-copyable
+    OSMExtractStore(const OSMExtractStore&) = delete;
+    OSMExtractStore& operator=(const OSMExtractStore&) = delete;
+
+    /**
+     * @brief Build a store file from an .osm.pbf extract
+     * @param pbfPath Extract to import (e.g. from download.geofabrik.de)
+     * @param storePath Output file; replaced atomically on success
+     * @param error Set when the import fails
+     * @return true on success
+     */
+    static bool importPbf(const std::string& pbfPath, const std::string& storePath,
+                          std::string& error);
+
+    /**
+     * @brief Map a store file, reusing an existing mapping of the same path
+     * @return nullptr (and error set) if the file is missing or invalid
+     */
+    static std::shared_ptr<const OSMExtractStore> open(const std::string& storePath,
+                                                       std::string* error = nullptr);
+
+    /**
+     * @brief open(), starting a background import of pbfPath if the store does not exist yet
+     * @param importing Set while the import is queued or running; call again
+     *                  later to pick up the store
+     *
+     * Never waits for an import and does no I/O while one runs. Each store
+     * path is imported at most once; a failed import is remembered and only
+     * retried once the .osm.pbf file changes.
+     */
+    static std::shared_ptr<const OSMExtractStore> openOrStartImport(const std::string& storePath,
+                                                                    const std::string& pbfPath,
+                                                                    std::string* error = nullptr,
+                                                                    bool* importing = nullptr);
+
+    /**
+     * @brief openOrStartImport(), then wait for the import to finish
+     *
+     * Blocks for as long as the import takes; for background tasks only.
+     * Concurrent callers wait for a single import instead of each running one.
+     */
+    static std::shared_ptr<const OSMExtractStore> openOrImport(const std::string& storePath,
+                                                               const std::string& pbfPath,
+                                                               std::string* error = nullptr);
+
+    /**
+     * @brief Whether the circle lies entirely inside the imported extract
+     */
+    bool covers(double latitude, double longitude, double radiusMeters) const;
+
+    /**
+     * @brief Area the extract covers
+     */
+    Models::GeoBoundingBox bounds() const;
+
+    /**
+     * @brief Call fn(const OSMPoiView&) for every POI within the radius
+     */
+    void forEachWithin(double latitude, double longitude, double radiusMeters,
+                       const std::function<void(const OSMPoiView&)>& fn) const;
+
+    /**
+     * @brief Number of POIs within the radius for each area statistic
+     *
+     * Grid cells entirely inside the circle are read from counts computed
+     * at import; only the POIs of cells on its edge are visited.
+     */
+    OSMAreaCounts countWithin(double latitude, double longitude, double radiusMeters) const;
+
+    /**
+     * @brief Number of POIs in the store
+     */
+    size_t size() const;
+
+    /**
+     * @brief Grid cell edge length in degrees
+     */
+    static constexpr double kCellDegrees = 0.01;
+
+private:
+    friend class OSMPoiView;
+    OSMExtractStore() = default;
+
+    bool map(const std::string& storePath, std::string& error);
+
+    const void* data_ = nullptr;
+    size_t size_ = 0;
+
+    // Views into the mapping, set by map()
+    const StoreHeader* header_ = nullptr;
+    const uint32_t* cellStart_ = nullptr;
+    const StoreRecord* records_ = nullptr;
+    const StoreTag* tags_ = nullptr;
+    const char* pool_ = nullptr;
+    const StoreCellCounts* cellCounts_ = nullptr;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // OSM_EXTRACT_STORE_H
@@ -0,0 +1,440 @@
+#include "OSMPoiIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+namespace FranchiseAI {
+namespace Services {
+
+static const double kTilesPerSide = static_cast<double>(1 << OSMPoiIndex::kZoom);
+
+// Web Mercator latitude limit; tiles do not extend past it
+static const double kMaxLatitude = 85.0511287798;
+
+// Degrees of latitude/longitude spanned by a distance around a latitude
+static double latDegrees(double meters) {
+    return meters / 111320.0;
+}
+
+static double lonDegrees(double meters, double latitude) {
+    double scale = std::cos(latitude * M_PI / 180.0);
+    return meters / (111320.0 * std::max(scale, 0.01));
+}
+
+static double distanceMeters(double lat1, double lon1, double lat2, double lon2) {
+    const double earthRadius = 6371000.0;
+    double dLat = (lat2 - lat1) * M_PI / 180.0;
+    double dLon = (lon2 - lon1) * M_PI / 180.0;
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+               std::cos(lat1 * M_PI / 180.0) * std::cos(lat2 * M_PI / 180.0) *
+               std::sin(dLon / 2) * std::sin(dLon / 2);
+    return earthRadius * 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+}
+
+static int32_t clampTile(double index) {
+    return static_cast<int32_t>(std::max(0.0, std::min(std::floor(index), kTilesPerSide - 1)));
+}
+
+static int32_t tileX(double longitude) {
+    return clampTile((longitude + 180.0) / 360.0 * kTilesPerSide);
+}
+
+static int32_t tileY(double latitude) {
+    double lat = std::max(-kMaxLatitude, std::min(latitude, kMaxLatitude)) * M_PI / 180.0;
+    return clampTile((1.0 - std::asinh(std::tan(lat)) / M_PI) / 2.0 * kTilesPerSide);
+}
+
+static double tileLongitude(int32_t x) {
+    return x / kTilesPerSide * 360.0 - 180.0;
+}
+
+static double tileLatitude(int32_t y) {
+    return std::atan(std::sinh(M_PI * (1.0 - 2.0 * y / kTilesPerSide))) * 180.0 / M_PI;
+}
+
+// Identity of an OSM element across tiles (ids are only unique per type)
+static int64_t elementKey(const OSMPoi& poi) {
+    int64_t type = poi.osmType == "way" ? 1 : poi.osmType == "relation" ? 2 : 0;
+    return (poi.osmId << 2) | type;
+}
+
+double OSMPoiIndex::Tile::south() const { return tileLatitude(y + 1); }
+double OSMPoiIndex::Tile::north() const { return tileLatitude(y); }
+double OSMPoiIndex::Tile::west() const { return tileLongitude(x); }
+double OSMPoiIndex::Tile::east() const { return tileLongitude(x + 1); }
+
+// Bytes held by the POIs of a tile (interned tag strings are shared and not counted)
+static size_t weighTile(const std::vector<OSMPoi>& pois) {
+    size_t bytes = sizeof(std::vector<OSMPoi>) + pois.capacity() * sizeof(OSMPoi);
+    for (const auto& poi : pois) {
+        bytes += heapBytes(poi.osmType) + poi.tags.heapBytes();
+    }
+    return bytes;
+}
+
+// Tiles in the on-disk cache; bump the encoding when the layout changes
+static const char kTileKeyPrefix[] = "osm:tile:";
+static const uint8_t kTileEncoding = 1;
+
+static std::string encodeTile(const std::vector<OSMPoi>& pois) {
+    ByteWriter writer;
+    writer.put(kTileEncoding);
+    writer.put(static_cast<uint32_t>(pois.size()));
+    for (const auto& poi : pois) {
+        writer.put(poi.osmId);
+        writer.putString(poi.osmType);
+        writer.put(poi.latitude);
+        writer.put(poi.longitude);
+        writer.put(static_cast<uint32_t>(poi.tags.size()));
+        poi.tags.forEach([&writer](std::string_view key, std::string_view value) {
+            writer.putString(key.data(), key.size());
+            writer.putString(value.data(), value.size());
+        });
+    }
+    return std::move(writer.bytes());
+}
+
+static bool decodeTile(const std::string& bytes, std::vector<OSMPoi>& pois) {
+    ByteReader reader(bytes);
+    if (reader.get<uint8_t>() != kTileEncoding) {
+        return false;
+    }
+    uint32_t count = reader.get<uint32_t>();
+    pois.clear();
+    while (reader.ok() && pois.size() < count) {
+        OSMPoi poi;
+        poi.osmId = reader.get<int64_t>();
+        poi.osmType = reader.getString();
+        poi.latitude = reader.get<double>();
+        poi.longitude = reader.get<double>();
+        uint32_t tagCount = reader.get<uint32_t>();
+        for (uint32_t i = 0; i < tagCount && reader.ok(); ++i) {
+            std::string key = reader.getString();
+            std::string value = reader.getString();
+            poi.tags.set(key, value);
+        }
+        poi.tags.shrinkToFit();
+        pois.push_back(std::move(poi));
+    }
+    return reader.ok() && reader.atEnd();
+}
+
+OSMPoiIndex::OSMPoiIndex(size_t maxBytes)
+    : tiles_(maxBytes,
+             [](const int64_t&, const CachedTile& tile) {
+                 return tile.pois ? weighTile(*tile.pois) : 0;
+             },
+             &stats_) {}
+
+std::shared_ptr<OSMPoiIndex> OSMPoiIndex::shared() {
+    static std::shared_ptr<OSMPoiIndex> instance = std::make_shared<OSMPoiIndex>();
+    return instance;
+}
+
+void OSMPoiIndex::reserveBytes(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (maxBytes > tiles_.maxBytes()) {
+        tiles_.setMaxBytes(maxBytes);
+    }
+}
+
+void OSMPoiIndex::persistTo(std::shared_ptr<PersistentCache> store) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    store_ = std::move(store);
+}
+
+OSMPoiIndex::RestoredTiles OSMPoiIndex::restore(const TileRange& range, int lifetimeSeconds) {
+    RestoredTiles restored;
+    std::shared_ptr<PersistentCache> store;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        store = store_;
+    }
+    if (!store || lifetimeSeconds <= 0) {
+        return restored;
+    }
+
+    // Read and decoded without mutex_; claim() only uses a tile that is
+    // still missing from memory once it holds the lock
+    time_t now = std::time(nullptr);
+    for (int32_t y = range.yMin; y <= range.yMax; ++y) {
+        for (int32_t x = range.xMin; x <= range.xMax; ++x) {
+            int64_t key = tileKey(x, y);
+            CachedTile tile;
+            std::string bytes;
+            time_t storedAt = 0;
+            if (tiles_.peek(key, tile) ||
+                !store->get(kTileKeyPrefix + std::to_string(key), bytes, storedAt) ||
+                now - storedAt >= lifetimeSeconds) {
+                continue;
+            }
+
+            auto pois = std::make_shared<std::vector<OSMPoi>>();
+            if (!decodeTile(bytes, *pois)) {
+                continue;
+            }
+            tile.pois = std::move(pois);
+            tile.fetchedAt = storedAt;
+            restored.emplace(key, std::move(tile));
+        }
+    }
+    return restored;
+}
+
+bool OSMPoiIndex::adoptLocked(int64_t key, RestoredTiles& restored, CachedTile& tile) {
+    auto it = restored.find(key);
+    if (it == restored.end()) {
+        return false;
+    }
+    tile = std::move(it->second);
+    tiles_.put(key, tile, tile.fetchedAt + lifetimeSeconds_);
+    stats_.diskHits++;
+    return true;
+}
+
+OSMPoiIndex::TileRange OSMPoiIndex::tilesAround(double latitude, double longitude,
+                                                double radiusMeters) {
+    double dLat = latDegrees(radiusMeters);
+    double dLon = lonDegrees(radiusMeters, latitude);
+
+    // Tile rows count down from the north
+    TileRange range;
+    range.xMin = tileX(longitude - dLon);
+    range.xMax = tileX(longitude + dLon);
+    range.yMin = tileY(latitude + dLat);
+    range.yMax = tileY(latitude - dLat);
+    return range;
+}
+
+OSMPoiIndex::Tile OSMPoiIndex::tileAt(double latitude, double longitude) {
+    return Tile{tileX(longitude), tileY(latitude)};
+}
+
+std::vector<OSMPoiIndex::TileRange> OSMPoiIndex::coalesce(const std::vector<Tile>& tiles,
+                                                          size_t maxTiles) {
+    maxTiles = std::max<size_t>(1, maxTiles);
+    std::vector<int64_t> keys;
+    keys.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        keys.push_back(tileKey(tile.x, tile.y));
+    }
+    std::unordered_set<int64_t> open(keys.begin(), keys.end());
+
+    // Row by row from the north-west: run east as far as the tiles go,
+    // then extend the run south while every tile of the next row is there
+    std::sort(keys.begin(), keys.end(), [](int64_t a, int64_t b) {
+        int32_t ya = static_cast<int32_t>(a & 0xFFFFFFFF), yb = static_cast<int32_t>(b & 0xFFFFFFFF);
+        return ya != yb ? ya < yb : (a >> 32) < (b >> 32);
+    });
+
+    std::vector<TileRange> ranges;
+    for (int64_t key : keys) {
+        if (!open.count(key)) {
+            continue;
+        }
+        TileRange range;
+        range.xMin = range.xMax = static_cast<int32_t>(key >> 32);
+        range.yMin = range.yMax = static_cast<int32_t>(key & 0xFFFFFFFF);
+        open.erase(key);
+
+        while (range.tileCount() < maxTiles && open.count(tileKey(range.xMax + 1, range.yMin))) {
+            open.erase(tileKey(++range.xMax, range.yMin));
+        }
+        size_t width = static_cast<size_t>(range.xMax - range.xMin + 1);
+        while (range.tileCount() + width <= maxTiles) {
+            int32_t y = range.yMax + 1;
+            bool full = true;
+            for (int32_t x = range.xMin; x <= range.xMax && full; ++x) {
+                full = open.count(tileKey(x, y)) > 0;
+            }
+            if (!full) {
+                break;
+            }
+            for (int32_t x = range.xMin; x <= range.xMax; ++x) {
+                open.erase(tileKey(x, y));
+            }
+            range.yMax = y;
+        }
+        ranges.push_back(range);
+    }
+    return ranges;
+}
+
+OSMPoiIndex::TileClaim OSMPoiIndex::claim(const TileRange& range, const Policy& policy) {
+    TileClaim claim;
+    time_t now = std::time(nullptr);
+    int hits = 0;
+    int stale = 0;
+    int lifetimeSeconds = policy.maxAgeSeconds + policy.staleSeconds;
+    RestoredTiles restored = restore(range, lifetimeSeconds);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        negativeSeconds_ = policy.negativeSeconds;
+        lifetimeSeconds_ = lifetimeSeconds;
+
+        for (int32_t y = range.yMin; y <= range.yMax; ++y) {
+            for (int32_t x = range.xMin; x <= range.xMax; ++x) {
+                int64_t key = tileKey(x, y);
+                CachedTile tile;
+                bool cached = tiles_.get(key, tile) ||
+                              (claims_.find(key) == claims_.end() && adoptLocked(key, restored, tile));
+                time_t age = cached ? now - tile.fetchedAt : 0;
+
+                auto failed = failedAt_.find(key);
+                bool failedRecently = failed != failedAt_.end() &&
+                                      now - failed->second < policy.negativeSeconds;
+                if (failed != failedAt_.end() && !failedRecently) {
+                    failedAt_.erase(failed);
+                }
+
+                if (cached && age < policy.maxAgeSeconds) {
+                    ++hits;
+                    claim.cached.push_back(std::move(tile.pois));
+                } else if (cached && age < lifetimeSeconds_) {
+                    // Served as it is; one caller refetches it in the background
+                    ++stale;
+                    claim.cached.push_back(std::move(tile.pois));
+                    if (!failedRecently && claims_.find(key) == claims_.end()) {
+                        claimLocked(key);
+                        claim.refresh.push_back(Tile{x, y});
+                    }
+                } else if (claims_.find(key) != claims_.end()) {
+                    claim.pending.push_back(claims_[key].ready);
+                } else if (failedRecently) {
+                    ++claim.failed;
+                } else {
+                    claimLocked(key);
+                    claim.fetch.push_back(Tile{x, y});
+                }
+            }
+        }
+    }
+
+    stats_.tileHits += hits + stale + claim.failed;
+    stats_.tileMisses += static_cast<int>(claim.fetch.size() + claim.pending.size());
+    stats_.staleHits += stale;
+    stats_.negativeHits += claim.failed;
+    stats_.coalesced += static_cast<int>(claim.pending.size());
+    return claim;
+}
+
+void OSMPoiIndex::claimLocked(int64_t key) {
+    Claim& claim = claims_[key];
+    claim.ready = claim.done.get_future().share();
+}
+
+void OSMPoiIndex::releaseLocked(int64_t key, OSMPoiList pois) {
+    auto it = claims_.find(key);
+    if (it != claims_.end()) {
+        it->second.done.set_value(std::move(pois));
+        claims_.erase(it);
+    }
+}
+
+OSMPoiList OSMPoiIndex::insert(const Tile& tile, std::vector<OSMPoi> pois) {
+    CachedTile fetched;
+    fetched.pois = std::make_shared<const std::vector<OSMPoi>>(std::move(pois));
+    fetched.fetchedAt = std::time(nullptr);
+    stats_.tilesFetched++;
+
+    int64_t key = tileKey(tile.x, tile.y);
+    time_t expiresAt = 0;
+    std::shared_ptr<PersistentCache> store;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expiresAt = lifetimeSeconds_ > 0 ? fetched.fetchedAt + lifetimeSeconds_ : 0;
+        if (expiresAt != 0) {
+            store = store_;
+        }
+        tiles_.put(key, fetched, expiresAt);
+        failedAt_.erase(key);
+        releaseLocked(key, fetched.pois);
+    }
+
+    // The list is immutable once shared, so it is encoded and written
+    // without holding mutex_
+    if (store) {
+        store->put(kTileKeyPrefix + std::to_string(key), encodeTile(*fetched.pois),
+                   fetched.fetchedAt, expiresAt);
+    }
+    return fetched.pois;
+}
+
+void OSMPoiIndex::fail(const Tile& tile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t key = tileKey(tile.x, tile.y);
+    releaseLocked(key, nullptr);
+    if (negativeSeconds_ <= 0) {
+        return;
+    }
+
+    time_t now = std::time(nullptr);
+    if (failedAt_.size() >= kMaxFailedTiles) {
+        // Only failures within the negative TTL matter
+        for (auto it = failedAt_.begin(); it != failedAt_.end();) {
+            it = now - it->second >= negativeSeconds_ ? failedAt_.erase(it) : std::next(it);
+        }
+    }
+    failedAt_[key] = now;
+}
+
+void OSMPoiIndex::release(const Tile& tile, OSMPoiList pois) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releaseLocked(tileKey(tile.x, tile.y), std::move(pois));
+}
+
+std::vector<OSMPoi> OSMPoiIndex::nearestWithin(double latitude, double longitude,
+                                               double radiusMeters, size_t maxResults,
+                                               const std::vector<OSMPoiList>& tiles) {
+    std::vector<std::pair<double, const OSMPoi*>> matches;
+    std::unordered_set<int64_t> seen;
+
+    for (const auto& pois : tiles) {
+        if (!pois) {
+            continue;
+        }
+        for (const auto& poi : *pois) {
+            double distance = distanceMeters(latitude, longitude, poi.latitude, poi.longitude);
+            if (distance <= radiusMeters && seen.insert(elementKey(poi)).second) {
+                matches.emplace_back(distance, &poi);
+            }
+        }
+    }
+
+    // Only the selected POIs are copied
+    size_t limit = std::min(matches.size(), maxResults);
+    std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<OSMPoi> pois;
+    pois.reserve(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        pois.push_back(*matches[i].second);
+    }
+    return pois;
+}
+
+void OSMPoiIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tiles_.clear();
+    failedAt_.clear();
+    if (store_) {
+        store_->eraseAll(kTileKeyPrefix);
+    }
+}
+
+size_t OSMPoiIndex::tileCount() const {
+    return tiles_.size();
+}
+
+size_t OSMPoiIndex::poiCount() const {
+    size_t count = 0;
+    tiles_.forEach([&count](const int64_t&, const CachedTile& tile) {
+        count += tile.pois ? tile.pois->size() : 0;
+    });
+    return count;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
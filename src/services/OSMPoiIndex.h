@@ -0,0 +1,260 @@
+#ifndef OSM_POI_INDEX_H
+#define OSM_POI_INDEX_H
+
+#include "OpenStreetMapAPI.h"
+#include "PersistentCache.h"
+#include "ShardedCache.h"
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Tile hit/miss counters for OSMPoiIndex, plus the size of its storage
+ */
+struct OSMTileCacheStats : ShardedCacheStats {
+    std::atomic<int> tileHits{0};       // Tiles a search found already fetched
+    std::atomic<int> tileMisses{0};     // Tiles a search had to fetch
+    std::atomic<int> tilesFetched{0};   // Tiles stored from a complete response
+    std::atomic<int> staleHits{0};      // Expired tiles served while refetched in the background
+    std::atomic<int> negativeHits{0};   // Tiles skipped because their last fetch failed recently
+    std::atomic<int> coalesced{0};      // Tiles a search waited for while another fetched them
+    std::atomic<int> diskHits{0};       // Tiles restored from the on-disk cache
+
+    double getTileHitRate() const {
+        int total = tileHits.load() + tileMisses.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(tileHits.load()) / total;
+    }
+
+    void reset() {
+        tileHits = 0;
+        tileMisses = 0;
+        tilesFetched = 0;
+        staleHits = 0;
+        negativeHits = 0;
+        coalesced = 0;
+        diskHits = 0;
+        resetCounters();
+    }
+};
+
+/**
+ * @brief In-memory POI cache keyed by zoom-14 map tiles
+ *
+ * Search areas are decomposed into the standard web-map quadtiles at
+ * zoom 14 (about 2.4 km at the equator, 1.8 km across at US latitudes).
+ * Each tile holds the complete response of one Overpass query over its
+ * bounds together with the time it was fetched, so a search only fetches
+ * the tiles of its area that are missing, and overlapping searches -
+ * a moved pin, a narrower radius, another franchisee in the same metro -
+ * reuse the tiles already there.
+ *
+ * A way crossing a tile edge is returned for both tiles; lookups merge
+ * tiles and drop duplicates by OSM type and id.
+ *
+ * claim() applies the same policy as ApiCache: an expired tile is still
+ * served for a while and refetched once in the background, a tile whose
+ * fetch failed is not retried for a short time, and a tile is fetched by
+ * one search at a time while the others wait for it.
+ *
+ * Tiles are kept in a ShardedCache bounded by a memory budget: tiles read
+ * by many searches outlive tiles fetched once. A tile's POIs are shared
+ * and immutable, so a search holds the lists it claimed and merges them
+ * even if the tiles are evicted in the meantime.
+ *
+ * With persistTo(), fetched tiles are also written to a PersistentCache
+ * and a tile missing from memory is looked up there, so tiles survive a
+ * restart.
+ *
+ * shared() is the process-wide instance used by every OpenStreetMapAPI.
+ * Safe to use from any thread.
+ */
+class OSMPoiIndex {
+public:
+    struct Tile {
+        int32_t x = 0;
+        int32_t y = 0;
+
+        // Bounds in degrees
+        double south() const;
+        double north() const;
+        double west() const;
+        double east() const;
+    };
+
+    /**
+     * @brief Inclusive rectangle of tiles
+     */
+    struct TileRange {
+        int32_t xMin = 0;
+        int32_t xMax = -1;
+        int32_t yMin = 0;
+        int32_t yMax = -1;
+
+        size_t tileCount() const {
+            if (xMax < xMin || yMax < yMin) return 0;
+            return static_cast<size_t>(xMax - xMin + 1) * static_cast<size_t>(yMax - yMin + 1);
+        }
+
+        // Bounds in degrees
+        double south() const { return Tile{xMin, yMax}.south(); }
+        double north() const { return Tile{xMin, yMin}.north(); }
+        double west() const { return Tile{xMin, yMin}.west(); }
+        double east() const { return Tile{xMax, yMin}.east(); }
+    };
+
+    /**
+     * @brief Tiles of a range that a search has to fetch, refresh or wait for
+     */
+    struct TileClaim {
+        std::vector<OSMPoiList> cached; // Fresh and stale tiles
+        std::vector<Tile> fetch;        // Missing or expired: the caller fetches each, then insert() or fail()
+        std::vector<Tile> refresh;      // Stale but served: the caller refetches each in the background
+        std::vector<std::shared_future<OSMPoiList>> pending;  // Tiles another caller is fetching (nullptr if it failed)
+        int failed = 0;                 // Tiles skipped because their last fetch failed recently
+    };
+
+    /**
+     * @brief Ages at which claim() fetches, refreshes or skips a tile
+     */
+    struct Policy {
+        int maxAgeSeconds = 0;          // Tiles are fresh this long
+        int staleSeconds = 0;           // Then served while refreshed in the background
+        int negativeSeconds = 0;        // A failed tile is not fetched again for this long
+    };
+
+    static constexpr int kZoom = 14;
+
+    /**
+     * @param maxBytes Memory budget of the cached tiles
+     */
+    explicit OSMPoiIndex(size_t maxBytes = 256u << 20);
+
+    /**
+     * @brief Process-wide tile cache
+     */
+    static std::shared_ptr<OSMPoiIndex> shared();
+
+    /**
+     * @brief Raise the memory budget (it is never lowered below the current one)
+     */
+    void reserveBytes(size_t maxBytes);
+
+    /**
+     * @brief Keep fetched tiles in store as well (nullptr = memory only)
+     */
+    void persistTo(std::shared_ptr<PersistentCache> store);
+
+    /**
+     * @brief Tiles overlapping the bounding box of a circle
+     */
+    static TileRange tilesAround(double latitude, double longitude, double radiusMeters);
+
+    /**
+     * @brief Tile containing a point
+     */
+    static Tile tileAt(double latitude, double longitude);
+
+    /**
+     * @brief Cover a set of tiles with rectangles of adjacent tiles
+     *
+     * Each tile ends up in exactly one rectangle of at most maxTiles
+     * tiles, so neighbouring tiles can be fetched by one bbox query.
+     */
+    static std::vector<TileRange> coalesce(const std::vector<Tile>& tiles, size_t maxTiles);
+
+    /**
+     * @brief Claim the tiles of a range that need fetching
+     *
+     * Every tile in fetch or refresh is claimed by the caller until it
+     * calls insert(), fail() or release() for it; other callers get its
+     * future in pending instead of fetching it again. Counts each tile of
+     * the range as a hit (fresh, stale or failed recently) or a miss.
+     */
+    TileClaim claim(const TileRange& range, const Policy& policy);
+
+    /**
+     * @brief Store the complete response of a query over one tile
+     *
+     * Releases a claim on the tile.
+     * @return The stored list, also valid if the cache did not admit it
+     */
+    OSMPoiList insert(const Tile& tile, std::vector<OSMPoi> pois);
+
+    /**
+     * @brief Record that fetching a claimed tile failed, and release the claim
+     *
+     * A stale copy of the tile is kept.
+     */
+    void fail(const Tile& tile);
+
+    /**
+     * @brief Release a claimed tile without storing it (e.g. a truncated response)
+     * @param pois Passed on to callers waiting for the tile
+     */
+    void release(const Tile& tile, OSMPoiList pois = nullptr);
+
+    /**
+     * @brief Copies of the POIs of some tiles within the radius, nearest first
+     *
+     * Tiles are merged and POIs seen in more than one tile returned once.
+     */
+    static std::vector<OSMPoi> nearestWithin(double latitude, double longitude, double radiusMeters,
+                                             size_t maxResults,
+                                             const std::vector<OSMPoiList>& tiles);
+
+    void clear();
+    size_t tileCount() const;
+    size_t poiCount() const;
+
+    const OSMTileCacheStats& getStats() const { return stats_; }
+    void resetStats() { stats_.reset(); }
+
+private:
+    struct CachedTile {
+        OSMPoiList pois;
+        time_t fetchedAt = 0;
+    };
+
+    struct Claim {
+        std::promise<OSMPoiList> done;
+        std::shared_future<OSMPoiList> ready;
+    };
+
+    // Failures remembered at most; older ones are pruned first
+    static constexpr size_t kMaxFailedTiles = 4096;
+
+    static int64_t tileKey(int32_t x, int32_t y) {
+        return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+    }
+
+    // Tiles of a range read back from the store, by key
+    using RestoredTiles = std::unordered_map<int64_t, CachedTile>;
+    RestoredTiles restore(const TileRange& range, int lifetimeSeconds);
+    bool adoptLocked(int64_t key, RestoredTiles& restored, CachedTile& tile);
+    void claimLocked(int64_t key);
+    void releaseLocked(int64_t key, OSMPoiList pois);
+
+    OSMTileCacheStats stats_;
+    ShardedCache<int64_t, CachedTile> tiles_;
+    std::unordered_map<int64_t, Claim> claims_;         // Tiles being fetched
+    std::unordered_map<int64_t, time_t> failedAt_;      // Tiles whose last fetch failed
+    std::shared_ptr<PersistentCache> store_;
+    int lifetimeSeconds_ = 0;                           // Tiles are dropped this long after fetching
+    int negativeSeconds_ = 0;
+    mutable std::mutex mutex_;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // OSM_POI_INDEX_H
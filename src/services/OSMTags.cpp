@@ -0,0 +1,362 @@
+#include "OSMTags.h"
+#include <algorithm>
+#include <cstring>
+
+namespace FranchiseAI {
+namespace Services {
+
+struct WellKnownKey {
+    std::string_view key;
+    bool internValues;      // Small vocabulary shared by many POIs
+};
+
+// Interned first, at ids 0..N-1. The first rows are OSMKey in order.
+static constexpr WellKnownKey kWellKnownKeys[] = {
+    {"name", false},
+    {"amenity", true},
+    {"building", true},
+    {"office", true},
+    {"shop", true},
+    {"tourism", true},
+    {"healthcare", true},
+    {"addr:street", false},
+    {"addr:housenumber", false},
+    {"addr:city", true},
+    {"addr:postcode", true},
+    {"addr:state", true},
+    {"addr:country", true},
+    {"phone", false},
+    {"website", false},
+    {"email", false},
+    {"opening_hours", false},
+    // Read by the category filters and the extract import
+    {"landuse", true},
+    {"highway", true},
+    {"railway", true},
+    {"leisure", true},
+    {"cuisine", true},
+};
+
+static constexpr uint32_t kWellKnownKeyCount =
+    static_cast<uint32_t>(sizeof(kWellKnownKeys) / sizeof(kWellKnownKeys[0]));
+
+static_assert(kWellKnownKeys[static_cast<uint32_t>(OSMKey::OpeningHours)].key == "opening_hours",
+              "OSMKey must match the start of kWellKnownKeys");
+
+// ============================================================================
+// OSMStringInterner
+// ============================================================================
+
+OSMStringInterner& OSMStringInterner::instance() {
+    static OSMStringInterner interner;
+    return interner;
+}
+
+OSMStringInterner::OSMStringInterner() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& wellKnown : kWellKnownKeys) {
+        internLocked(wellKnown.key);
+    }
+}
+
+uint32_t OSMStringInterner::intern(std::string_view text) {
+    uint32_t id = find(text);
+    if (id != kNotFound) {
+        return id;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return internLocked(text);
+}
+
+uint32_t OSMStringInterner::find(std::string_view text) const {
+    // The well-known keys are most lookups and need no lock
+    for (uint32_t id = 0; id < kWellKnownKeyCount; ++id) {
+        if (kWellKnownKeys[id].key == text) {
+            return id;
+        }
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(text);
+    return it == ids_.end() ? kNotFound : it->second;
+}
+
+uint32_t OSMStringInterner::internLocked(std::string_view text) {
+    auto it = ids_.find(text);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    uint32_t id = count_.load(std::memory_order_relaxed);
+    if (id >= kChunkSize * kMaxChunks) {
+        return kNotFound;
+    }
+    if (id % kChunkSize == 0) {
+        chunkStorage_.push_back(std::make_unique<std::string_view[]>(kChunkSize));
+        chunks_[id / kChunkSize].store(chunkStorage_.back().get(), std::memory_order_release);
+    }
+
+    std::string_view stored(storeLocked(text), text.size());
+    chunks_[id / kChunkSize].load(std::memory_order_relaxed)[id % kChunkSize] = stored;
+    ids_.emplace(stored, id);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const char* OSMStringInterner::storeLocked(std::string_view text) {
+    if (text.size() > kArenaBlockSize / 4) {
+        // Long strings get their own block; the last block stays the open one
+        arena_.insert(arena_.begin(), std::make_unique<char[]>(text.size()));
+        arenaBytes_ += text.size();
+        std::memcpy(arena_.front().get(), text.data(), text.size());
+        return arena_.front().get();
+    }
+    if (arenaUsed_ + text.size() > kArenaBlockSize) {
+        arena_.push_back(std::make_unique<char[]>(kArenaBlockSize));
+        arenaUsed_ = 0;
+        arenaBytes_ += kArenaBlockSize;
+    }
+    char* out = arena_.back().get() + arenaUsed_;
+    std::memcpy(out, text.data(), text.size());
+    arenaUsed_ += text.size();
+    return out;
+}
+
+bool OSMStringInterner::internsValuesOf(uint32_t keyId) const {
+    return keyId < kWellKnownKeyCount && kWellKnownKeys[keyId].internValues &&
+           count_.load(std::memory_order_relaxed) < kMaxInternedValues;
+}
+
+size_t OSMStringInterner::size() const {
+    return count_.load(std::memory_order_acquire);
+}
+
+size_t OSMStringInterner::memoryBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    // Node, bucket and chunk sizes of the index
+    size_t indexBytes = ids_.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*)) +
+                        ids_.bucket_count() * sizeof(void*);
+    return arenaBytes_ + indexBytes + chunkStorage_.size() * kChunkSize * sizeof(std::string_view);
+}
+
+// ============================================================================
+// OSMTagList
+// ============================================================================
+
+OSMTagList::OSMTagList(const OSMTagList& other) : heap_(nullptr) {
+    *this = other;
+}
+
+OSMTagList::OSMTagList(OSMTagList&& other) noexcept : heap_(nullptr) {
+    *this = std::move(other);
+}
+
+OSMTagList& OSMTagList::operator=(const OSMTagList& other) {
+    if (this == &other) {
+        return *this;
+    }
+    size_ = 0;
+    if (other.size_ > capacity_) {
+        reallocate(other.size_);
+    }
+    std::copy(other.data(), other.data() + other.size_, data());
+    size_ = other.size_;
+    text_ = other.text_;
+    return *this;
+}
+
+OSMTagList& OSMTagList::operator=(OSMTagList&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (capacity_ > kInlineTags) {
+        delete[] heap_;
+    }
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    if (other.capacity_ > kInlineTags) {
+        heap_ = other.heap_;
+    } else {
+        std::copy(other.inline_, other.inline_ + other.size_, inline_);
+    }
+    text_ = std::move(other.text_);
+
+    other.size_ = 0;
+    other.capacity_ = kInlineTags;
+    other.text_.clear();
+    return *this;
+}
+
+OSMTagList::~OSMTagList() {
+    if (capacity_ > kInlineTags) {
+        delete[] heap_;
+    }
+}
+
+std::string_view OSMTagList::get(std::string_view key) const {
+    uint32_t keyId = OSMStringInterner::instance().find(key);
+    // A key never interned is a key no POI has
+    return keyId == OSMStringInterner::kNotFound ? std::string_view() : get(keyId);
+}
+
+std::string_view OSMTagList::get(uint32_t keyId) const {
+    const Tag* begin = data();
+    const Tag* end = begin + size_;
+    const Tag* tag = std::lower_bound(begin, end, keyId,
+        [](const Tag& t, uint32_t id) { return t.key < id; });
+    return tag != end && tag->key == keyId ? valueOf(*tag) : std::string_view();
+}
+
+std::string_view OSMTagList::valueOf(const Tag& tag) const {
+    if (tag.value & kLocalValue) {
+        return std::string_view(text_.c_str() + (tag.value & ~kLocalValue));
+    }
+    return OSMStringInterner::instance().lookup(tag.value);
+}
+
+void OSMTagList::set(std::string_view key, std::string_view value) {
+    uint32_t keyId = OSMStringInterner::instance().intern(key);
+    if (keyId != OSMStringInterner::kNotFound) {
+        set(keyId, value);
+    }
+}
+
+void OSMTagList::set(uint32_t keyId, std::string_view value) {
+    OSMStringInterner& strings = OSMStringInterner::instance();
+
+    uint32_t valueId = OSMStringInterner::kNotFound;
+    if (strings.internsValuesOf(keyId)) {
+        valueId = strings.intern(value);
+    }
+    bool local = valueId == OSMStringInterner::kNotFound;
+    if (local) {
+        // Values are read back as C strings; stop at an embedded NUL
+        value = value.substr(0, value.find('\0'));
+    }
+
+    Tag* begin = data();
+    Tag* end = begin + size_;
+    Tag* tag = std::lower_bound(begin, end, keyId,
+        [](const Tag& t, uint32_t id) { return t.key < id; });
+    if (tag != end && tag->key == keyId) {
+        if (!(tag->value & kLocalValue)) {
+            tag->value = local ? appendText(value) : valueId;
+            return;
+        }
+
+        uint32_t offset = tag->value & ~kLocalValue;
+        if (local && offset + value.size() < slotEnd(offset)) {
+            // Fits where the old value was
+            text_.replace(offset, value.size(), value.data(), value.size());
+            text_[offset + value.size()] = '\0';
+            return;
+        }
+        // Appended before the old text is released, as value may point into it
+        tag->value = local ? appendText(value) : valueId;
+        eraseText(offset);
+        return;
+    }
+
+    if (local) {
+        valueId = appendText(value);
+    }
+    size_t position = static_cast<size_t>(tag - begin);
+    if (size_ == capacity_) {
+        reallocate(capacity_ * 2);
+        begin = data();
+    }
+    std::copy_backward(begin + position, begin + size_, begin + size_ + 1);
+    begin[position] = Tag{keyId, valueId};
+    ++size_;
+}
+
+bool OSMTagList::erase(std::string_view key) {
+    uint32_t keyId = OSMStringInterner::instance().find(key);
+    return keyId != OSMStringInterner::kNotFound && erase(keyId);
+}
+
+bool OSMTagList::erase(uint32_t keyId) {
+    Tag* begin = data();
+    Tag* end = begin + size_;
+    Tag* tag = std::lower_bound(begin, end, keyId,
+        [](const Tag& t, uint32_t id) { return t.key < id; });
+    if (tag == end || tag->key != keyId) {
+        return false;
+    }
+
+    uint32_t value = tag->value;
+    std::copy(tag + 1, end, tag);
+    --size_;
+    if (value & kLocalValue) {
+        eraseText(value & ~kLocalValue);
+    }
+    return true;
+}
+
+uint32_t OSMTagList::appendText(std::string_view value) {
+    uint32_t valueId = kLocalValue | static_cast<uint32_t>(text_.size());
+    text_.append(value.data(), value.size());
+    text_.push_back('\0');
+    return valueId;
+}
+
+size_t OSMTagList::slotEnd(uint32_t offset) const {
+    size_t end = text_.size();
+    const Tag* tags = data();
+    for (uint32_t i = 0; i < size_; ++i) {
+        uint32_t other = tags[i].value & ~kLocalValue;
+        if ((tags[i].value & kLocalValue) && other > offset && other < end) {
+            end = other;
+        }
+    }
+    return end;
+}
+
+void OSMTagList::eraseText(uint32_t offset) {
+    // Drops the slot with any space left in it by shorter overwrites
+    size_t length = slotEnd(offset) - offset;
+    text_.erase(offset, length);
+    Tag* tags = data();
+    for (uint32_t i = 0; i < size_; ++i) {
+        if ((tags[i].value & kLocalValue) && (tags[i].value & ~kLocalValue) > offset) {
+            tags[i].value -= static_cast<uint32_t>(length);
+        }
+    }
+}
+
+void OSMTagList::reallocate(uint32_t capacity) {
+    Tag* tags = new Tag[capacity];
+    std::copy(data(), data() + size_, tags);
+    if (capacity_ > kInlineTags) {
+        delete[] heap_;
+    }
+    heap_ = tags;
+    capacity_ = capacity;
+}
+
+void OSMTagList::shrinkToFit() {
+    text_.shrink_to_fit();
+    if (capacity_ <= kInlineTags || size_ == capacity_) {
+        return;
+    }
+    Tag* heap = heap_;
+    if (size_ <= kInlineTags) {
+        std::copy(heap, heap + size_, inline_);
+        capacity_ = kInlineTags;
+        delete[] heap;
+    } else {
+        reallocate(size_);
+    }
+}
+
+size_t OSMTagList::heapBytes() const {
+    size_t bytes = capacity_ > kInlineTags ? capacity_ * sizeof(Tag) : 0;
+    // Short text lives in the string's own small buffer
+    const char* object = reinterpret_cast<const char*>(&text_);
+    if (text_.data() < object || text_.data() >= object + sizeof(text_)) {
+        bytes += text_.capacity() + 1;
+    }
+    return bytes;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,217 @@
+#ifndef OSM_TAGS_H
+#define OSM_TAGS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Tag keys interned at fixed ids, read by the OSMPoi accessors
+ *
+ * The order matches the well-known key table in OSMTags.cpp.
+ */
+enum class OSMKey : uint32_t {
+    Name,
+    Amenity,
+    Building,
+    Office,
+    Shop,
+    Tourism,
+    Healthcare,
+    AddrStreet,
+    AddrHouseNumber,
+    AddrCity,
+    AddrPostcode,
+    AddrState,
+    AddrCountry,
+    Phone,
+    Website,
+    Email,
+    OpeningHours
+};
+
+/**
+ * @brief Process-wide table of tag key and value strings
+ *
+ * Each distinct string is stored once and identified by a 32-bit id.
+ * Keys are always interned. Values are interned only for keys with a
+ * small vocabulary (amenity, office, addr:city, ...) and only while the
+ * table is below its value limit; names, phone numbers and other values
+ * that are unique per POI stay with the POI.
+ *
+ * Strings are never removed. lookup() does not lock; intern() and find()
+ * take a reader/writer lock. Safe to use from any thread.
+ */
+class OSMStringInterner {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    static OSMStringInterner& instance();
+
+    // Non-copyable
+    OSMStringInterner(const OSMStringInterner&) = delete;
+    OSMStringInterner& operator=(const OSMStringInterner&) = delete;
+
+    /**
+     * @brief Id of a string, adding it if it is new
+     * @return kNotFound if the table is full
+     */
+    uint32_t intern(std::string_view text);
+
+    /**
+     * @brief Id of a string already in the table, or kNotFound
+     */
+    uint32_t find(std::string_view text) const;
+
+    /**
+     * @brief String of an id returned by intern() or find()
+     */
+    std::string_view lookup(uint32_t id) const {
+        return chunks_[id / kChunkSize].load(std::memory_order_acquire)[id % kChunkSize];
+    }
+
+    /**
+     * @brief Whether values of this key are interned rather than kept per POI
+     */
+    bool internsValuesOf(uint32_t keyId) const;
+
+    size_t size() const;
+
+    /**
+     * @brief Heap bytes held by the table (strings, index and id chunks)
+     */
+    size_t memoryBytes() const;
+
+private:
+    OSMStringInterner();
+
+    static constexpr size_t kChunkSize = 4096;
+    static constexpr size_t kMaxChunks = 256;        // 1M strings
+    static constexpr size_t kMaxInternedValues = 1 << 18;
+    static constexpr size_t kArenaBlockSize = 64 * 1024;
+
+    uint32_t internLocked(std::string_view text);
+    const char* storeLocked(std::string_view text);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::atomic<std::string_view*> chunks_[kMaxChunks] = {};
+    std::vector<std::unique_ptr<std::string_view[]>> chunkStorage_;
+    std::vector<std::unique_ptr<char[]>> arena_;
+    size_t arenaUsed_ = kArenaBlockSize;
+    size_t arenaBytes_ = 0;
+    std::atomic<uint32_t> count_{0};
+};
+
+/**
+ * @brief Tags of one POI as a flat array of (key id, value id) pairs
+ *
+ * Pairs are sorted by key id. Up to kInlineTags pairs are stored inside
+ * the object; longer lists move to one heap array. Values that are not
+ * interned are kept NUL-terminated in a per-list text buffer, so a POI
+ * costs at most two allocations however many tags it has.
+ */
+class OSMTagList {
+public:
+    static constexpr uint32_t kInlineTags = 6;
+
+    OSMTagList() : heap_(nullptr) {}
+    OSMTagList(const OSMTagList& other);
+    OSMTagList(OSMTagList&& other) noexcept;
+    OSMTagList& operator=(const OSMTagList& other);
+    OSMTagList& operator=(OSMTagList&& other) noexcept;
+    ~OSMTagList();
+
+    /**
+     * @brief Value of a tag, or an empty view if the POI does not have it
+     */
+    std::string_view get(OSMKey key) const { return get(static_cast<uint32_t>(key)); }
+    std::string_view get(std::string_view key) const;
+
+    bool has(std::string_view key) const { return !get(key).empty(); }
+
+    /**
+     * @brief Add a tag, or replace its value
+     *
+     * A replaced value's text is reused when the new value fits in it,
+     * and released otherwise, so updating a tag does not grow the list.
+     */
+    void set(OSMKey key, std::string_view value) { set(static_cast<uint32_t>(key), value); }
+    void set(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Remove a tag
+     * @return Whether the POI had it
+     */
+    bool erase(OSMKey key) { return erase(static_cast<uint32_t>(key)); }
+    bool erase(std::string_view key);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Call fn(std::string_view key, std::string_view value) for every tag
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        const OSMStringInterner& strings = OSMStringInterner::instance();
+        const Tag* tags = data();
+        for (uint32_t i = 0; i < size_; ++i) {
+            fn(strings.lookup(tags[i].key), valueOf(tags[i]));
+        }
+    }
+
+    /**
+     * @brief Release unused capacity once the list is complete
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Heap bytes owned by this list (not counting interned strings)
+     */
+    size_t heapBytes() const;
+
+private:
+    struct Tag {
+        uint32_t key;
+        uint32_t value;   // Interned id, or kLocalValue | offset into text_
+    };
+
+    static constexpr uint32_t kLocalValue = 0x80000000u;
+
+    std::string_view get(uint32_t keyId) const;
+    void set(uint32_t keyId, std::string_view value);
+    bool erase(uint32_t keyId);
+
+    const Tag* data() const { return capacity_ > kInlineTags ? heap_ : inline_; }
+    Tag* data() { return capacity_ > kInlineTags ? heap_ : inline_; }
+    std::string_view valueOf(const Tag& tag) const;
+    void reallocate(uint32_t capacity);
+
+    // Local value text: each value owns the bytes up to the next one
+    uint32_t appendText(std::string_view value);
+    size_t slotEnd(uint32_t offset) const;
+    void eraseText(uint32_t offset);
+
+    uint32_t size_ = 0;
+    uint32_t capacity_ = kInlineTags;
+    union {
+        Tag inline_[kInlineTags];
+        Tag* heap_;
+    };
+    std::string text_;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // OSM_TAGS_H
@@ -1,5 +1,6 @@
 #include "OpenAIEngine.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
+#include "JsonReader.h"
 #include <sstream>
 #include <cstring>
 #include <algorithm>
@@ -10,13 +11,6 @@ namespace FranchiseAI {
 namespace Services {
 
 namespace {
-    // CURL write callback
-    size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* response) {
-        size_t totalSize = size * nmemb;
-        response->append(static_cast<char*>(contents), totalSize);
-        return totalSize;
-    }
-
     // Simple JSON string escaping
     std::string escapeJSON(const std::string& str) {
         std::ostringstream result;
@@ -38,65 +32,6 @@ namespace {
         }
         return result.str();
     }
-
-    // Extract JSON string value
-    std::string extractJSONString(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = json.find(searchKey);
-        if (keyPos == std::string::npos) return "";
-
-        size_t colonPos = json.find(':', keyPos);
-        if (colonPos == std::string::npos) return "";
-
-        size_t startPos = json.find('"', colonPos + 1);
-        if (startPos == std::string::npos) return "";
-
-        std::string result;
-        bool escaped = false;
-        for (size_t i = startPos + 1; i < json.size(); ++i) {
-            char c = json[i];
-            if (escaped) {
-                switch (c) {
-                    case 'n': result += '\n'; break;
-                    case 'r': result += '\r'; break;
-                    case 't': result += '\t'; break;
-                    case '"': result += '"'; break;
-                    case '\\': result += '\\'; break;
-                    default: result += c;
-                }
-                escaped = false;
-            } else if (c == '\\') {
-                escaped = true;
-            } else if (c == '"') {
-                break;
-            } else {
-                result += c;
-            }
-        }
-        return result;
-    }
-
-    // Extract JSON number value
-    int extractJSONNumber(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = json.find(searchKey);
-        if (keyPos == std::string::npos) return 0;
-
-        size_t colonPos = json.find(':', keyPos);
-        if (colonPos == std::string::npos) return 0;
-
-        size_t startPos = colonPos + 1;
-        while (startPos < json.size() && (json[startPos] == ' ' || json[startPos] == '\t')) {
-            ++startPos;
-        }
-
-        std::string numStr;
-        while (startPos < json.size() && (std::isdigit(json[startPos]) || json[startPos] == '-')) {
-            numStr += json[startPos++];
-        }
-
-        return numStr.empty() ? 0 : std::stoi(numStr);
-    }
 }
 
 OpenAIEngine::OpenAIEngine() {
@@ -158,36 +93,20 @@ std::string OpenAIEngine::buildRequestJSON(
 }
 
 std::string OpenAIEngine::makeAPIRequest(const std::string& requestBody) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "{\"error\":{\"message\":\"Failed to initialize CURL\"}}";
-    }
-
-    std::string response;
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-
-    std::string authHeader = "Authorization: Bearer " + config_.apiKey;
-    headers = curl_slist_append(headers, authHeader.c_str());
-
-    curl_easy_setopt(curl, CURLOPT_URL, config_.apiEndpoint.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, requestBody.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.timeoutMs);
+    HttpRequest request;
+    request.url = config_.apiEndpoint;
+    request.method = "POST";
+    request.body = requestBody;
+    request.headers.push_back("Content-Type: application/json");
+    request.headers.push_back("Authorization: Bearer " + config_.apiKey);
+    request.timeoutMs = config_.timeoutMs;
 
-    CURLcode res = curl_easy_perform(curl);
-
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-        return "{\"error\":{\"message\":\"CURL error: " +
-               std::string(curl_easy_strerror(res)) + "\"}}";
+    HttpResponse response = HttpClient::instance().perform(request);
+    if (!response.ok) {
+        return "{\"error\":{\"message\":\"CURL error: " + response.error + "\"}}";
     }
 
-    return response;
+    return response.body;
 }
 
 AIAnalysisResponse OpenAIEngine::parseAPIResponse(const std::string& jsonResponse) {
@@ -195,10 +114,13 @@ AIAnalysisResponse OpenAIEngine::parseAPIResponse(const std::string& jsonRespons
     response.provider = "OpenAI";
     response.model = config_.model;
 
+    JsonValue root = JsonValue::parse(jsonResponse);
+
     // Check for error
-    if (jsonResponse.find("\"error\"") != std::string::npos) {
+    JsonValue error = root["error"];
+    if (error.exists()) {
         response.success = false;
-        response.error = extractJSONString(jsonResponse, "message");
+        response.error = error.isString() ? error.asString() : error["message"].asString();
         if (response.error.empty()) {
             response.error = "Unknown API error";
         }
@@ -206,14 +128,14 @@ AIAnalysisResponse OpenAIEngine::parseAPIResponse(const std::string& jsonRespons
     }
 
     // Extract content from choices[0].message.content
-    size_t contentStart = jsonResponse.find("\"content\"");
-    if (contentStart != std::string::npos) {
-        response.content = extractJSONString(jsonResponse, "content");
-        response.success = !response.content.empty();
-    }
+    root["choices"].forEachElement([&response](const JsonValue& choice) {
+        response.content = choice["message"]["content"].asString();
+        return false;
+    });
+    response.success = !response.content.empty();
 
     // Extract token usage
-    response.tokensUsed = extractJSONNumber(jsonResponse, "total_tokens");
+    response.tokensUsed = root["usage"]["total_tokens"].asInt();
 
     if (response.success) {
         response.confidenceScore = 0.85;  // Default confidence for successful responses
@@ -1,11 +1,21 @@
 #include "OpenStreetMapAPI.h"
-#include <curl/curl.h>
+#include "ApiCache.h"
+#include "HttpClient.h"
+#include "JsonReader.h"
+#include "OSMExtractStore.h"
+#include "OSMPoiIndex.h"
+#include "RateLimiter.h"
 #include <random>
 #include <ctime>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <deque>
+#include <future>
 #include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
 
 namespace FranchiseAI {
 namespace Services {
@@ -65,21 +75,233 @@ const std::map<std::string, Models::BusinessType> OpenStreetMapAPI::osmTagMappin
     {"landuse=commercial", Models::BusinessType::CORPORATE_OFFICE},
 };
 
-// CURL write callback
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
+// ===== Category filters =====
+// One row per Overpass filter of a map category (the names match the
+// Demographics stats). buildCategoryQuery() emits them as bbox clauses,
+// and the same rows classify POIs from a response or the local extract.
+
+struct CategoryFilter {
+    std::string_view category;
+    std::string_view elements;  // Overpass element set: "nw" or "way"
+    std::string_view key;
+    std::string_view value;     // Empty matches any value
+};
+
+static constexpr CategoryFilter kCategoryFilters[] = {
+    {"offices", "nw", "office", ""},
+    {"offices", "way", "building", "office"},
+    {"offices", "way", "building", "commercial"},
+    {"hotels", "nw", "tourism", "hotel"},
+    {"hotels", "nw", "tourism", "motel"},
+    {"conference", "nw", "amenity", "conference_centre"},
+    {"conference", "nw", "amenity", "events_venue"},
+    {"hospitals", "nw", "amenity", "hospital"},
+    {"hospitals", "nw", "amenity", "clinic"},
+    {"universities", "nw", "amenity", "university"},
+    {"universities", "nw", "amenity", "college"},
+    {"schools", "nw", "amenity", "school"},
+    {"industrial", "way", "building", "industrial"},
+    {"industrial", "way", "landuse", "industrial"},
+    {"warehouses", "way", "building", "warehouse"},
+    {"banks", "nw", "amenity", "bank"},
+    {"banks", "nw", "office", "financial"},
+    {"government", "nw", "office", "government"},
+    {"government", "way", "building", "government"},
+    {"restaurants", "nw", "amenity", "restaurant"},
+    {"cafes", "nw", "amenity", "cafe"},
+};
+
+static constexpr bool isKnownCategory(std::string_view category) {
+    for (const auto& filter : kCategoryFilters) {
+        if (filter.category == category) {
+            return true;
+        }
+    }
+    return false;
 }
 
-OpenStreetMapAPI::OpenStreetMapAPI() = default;
+static_assert(isKnownCategory("offices") && isKnownCategory("cafes") && !isKnownCategory(""),
+              "kCategoryFilters must cover the map categories");
+
+// Whether a POI belongs to a category; tag(key) returns the tag's value
+// or an empty view
+template<typename TagLookup>
+static bool matchesCategory(std::string_view category, std::string_view osmType, TagLookup tag) {
+    for (const auto& filter : kCategoryFilters) {
+        if (filter.category != category || (filter.elements == "way" && osmType != "way")) {
+            continue;
+        }
+        std::string_view value = tag(filter.key);
+        if (!value.empty() && (filter.value.empty() || value == filter.value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool matchesCategory(const OSMPoiView& poi, std::string_view category) {
+    return matchesCategory(category, poi.osmType(), [&poi](std::string_view key) {
+        return poi.tag(key);
+    });
+}
+
+static bool matchesCategory(const OSMPoi& poi, std::string_view category) {
+    return matchesCategory(category, poi.osmType, [&poi](std::string_view key) {
+        return poi.tags.get(key);
+    });
+}
+
+// ===== Area statistic filters =====
+// One row per tag that counts towards an OSMAreaStat. Rows of the same
+// statistic are a union: a POI matching several of them counts once.
+
+struct AreaStatFilter {
+    OSMAreaStat stat;
+    std::string_view key;
+    std::string_view value;     // Empty matches any value
+};
+
+static constexpr AreaStatFilter kAreaStatFilters[] = {
+    {OSMAreaStat::Offices, "office", ""},
+    {OSMAreaStat::Restaurants, "amenity", "restaurant"},
+    {OSMAreaStat::Cafes, "amenity", "cafe"},
+    {OSMAreaStat::Hotels, "tourism", "hotel"},
+    {OSMAreaStat::Hotels, "tourism", "motel"},
+    {OSMAreaStat::ConferenceVenues, "amenity", "conference_centre"},
+    {OSMAreaStat::ConferenceVenues, "amenity", "events_venue"},
+    {OSMAreaStat::Hospitals, "amenity", "hospital"},
+    {OSMAreaStat::Schools, "amenity", "school"},
+    {OSMAreaStat::Universities, "amenity", "university"},
+    {OSMAreaStat::Universities, "amenity", "college"},
+    {OSMAreaStat::IndustrialBuildings, "building", "industrial"},
+    {OSMAreaStat::IndustrialBuildings, "landuse", "industrial"},
+    {OSMAreaStat::Warehouses, "building", "warehouse"},
+    {OSMAreaStat::Shops, "shop", ""},
+    {OSMAreaStat::Banks, "amenity", "bank"},
+    {OSMAreaStat::GovernmentBuildings, "office", "government"},
+    {OSMAreaStat::GovernmentBuildings, "building", "government"},
+    {OSMAreaStat::ParkingLots, "amenity", "parking"},
+    {OSMAreaStat::BusStops, "highway", "bus_stop"},
+    {OSMAreaStat::RailwayStations, "railway", "station"},
+};
+
+static_assert(static_cast<size_t>(OSMAreaStat::Count) <= 32,
+              "OSMAreaStats::classify() returns one bit per statistic");
+
+// ===== Area statistics cache =====
+// Overpass counts shared by every session, keyed by center (~100 m) and
+// radius (0.1 km), so rendering the map page for an area again is free.
+// The policy comes from the first caller's config; every session shares
+// one AppConfig.
+
+static const size_t kAreaCountsCacheBytes = 4u << 20;
+
+static std::shared_ptr<ApiCache<OSMAreaCounts>> sharedAreaCountsCache(const OSMAPIConfig& config) {
+    static auto cache = std::make_shared<ApiCache<OSMAreaCounts>>(
+        ApiCachePolicy{config.enableCaching ? config.cacheDurationMinutes * 60 : 0,
+                       config.enableCaching ? config.cacheStaleMinutes * 60 : 0,
+                       config.enableCaching ? config.negativeCacheSeconds : 0,
+                       kAreaCountsCacheBytes});
+    return cache;
+}
+
+static std::string areaCountsKey(double lat, double lon, double radiusKm) {
+    std::ostringstream key;
+    key << std::lround(lat * 1000.0) << "," << std::lround(lon * 1000.0) << ","
+        << std::lround(radiusKm * 10.0);
+    return key.str();
+}
+
+/**
+ * @brief Counts from an Overpass "out count" response, one per statistic in query order
+ */
+static bool parseAreaCounts(const HttpResponse& response, OSMAreaCounts& counts, std::string& error) {
+    if (!response.ok) {
+        error = response.error.empty() ? "Overpass API request failed - no response" : response.error;
+        return false;
+    }
+    if (!response.isSuccess()) {
+        error = "Overpass API returned HTTP " + std::to_string(response.statusCode);
+        return false;
+    }
+
+    JsonValue root = JsonValue::parse(response.body);
+    size_t stat = 0;
+    root["elements"].forEachElement([&](const JsonValue& element) {
+        if (element["type"].asStringView() == "count") {
+            counts[stat++] = static_cast<uint32_t>(element["tags"]["total"].asInt64());
+        }
+        return stat < counts.size();
+    });
+
+    if (stat < counts.size()) {
+        // A remark means the server stopped part way; partial counts are not cached
+        std::string remark = root["remark"].asString();
+        error = remark.empty() ? "Overpass count response is incomplete" : "Overpass remark: " + remark;
+        return false;
+    }
+    return true;
+}
+
+static std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text;
+}
+
+// Same union as buildCateringProspectQuery()
+static bool isCateringProspect(const OSMPoiView& poi) {
+    std::string_view office = poi.tag("office");
+    if (!office.empty() && (poi.hasTag("name") || office == "company" || office == "corporation")) {
+        return true;
+    }
+    std::string_view amenity = poi.tag("amenity");
+    return poi.hasTag("tourism", "hotel") ||
+           amenity == "conference_centre" || amenity == "hospital" ||
+           amenity == "university" || amenity == "college";
+}
+
+// Catering prospect searches are clamped to this radius (~8 miles) so the
+// Overpass query stays fast
+static const double kMaxProspectRadiusKm = 13.0;
+
+OpenStreetMapAPI::OpenStreetMapAPI()
+    : poiCache_(OSMPoiIndex::shared()) {
+    poiCache_->reserveBytes(static_cast<size_t>(std::max(config_.cacheMaxMegabytes, 1)) << 20);
+}
 
 OpenStreetMapAPI::OpenStreetMapAPI(const OSMAPIConfig& config)
-    : config_(config) {}
+    : config_(config),
+      poiCache_(OSMPoiIndex::shared()) {
+    poiCache_->reserveBytes(static_cast<size_t>(std::max(config_.cacheMaxMegabytes, 1)) << 20);
+    openCacheStore();
+    openExtract();
+}
 
 OpenStreetMapAPI::~OpenStreetMapAPI() = default;
 
+void OpenStreetMapAPI::openCacheStore() {
+    // The tile index is shared; an instance without a store path keeps
+    // whatever store another instance attached
+    if (config_.cacheStorePath.empty()) {
+        return;
+    }
+    auto store = PersistentCache::shared(
+        config_.cacheStorePath,
+        static_cast<size_t>(std::max(config_.cacheStoreMaxMegabytes, 1)) << 20);
+    if (store) {
+        poiCache_->persistTo(store);
+    }
+}
+
 void OpenStreetMapAPI::setConfig(const OSMAPIConfig& config) {
+    bool extractChanged = config.extractStorePath != config_.extractStorePath ||
+                          config.extractPbfPath != config_.extractPbfPath;
     config_ = config;
+    poiCache_->reserveBytes(static_cast<size_t>(std::max(config_.cacheMaxMegabytes, 1)) << 20);
+    openCacheStore();
+    if (extractChanged || (!extract_ && !config_.extractStorePath.empty())) {
+        openExtract();
+    }
 }
 
 void OpenStreetMapAPI::searchNearby(
@@ -88,58 +310,38 @@ void OpenStreetMapAPI::searchNearby(
     int radiusMeters,
     POICallback callback
 ) {
-    ++totalApiCalls_;
-
-    // Check cache first
-    std::string cacheKey = std::to_string(latitude) + "," + std::to_string(longitude) + "," + std::to_string(radiusMeters);
-    if (config_.enableCaching) {
-        auto it = poiCache_.find(cacheKey);
-        if (it != poiCache_.end()) {
-            time_t now = std::time(nullptr);
-            if (now - it->second.second < config_.cacheDurationMinutes * 60) {
-                if (callback) {
-                    callback(it->second.first, "");
-                }
-                return;
-            }
+    // Served from the local extract when it covers the whole radius
+    if (coveredByExtract(latitude, longitude, radiusMeters)) {
+        auto results = queryExtract(latitude, longitude, radiusMeters, isCateringProspect);
+        if (callback) {
+            callback(results, "");
         }
-    }
-
-    // Build and execute real Overpass API query for catering prospects
-    std::string query = buildCateringProspectQuery(latitude, longitude, radiusMeters);
-    std::string response = executeOverpassQuery(query);
-
-    // Check for error in response
-    if (response.empty()) {
-        if (callback) callback({}, "Overpass API request failed - no response");
         return;
     }
 
-    // Check for error JSON (from curl failure or API error)
-    if (response.find("\"error\"") != std::string::npos) {
-        // Extract error message if possible
-        size_t errorStart = response.find("\"error\"");
-        size_t colonPos = response.find(':', errorStart);
-        size_t quoteStart = response.find('"', colonPos);
-        size_t quoteEnd = response.find('"', quoteStart + 1);
-        std::string errorMsg = "Overpass API error";
-        if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-            errorMsg = response.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+    if (config_.enableCaching) {
+        // Only the tiles of the area that are not cached yet are fetched
+        double limitedRadius = std::min(radiusMeters / 1000.0, kMaxProspectRadiusKm) * 1000.0;
+        std::vector<OSMPoiList> tiles;
+        std::string error;
+        if (!fetchMissingTiles(latitude, longitude, limitedRadius, tiles, error)) {
+            if (callback) callback({}, error);
+            return;
+        }
+
+        if (callback) {
+            callback(queryPoiCache(latitude, longitude, limitedRadius, tiles), "");
         }
-        if (callback) callback({}, errorMsg);
         return;
     }
 
-    // Parse the JSON response
-    auto results = parseOverpassResponse(response);
-
-    // Cache results
-    if (config_.enableCaching && !results.empty()) {
-        poiCache_[cacheKey] = {results, std::time(nullptr)};
-    }
+    // Build and execute real Overpass API query for catering prospects
+    std::string query = buildCateringProspectQuery(latitude, longitude, radiusMeters);
+    std::string error;
+    auto results = fetchPois(query, config_.maxResultsPerQuery, error);
 
     if (callback) {
-        callback(results, "");
+        callback(results, error);
     }
 }
 
@@ -162,7 +364,7 @@ void OpenStreetMapAPI::searchBusinesses(
             businesses.reserve(pois.size());
 
             for (const auto& poi : pois) {
-                if (!poi.name.empty()) {
+                if (!poi.name().empty()) {
                     businesses.push_back(poiToBusinessInfo(poi));
                 }
             }
@@ -233,14 +435,67 @@ void OpenStreetMapAPI::getAreaStatistics(
     double radiusKm,
     AreaStatsCallback callback
 ) {
-    ++totalApiCalls_;
+    if (coveredByExtract(latitude, longitude, radiusKm * 1000.0)) {
+        if (callback) {
+            callback(extractAreaStats(latitude, longitude, radiusKm), "");
+        }
+        return;
+    }
 
-    // For demo/prototype, generate sample statistics
-    auto stats = generateDemoAreaStats(latitude, longitude, radiusKm);
+    OSMAreaStats stats;
+    stats.centerLat = latitude;
+    stats.centerLon = longitude;
+    stats.radiusKm = radiusKm;
 
-    if (callback) {
-        callback(stats, "");
+    // The loader runs inline in fetch(); only the reactor callback runs
+    // later, and it does not touch this client
+    auto loadCounts = [this, latitude, longitude, radiusKm](ApiCache<OSMAreaCounts>::Done done) {
+        ++totalApiCalls_;
+        std::string query = buildAreaStatsQuery(latitude, longitude, static_cast<int>(radiusKm * 1000.0));
+        HttpClient::instance().performAsync(buildOverpassRequest(query),
+            [done](HttpResponse response) {
+                OSMAreaCounts counts = {};
+                std::string error;
+                bool ok = parseAreaCounts(response, counts, error);
+                if (!ok) {
+                    std::cerr << "[OSM] Area statistics failed: " << error << std::endl;
+                }
+                done(counts, ok);
+            });
+    };
+
+    sharedAreaCountsCache(config_)->fetch(areaCountsKey(latitude, longitude, radiusKm), loadCounts,
+        [stats, callback](const OSMAreaCounts& counts, bool ok) mutable {
+            if (!ok) {
+                // No counts: report the failure rather than an empty area
+                if (callback) callback(stats, "Area statistics are unavailable");
+                return;
+            }
+            stats.setCounts(counts);
+            if (callback) callback(stats, "");
+        });
+}
+
+bool OpenStreetMapAPI::peekAreaStatistics(const Models::SearchArea& searchArea, OSMAreaStats& stats) {
+    double latitude = searchArea.center.latitude;
+    double longitude = searchArea.center.longitude;
+    double radiusKm = searchArea.radiusKm;
+
+    if (coveredByExtract(latitude, longitude, radiusKm * 1000.0)) {
+        stats = extractAreaStats(latitude, longitude, radiusKm);
+        return true;
     }
+
+    OSMAreaCounts counts = {};
+    if (!sharedAreaCountsCache(config_)->peek(areaCountsKey(latitude, longitude, radiusKm), counts)) {
+        return false;
+    }
+    stats = OSMAreaStats();
+    stats.centerLat = latitude;
+    stats.centerLon = longitude;
+    stats.radiusKm = radiusKm;
+    stats.setCounts(counts);
+    return true;
 }
 
 void OpenStreetMapAPI::geocodeAddress(
@@ -249,24 +504,9 @@ void OpenStreetMapAPI::geocodeAddress(
 ) {
     ++totalApiCalls_;
 
-    // URL encode the address
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        if (callback) callback(0.0, 0.0, "Failed to initialize CURL");
-        return;
-    }
-
-    char* encodedAddress = curl_easy_escape(curl, address.c_str(), static_cast<int>(address.length()));
-    if (!encodedAddress) {
-        curl_easy_cleanup(curl);
-        if (callback) callback(0.0, 0.0, "Failed to encode address");
-        return;
-    }
-
     // Build Nominatim search URL
-    std::string url = config_.nominatimEndpoint + "/search?format=json&limit=1&q=" + std::string(encodedAddress);
-    curl_free(encodedAddress);
-    curl_easy_cleanup(curl);
+    std::string url = config_.nominatimEndpoint + "/search?format=json&limit=1&q=" +
+                      HttpClient::urlEncode(address);
 
     // Execute the query
     std::string response = executeNominatimQuery(url);
@@ -343,26 +583,47 @@ std::vector<Models::BusinessInfo> OpenStreetMapAPI::searchBusinessesSync(
 OSMAreaStats OpenStreetMapAPI::getAreaStatisticsSync(
     double latitude,
     double longitude,
-    double radiusKm
+    double radiusKm,
+    std::string* error
 ) {
-    OSMAreaStats stats;
+    auto promise = std::make_shared<std::promise<std::pair<OSMAreaStats, std::string>>>();
+    auto future = promise->get_future();
     getAreaStatistics(latitude, longitude, radiusKm,
-        [&stats](OSMAreaStats s, const std::string&) {
-            stats = std::move(s);
+        [promise](OSMAreaStats stats, const std::string& statsError) {
+            promise->set_value({std::move(stats), statsError});
         });
-    return stats;
+
+    auto result = future.get();
+    if (error) {
+        *error = result.second;
+    }
+    return result.first;
 }
 
 void OpenStreetMapAPI::clearCache() {
-    poiCache_.clear();
+    poiCache_->clear();
 }
 
 int OpenStreetMapAPI::getCacheSize() const {
-    return static_cast<int>(poiCache_.size());
+    return static_cast<int>(poiCache_->tileCount());
+}
+
+const OSMTileCacheStats& OpenStreetMapAPI::getTileCacheStats() const {
+    return poiCache_->getStats();
 }
 
 void OpenStreetMapAPI::resetStatistics() {
     totalApiCalls_ = 0;
+    localQueries_ = 0;
+    poiCache_->resetStats();
+}
+
+std::string OSMPoi::streetAddress() const {
+    std::string address(houseNumber());
+    if (!address.empty() && !street().empty()) {
+        address += ' ';
+    }
+    return address.append(street());
 }
 
 Models::BusinessInfo OpenStreetMapAPI::poiToBusinessInfo(const OSMPoi& poi) {
@@ -370,31 +631,31 @@ Models::BusinessInfo OpenStreetMapAPI::poiToBusinessInfo(const OSMPoi& poi) {
 
     // Generate unique ID from OSM data
     business.id = "osm_" + poi.osmType + "_" + std::to_string(poi.osmId);
-    business.name = poi.name;
+    business.name = std::string(poi.name());
     business.source = Models::DataSource::OPENSTREETMAP;
     business.type = inferBusinessType(poi);
 
     // Address
-    business.address.street1 = poi.houseNumber.empty() ? poi.street : poi.houseNumber + " " + poi.street;
-    business.address.city = poi.city;
-    business.address.state = poi.state;
-    business.address.zipCode = poi.postcode;
-    business.address.country = poi.country.empty() ? "USA" : poi.country;
+    business.address.street1 = poi.streetAddress();
+    business.address.city = std::string(poi.city());
+    business.address.state = std::string(poi.state());
+    business.address.zipCode = std::string(poi.postcode());
+    business.address.country = poi.country().empty() ? "USA" : std::string(poi.country());
     business.address.latitude = poi.latitude;
     business.address.longitude = poi.longitude;
 
     // Contact info from OSM tags
-    business.contact.primaryPhone = poi.phone;
-    business.contact.website = poi.website;
-    business.contact.email = poi.email;
+    business.contact.primaryPhone = std::string(poi.phone());
+    business.contact.website = std::string(poi.website());
+    business.contact.email = std::string(poi.email());
 
     // Set description based on type
     business.description = "Business found via OpenStreetMap";
 
     // Parse opening hours if available
-    if (!poi.openingHours.empty()) {
+    if (!poi.openingHours().empty()) {
         // Simplified: just store the raw string
-        business.hours.monday = poi.openingHours;
+        business.hours.monday = std::string(poi.openingHours());
     }
 
     // Set catering-relevant flags based on type
@@ -440,62 +701,65 @@ Models::BusinessType OpenStreetMapAPI::inferBusinessType(const OSMPoi& poi) {
             std::string key = tag.substr(0, eqPos);
             std::string value = tag.substr(eqPos + 1);
 
-            auto it = poi.tags.find(key);
-            if (it != poi.tags.end() && it->second == value) {
+            if (poi.tags.get(key) == value) {
                 return type;
             }
         }
     }
 
     // Check by general tag categories
-    if (!poi.office.empty()) {
-        if (poi.office == "company" || poi.office == "corporate")
+    std::string_view office = poi.office();
+    std::string_view building = poi.building();
+    std::string_view amenity = poi.amenity();
+    std::string_view tourism = poi.tourism();
+    if (!office.empty()) {
+        if (office == "company" || office == "corporate")
             return Models::BusinessType::CORPORATE_OFFICE;
-        if (poi.office == "it" || poi.office == "telecommunication")
+        if (office == "it" || office == "telecommunication")
             return Models::BusinessType::TECH_COMPANY;
-        if (poi.office == "lawyer" || poi.office == "notary")
+        if (office == "lawyer" || office == "notary")
             return Models::BusinessType::LAW_FIRM;
-        if (poi.office == "financial" || poi.office == "insurance")
+        if (office == "financial" || office == "insurance")
             return Models::BusinessType::FINANCIAL_SERVICES;
-        if (poi.office == "government")
+        if (office == "government")
             return Models::BusinessType::GOVERNMENT_OFFICE;
-        if (poi.office == "ngo" || poi.office == "foundation")
+        if (office == "ngo" || office == "foundation")
             return Models::BusinessType::NONPROFIT;
         return Models::BusinessType::CORPORATE_OFFICE;  // Default for unspecified office
     }
 
-    if (!poi.building.empty()) {
-        if (poi.building == "office" || poi.building == "commercial")
+    if (!building.empty()) {
+        if (building == "office" || building == "commercial")
             return Models::BusinessType::CORPORATE_OFFICE;
-        if (poi.building == "warehouse")
+        if (building == "warehouse")
             return Models::BusinessType::WAREHOUSE;
-        if (poi.building == "industrial")
+        if (building == "industrial")
             return Models::BusinessType::MANUFACTURING;
-        if (poi.building == "hotel")
+        if (building == "hotel")
             return Models::BusinessType::HOTEL;
-        if (poi.building == "hospital")
+        if (building == "hospital")
             return Models::BusinessType::MEDICAL_FACILITY;
-        if (poi.building == "university" || poi.building == "school")
+        if (building == "university" || building == "school")
             return Models::BusinessType::EDUCATIONAL_INSTITUTION;
     }
 
-    if (!poi.amenity.empty()) {
-        if (poi.amenity == "conference_centre" || poi.amenity == "events_venue")
+    if (!amenity.empty()) {
+        if (amenity == "conference_centre" || amenity == "events_venue")
             return Models::BusinessType::CONFERENCE_CENTER;
-        if (poi.amenity == "hospital" || poi.amenity == "clinic")
+        if (amenity == "hospital" || amenity == "clinic")
             return Models::BusinessType::MEDICAL_FACILITY;
-        if (poi.amenity == "university" || poi.amenity == "college" || poi.amenity == "school")
+        if (amenity == "university" || amenity == "college" || amenity == "school")
             return Models::BusinessType::EDUCATIONAL_INSTITUTION;
-        if (poi.amenity == "coworking_space")
+        if (amenity == "coworking_space")
             return Models::BusinessType::COWORKING_SPACE;
     }
 
-    if (!poi.tourism.empty()) {
-        if (poi.tourism == "hotel" || poi.tourism == "motel")
+    if (!tourism.empty()) {
+        if (tourism == "hotel" || tourism == "motel")
             return Models::BusinessType::HOTEL;
     }
 
-    if (!poi.healthcare.empty()) {
+    if (!poi.healthcare().empty()) {
         return Models::BusinessType::MEDICAL_FACILITY;
     }
 
@@ -526,19 +790,24 @@ std::string OpenStreetMapAPI::buildCateringProspectQuery(
     int radiusMeters
 ) {
     // Limit radius to avoid overly large queries that timeout
-    // Max ~8 miles for performance
-    double limitedRadiusKm = std::min(radiusMeters / 1000.0, 13.0);
+    double limitedRadiusKm = std::min(radiusMeters / 1000.0, kMaxProspectRadiusKm);
 
     // Convert to bounding box (MUCH faster than "around:" radius queries)
     // 1 degree latitude ≈ 111 km, 1 degree longitude ≈ 111 * cos(lat) km
     double latDelta = limitedRadiusKm / 111.0;
     double lonDelta = limitedRadiusKm / (111.0 * std::cos(lat * 3.14159265 / 180.0));
 
-    double south = lat - latDelta;
-    double north = lat + latDelta;
-    double west = lon - lonDelta;
-    double east = lon + lonDelta;
+    return buildCateringProspectQuery(lat - latDelta, lon - lonDelta, lat + latDelta, lon + lonDelta,
+                                      config_.maxResultsPerQuery);
+}
 
+std::string OpenStreetMapAPI::buildCateringProspectQuery(
+    double south,
+    double west,
+    double north,
+    double east,
+    int maxResults
+) {
     std::ostringstream query;
     query << std::fixed << std::setprecision(6);
 
@@ -560,351 +829,641 @@ std::string OpenStreetMapAPI::buildCateringProspectQuery(
     query << ");";
 
     // "out center qt" - center for way centroids, qt for quadtile-sorted fast output
-    query << "out center qt " << config_.maxResultsPerQuery << ";";
+    query << "out center qt " << maxResults << ";";
 
     return query.str();
 }
 
-std::string OpenStreetMapAPI::executeOverpassQuery(const std::string& query) {
-    CURL* curl = curl_easy_init();
-    std::string response;
-
-    if (curl) {
-        std::string url = config_.overpassEndpoint;
-        std::string postData = "data=" + query;
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postData.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.requestTimeoutMs);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connectTimeoutMs);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.userAgent.c_str());
-        // Enable compression for faster transfer (works well with lz4 endpoint)
-        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip, deflate");
-        // Enable TCP keepalive for faster failure detection
-        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
-        // Disable Nagle algorithm for faster small requests
-        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            response = "{\"error\": \"" + std::string(curl_easy_strerror(res)) + "\"}";
-        }
+std::vector<OSMPoi> OpenStreetMapAPI::fetchPois(
+    const std::string& query,
+    size_t maxResults,
+    std::string& error
+) {
+    std::vector<OSMPoi> pois;
+    streamPois(query, maxResults, [&pois](OSMPoi&& poi) {
+        pois.push_back(std::move(poi));
+        return true;
+    }, error);
+    return pois;
+}
 
-        curl_easy_cleanup(curl);
+bool OpenStreetMapAPI::streamPois(
+    const std::string& query,
+    size_t maxResults,
+    const OverpassStreamParser::Sink& sink,
+    std::string& error
+) {
+    if (maxResults == 0) {
+        return true;
     }
 
-    return response;
-}
+    size_t passed = 0;
+    OverpassStreamParser parser([&](OSMPoi&& poi) {
+        return sink(std::move(poi)) && ++passed < maxResults;
+    });
 
-std::string OpenStreetMapAPI::executeNominatimQuery(const std::string& endpoint) {
-    CURL* curl = curl_easy_init();
-    std::string response;
-
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, endpoint.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, config_.requestTimeoutMs);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connectTimeoutMs);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.userAgent.c_str());
-        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip, deflate");
-        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
-        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            response = "{\"error\": \"" + std::string(curl_easy_strerror(res)) + "\"}";
-        }
+    // Elements are parsed from each chunk as curl receives it; once the
+    // parser stops, the rest of the response is not downloaded
+    HttpRequest request = buildOverpassRequest(query);
+    request.onData = [&parser](std::string_view chunk) {
+        return parser.feed(chunk);
+    };
 
-        curl_easy_cleanup(curl);
-    }
+    ++totalApiCalls_;
+    HttpResponse response = HttpClient::instance().perform(request);
 
-    return response;
+    if (!response.ok) {
+        error = response.error.empty() ? "Overpass API request failed - no response" : response.error;
+        return false;
+    }
+    if (!response.isSuccess() && !parser.sawElements()) {
+        error = "Overpass API returned HTTP " + std::to_string(response.statusCode);
+        return false;
+    }
+    if (!parser.remark().empty()) {
+        // The server gave up part way; what arrived before it is still usable
+        std::cerr << "[OSM] Overpass remark: " << parser.remark() << std::endl;
+    }
+    return true;
 }
 
-// Helper to extract JSON string value
-static std::string extractJsonString(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-
-    size_t colonPos = json.find(':', keyPos + searchKey.length());
-    if (colonPos == std::string::npos) return "";
-
-    // Skip whitespace
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && std::isspace(json[valueStart])) valueStart++;
+// Tile response checks shared by searches and background refreshes
+static bool readTileResponse(const HttpResponse& response, size_t maxResults,
+                             std::vector<OSMPoi>& pois, std::string& error);
+
+namespace {
+
+/**
+ * @brief Process-wide cap on Overpass tile queries in flight
+ *
+ * The public Overpass instance grants each client about two query slots
+ * and answers 429 beyond that, so the tile queries of every session share
+ * one small window. Queries waiting for a slot are queued here rather
+ * than holding a thread.
+ */
+class OverpassSlots {
+public:
+    static OverpassSlots& instance() {
+        static OverpassSlots slots;
+        return slots;
+    }
 
-    if (valueStart >= json.length()) return "";
+    void setLimit(int limit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        limit_ = std::max(1, limit);
+    }
 
-    if (json[valueStart] == '"') {
-        // String value
-        size_t valueEnd = json.find('"', valueStart + 1);
-        if (valueEnd == std::string::npos) return "";
-        return json.substr(valueStart + 1, valueEnd - valueStart - 1);
-    } else if (json[valueStart] == '-' || std::isdigit(json[valueStart])) {
-        // Numeric value
-        size_t valueEnd = valueStart;
-        while (valueEnd < json.length() && (std::isdigit(json[valueEnd]) || json[valueEnd] == '.' || json[valueEnd] == '-')) {
-            valueEnd++;
+    /**
+     * @brief Run start now if a slot is free, otherwise once one is
+     *
+     * Whatever start sends must call release() exactly once when it ends.
+     */
+    void acquire(std::function<void()> start) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (inFlight_ >= limit_) {
+                waiting_.push_back(std::move(start));
+                return;
+            }
+            ++inFlight_;
         }
-        return json.substr(valueStart, valueEnd - valueStart);
+        start();
     }
 
-    return "";
-}
-
-// Helper to extract JSON number value
-static double extractJsonNumber(const std::string& json, const std::string& key) {
-    std::string value = extractJsonString(json, key);
-    if (value.empty()) return 0.0;
-    try {
-        return std::stod(value);
-    } catch (...) {
-        return 0.0;
+    // Hands the slot to the next waiting query, if any
+    void release() {
+        std::function<void()> next;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (waiting_.empty() || inFlight_ > limit_) {
+                --inFlight_;
+                return;
+            }
+            next = std::move(waiting_.front());
+            waiting_.pop_front();
+        }
+        next();
     }
-}
-
-// Helper to extract tags from JSON object
-static std::map<std::string, std::string> extractJsonTags(const std::string& json) {
-    std::map<std::string, std::string> tags;
 
-    size_t tagsStart = json.find("\"tags\"");
-    if (tagsStart == std::string::npos) return tags;
-
-    size_t braceStart = json.find('{', tagsStart);
-    if (braceStart == std::string::npos) return tags;
+private:
+    std::mutex mutex_;
+    int limit_ = 2;
+    int inFlight_ = 0;
+    std::deque<std::function<void()>> waiting_;
+};
 
-    // Find matching closing brace
-    int braceCount = 1;
-    size_t braceEnd = braceStart + 1;
-    while (braceEnd < json.length() && braceCount > 0) {
-        if (json[braceEnd] == '{') braceCount++;
-        else if (json[braceEnd] == '}') braceCount--;
-        braceEnd++;
-    }
+struct TileRetryPolicy {
+    int maxRetries = 0;
+    std::chrono::milliseconds base{0};
+};
 
-    std::string tagsJson = json.substr(braceStart + 1, braceEnd - braceStart - 2);
+/**
+ * @brief Send a tile query, retrying 429 and 5xx answers on the reactor
+ *
+ * A 429 pauses the host's limiter for the Retry-After time (or a jittered
+ * backoff), so every tile query waits, not just this one. done runs on
+ * the reactor with the last response.
+ */
+void sendTileQuery(const HttpRequest& request, const std::shared_ptr<RateLimiter>& limiter,
+                   const TileRetryPolicy& retry, int attempt, std::chrono::milliseconds backoff,
+                   std::function<void(HttpResponse)> done) {
+    HttpClient::instance().performAsync(request,
+        [request, limiter, retry, attempt, done](HttpResponse response) {
+            bool rateLimited = response.isRateLimited();
+            bool transient = rateLimited || (response.ok && response.statusCode >= 500);
+            if (transient && attempt < retry.maxRetries) {
+                auto delay = RateLimiter::retryDelay(response, attempt, retry.base);
+                if (rateLimited) {
+                    limiter->pause(delay);
+                    delay = std::chrono::milliseconds(0);
+                }
+                sendTileQuery(request, limiter, retry, attempt + 1, delay, done);
+                return;
+            }
+            done(std::move(response));
+        },
+        limiter->reserve() + backoff);
+}
 
-    // Parse key-value pairs
-    size_t pos = 0;
-    while (pos < tagsJson.length()) {
-        // Find key
-        size_t keyStart = tagsJson.find('"', pos);
-        if (keyStart == std::string::npos) break;
-        size_t keyEnd = tagsJson.find('"', keyStart + 1);
-        if (keyEnd == std::string::npos) break;
-        std::string key = tagsJson.substr(keyStart + 1, keyEnd - keyStart - 1);
+/**
+ * @brief Queue a tile query behind the Overpass slots
+ */
+void queueTileQuery(const HttpRequest& request, const std::shared_ptr<RateLimiter>& limiter,
+                    const TileRetryPolicy& retry, std::function<void(HttpResponse)> done) {
+    OverpassSlots::instance().acquire([request, limiter, retry, done]() {
+        sendTileQuery(request, limiter, retry, 0, std::chrono::milliseconds(0),
+            [done](HttpResponse response) {
+                OverpassSlots::instance().release();
+                done(std::move(response));
+            });
+    });
+}
 
-        // Find value
-        size_t colonPos = tagsJson.find(':', keyEnd);
-        if (colonPos == std::string::npos) break;
+} // namespace
+
+/**
+ * @brief Split the response of a query over a range of tiles into its tiles
+ * @param tiles Receives the list of every tile of the range (may be null)
+ * @return false if the query failed (error set)
+ *
+ * POIs are assigned to the tile their coordinates fall in. A tile is not
+ * cached when it reaches maxPerTile or the whole response may be
+ * truncated; its POIs are still passed to tiles. A failed query marks
+ * its tiles failed, except on a 429, which says nothing about the tiles.
+ */
+static bool storeTileResponse(OSMPoiIndex& index, const OSMPoiIndex::TileRange& range,
+                              const HttpResponse& response, size_t maxPerTile,
+                              std::vector<OSMPoiList>* tiles, std::string& error) {
+    size_t width = static_cast<size_t>(range.xMax - range.xMin + 1);
+    size_t cap = maxPerTile * range.tileCount();
 
-        size_t valueStart = tagsJson.find('"', colonPos);
-        if (valueStart == std::string::npos) break;
-        size_t valueEnd = tagsJson.find('"', valueStart + 1);
-        if (valueEnd == std::string::npos) break;
-        std::string value = tagsJson.substr(valueStart + 1, valueEnd - valueStart - 1);
+    std::vector<OSMPoi> pois;
+    if (!readTileResponse(response, cap, pois, error)) {
+        for (int32_t y = range.yMin; y <= range.yMax; ++y) {
+            for (int32_t x = range.xMin; x <= range.xMax; ++x) {
+                if (response.isRateLimited()) {
+                    index.release(OSMPoiIndex::Tile{x, y});
+                } else {
+                    index.fail(OSMPoiIndex::Tile{x, y});
+                }
+            }
+        }
+        return false;
+    }
 
-        tags[key] = value;
-        pos = valueEnd + 1;
+    bool truncated = pois.size() >= cap;
+    std::vector<std::vector<OSMPoi>> split(range.tileCount());
+    for (auto& poi : pois) {
+        OSMPoiIndex::Tile tile = OSMPoiIndex::tileAt(poi.latitude, poi.longitude);
+        if (tile.x < range.xMin || tile.x > range.xMax || tile.y < range.yMin || tile.y > range.yMax) {
+            continue;   // A way centered outside the range belongs to another tile
+        }
+        split[static_cast<size_t>(tile.y - range.yMin) * width + (tile.x - range.xMin)].push_back(std::move(poi));
     }
 
-    return tags;
+    for (int32_t y = range.yMin; y <= range.yMax; ++y) {
+        for (int32_t x = range.xMin; x <= range.xMax; ++x) {
+            OSMPoiIndex::Tile tile{x, y};
+            auto& tilePois = split[static_cast<size_t>(y - range.yMin) * width + (x - range.xMin)];
+            OSMPoiList list;
+            if (truncated || tilePois.size() >= maxPerTile) {
+                // Possibly incomplete: used for this search but not cached
+                list = std::make_shared<const std::vector<OSMPoi>>(std::move(tilePois));
+                index.release(tile, list);
+            } else {
+                list = index.insert(tile, std::move(tilePois));
+            }
+            if (tiles) {
+                tiles->push_back(std::move(list));
+            }
+        }
+    }
+    return true;
 }
 
-std::vector<OSMPoi> OpenStreetMapAPI::parseOverpassResponse(const std::string& json) {
-    std::vector<OSMPoi> pois;
+bool OpenStreetMapAPI::fetchMissingTiles(
+    double lat,
+    double lon,
+    double radiusMeters,
+    std::vector<OSMPoiList>& tiles,
+    std::string& error
+) {
+    OSMPoiIndex::Policy policy;
+    policy.maxAgeSeconds = config_.cacheDurationMinutes * 60;
+    policy.staleSeconds = config_.cacheStaleMinutes * 60;
+    policy.negativeSeconds = config_.negativeCacheSeconds;
+
+    auto claim = poiCache_->claim(OSMPoiIndex::tilesAround(lat, lon, radiusMeters), policy);
+    tiles = std::move(claim.cached);
+    size_t maxPerTile = static_cast<size_t>(std::max(1, config_.tileMaxResults));
+    size_t maxTilesPerQuery = static_cast<size_t>(std::max(1, config_.maxTilesPerQuery));
+
+    OverpassSlots::instance().setLimit(config_.maxParallelTileFetches);
+    auto limiter = RateLimiter::shared(RateLimiter::hostOf(config_.overpassEndpoint),
+                                       config_.overpassRequestsPerSecond);
+    TileRetryPolicy retry;
+    retry.maxRetries = std::max(0, config_.maxRetries);
+    retry.base = std::chrono::milliseconds(config_.retryDelayMs);
+
+    auto tileQuery = [&](const OSMPoiIndex::TileRange& range) {
+        size_t cap = maxPerTile * range.tileCount();
+        return buildOverpassRequest(buildCateringProspectQuery(
+            range.south(), range.west(), range.north(), range.east(), static_cast<int>(cap)));
+    };
 
-    // Check for error
-    if (json.find("\"error\"") != std::string::npos) {
-        return pois;
+    // Stale tiles are refetched in the background; until a refresh
+    // completes the stale copy is served, and if it fails the copy is kept
+    std::shared_ptr<OSMPoiIndex> index = poiCache_;
+    for (const auto& range : OSMPoiIndex::coalesce(claim.refresh, maxTilesPerQuery)) {
+        ++totalApiCalls_;
+        queueTileQuery(tileQuery(range), limiter, retry,
+            [index, range, maxPerTile](HttpResponse response) {
+                std::string refreshError;
+                storeTileResponse(*index, range, response, maxPerTile, nullptr, refreshError);
+            });
     }
 
-    // Find "elements" array
-    size_t elementsPos = json.find("\"elements\"");
-    if (elementsPos == std::string::npos) {
-        return pois;
+    // Adjacent missing tiles share one bbox query; every query is queued
+    // at once and the Overpass slots pace them
+    auto ranges = OSMPoiIndex::coalesce(claim.fetch, maxTilesPerQuery);
+    std::vector<std::future<HttpResponse>> responses;
+    for (const auto& range : ranges) {
+        auto promise = std::make_shared<std::promise<HttpResponse>>();
+        responses.push_back(promise->get_future());
+        ++totalApiCalls_;
+        queueTileQuery(tileQuery(range), limiter, retry, [promise](HttpResponse response) {
+            promise->set_value(std::move(response));
+        });
     }
 
-    size_t arrayStart = json.find('[', elementsPos);
-    if (arrayStart == std::string::npos) {
-        return pois;
+    size_t failed = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        std::string queryError;
+        if (!storeTileResponse(*poiCache_, ranges[i], responses[i].get(), maxPerTile, &tiles, queryError)) {
+            error = queryError;
+            failed += ranges[i].tileCount();
+        }
     }
 
-    // Parse each element object
-    size_t pos = arrayStart + 1;
-    while (pos < json.length()) {
-        // Find next object
-        size_t objStart = json.find('{', pos);
-        if (objStart == std::string::npos) break;
-
-        // Find end of object (matching brace)
-        int braceCount = 1;
-        size_t objEnd = objStart + 1;
-        while (objEnd < json.length() && braceCount > 0) {
-            if (json[objEnd] == '{') braceCount++;
-            else if (json[objEnd] == '}') braceCount--;
-            objEnd++;
+    // Tiles another search is fetching are merged once it has them
+    for (const auto& pending : claim.pending) {
+        if (OSMPoiList pois = pending.get()) {
+            tiles.push_back(std::move(pois));
         }
+    }
 
-        std::string objJson = json.substr(objStart, objEnd - objStart);
+    const auto& missing = claim.fetch;
+    if (failed > 0) {
+        std::cerr << "[OSM] " << failed << " of " << missing.size()
+                  << " tiles failed: " << error << std::endl;
+    }
 
-        OSMPoi poi;
+    // Tiles that failed recently count as failed without a request
+    size_t attempted = missing.size() + static_cast<size_t>(claim.failed);
+    failed += static_cast<size_t>(claim.failed);
+    if (claim.failed > 0 && error.empty()) {
+        error = "Overpass API failed for this area recently; retrying shortly";
+    }
+    return failed == 0 || failed < attempted;
+}
 
-        // Extract basic fields
-        poi.osmType = extractJsonString(objJson, "type");
-        std::string idStr = extractJsonString(objJson, "id");
-        if (!idStr.empty()) {
-            try {
-                poi.osmId = std::stoll(idStr);
-            } catch (...) {
-                poi.osmId = 0;
-            }
-        }
+HttpRequest OpenStreetMapAPI::buildOverpassRequest(const std::string& query) const {
+    HttpRequest request;
+    request.url = config_.overpassEndpoint;
+    request.method = "POST";
+    request.body = "data=" + query;
+    request.timeoutMs = config_.requestTimeoutMs;
+    request.connectTimeoutMs = config_.connectTimeoutMs;
+    request.userAgent = config_.userAgent;
+    // Enable compression for faster transfer (works well with lz4 endpoint)
+    request.acceptCompressed = true;
+    return request;
+}
 
-        // Get coordinates - check for "center" (for ways) or direct lat/lon (for nodes)
-        if (objJson.find("\"center\"") != std::string::npos) {
-            size_t centerPos = objJson.find("\"center\"");
-            size_t centerStart = objJson.find('{', centerPos);
-            size_t centerEnd = objJson.find('}', centerStart);
-            if (centerStart != std::string::npos && centerEnd != std::string::npos) {
-                std::string centerJson = objJson.substr(centerStart, centerEnd - centerStart + 1);
-                poi.latitude = extractJsonNumber(centerJson, "lat");
-                poi.longitude = extractJsonNumber(centerJson, "lon");
-            }
-        } else {
-            poi.latitude = extractJsonNumber(objJson, "lat");
-            poi.longitude = extractJsonNumber(objJson, "lon");
+std::string OpenStreetMapAPI::executeNominatimQuery(const std::string& endpoint) {
+    HttpRequest request;
+    request.url = endpoint;
+    request.timeoutMs = config_.requestTimeoutMs;
+    request.connectTimeoutMs = config_.connectTimeoutMs;
+    request.userAgent = config_.userAgent;
+    request.acceptCompressed = true;
+
+    // Same per-host limiter as NominatimGeocodingService; the reactor holds
+    // the request until it has a token
+    auto limiter = RateLimiter::shared(RateLimiter::hostOf(config_.nominatimEndpoint),
+                                       config_.nominatimRequestsPerSecond);
+    HttpResponse response;
+    auto backoff = std::chrono::milliseconds(0);
+    for (int attempt = 0; ; ++attempt) {
+        response = HttpClient::instance().performAsync(request,
+            std::max(backoff, limiter->reserve())).get();
+
+        bool rateLimited = response.isRateLimited();
+        if (!rateLimited && response.statusCode < 500) {
+            break;
         }
+        auto retryDelay = RateLimiter::retryDelay(response, attempt,
+                                                  std::chrono::milliseconds(config_.retryDelayMs));
+        if (rateLimited) {
+            // Every request to the host waits out Retry-After; the retry
+            // reserves its token after the pause
+            limiter->pause(retryDelay);
+        }
+        if (attempt >= config_.maxRetries) {
+            break;
+        }
+        backoff = rateLimited ? std::chrono::milliseconds(0) : retryDelay;
+    }
+    if (!response.ok) {
+        return "{\"error\": \"" + response.error + "\"}";
+    }
 
-        // Extract tags
-        poi.tags = extractJsonTags(objJson);
-
-        // Set common tag fields
-        auto tagIt = poi.tags.find("name");
-        if (tagIt != poi.tags.end()) poi.name = tagIt->second;
-
-        tagIt = poi.tags.find("amenity");
-        if (tagIt != poi.tags.end()) poi.amenity = tagIt->second;
+    return response.body;
+}
 
-        tagIt = poi.tags.find("building");
-        if (tagIt != poi.tags.end()) poi.building = tagIt->second;
+// Generate a name from the POI's type if it has none
+static void nameFromType(OSMPoi& poi) {
+    if (!poi.name().empty()) {
+        return;
+    }
+    std::string name;
+    if (!poi.office().empty()) {
+        name = "Office (" + std::string(poi.office()) + ")";
+    } else if (!poi.building().empty()) {
+        name = "Building (" + std::string(poi.building()) + ")";
+    } else if (!poi.amenity().empty()) {
+        name = std::string(poi.amenity());
+        name[0] = static_cast<char>(::toupper(static_cast<unsigned char>(name[0])));
+    } else if (!poi.tourism().empty()) {
+        name = std::string(poi.tourism());
+    }
+    if (!name.empty()) {
+        poi.tags.set(OSMKey::Name, name);
+    }
+}
 
-        tagIt = poi.tags.find("office");
-        if (tagIt != poi.tags.end()) poi.office = tagIt->second;
+// Helper to read an element's "tags" object into the POI
+static void readTags(const JsonValue& tagsJson, OSMPoi& poi) {
+    tagsJson.forEachMember([&poi](std::string_view key, const JsonValue& value) {
+        poi.tags.set(jsonUnescape(key), value.asString());
+    });
+}
 
-        tagIt = poi.tags.find("shop");
-        if (tagIt != poi.tags.end()) poi.shop = tagIt->second;
+// Read one element of an Overpass "elements" array in a single pass over
+// its members. Returns false if it has no usable coordinates.
+static bool readElement(const JsonValue& element, OSMPoi& poi) {
+    JsonValue center;
+
+    element.forEachMember([&](std::string_view key, const JsonValue& value) {
+        if (key == "type") {
+            poi.osmType = value.asString();
+        } else if (key == "id") {
+            poi.osmId = value.asInt64();
+        } else if (key == "lat") {
+            poi.latitude = value.asDouble();
+        } else if (key == "lon") {
+            poi.longitude = value.asDouble();
+        } else if (key == "center") {
+            center = value;
+        } else if (key == "tags") {
+            readTags(value, poi);
+        }
+    });
 
-        tagIt = poi.tags.find("tourism");
-        if (tagIt != poi.tags.end()) poi.tourism = tagIt->second;
+    // Ways and relations carry their coordinates in "center"
+    if (center.isObject()) {
+        poi.latitude = center["lat"].asDouble();
+        poi.longitude = center["lon"].asDouble();
+    }
 
-        tagIt = poi.tags.find("healthcare");
-        if (tagIt != poi.tags.end()) poi.healthcare = tagIt->second;
+    // Only POIs with valid coordinates; unnamed ones are named after their type
+    if (poi.latitude == 0.0 || poi.longitude == 0.0) {
+        return false;
+    }
+    nameFromType(poi);
+    poi.tags.shrinkToFit();
+    return true;
+}
 
-        // Address info
-        tagIt = poi.tags.find("addr:street");
-        if (tagIt != poi.tags.end()) poi.street = tagIt->second;
+// ===== OverpassStreamParser =====
 
-        tagIt = poi.tags.find("addr:housenumber");
-        if (tagIt != poi.tags.end()) poi.houseNumber = tagIt->second;
+bool OverpassStreamParser::feed(std::string_view chunk) {
+    if (stopped_) {
+        return false;
+    }
+    buffer_.append(chunk.data(), chunk.size());
+
+    for (; pos_ < buffer_.size(); ++pos_) {
+        char c = buffer_[pos_];
+
+        if (inString_) {
+            if (escaped_) {
+                escaped_ = false;
+            } else if (c == '\\') {
+                escaped_ = true;
+            } else if (c == '"') {
+                inString_ = false;
+                if (depth_ == 1) {
+                    topLevelString(std::string_view(buffer_).substr(tokenStart_ + 1, pos_ - tokenStart_ - 1));
+                }
+            }
+            continue;
+        }
 
-        tagIt = poi.tags.find("addr:city");
-        if (tagIt != poi.tags.end()) poi.city = tagIt->second;
+        switch (c) {
+            case '"':
+                inString_ = true;
+                if (depth_ == 1) {
+                    tokenStart_ = pos_;
+                }
+                break;
+            case ':':
+                if (depth_ == 1) {
+                    afterColon_ = true;
+                }
+                break;
+            case ',':
+                if (depth_ == 1) {
+                    afterColon_ = false;
+                }
+                break;
+            case '{':
+            case '[':
+                if (depth_ == 1 && c == '[' && key_ == "elements") {
+                    inElements_ = true;
+                    sawElements_ = true;
+                } else if (inElements_ && depth_ == 2 && c == '{') {
+                    elementStart_ = pos_;
+                }
+                ++depth_;
+                break;
+            case '}':
+            case ']':
+                --depth_;
+                if (inElements_ && depth_ == 2 && c == '}' && elementStart_ != std::string::npos) {
+                    if (!emitElement(std::string_view(buffer_).substr(elementStart_, pos_ - elementStart_ + 1))) {
+                        stopped_ = true;
+                        return false;
+                    }
+                    elementStart_ = std::string::npos;
+                } else if (inElements_ && depth_ == 1) {
+                    inElements_ = false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
 
-        tagIt = poi.tags.find("addr:postcode");
-        if (tagIt != poi.tags.end()) poi.postcode = tagIt->second;
+    // Keep only the element or top-level string still being read
+    size_t keepFrom = pos_;
+    if (elementStart_ != std::string::npos) {
+        keepFrom = elementStart_;
+    } else if (inString_ && depth_ == 1) {
+        keepFrom = tokenStart_;
+    }
+    buffer_.erase(0, keepFrom);
+    pos_ -= keepFrom;
+    if (elementStart_ != std::string::npos) elementStart_ -= keepFrom;
+    if (tokenStart_ != std::string::npos && tokenStart_ >= keepFrom) tokenStart_ -= keepFrom;
+    return true;
+}
 
-        tagIt = poi.tags.find("addr:state");
-        if (tagIt != poi.tags.end()) poi.state = tagIt->second;
+void OverpassStreamParser::topLevelString(std::string_view text) {
+    if (!afterColon_) {
+        key_ = jsonUnescape(text);
+    } else if (key_ == "remark") {
+        remark_ = jsonUnescape(text);
+    }
+}
 
-        tagIt = poi.tags.find("addr:country");
-        if (tagIt != poi.tags.end()) poi.country = tagIt->second;
+bool OverpassStreamParser::emitElement(std::string_view text) {
+    OSMPoi poi;
+    if (!readElement(JsonValue::parse(text), poi)) {
+        return true;
+    }
+    ++count_;
+    return sink_(std::move(poi));
+}
 
-        // Contact info
-        tagIt = poi.tags.find("phone");
-        if (tagIt != poi.tags.end()) poi.phone = tagIt->second;
+std::vector<OSMPoi> OpenStreetMapAPI::parseOverpassResponse(const std::string& json) {
+    return parseOverpassResponse(json, static_cast<size_t>(std::max(0, config_.maxResultsPerQuery)));
+}
 
-        tagIt = poi.tags.find("website");
-        if (tagIt != poi.tags.end()) poi.website = tagIt->second;
+std::vector<OSMPoi> OpenStreetMapAPI::parseOverpassResponse(const std::string& json, size_t maxResults) {
+    std::vector<OSMPoi> pois;
 
-        tagIt = poi.tags.find("email");
-        if (tagIt != poi.tags.end()) poi.email = tagIt->second;
+    JsonValue root = JsonValue::parse(json);
 
-        tagIt = poi.tags.find("opening_hours");
-        if (tagIt != poi.tags.end()) poi.openingHours = tagIt->second;
+    // Check for error
+    if (!root.isObject() || root["error"].exists() || maxResults == 0) {
+        return pois;
+    }
 
-        // Only add POIs with valid coordinates and preferably a name
-        if (poi.latitude != 0.0 && poi.longitude != 0.0) {
-            // Generate a name from type if name is empty
-            if (poi.name.empty()) {
-                if (!poi.office.empty()) {
-                    poi.name = "Office (" + poi.office + ")";
-                } else if (!poi.building.empty()) {
-                    poi.name = "Building (" + poi.building + ")";
-                } else if (!poi.amenity.empty()) {
-                    poi.name = poi.amenity.substr(0, 1);
-                    std::transform(poi.name.begin(), poi.name.end(), poi.name.begin(), ::toupper);
-                    poi.name += poi.amenity.substr(1);
-                } else if (!poi.tourism.empty()) {
-                    poi.name = poi.tourism;
-                }
-            }
-            pois.push_back(poi);
+    // Walk the "elements" array once, stopping at maxResults
+    root["elements"].forEachElement([&](const JsonValue& element) {
+        OSMPoi poi;
+        if (readElement(element, poi)) {
+            pois.push_back(std::move(poi));
         }
+        return pois.size() < maxResults;
+    });
 
-        pos = objEnd;
-        if (pos < json.length() && json[pos] == ']') break;
-    }
+    return pois;
+}
 
-    // Limit results to configured maximum
-    if (pois.size() > static_cast<size_t>(config_.maxResultsPerQuery)) {
-        pois.resize(config_.maxResultsPerQuery);
+static bool readTileResponse(const HttpResponse& response, size_t maxResults,
+                             std::vector<OSMPoi>& pois, std::string& error) {
+    JsonValue root = JsonValue::parse(response.body);
+    if (!response.ok) {
+        error = response.error;
+    } else if (!response.isSuccess()) {
+        error = "Overpass API returned HTTP " + std::to_string(response.statusCode);
+    } else if (!root.isObject()) {
+        error = "Overpass API returned an invalid response";
+    } else if (root["remark"].exists()) {
+        // Sent when the server gave up part way (e.g. timeout); the
+        // elements before it are not the whole tile
+        error = root["remark"].asString();
+    }
+    if (!error.empty()) {
+        return false;
     }
 
-    return pois;
+    root["elements"].forEachElement([&](const JsonValue& element) {
+        OSMPoi poi;
+        if (readElement(element, poi)) {
+            pois.push_back(std::move(poi));
+        }
+        return pois.size() < maxResults;
+    });
+    return true;
 }
 
 OSMPoi OpenStreetMapAPI::parseNominatimResponse(const std::string& json) {
     OSMPoi poi;
 
-    // Check for error or empty result
-    if (json.empty() || json.find("\"error\"") != std::string::npos || json == "[]") {
-        return poi;
-    }
+    JsonValue root = JsonValue::parse(json);
 
     // Handle array response (search returns array)
-    std::string objJson = json;
-    if (json[0] == '[') {
-        size_t objStart = json.find('{');
-        if (objStart == std::string::npos) return poi;
-        size_t objEnd = json.find('}', objStart);
-        if (objEnd == std::string::npos) return poi;
-        objJson = json.substr(objStart, objEnd - objStart + 1);
+    JsonValue place = root;
+    if (root.isArray()) {
+        root.forEachElement([&place](const JsonValue& first) {
+            place = first;
+            return false;
+        });
     }
 
-    poi.latitude = extractJsonNumber(objJson, "lat");
-    poi.longitude = extractJsonNumber(objJson, "lon");
-    poi.name = extractJsonString(objJson, "display_name");
+    // Check for error or empty result
+    if (!place.isObject() || place["error"].exists()) {
+        return poi;
+    }
+
+    JsonObject fields(place);
+    poi.latitude = fields["lat"].asDouble();
+    poi.longitude = fields["lon"].asDouble();
+    poi.tags.set(OSMKey::Name, fields["display_name"].asString());
 
     // Extract address components if present
-    size_t addrPos = objJson.find("\"address\"");
-    if (addrPos != std::string::npos) {
-        size_t addrStart = objJson.find('{', addrPos);
-        size_t addrEnd = objJson.find('}', addrStart);
-        if (addrStart != std::string::npos && addrEnd != std::string::npos) {
-            std::string addrJson = objJson.substr(addrStart, addrEnd - addrStart + 1);
-            poi.street = extractJsonString(addrJson, "road");
-            poi.houseNumber = extractJsonString(addrJson, "house_number");
-            poi.city = extractJsonString(addrJson, "city");
-            if (poi.city.empty()) poi.city = extractJsonString(addrJson, "town");
-            if (poi.city.empty()) poi.city = extractJsonString(addrJson, "village");
-            poi.state = extractJsonString(addrJson, "state");
-            poi.postcode = extractJsonString(addrJson, "postcode");
-            poi.country = extractJsonString(addrJson, "country");
+    JsonValue addressJson = fields["address"];
+    if (addressJson.isObject()) {
+        JsonObject address(addressJson);
+        std::string city = address["city"].asString();
+        if (city.empty()) city = address["town"].asString();
+        if (city.empty()) city = address["village"].asString();
+
+        const std::pair<OSMKey, std::string> fields[] = {
+            {OSMKey::AddrStreet, address["road"].asString()},
+            {OSMKey::AddrHouseNumber, address["house_number"].asString()},
+            {OSMKey::AddrCity, city},
+            {OSMKey::AddrState, address["state"].asString()},
+            {OSMKey::AddrPostcode, address["postcode"].asString()},
+            {OSMKey::AddrCountry, address["country"].asString()}
+        };
+        for (const auto& field : fields) {
+            if (!field.second.empty()) {
+                poi.tags.set(field.first, field.second);
+            }
         }
     }
 
@@ -1019,31 +1578,27 @@ std::vector<OSMPoi> OpenStreetMapAPI::generateDemoPOIs(
 
         poi.osmId = idDist(gen);
         poi.osmType = "way";
-        poi.name = name;
+        poi.tags.set(OSMKey::Name, name);
         poi.latitude = lat + latDist(gen) * (radiusMeters / 1000.0);
         poi.longitude = lon + lonDist(gen) * (radiusMeters / 1000.0);
 
         // Set the appropriate tag
-        poi.tags[tagKey] = tagValue;
-        if (tagKey == "office") poi.office = tagValue;
-        else if (tagKey == "building") poi.building = tagValue;
-        else if (tagKey == "amenity") poi.amenity = tagValue;
-        else if (tagKey == "tourism") poi.tourism = tagValue;
+        poi.tags.set(tagKey, tagValue);
 
         // Address
-        poi.houseNumber = std::to_string(100 + i * 50);
-        poi.street = streets[i % streets.size()];
-        poi.city = "Sample City";
-        poi.state = "ST";
-        poi.postcode = "12345";
-        poi.country = "USA";
+        poi.tags.set(OSMKey::AddrHouseNumber, std::to_string(100 + i * 50));
+        poi.tags.set(OSMKey::AddrStreet, streets[i % streets.size()]);
+        poi.tags.set(OSMKey::AddrCity, "Sample City");
+        poi.tags.set(OSMKey::AddrState, "ST");
+        poi.tags.set(OSMKey::AddrPostcode, "12345");
+        poi.tags.set(OSMKey::AddrCountry, "USA");
 
         // Contact info (random generation)
-        poi.phone = "(555) " + std::to_string(100 + i) + "-" + std::to_string(1000 + i * 111);
+        poi.tags.set(OSMKey::Phone, "(555) " + std::to_string(100 + i) + "-" + std::to_string(1000 + i * 111));
         std::string domain = name.substr(0, name.find(' '));
         std::transform(domain.begin(), domain.end(), domain.begin(), ::tolower);
-        poi.website = "www." + domain + ".com";
-        poi.email = "info@" + domain + ".com";
+        poi.tags.set(OSMKey::Website, "www." + domain + ".com");
+        poi.tags.set(OSMKey::Email, "info@" + domain + ".com");
 
         pois.push_back(poi);
     }
@@ -1100,6 +1655,46 @@ OSMAreaStats OpenStreetMapAPI::generateDemoAreaStats(
     return stats;
 }
 
+void OSMAreaStats::setCounts(const OSMAreaCounts& counts) {
+    auto count = [&counts](OSMAreaStat stat) {
+        return static_cast<int>(counts[static_cast<size_t>(stat)]);
+    };
+
+    offices = count(OSMAreaStat::Offices);
+    restaurants = count(OSMAreaStat::Restaurants);
+    cafes = count(OSMAreaStat::Cafes);
+    hotels = count(OSMAreaStat::Hotels);
+    conferenceVenues = count(OSMAreaStat::ConferenceVenues);
+    hospitals = count(OSMAreaStat::Hospitals);
+    schools = count(OSMAreaStat::Schools);
+    universities = count(OSMAreaStat::Universities);
+    industrialBuildings = count(OSMAreaStat::IndustrialBuildings);
+    warehouses = count(OSMAreaStat::Warehouses);
+    shops = count(OSMAreaStat::Shops);
+    banks = count(OSMAreaStat::Banks);
+    governmentBuildings = count(OSMAreaStat::GovernmentBuildings);
+    parkingLots = count(OSMAreaStat::ParkingLots);
+    busStops = count(OSMAreaStat::BusStops);
+    railwayStations = count(OSMAreaStat::RailwayStations);
+
+    totalPois = offices + restaurants + cafes + hotels + conferenceVenues + hospitals +
+                schools + universities + industrialBuildings + warehouses + shops + banks +
+                governmentBuildings;
+
+    calculateMetrics();
+}
+
+uint32_t OSMAreaStats::classify(const std::function<std::string_view(std::string_view)>& tag) {
+    uint32_t mask = 0;
+    for (const auto& filter : kAreaStatFilters) {
+        std::string_view value = tag(filter.key);
+        if (!value.empty() && (filter.value.empty() || value == filter.value)) {
+            mask |= 1u << static_cast<uint32_t>(filter.stat);
+        }
+    }
+    return mask;
+}
+
 void OSMAreaStats::calculateMetrics() {
     // Calculate business density
     double areaSqKm = 3.14159 * radiusKm * radiusKm;
@@ -1204,11 +1799,13 @@ void OpenStreetMapAPI::getAreaStatistics(
     );
 }
 
-OSMAreaStats OpenStreetMapAPI::getAreaStatisticsSync(const Models::SearchArea& searchArea) {
+OSMAreaStats OpenStreetMapAPI::getAreaStatisticsSync(const Models::SearchArea& searchArea,
+                                                     std::string* error) {
     return getAreaStatisticsSync(
         searchArea.center.latitude,
         searchArea.center.longitude,
-        searchArea.radiusKm
+        searchArea.radiusKm,
+        error
     );
 }
 
@@ -1226,11 +1823,11 @@ void OpenStreetMapAPI::searchNearby(
 
 Models::GeoLocation OpenStreetMapAPI::poiToGeoLocation(const OSMPoi& poi) {
     Models::GeoLocation location(poi.latitude, poi.longitude);
-    location.street = poi.houseNumber.empty() ? poi.street : poi.houseNumber + " " + poi.street;
-    location.city = poi.city;
-    location.state = poi.state;
-    location.postalCode = poi.postcode;
-    location.country = poi.country.empty() ? "USA" : poi.country;
+    location.street = poi.streetAddress();
+    location.city = std::string(poi.city());
+    location.state = std::string(poi.state());
+    location.postalCode = std::string(poi.postcode());
+    location.country = poi.country().empty() ? "USA" : std::string(poi.country());
     location.source = "openstreetmap";
 
     // Build formatted address
@@ -1267,82 +1864,280 @@ std::vector<OSMPoi> OpenStreetMapAPI::searchByCategorySync(
     const Models::SearchArea& searchArea,
     const std::string& category
 ) {
-    ++totalApiCalls_;
+    return searchByCategoriesSync(searchArea, {category})[category];
+}
+
+std::map<std::string, std::vector<OSMPoi>> OpenStreetMapAPI::searchByCategoriesSync(
+    const Models::SearchArea& searchArea,
+    const std::vector<std::string>& categories
+) {
+    std::map<std::string, std::vector<OSMPoi>> results;
+    std::vector<std::string> known;
+    for (const auto& category : categories) {
+        results[category];
+        std::string categoryLower = toLower(category);
+        if (isKnownCategory(categoryLower) &&
+            std::find(known.begin(), known.end(), categoryLower) == known.end()) {
+            known.push_back(categoryLower);
+        }
+    }
+    if (known.empty()) {
+        // Unknown categories only - nothing to query
+        return results;
+    }
+
+    double lat = searchArea.center.latitude;
+    double lon = searchArea.center.longitude;
+
+    if (coveredByExtract(lat, lon, searchArea.radiusMeters())) {
+        for (const auto& category : categories) {
+            std::string categoryLower = toLower(category);
+            results[category] = queryExtract(lat, lon, searchArea.radiusMeters(),
+                [&categoryLower](const OSMPoiView& poi) {
+                    return matchesCategory(poi, categoryLower);
+                });
+        }
+        return results;
+    }
 
-    // Normalize category name
-    std::string categoryLower = category;
-    std::transform(categoryLower.begin(), categoryLower.end(), categoryLower.begin(), ::tolower);
+    // One request for every category; the response is split up below
+    std::string error;
+    auto pois = fetchPois(buildCategoryQuery(searchArea, known), std::numeric_limits<size_t>::max(), error);
+    if (!error.empty()) {
+        std::cerr << "[OSM] Category search failed: " << error << std::endl;
+        return results;
+    }
+
+    // The query covers the bounding box; keep the circle, nearest first
+    std::vector<std::pair<double, const OSMPoi*>> inRadius;
+    for (const auto& poi : pois) {
+        double distanceKm = searchArea.center.distanceToKm(Models::GeoLocation(poi.latitude, poi.longitude));
+        if (distanceKm <= searchArea.radiusKm) {
+            inRadius.emplace_back(distanceKm, &poi);
+        }
+    }
+    std::stable_sort(inRadius.begin(), inRadius.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    size_t limit = static_cast<size_t>(std::max(0, config_.maxResultsPerQuery));
+    for (const auto& category : categories) {
+        std::string categoryLower = toLower(category);
+        auto& matches = results[category];
+        for (const auto& entry : inRadius) {
+            if (matches.size() >= limit) break;
+            if (matchesCategory(*entry.second, categoryLower)) {
+                matches.push_back(*entry.second);
+            }
+        }
+    }
+    return results;
+}
+
+void OpenStreetMapAPI::searchByCategoriesStreaming(
+    const Models::SearchArea& searchArea,
+    const std::vector<std::string>& categories,
+    const CategorySink& sink
+) {
+    size_t limit = static_cast<size_t>(std::max(0, config_.maxResultsPerQuery));
+    std::vector<std::string> lower;
+    std::vector<std::string> known;
+    for (const auto& category : categories) {
+        lower.push_back(toLower(category));
+        if (isKnownCategory(lower.back()) &&
+            std::find(known.begin(), known.end(), lower.back()) == known.end()) {
+            known.push_back(lower.back());
+        }
+    }
+    if (known.empty() || limit == 0) {
+        return;
+    }
+
+    // The extract answers at once; hand its results over category by category
+    if (coveredByExtract(searchArea.center.latitude, searchArea.center.longitude,
+                         searchArea.radiusMeters())) {
+        for (const auto& [category, pois] : searchByCategoriesSync(searchArea, categories)) {
+            for (const auto& poi : pois) {
+                if (!sink(category, poi)) return;
+            }
+        }
+        return;
+    }
+
+    // Categories still short of the limit
+    std::vector<size_t> counts(categories.size(), 0);
+    size_t open = 0;
+    for (const auto& category : lower) {
+        if (isKnownCategory(category)) ++open;
+    }
+
+    std::string error;
+    streamPois(buildCategoryQuery(searchArea, known), std::numeric_limits<size_t>::max(),
+        [&](OSMPoi&& poi) {
+            // The query covers the bounding box; keep the circle
+            double distanceKm = searchArea.center.distanceToKm(Models::GeoLocation(poi.latitude, poi.longitude));
+            if (distanceKm > searchArea.radiusKm) {
+                return true;
+            }
+            for (size_t i = 0; i < categories.size(); ++i) {
+                if (counts[i] >= limit || !matchesCategory(poi, lower[i])) {
+                    continue;
+                }
+                if (!sink(categories[i], poi)) {
+                    return false;
+                }
+                if (++counts[i] == limit) {
+                    --open;
+                }
+            }
+            return open > 0;
+        }, error);
+
+    if (!error.empty()) {
+        std::cerr << "[OSM] Category search failed: " << error << std::endl;
+    }
+}
+
+std::string OpenStreetMapAPI::buildAreaStatsQuery(
+    double lat,
+    double lon,
+    int radiusMeters
+) {
+    std::ostringstream around;
+    around << std::fixed << std::setprecision(6);
+    around << "(around:" << radiusMeters << "," << lat << "," << lon << ")";
+
+    // The circle rather than a bbox, so densities match the extract path.
+    // "out count" returns one small element per union instead of its members.
+    std::ostringstream query;
+    query << "[out:json][timeout:25];";
+    for (size_t stat = 0; stat < static_cast<size_t>(OSMAreaStat::Count); ++stat) {
+        query << "(";
+        for (const auto& filter : kAreaStatFilters) {
+            if (static_cast<size_t>(filter.stat) != stat) {
+                continue;
+            }
+            query << "nw[\"" << filter.key << "\"";
+            if (!filter.value.empty()) {
+                query << "=\"" << filter.value << "\"";
+            }
+            query << "]" << around.str() << ";";
+        }
+        query << ");out count;";
+    }
+    return query.str();
+}
+
+std::string OpenStreetMapAPI::buildCategoryQuery(
+    const Models::SearchArea& searchArea,
+    const std::vector<std::string>& categories
+) {
+    auto box = Models::GeoBoundingBox::fromSearchArea(searchArea);
 
-    // Build Overpass query for this category
     std::ostringstream query;
     query << std::fixed << std::setprecision(6);
-    query << "[out:json][timeout:30];(";
+    query << "[out:json][timeout:25][bbox:" << box.minLat << "," << box.minLon << ","
+          << box.maxLat << "," << box.maxLon << "];(";
 
-    int radiusMeters = searchArea.radiusMeters();
-    double lat = searchArea.center.latitude;
-    double lon = searchArea.center.longitude;
+    // Union of every filter of every category; "nw" covers nodes and ways
+    for (const auto& filter : kCategoryFilters) {
+        if (std::find(categories.begin(), categories.end(), filter.category) == categories.end()) {
+            continue;
+        }
+        query << filter.elements << "[\"" << filter.key << "\"";
+        if (!filter.value.empty()) {
+            query << "=\"" << filter.value << "\"";
+        }
+        query << "];";
+    }
 
-    // Category-specific queries
-    if (categoryLower == "offices") {
-        query << "node[\"office\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"office\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"building\"=\"office\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"building\"=\"commercial\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "hotels") {
-        query << "node[\"tourism\"=\"hotel\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"tourism\"=\"hotel\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "node[\"tourism\"=\"motel\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"tourism\"=\"motel\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "conference") {
-        query << "node[\"amenity\"=\"conference_centre\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"conference_centre\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "node[\"amenity\"=\"events_venue\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"events_venue\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "hospitals") {
-        query << "node[\"amenity\"=\"hospital\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"hospital\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "node[\"amenity\"=\"clinic\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"clinic\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "universities") {
-        query << "node[\"amenity\"=\"university\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"university\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "node[\"amenity\"=\"college\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"college\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "schools") {
-        query << "node[\"amenity\"=\"school\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"school\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "industrial") {
-        query << "way[\"building\"=\"industrial\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"landuse\"=\"industrial\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "warehouses") {
-        query << "way[\"building\"=\"warehouse\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "banks") {
-        query << "node[\"amenity\"=\"bank\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"bank\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "node[\"office\"=\"financial\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"office\"=\"financial\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "government") {
-        query << "node[\"office\"=\"government\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"office\"=\"government\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"building\"=\"government\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "restaurants") {
-        query << "node[\"amenity\"=\"restaurant\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"restaurant\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else if (categoryLower == "cafes") {
-        query << "node[\"amenity\"=\"cafe\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-        query << "way[\"amenity\"=\"cafe\"](around:" << radiusMeters << "," << lat << "," << lon << ");";
-    } else {
-        // Unknown category - return empty
-        return {};
+    query << ");out center qt;";
+    return query.str();
+}
+
+// ===== Tile cache =====
+
+std::vector<OSMPoi> OpenStreetMapAPI::queryPoiCache(
+    double lat,
+    double lon,
+    double radiusMeters,
+    const std::vector<OSMPoiList>& tiles
+) {
+    return OSMPoiIndex::nearestWithin(lat, lon, radiusMeters,
+                                      static_cast<size_t>(std::max(0, config_.maxResultsPerQuery)),
+                                      tiles);
+}
+
+// ===== Local extract =====
+
+void OpenStreetMapAPI::openExtract() {
+    extract_.reset();
+    extractImporting_ = false;
+    if (config_.extractStorePath.empty()) {
+        return;
     }
 
-    query << ");out center;";
+    // Maps an existing store only; a missing one is imported once in the
+    // background and Overpass answers until it is ready
+    std::string error;
+    extract_ = OSMExtractStore::openOrStartImport(config_.extractStorePath, config_.extractPbfPath,
+                                                  &error, &extractImporting_);
+    if (!extract_) {
+        std::cerr << "[OSM] Local extract unavailable, using Overpass: " << error << std::endl;
+    }
+}
+
+bool OpenStreetMapAPI::coveredByExtract(double lat, double lon, double radiusMeters) {
+    // Pick up the store once its background import has finished
+    if (extractImporting_) {
+        extract_ = OSMExtractStore::openOrStartImport(config_.extractStorePath, config_.extractPbfPath,
+                                                      nullptr, &extractImporting_);
+    }
+    return extract_ && extract_->covers(lat, lon, radiusMeters);
+}
+
+std::vector<OSMPoi> OpenStreetMapAPI::queryExtract(
+    double lat,
+    double lon,
+    double radiusMeters,
+    const std::function<bool(const OSMPoiView&)>& match
+) {
+    ++localQueries_;
+
+    // Nearest matches first, capped like the Overpass queries
+    double lonScale = std::cos(lat * 3.14159265 / 180.0);
+    std::vector<std::pair<double, OSMPoiView>> matches;
+    extract_->forEachWithin(lat, lon, radiusMeters, [&](const OSMPoiView& poi) {
+        if (match(poi)) {
+            double dLat = poi.latitude() - lat;
+            double dLon = (poi.longitude() - lon) * lonScale;
+            matches.emplace_back(dLat * dLat + dLon * dLon, poi);
+        }
+    });
+
+    size_t limit = std::min(matches.size(), static_cast<size_t>(std::max(0, config_.maxResultsPerQuery)));
+    std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
 
-    // Execute the Overpass query
-    std::string response = executeOverpassQuery(query.str());
+    std::vector<OSMPoi> pois;
+    pois.reserve(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        OSMPoi poi = matches[i].second.toPoi();
+        nameFromType(poi);
+        pois.push_back(std::move(poi));
+    }
+    return pois;
+}
+
+OSMAreaStats OpenStreetMapAPI::extractAreaStats(double lat, double lon, double radiusKm) {
+    ++localQueries_;
 
-    // Parse and return results
-    return parseOverpassResponse(response);
+    OSMAreaStats stats;
+    stats.centerLat = lat;
+    stats.centerLon = lon;
+    stats.radiusKm = radiusKm;
+
+    stats.setCounts(extract_->countWithin(lat, lon, radiusKm * 1000.0));
+    return stats;
 }
 
 } // namespace Services
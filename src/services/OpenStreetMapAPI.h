@@ -1,12 +1,16 @@
 #ifndef OPENSTREETMAP_API_H
 #define OPENSTREETMAP_API_H
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <memory>
 #include <map>
 #include <unordered_map>
+#include "OSMTags.h"
 #include "models/BusinessInfo.h"
 #include "models/DemographicData.h"
 #include "models/GeoLocation.h"
@@ -14,6 +18,12 @@
 namespace FranchiseAI {
 namespace Services {
 
+class OSMExtractStore;
+class OSMPoiView;
+class OSMPoiIndex;
+struct OSMTileCacheStats;
+struct HttpRequest;
+
 /**
  * @brief Configuration for OpenStreetMap API (Overpass)
  */
@@ -21,48 +31,158 @@ struct OSMAPIConfig {
     // Use lz4 mirror - faster response with compression
     std::string overpassEndpoint = "https://lz4.overpass-api.de/api/interpreter";
     std::string nominatimEndpoint = "https://nominatim.openstreetmap.org";
+    int nominatimRequestsPerSecond = 1; // Nominatim usage policy (shared with the geocoder per host)
     int requestTimeoutMs = 8000;        // 8 seconds - bbox queries are fast
     int connectTimeoutMs = 3000;        // 3 seconds connection timeout
     bool enableCaching = true;
     int cacheDurationMinutes = 1440;    // 24 hours - OSM data is relatively static
+    int cacheStaleMinutes = 10080;      // Then served for up to 7 days while refetched in the background
+    int negativeCacheSeconds = 60;      // A tile whose query failed is not retried for a minute
+    int cacheMaxMegabytes = 256;        // Memory budget of the tile cache (shared; the largest setting wins)
+    std::string cacheStorePath;         // On-disk cache kept across restarts (empty = memory only)
+    int cacheStoreMaxMegabytes = 512;   // Size budget of that file (shared; the largest setting wins)
+    int tileMaxResults = 2000;          // Cap per tile; a tile at the cap is not cached
+    int maxTilesPerQuery = 16;          // Adjacent missing tiles fetched by one bbox query
+    int maxParallelTileFetches = 2;     // Tile queries in flight in the process (Overpass grants ~2 slots)
+    int overpassRequestsPerSecond = 2;  // Spacing of tile queries (shared per host)
+    int maxRetries = 2;                 // Retries of a tile or Nominatim query answered 429 or 5xx
+    int retryDelayMs = 1000;            // Base of the jittered backoff when there is no Retry-After
     int maxResultsPerQuery = 50;        // Limit results for faster response
     std::string userAgent = "FranchiseAI/1.0";  // Required by OSM usage policy
+
+    // Local extract - areas it covers are answered in-process, others go to Overpass
+    std::string extractStorePath;       // POI store file (see OSMExtractStore); empty = disabled
+    std::string extractPbfPath;         // .osm.pbf imported (in the background) if extractStorePath is missing
 };
 
 /**
  * @brief OSM POI (Point of Interest) data
+ *
+ * Tags are held in a compact OSMTagList; the common ones are read through
+ * the accessors below. name() is filled with a description of the POI's
+ * type when the element has no name.
  */
 struct OSMPoi {
     int64_t osmId = 0;
     std::string osmType;  // "node", "way", "relation"
-    std::string name;
     double latitude = 0.0;
     double longitude = 0.0;
-    std::map<std::string, std::string> tags;
+    OSMTagList tags;
 
-    // Parsed from tags
-    std::string amenity;
-    std::string building;
-    std::string office;
-    std::string shop;
-    std::string tourism;
-    std::string healthcare;
+    std::string_view name() const { return tags.get(OSMKey::Name); }
+
+    // Type tags
+    std::string_view amenity() const { return tags.get(OSMKey::Amenity); }
+    std::string_view building() const { return tags.get(OSMKey::Building); }
+    std::string_view office() const { return tags.get(OSMKey::Office); }
+    std::string_view shop() const { return tags.get(OSMKey::Shop); }
+    std::string_view tourism() const { return tags.get(OSMKey::Tourism); }
+    std::string_view healthcare() const { return tags.get(OSMKey::Healthcare); }
 
     // Address components (if available)
-    std::string street;
-    std::string houseNumber;
-    std::string city;
-    std::string postcode;
-    std::string state;
-    std::string country;
-
-    // Contact info from tags
-    std::string phone;
-    std::string website;
-    std::string email;
-    std::string openingHours;
+    std::string_view street() const { return tags.get(OSMKey::AddrStreet); }
+    std::string_view houseNumber() const { return tags.get(OSMKey::AddrHouseNumber); }
+    std::string_view city() const { return tags.get(OSMKey::AddrCity); }
+    std::string_view postcode() const { return tags.get(OSMKey::AddrPostcode); }
+    std::string_view state() const { return tags.get(OSMKey::AddrState); }
+    std::string_view country() const { return tags.get(OSMKey::AddrCountry); }
+
+    // Contact info
+    std::string_view phone() const { return tags.get(OSMKey::Phone); }
+    std::string_view website() const { return tags.get(OSMKey::Website); }
+    std::string_view email() const { return tags.get(OSMKey::Email); }
+    std::string_view openingHours() const { return tags.get(OSMKey::OpeningHours); }
+
+    /**
+     * @brief "<house number> <street>", or the street alone
+     */
+    std::string streetAddress() const;
+};
+
+/**
+ * @brief Immutable POI list shared between a cache and its readers
+ */
+using OSMPoiList = std::shared_ptr<const std::vector<OSMPoi>>;
+
+/**
+ * @brief Incremental parser for an Overpass JSON response
+ *
+ * Bytes are fed as they arrive (e.g. from HttpRequest::onData). Each
+ * element of the top-level "elements" array is parsed as soon as its
+ * closing brace has been read and passed to the sink, so only the element
+ * in progress is buffered. Elements without coordinates are skipped, as
+ * in OpenStreetMapAPI::parseOverpassResponse().
+ */
+class OverpassStreamParser {
+public:
+    /**
+     * @brief Receives each parsed POI; return false to stop parsing
+     */
+    using Sink = std::function<bool(OSMPoi&&)>;
+
+    explicit OverpassStreamParser(Sink sink) : sink_(std::move(sink)) {}
+
+    /**
+     * @brief Parse the next chunk of the response
+     * @return false once the sink has asked to stop
+     */
+    bool feed(std::string_view chunk);
+
+    size_t count() const { return count_; }          // POIs passed to the sink
+    bool sawElements() const { return sawElements_; }  // "elements" array was found
+    bool stopped() const { return stopped_; }
+
+    /**
+     * @brief "remark" sent by the server when it gave up part way (e.g. timeout)
+     */
+    const std::string& remark() const { return remark_; }
+
+private:
+    void topLevelString(std::string_view text);
+    bool emitElement(std::string_view text);
+
+    Sink sink_;
+    std::string buffer_;                 // Unconsumed bytes, from the oldest still needed
+    size_t pos_ = 0;                     // Next byte of buffer_ to scan
+    size_t tokenStart_ = std::string::npos;
+    size_t elementStart_ = std::string::npos;
+    int depth_ = 0;
+    bool inString_ = false;
+    bool escaped_ = false;
+    bool afterColon_ = false;            // A top-level string is a value, not a key
+    bool inElements_ = false;
+    bool sawElements_ = false;
+    bool stopped_ = false;
+    size_t count_ = 0;
+    std::string key_;                    // Last top-level key
+    std::string remark_;
+};
+
+/**
+ * @brief Counters of OSMAreaStats that count POIs
+ */
+enum class OSMAreaStat : uint8_t {
+    Offices,
+    Restaurants,
+    Cafes,
+    Hotels,
+    ConferenceVenues,
+    Hospitals,
+    Schools,
+    Universities,
+    IndustrialBuildings,
+    Warehouses,
+    Shops,
+    Banks,
+    GovernmentBuildings,
+    ParkingLots,
+    BusStops,
+    RailwayStations,
+    Count
 };
 
+using OSMAreaCounts = std::array<uint32_t, static_cast<size_t>(OSMAreaStat::Count)>;
+
 /**
  * @brief Area statistics from OSM data
  */
@@ -99,6 +219,18 @@ struct OSMAreaStats {
 
     void calculateMetrics();
     std::string getMarketQualityDescription() const;
+
+    /**
+     * @brief Set the counters and totalPois from per-statistic counts,
+     *        then calculateMetrics()
+     */
+    void setCounts(const OSMAreaCounts& counts);
+
+    /**
+     * @brief Statistics a POI counts towards, one bit per OSMAreaStat
+     * @param tag Returns the value of a tag, or an empty view
+     */
+    static uint32_t classify(const std::function<std::string_view(std::string_view)>& tag);
 };
 
 /**
@@ -106,6 +238,15 @@ struct OSMAreaStats {
  *
  * Provides geolocation search capabilities using free, open-source
  * OpenStreetMap data via the Overpass API.
+ *
+ * When OSMAPIConfig names a local extract, searches and area statistics
+ * whose radius lies inside it are answered from the memory-mapped
+ * OSMExtractStore without a network round trip. A missing store is
+ * imported in the background; Overpass answers until it is ready.
+ *
+ * Overpass results are cached by zoom-14 tile in a process-wide
+ * OSMPoiIndex: a search fetches only the tiles of its area that are not
+ * cached yet, several at a time, and shares them with every session.
  */
 class OpenStreetMapAPI {
 public:
@@ -113,6 +254,7 @@ public:
     using BusinessCallback = std::function<void(std::vector<Models::BusinessInfo>, std::string)>;
     using AreaStatsCallback = std::function<void(OSMAreaStats, std::string)>;
     using GeocodeCallback = std::function<void(double lat, double lon, std::string error)>;
+    using CategorySink = std::function<bool(const std::string& category, const OSMPoi& poi)>;
 
     OpenStreetMapAPI();
     explicit OpenStreetMapAPI(const OSMAPIConfig& config);
@@ -182,6 +324,19 @@ public:
 
     /**
      * @brief Get area statistics for demographic analysis
+     *
+     * Only counts are requested: inside the local extract they are summed
+     * from its per-cell counts, otherwise one Overpass "out count" query
+     * returns every counter. Its result is kept in a process-wide ApiCache
+     * (fresh for cacheDurationMinutes, then refreshed in the background;
+     * failures remembered for negativeCacheSeconds), and concurrent
+     * requests for one area share a single query.
+     *
+     * The callback runs inline when the extract or the cache answers,
+     * otherwise on the HttpClient reactor thread; the caller never waits
+     * for Overpass. When no counts could be loaded the error is set and
+     * the counters are left at zero.
+     *
      * @param latitude Center latitude
      * @param longitude Center longitude
      * @param radiusKm Search radius in kilometers
@@ -223,10 +378,15 @@ public:
         double radiusMiles
     );
 
+    /**
+     * @brief Blocking form of getAreaStatistics(); not for the session thread
+     * @param error Set to the error, empty on success (optional)
+     */
     OSMAreaStats getAreaStatisticsSync(
         double latitude,
         double longitude,
-        double radiusKm
+        double radiusKm,
+        std::string* error = nullptr
     );
 
     // ===== GeoLocation-based API (preferred for new code) =====
@@ -267,7 +427,14 @@ public:
     /**
      * @brief Get area statistics (sync) using SearchArea
      */
-    OSMAreaStats getAreaStatisticsSync(const Models::SearchArea& searchArea);
+    OSMAreaStats getAreaStatisticsSync(const Models::SearchArea& searchArea,
+                                       std::string* error = nullptr);
+
+    /**
+     * @brief Area statistics the extract or the cache can answer now
+     * @return false when they would need an Overpass query
+     */
+    bool peekAreaStatistics(const Models::SearchArea& searchArea, OSMAreaStats& stats);
 
     /**
      * @brief Search POIs by category name (e.g., "offices", "hotels", "restaurants")
@@ -289,6 +456,33 @@ public:
         const std::string& category
     );
 
+    /**
+     * @brief Search several categories with a single Overpass request
+     * @return POIs per requested category name, nearest first, each capped
+     *         at maxResultsPerQuery (unknown categories map to no POIs)
+     */
+    std::map<std::string, std::vector<OSMPoi>> searchByCategoriesSync(
+        const Models::SearchArea& searchArea,
+        const std::vector<std::string>& categories
+    );
+
+    /**
+     * @brief searchByCategoriesSync() that hands POIs over while they download
+     *
+     * sink(category, poi) is called for each POI within the radius, once
+     * for every requested category it matches, as soon as it has been
+     * parsed. POIs arrive in the server's quadtile order rather than
+     * nearest first. The download stops once every category has
+     * maxResultsPerQuery POIs or sink returns false.
+     *
+     * Blocks until then; sink runs on the calling thread.
+     */
+    void searchByCategoriesStreaming(
+        const Models::SearchArea& searchArea,
+        const std::vector<std::string>& categories,
+        const CategorySink& sink
+    );
+
     /**
      * @brief Search for POIs using SearchArea
      */
@@ -304,24 +498,94 @@ public:
 
     // Cache management
     void clearCache();
-    int getCacheSize() const;
+    int getCacheSize() const;   // Cached tiles
+
+    /**
+     * @brief Tile hit/miss counts of the shared POI cache
+     */
+    const OSMTileCacheStats& getTileCacheStats() const;
 
     // Statistics
     int getTotalApiCalls() const { return totalApiCalls_; }
+    int getLocalQueryCount() const { return localQueries_; }  // Answered from the extract
     void resetStatistics();
 
+    /**
+     * @brief Whether a local extract store is loaded
+     */
+    bool hasLocalExtract() const { return extract_ != nullptr; }
+
     // Utility: Convert OSM POI to BusinessInfo
     static Models::BusinessInfo poiToBusinessInfo(const OSMPoi& poi);
 
     // Utility: Map OSM tags to BusinessType
     static Models::BusinessType inferBusinessType(const OSMPoi& poi);
 
+    /**
+     * @brief Parse an Overpass API JSON response into POIs
+     *
+     * Elements without coordinates are dropped and the result is capped
+     * at maxResultsPerQuery.
+     */
+    std::vector<OSMPoi> parseOverpassResponse(const std::string& json);
+
+    /**
+     * @brief parseOverpassResponse() with an explicit result cap
+     */
+    std::vector<OSMPoi> parseOverpassResponse(const std::string& json, size_t maxResults);
+
 private:
     OSMAPIConfig config_;
     int totalApiCalls_ = 0;
+    int localQueries_ = 0;
 
-    // Simple in-memory cache
-    std::unordered_map<std::string, std::pair<std::vector<OSMPoi>, time_t>> poiCache_;
+    // Local extract (null when not configured, not loadable or still importing)
+    std::shared_ptr<const OSMExtractStore> extract_;
+    bool extractImporting_ = false;
+
+    void openExtract();
+    void openCacheStore();
+    bool coveredByExtract(double lat, double lon, double radiusMeters);
+    std::vector<OSMPoi> queryExtract(
+        double lat,
+        double lon,
+        double radiusMeters,
+        const std::function<bool(const OSMPoiView&)>& match
+    );
+    OSMAreaStats extractAreaStats(double lat, double lon, double radiusKm);
+
+    // Overpass POIs cached by tile (OSMPoiIndex::shared())
+    std::shared_ptr<OSMPoiIndex> poiCache_;
+
+    /**
+     * @brief Fetch the uncached tiles of an area into the tile cache
+     * @param tiles Receives the POI lists of every available tile of the area,
+     *              including tiles too dense to cache
+     * @return false if every tile fetch failed (error set)
+     */
+    bool fetchMissingTiles(
+        double lat,
+        double lon,
+        double radiusMeters,
+        std::vector<OSMPoiList>& tiles,
+        std::string& error
+    );
+
+    std::vector<OSMPoi> queryPoiCache(
+        double lat,
+        double lon,
+        double radiusMeters,
+        const std::vector<OSMPoiList>& tiles
+    );
+
+    // Run an Overpass query; error is set on a failed request or API error
+    std::vector<OSMPoi> fetchPois(const std::string& query, size_t maxResults, std::string& error);
+
+    // Run an Overpass query, parsing the response as it downloads and
+    // passing each POI to sink; stops after maxResults or when sink
+    // returns false. Returns false (and sets error) if the request failed.
+    bool streamPois(const std::string& query, size_t maxResults,
+                    const OverpassStreamParser::Sink& sink, std::string& error);
 
     // Overpass query builders
     std::string buildOverpassQuery(
@@ -337,6 +601,21 @@ private:
         int radiusMeters
     );
 
+    std::string buildCateringProspectQuery(
+        double south,
+        double west,
+        double north,
+        double east,
+        int maxResults
+    );
+
+    // Bbox union of the filters of the given (lowercase) categories
+    std::string buildCategoryQuery(
+        const Models::SearchArea& searchArea,
+        const std::vector<std::string>& categories
+    );
+
+    // One "out count" per OSMAreaStat, in enum order
     std::string buildAreaStatsQuery(
         double lat,
         double lon,
@@ -344,11 +623,10 @@ private:
     );
 
     // HTTP helpers
-    std::string executeOverpassQuery(const std::string& query);
+    HttpRequest buildOverpassRequest(const std::string& query) const;
     std::string executeNominatimQuery(const std::string& endpoint);
 
     // JSON parsing
-    std::vector<OSMPoi> parseOverpassResponse(const std::string& json);
     OSMPoi parseNominatimResponse(const std::string& json);
 
     // OSM tag to business type mapping
@@ -0,0 +1,545 @@
+#include "PersistentCache.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace FranchiseAI {
+namespace Services {
+
+// ============================================================================
+// Log file format
+// ============================================================================
+
+static const char kLogMagic[8] = {'F', 'A', 'I', 'C', 'A', 'C', 'H', 'E'};
+static const uint32_t kLogVersion = 1;
+
+static const uint32_t kMaxKeyLength = 4096;
+static const uint32_t kMaxValueLength = 64u << 20;
+static const uint32_t kErasedFlag = 1;
+
+// Logs smaller than this are not compacted for dead records alone
+static const uint64_t kMinCompactBytes = 4u << 20;
+
+// Writes queued while the log loads; beyond this they are dropped
+static const size_t kMaxPendingRecords = 10000;
+
+struct LogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+// Followed by the key and the value bytes
+struct LogRecordHeader {
+    uint32_t crc;               // CRC32 of the rest of the header, the key and the value
+    uint32_t keyLength;
+    uint32_t valueLength;
+    uint32_t flags;
+    int64_t storedAt;
+    int64_t expiresAt;          // 0 = never
+};
+
+static_assert(sizeof(LogHeader) == 16, "log header layout");
+static_assert(sizeof(LogRecordHeader) == 32, "log record layout");
+
+static uint32_t recordCrc(const LogRecordHeader& header, const char* key, const char* value) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(&header.keyLength),
+                sizeof(header) - sizeof(header.crc));
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(key), header.keyLength);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(value), header.valueLength);
+    return static_cast<uint32_t>(crc);
+}
+
+static bool expiredAt(int64_t expiresAt, time_t now) {
+    return expiresAt != 0 && now >= expiresAt;
+}
+
+static bool writeAt(int fd, const char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+static bool readAt(int fd, char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t got = pread(fd, data, size, static_cast<off_t>(offset));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        data += got;
+        size -= static_cast<size_t>(got);
+        offset += static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+static bool writeLogHeader(int fd) {
+    LogHeader header = {};
+    std::memcpy(header.magic, kLogMagic, sizeof(kLogMagic));
+    header.version = kLogVersion;
+    return writeAt(fd, reinterpret_cast<const char*>(&header), sizeof(header), 0);
+}
+
+// ============================================================================
+// Shared instances
+// ============================================================================
+
+static std::mutex sharedCachesMutex;
+static std::unordered_map<std::string, std::shared_ptr<PersistentCache>> sharedCaches;
+
+std::shared_ptr<PersistentCache> PersistentCache::shared(const std::string& path, size_t maxBytes) {
+    if (path.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(sharedCachesMutex);
+    auto it = sharedCaches.find(path);
+    if (it != sharedCaches.end()) {
+        size_t current = it->second->maxBytes_.load();
+        while (maxBytes > current && !it->second->maxBytes_.compare_exchange_weak(current, maxBytes)) {
+        }
+        return it->second;
+    }
+
+    std::shared_ptr<PersistentCache> cache(new PersistentCache(path, maxBytes));
+    std::string error;
+    if (!cache->openFile(error)) {
+        std::cerr << "[DiskCache] " << error << "; caching in memory only" << std::endl;
+        return nullptr;
+    }
+
+    ThreadPool::shared().post(TaskOptions::background(), [cache]() { cache->load(); });
+    sharedCaches[path] = cache;
+    return cache;
+}
+
+PersistentCache::PersistentCache(const std::string& path, size_t maxBytes)
+    : path_(path), maxBytes_(maxBytes) {}
+
+PersistentCache::~PersistentCache() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool PersistentCache::openFile(std::string& error) {
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        error = "cannot open " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+uint64_t PersistentCache::scanRecords(const char* data, uint64_t size, uint64_t baseOffset,
+                                      const RecordFn& fn) {
+    uint64_t offset = 0;
+    while (offset + sizeof(LogRecordHeader) <= size) {
+        LogRecordHeader header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        if (header.keyLength == 0 || header.keyLength > kMaxKeyLength ||
+            header.valueLength > kMaxValueLength) {
+            break;
+        }
+
+        uint64_t length = sizeof(header) + header.keyLength + header.valueLength;
+        if (offset + length > size) {
+            break;
+        }
+        const char* key = data + offset + sizeof(header);
+        if (recordCrc(header, key, key + header.keyLength) != header.crc) {
+            break;
+        }
+
+        Slot slot;
+        slot.offset = baseOffset + offset;
+        slot.length = static_cast<uint32_t>(length);
+        slot.storedAt = header.storedAt;
+        slot.expiresAt = header.expiresAt;
+        fn(std::string(key, header.keyLength), slot, (header.flags & kErasedFlag) != 0);
+        offset += length;
+    }
+    return offset;
+}
+
+void PersistentCache::applyRecord(Index& index, uint64_t& liveBytes, const std::string& key,
+                                  const Slot& slot, bool erased) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        liveBytes -= it->second.length;
+        index.erase(it);
+    }
+    if (!erased && !expiredAt(slot.expiresAt, std::time(nullptr))) {
+        index.emplace(key, slot);
+        liveBytes += slot.length;
+    }
+}
+
+void PersistentCache::load() {
+    Index index;
+    uint64_t liveBytes = 0;
+    uint64_t end = sizeof(LogHeader);
+    bool ok = true;
+
+    // Nothing else touches the file until loaded_ is set
+    struct stat info;
+    uint64_t size = fstat(fd_, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+    const char* data = nullptr;
+    if (size >= sizeof(LogHeader)) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+        data = mapping == MAP_FAILED ? nullptr : static_cast<const char*>(mapping);
+    }
+
+    LogHeader header = {};
+    if (data) {
+        std::memcpy(&header, data, sizeof(header));
+    }
+    if (data && std::memcmp(header.magic, kLogMagic, sizeof(kLogMagic)) == 0 &&
+        header.version == kLogVersion) {
+        end += scanRecords(data + sizeof(LogHeader), size - sizeof(LogHeader), sizeof(LogHeader),
+            [&](const std::string& key, const Slot& slot, bool erased) {
+                applyRecord(index, liveBytes, key, slot, erased);
+            });
+        if (end < size) {
+            std::cerr << "[DiskCache] Dropped " << (size - end) << " bytes after the last valid record of "
+                      << path_ << std::endl;
+        }
+    } else {
+        if (size > 0) {
+            std::cerr << "[DiskCache] " << path_ << " is not a cache log (or wrong version); starting empty"
+                      << std::endl;
+        }
+        ok = writeLogHeader(fd_);
+    }
+    if (data) {
+        munmap(const_cast<char*>(data), size);
+    }
+    if (ok && end < size) {
+        ok = ftruncate(fd_, static_cast<off_t>(end)) == 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ok) {
+        std::cerr << "[DiskCache] Cannot initialize " << path_ << ": " << std::strerror(errno)
+                  << "; caching in memory only" << std::endl;
+        failed_ = true;
+        pending_.clear();
+    } else {
+        index_ = std::move(index);
+        liveBytes_ = liveBytes;
+        fileEnd_ = end;
+        for (const auto& record : pending_) {
+            appendLocked(record);
+        }
+        pending_.clear();
+        std::cerr << "[DiskCache] Loaded " << index_.size() << " entries (" << fileEnd_
+                  << " bytes) from " << path_ << std::endl;
+    }
+    loaded_ = true;
+    publishStatsLocked();
+    scheduleCompactionLocked();
+    loadedChanged_.notify_all();
+}
+
+bool PersistentCache::isLoaded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loaded_;
+}
+
+void PersistentCache::waitUntilLoaded() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    loadedChanged_.wait(lock, [this] { return loaded_; });
+}
+
+// ============================================================================
+// Lookups and writes
+// ============================================================================
+
+bool PersistentCache::get(const std::string& key, std::string& value, time_t& storedAt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = loaded_ && !failed_ ? index_.find(key) : index_.end();
+    if (it == index_.end()) {
+        stats_.misses++;
+        return false;
+    }
+
+    Slot slot = it->second;
+    if (expiredAt(slot.expiresAt, std::time(nullptr))) {
+        liveBytes_ -= slot.length;
+        index_.erase(it);
+        publishStatsLocked();
+        stats_.misses++;
+        return false;
+    }
+
+    std::string record(slot.length, '\0');
+    LogRecordHeader header;
+    bool valid = readAt(fd_, &record[0], record.size(), slot.offset);
+    if (valid) {
+        std::memcpy(&header, record.data(), sizeof(header));
+        const char* recordKey = record.data() + sizeof(header);
+        valid = sizeof(header) + header.keyLength + header.valueLength == record.size() &&
+                recordCrc(header, recordKey, recordKey + header.keyLength) == header.crc &&
+                key.compare(0, std::string::npos, recordKey, header.keyLength) == 0;
+    }
+    if (!valid) {
+        std::cerr << "[DiskCache] Unreadable record for " << key << " in " << path_ << std::endl;
+        liveBytes_ -= slot.length;
+        index_.erase(it);
+        publishStatsLocked();
+        stats_.misses++;
+        return false;
+    }
+
+    value.assign(record, sizeof(header) + header.keyLength, header.valueLength);
+    storedAt = static_cast<time_t>(header.storedAt);
+    stats_.hits++;
+    return true;
+}
+
+void PersistentCache::put(const std::string& key, const std::string& value,
+                          time_t storedAt, time_t expiresAt) {
+    if (key.empty() || key.size() > kMaxKeyLength || value.size() > kMaxValueLength) {
+        return;
+    }
+
+    PendingRecord record{key, value, storedAt, expiresAt, false};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+        return;
+    }
+    if (!loaded_) {
+        if (pending_.size() < kMaxPendingRecords) {
+            pending_.push_back(std::move(record));
+        }
+        return;
+    }
+    appendLocked(record);
+    publishStatsLocked();
+    scheduleCompactionLocked();
+}
+
+void PersistentCache::erase(const std::string& key) {
+    if (key.empty() || key.size() > kMaxKeyLength) {
+        return;
+    }
+
+    PendingRecord tombstone{key, std::string(), 0, 0, true};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+        return;
+    }
+    if (!loaded_) {
+        pending_.push_back(std::move(tombstone));
+        return;
+    }
+    if (index_.count(key) > 0) {
+        appendLocked(tombstone);
+        publishStatsLocked();
+    }
+}
+
+void PersistentCache::eraseAll(const std::string& prefix) {
+    // Keys are only known once the log is loaded
+    std::unique_lock<std::mutex> lock(mutex_);
+    loadedChanged_.wait(lock, [this] { return loaded_; });
+    if (failed_) {
+        return;
+    }
+
+    std::vector<std::string> keys;
+    for (const auto& entry : index_) {
+        if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+            keys.push_back(entry.first);
+        }
+    }
+    for (const auto& key : keys) {
+        appendLocked(PendingRecord{key, std::string(), 0, 0, true});
+    }
+    publishStatsLocked();
+    scheduleCompactionLocked();
+}
+
+bool PersistentCache::appendLocked(const PendingRecord& record) {
+    LogRecordHeader header = {};
+    header.keyLength = static_cast<uint32_t>(record.key.size());
+    header.valueLength = static_cast<uint32_t>(record.value.size());
+    header.flags = record.erased ? kErasedFlag : 0;
+    header.storedAt = record.storedAt;
+    header.expiresAt = record.expiresAt;
+    header.crc = recordCrc(header, record.key.data(), record.value.data());
+
+    std::string bytes;
+    bytes.reserve(sizeof(header) + record.key.size() + record.value.size());
+    bytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes.append(record.key);
+    bytes.append(record.value);
+
+    if (!writeAt(fd_, bytes.data(), bytes.size(), fileEnd_)) {
+        std::cerr << "[DiskCache] Write to " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    Slot slot;
+    slot.offset = fileEnd_;
+    slot.length = static_cast<uint32_t>(bytes.size());
+    slot.storedAt = record.storedAt;
+    slot.expiresAt = record.expiresAt;
+    applyRecord(index_, liveBytes_, record.key, slot, record.erased);
+    fileEnd_ += bytes.size();
+    stats_.writes++;
+    return true;
+}
+
+void PersistentCache::publishStatsLocked() {
+    stats_.entries = static_cast<int>(index_.size());
+    stats_.fileBytes = static_cast<int64_t>(fileEnd_);
+    stats_.liveBytes = static_cast<int64_t>(liveBytes_);
+}
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+void PersistentCache::scheduleCompactionLocked() {
+    if (compacting_ || !loaded_ || failed_) {
+        return;
+    }
+    uint64_t deadBytes = fileEnd_ - sizeof(LogHeader) - liveBytes_;
+    bool overBudget = fileEnd_ > maxBytes_.load();
+    bool mostlyDead = fileEnd_ > kMinCompactBytes && deadBytes > liveBytes_;
+    if (!overBudget && !mostlyDead) {
+        return;
+    }
+
+    compacting_ = true;
+    std::weak_ptr<PersistentCache> weak = shared_from_this();
+    ThreadPool::shared().post(TaskOptions::background(), [weak]() {
+        if (auto cache = weak.lock()) {
+            cache->compact();
+        }
+    });
+}
+
+bool PersistentCache::compact() {
+    std::lock_guard<std::mutex> compactLock(compactMutex_);
+
+    // Snapshot the live records; writes continue while they are copied
+    std::vector<std::pair<std::string, Slot>> live;
+    uint64_t snapshotEnd = 0;
+    uint64_t oldSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loaded_ || failed_) {
+            compacting_ = false;
+            return false;
+        }
+        compacting_ = true;
+        time_t now = std::time(nullptr);
+        live.reserve(index_.size());
+        for (const auto& entry : index_) {
+            if (!expiredAt(entry.second.expiresAt, now)) {
+                live.emplace_back(entry.first, entry.second);
+            }
+        }
+        snapshotEnd = fileEnd_;
+        oldSize = fileEnd_;
+    }
+
+    // Over budget: keep the most recently stored entries
+    uint64_t budget = maxBytes_.load() / 4 * 3;
+    std::sort(live.begin(), live.end(),
+        [](const auto& a, const auto& b) { return a.second.storedAt > b.second.storedAt; });
+    uint64_t kept = 0;
+    size_t keep = 0;
+    while (keep < live.size() && kept + live[keep].second.length <= budget) {
+        kept += live[keep].second.length;
+        ++keep;
+    }
+    size_t dropped = live.size() - keep;
+    live.resize(keep);
+    std::sort(live.begin(), live.end(),
+        [](const auto& a, const auto& b) { return a.second.offset < b.second.offset; });
+
+    std::string tempPath = path_ + ".compact";
+    int out = open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    bool ok = out >= 0 && writeLogHeader(out);
+
+    Index index;
+    uint64_t liveBytes = 0;
+    uint64_t end = sizeof(LogHeader);
+    std::string record;
+    for (size_t i = 0; ok && i < live.size(); ++i) {
+        // fd_ is only replaced below, by this thread
+        const Slot& slot = live[i].second;
+        record.resize(slot.length);
+        ok = readAt(fd_, &record[0], record.size(), slot.offset) &&
+             writeAt(out, record.data(), record.size(), end);
+        Slot moved = slot;
+        moved.offset = end;
+        index.emplace(live[i].first, moved);
+        liveBytes += moved.length;
+        end += moved.length;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ok && fileEnd_ > snapshotEnd) {
+        // Records written during the copy go after the copied ones
+        std::string tail(fileEnd_ - snapshotEnd, '\0');
+        ok = readAt(fd_, &tail[0], tail.size(), snapshotEnd) &&
+             writeAt(out, tail.data(), tail.size(), end);
+        if (ok) {
+            scanRecords(tail.data(), tail.size(), end,
+                [&](const std::string& key, const Slot& slot, bool erased) {
+                    applyRecord(index, liveBytes, key, slot, erased);
+                });
+            end += tail.size();
+        }
+    }
+    if (ok) {
+        ok = std::rename(tempPath.c_str(), path_.c_str()) == 0;
+    }
+    compacting_ = false;
+
+    if (!ok) {
+        std::cerr << "[DiskCache] Compaction of " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        if (out >= 0) {
+            close(out);
+        }
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    close(fd_);
+    fd_ = out;
+    index_ = std::move(index);
+    liveBytes_ = liveBytes;
+    fileEnd_ = end;
+    stats_.compactions++;
+    publishStatsLocked();
+
+    std::cerr << "[DiskCache] Compacted " << path_ << " from " << oldSize << " to " << fileEnd_
+              << " bytes" << (dropped > 0 ? " (dropped " + std::to_string(dropped) + " oldest entries)" : "")
+              << std::endl;
+    return true;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,248 @@
+#ifndef PERSISTENT_CACHE_H
+#define PERSISTENT_CACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Counters for PersistentCache
+ */
+struct PersistentCacheStats {
+    std::atomic<int> hits{0};           // Lookups answered from disk
+    std::atomic<int> misses{0};         // Lookups not on disk (or before the log was loaded)
+    std::atomic<int> writes{0};         // Records appended
+    std::atomic<int> compactions{0};
+    std::atomic<int> entries{0};        // Live keys in the index
+    std::atomic<int64_t> fileBytes{0};  // Size of the log, live and dead records
+    std::atomic<int64_t> liveBytes{0};  // Size of the records the index points to
+
+    double getHitRate() const {
+        int total = hits.load() + misses.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(hits.load()) / total * 100.0;
+    }
+
+    void reset() {
+        hits = 0;
+        misses = 0;
+        writes = 0;
+        compactions = 0;
+    }
+};
+
+/**
+ * @brief Appends fields to a byte string, for values stored in a PersistentCache
+ */
+class ByteWriter {
+public:
+    template<typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "plain values only");
+        bytes_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void putString(const std::string& text) { putString(text.data(), text.size()); }
+    void putString(const char* data, size_t size) {
+        put(static_cast<uint32_t>(size));
+        bytes_.append(data, size);
+    }
+
+    std::string& bytes() { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+/**
+ * @brief Reads fields written by ByteWriter; ok() turns false on a short read
+ */
+class ByteReader {
+public:
+    explicit ByteReader(const std::string& bytes) : data_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+    template<typename T>
+    T get() {
+        T value{};
+        if (static_cast<size_t>(end_ - data_) < sizeof(value)) {
+            ok_ = false;
+            return value;
+        }
+        std::memcpy(&value, data_, sizeof(value));
+        data_ += sizeof(value);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t size = get<uint32_t>();
+        if (!ok_ || static_cast<size_t>(end_ - data_) < size) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string text(data_, size);
+        data_ += size;
+        return text;
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return data_ == end_; }
+
+private:
+    const char* data_;
+    const char* end_;
+    bool ok_ = true;
+};
+
+/**
+ * @brief Key/value cache on disk that survives restarts
+ *
+ * The store is one append-only log file. Every put() appends a record
+ * (key, value bytes, storage and expiry time, CRC32); erase() appends a
+ * tombstone. An in-memory hash index maps each key to the offset of its
+ * latest record, so a lookup is one index probe and one pread().
+ *
+ * The log is loaded lazily: shared() returns at once and a background
+ * task on ThreadPool::shared() memory-maps the file and scans it to build
+ * the index, stopping at the first torn or corrupt record, which is cut
+ * off. Until then lookups miss and writes are queued, so startup never
+ * waits for the disk.
+ *
+ * Once dead records (overwritten, erased, expired) outweigh live ones,
+ * or the log grows past maxBytes, a background compaction copies the
+ * live records to a new file and renames it over the log, dropping the
+ * oldest entries when the live data alone exceeds 3/4 of maxBytes.
+ * Lookups and writes continue during the copy.
+ *
+ * The log is a cache: nothing is fsync'ed, and a crash loses at most the
+ * records written since the last page cache flush. Safe to use from any
+ * thread.
+ */
+class PersistentCache : public std::enable_shared_from_this<PersistentCache> {
+public:
+    ~PersistentCache();
+
+    // Non-copyable
+    PersistentCache(const PersistentCache&) = delete;
+    PersistentCache& operator=(const PersistentCache&) = delete;
+
+    /**
+     * @brief Store at path, opened once per process and loaded in the background
+     * @param maxBytes Log size budget; raised (never lowered) by later callers
+     * @return nullptr if path is empty or the file cannot be opened
+     */
+    static std::shared_ptr<PersistentCache> shared(const std::string& path, size_t maxBytes);
+
+    /**
+     * @brief Latest unexpired value of a key
+     * @param storedAt Set to the time the value was put
+     */
+    bool get(const std::string& key, std::string& value, time_t& storedAt);
+
+    /**
+     * @param expiresAt Time after which the record is ignored and compacted away
+     */
+    void put(const std::string& key, const std::string& value, time_t storedAt, time_t expiresAt);
+
+    void erase(const std::string& key);
+
+    /**
+     * @brief Erase every key starting with prefix
+     */
+    void eraseAll(const std::string& prefix);
+
+    /**
+     * @brief Whether the background load of the log has finished
+     */
+    bool isLoaded() const;
+
+    /**
+     * @brief Block until the background load has finished (for tools and tests)
+     */
+    void waitUntilLoaded() const;
+
+    /**
+     * @brief Rewrite the log with only its live records, on the calling thread
+     */
+    bool compact();
+
+    const std::string& path() const { return path_; }
+    size_t maxBytes() const { return maxBytes_.load(); }
+
+    const PersistentCacheStats& getStats() const { return stats_; }
+    void resetStats() { stats_.reset(); }
+
+private:
+    struct Slot {
+        uint64_t offset = 0;        // Start of the record in the log
+        uint32_t length = 0;        // Whole record, header included
+        int64_t storedAt = 0;
+        int64_t expiresAt = 0;
+    };
+
+    struct PendingRecord {
+        std::string key;
+        std::string value;
+        int64_t storedAt = 0;
+        int64_t expiresAt = 0;
+        bool erased = false;
+    };
+
+    PersistentCache(const std::string& path, size_t maxBytes);
+
+    using Index = std::unordered_map<std::string, Slot>;
+    using RecordFn = std::function<void(const std::string& key, const Slot& slot, bool erased)>;
+
+    bool openFile(std::string& error);
+    void load();
+    bool appendLocked(const PendingRecord& record);
+    void scheduleCompactionLocked();
+    void publishStatsLocked();
+
+    /**
+     * @brief Call fn for each valid record of a log region
+     * @param baseOffset File offset of data[0], added to the slot offsets
+     * @return Bytes up to the end of the last valid record
+     */
+    static uint64_t scanRecords(const char* data, uint64_t size, uint64_t baseOffset,
+                                const RecordFn& fn);
+
+    /**
+     * @brief Point the index at a record, or drop the key for a tombstone or expired record
+     */
+    static void applyRecord(Index& index, uint64_t& liveBytes, const std::string& key,
+                            const Slot& slot, bool erased);
+
+    std::string path_;
+    int fd_ = -1;
+    std::atomic<size_t> maxBytes_;
+
+    Index index_;
+    std::vector<PendingRecord> pending_;    // Writes made before the log was loaded
+    uint64_t fileEnd_ = 0;
+    uint64_t liveBytes_ = 0;
+    bool loaded_ = false;
+    bool compacting_ = false;
+    bool failed_ = false;                   // I/O error: the store stays empty
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable loadedChanged_;
+    std::mutex compactMutex_;               // One compaction at a time
+    PersistentCacheStats stats_;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // PERSISTENT_CACHE_H
@@ -0,0 +1,293 @@
+#include "QuotaExecutor.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace FranchiseAI {
+namespace Services {
+
+QuotaExecutor::QuotaExecutor(ThreadPool& pool, int quota, int maxQueueSize,
+                             const std::string& name)
+    : pool_(pool)
+    , name_(name)
+    , quota_(std::max(1, quota))
+    , maxQueueSize_(maxQueueSize) {
+}
+
+QuotaExecutor::~QuotaExecutor() {
+    shutdown(true);
+}
+
+void QuotaExecutor::execute(std::function<void()> task) {
+    execute(TaskOptions{}, std::move(task));
+}
+
+void QuotaExecutor::execute(const TaskOptions& options, std::function<void()> task) {
+    Entry entry{std::move(task), std::chrono::steady_clock::now(), options};
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (stopped_) {
+            throw std::runtime_error("Cannot execute on stopped " + name_);
+        }
+
+        if (running_ >= quota_ || !canStartLocked(options.priority)) {
+            if (maxQueueSize_ > 0 && waitingCount_ >= maxQueueSize_) {
+                throw std::runtime_error(name_ + " queue is full");
+            }
+            waiting_[static_cast<int>(options.priority)].push_back(std::move(entry));
+            metrics_.tasksSubmitted++;
+            metrics_.currentQueueSize = ++waitingCount_;
+            return;
+        }
+
+        running_++;
+        if (options.priority == TaskPriority::Background) {
+            runningBackground_++;
+        }
+        metrics_.tasksSubmitted++;
+    }
+
+    dispatch(std::move(entry), false);
+}
+
+bool QuotaExecutor::canStartLocked(TaskPriority priority) const {
+    if (priority != TaskPriority::Background || stopped_) {
+        return true;
+    }
+    // Keep one slot for foreground work
+    return runningBackground_ < std::max(1, quota_ - 1);
+}
+
+bool QuotaExecutor::popNextLocked(Entry& entry, bool allowBackground) {
+    int lanes = allowBackground ? kPriorityCount : kPriorityCount - 1;
+    for (int lane = 0; lane < lanes; ++lane) {
+        auto& queue = waiting_[lane];
+        if (queue.empty()) {
+            continue;
+        }
+
+        entry = std::move(queue.front());
+        queue.pop_front();
+        metrics_.currentQueueSize = --waitingCount_;
+        return true;
+    }
+
+    return false;
+}
+
+void QuotaExecutor::dispatch(Entry entry, bool fair) {
+    TaskOptions poolOptions;
+    poolOptions.priority = entry.options.priority;  // Deadline is checked in runEntry
+
+    auto shared = std::make_shared<Entry>(std::move(entry));
+    auto job = [this, shared]() {
+        runEntry(*shared);
+        releaseSlot(shared->options.priority);
+    };
+
+    try {
+        // Hand-offs from a finishing task go to the back of the shared
+        // injection queue so other clients' work is not starved
+        if (fair) {
+            pool_.post(poolOptions, std::move(job));
+        } else {
+            pool_.execute(poolOptions, std::move(job));
+        }
+    } catch (...) {
+        if (fair) {
+            // No caller to report to; run on the finishing thread instead
+            runEntry(*shared);
+            releaseSlot(shared->options.priority);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_--;
+        if (shared->options.priority == TaskPriority::Background) {
+            runningBackground_--;
+        }
+        metrics_.tasksSubmitted--;
+        notifyIfIdleLocked();
+        throw;
+    }
+}
+
+void QuotaExecutor::runEntry(Entry& entry) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (entry.options.isExpired(startTime)) {
+        // Dropping the closure breaks the submitter's promise
+        entry.fn = nullptr;
+        metrics_.tasksExpired++;
+        return;
+    }
+
+    metrics_.activeThreads++;
+
+    try {
+        entry.fn();
+        metrics_.tasksCompleted++;
+    } catch (...) {
+        metrics_.tasksFailed++;
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto runMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        endTime - startTime).count();
+    auto waitMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        startTime - entry.enqueuedAt).count();
+
+    metrics_.totalProcessingTimeMs += runMicros / 1000;
+    metrics_.queueWaitMicros.record(static_cast<uint64_t>(std::max<int64_t>(0, waitMicros)));
+    metrics_.runTimeMicros.record(static_cast<uint64_t>(runMicros));
+
+    metrics_.activeThreads--;
+
+    // Release the closure (and any captured promise) before signalling
+    entry.fn = nullptr;
+}
+
+void QuotaExecutor::releaseSlot(TaskPriority finished) {
+    Entry next;
+    bool haveNext = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (finished == TaskPriority::Background) {
+            runningBackground_--;
+        }
+
+        // The slot passes straight to the next waiting task unless the
+        // quota was lowered below the number already running
+        if (running_ <= quota_ &&
+            popNextLocked(next, canStartLocked(TaskPriority::Background))) {
+            haveNext = true;
+            if (next.options.priority == TaskPriority::Background) {
+                runningBackground_++;
+            }
+        } else {
+            running_--;
+        }
+
+        notifyIfIdleLocked();
+    }
+
+    if (haveNext) {
+        dispatch(std::move(next), true);
+    }
+}
+
+bool QuotaExecutor::tryRunWaiting() {
+    Entry entry;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // A foreground waiter must not pick up background work inline
+        bool allowBackground = ThreadPool::currentTaskPriority() == TaskPriority::Background;
+        if (!popNextLocked(entry, allowBackground)) {
+            return false;
+        }
+        runningInline_++;
+    }
+
+    runEntry(entry);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    runningInline_--;
+    notifyIfIdleLocked();
+    return true;
+}
+
+void QuotaExecutor::notifyIfIdleLocked() {
+    if (running_ == 0 && runningInline_ == 0 && waitingCount_ == 0) {
+        idleCondition_.notify_all();
+    }
+}
+
+void QuotaExecutor::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCondition_.wait(lock, [this] {
+        return running_ == 0 && runningInline_ == 0 && waitingCount_ == 0;
+    });
+}
+
+void QuotaExecutor::shutdown(bool waitForTasks) {
+    std::deque<Entry> dropped[kPriorityCount];
+    Entry entry;
+    std::deque<Entry> toDispatch;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+
+        if (!waitForTasks) {
+            for (int lane = 0; lane < kPriorityCount; ++lane) {
+                dropped[lane].swap(waiting_[lane]);
+            }
+            waitingCount_ = 0;
+            metrics_.currentQueueSize = 0;
+        } else {
+            // Background tasks held back by the cap may all start now
+            while (running_ < quota_ && popNextLocked(entry, true)) {
+                running_++;
+                if (entry.options.priority == TaskPriority::Background) {
+                    runningBackground_++;
+                }
+                toDispatch.push_back(std::move(entry));
+            }
+        }
+
+        notifyIfIdleLocked();
+    }
+
+    for (auto& pending : toDispatch) {
+        dispatch(std::move(pending), true);
+    }
+
+    // Destroying unrun packaged tasks breaks their futures; do it unlocked
+    for (auto& lane : dropped) {
+        lane.clear();
+    }
+
+    waitAll();
+}
+
+void QuotaExecutor::setQuota(int quota) {
+    quota = std::max(1, quota);
+    Entry entry;
+    std::deque<Entry> toDispatch;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quota_ = quota;
+
+        while (running_ < quota_ &&
+               popNextLocked(entry, canStartLocked(TaskPriority::Background))) {
+            running_++;
+            if (entry.options.priority == TaskPriority::Background) {
+                runningBackground_++;
+            }
+            toDispatch.push_back(std::move(entry));
+        }
+    }
+
+    for (auto& pending : toDispatch) {
+        dispatch(std::move(pending), true);
+    }
+}
+
+int QuotaExecutor::getQuota() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return quota_;
+}
+
+int QuotaExecutor::getPendingTaskCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waitingCount_ + running_ + runningInline_;
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,207 @@
+#ifndef QUOTA_EXECUTOR_H
+#define QUOTA_EXECUTOR_H
+
+#include "ThreadPool.h"
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <string>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Bounded share of a shared ThreadPool
+ *
+ * Each service (and each session's copy of it) gets a QuotaExecutor on
+ * ThreadPool::shared() instead of its own threads. At most `quota` of its
+ * tasks occupy pool workers at once; the rest wait in private queues and
+ * are posted to the pool's injection queue as slots free up, so a busy
+ * client cannot crowd out others and the process thread count stays
+ * bounded by the shared pool no matter how many sessions exist.
+ *
+ * Waiting tasks are kept in per-priority lanes and handed slots in
+ * priority order; background tasks may hold at most quota - 1 slots so
+ * foreground work always finds one. Deadlines are checked here, when a
+ * task is about to run, and priority is forwarded to the pool.
+ *
+ * The interface mirrors ThreadPool (submit/execute/waitHelp/waitAll) so
+ * services can switch between the two without restructuring.
+ */
+class QuotaExecutor {
+public:
+    /**
+     * @brief Create an executor on a shared pool
+     * @param pool Pool that runs the tasks (must outlive this executor)
+     * @param quota Maximum tasks running on the pool at once (weight)
+     * @param maxQueueSize Maximum tasks waiting for a slot (0 = unlimited)
+     * @param name Label used in error messages
+     */
+    QuotaExecutor(ThreadPool& pool, int quota, int maxQueueSize = 0,
+                  const std::string& name = "executor");
+
+    /**
+     * @brief Destructor - waits for all of this executor's tasks
+     */
+    ~QuotaExecutor();
+
+    // Non-copyable
+    QuotaExecutor(const QuotaExecutor&) = delete;
+    QuotaExecutor& operator=(const QuotaExecutor&) = delete;
+
+    /**
+     * @brief Submit a task and get a future for the result
+     * @param f Function to execute
+     * @param args Arguments to pass to the function
+     * @return Future containing the result
+     */
+    template<typename F, typename... Args,
+             typename = std::enable_if_t<!std::is_same<std::decay_t<F>, TaskOptions>::value>>
+    auto submit(F&& f, Args&&... args)
+        -> std::future<typename std::invoke_result<F, Args...>::type>;
+
+    /**
+     * @brief Submit a task with a priority and/or deadline
+     * @return Future for the result (broken_promise if the task expired)
+     */
+    template<typename F, typename... Args>
+    auto submit(const TaskOptions& options, F&& f, Args&&... args)
+        -> std::future<typename std::invoke_result<F, Args...>::type>;
+
+    /**
+     * @brief Submit a task without waiting for result
+     * @param task Function to execute
+     */
+    void execute(std::function<void()> task);
+    void execute(const TaskOptions& options, std::function<void()> task);
+
+    /**
+     * @brief Wait for a future, running queued work while it is not ready
+     *
+     * On a pool worker this first drains this executor's own waiting
+     * tasks inline (they would otherwise need a slot held by the caller),
+     * then helps the shared pool, so nested fan-out cannot deadlock.
+     */
+    template<typename T>
+    void waitHelp(const std::future<T>& future);
+
+    /**
+     * @brief Wait for all of this executor's tasks to complete
+     * @note Must not be called from a task of this executor
+     */
+    void waitAll();
+
+    /**
+     * @brief Stop accepting tasks
+     * @param waitForTasks If true, let queued tasks run; otherwise drop them
+     */
+    void shutdown(bool waitForTasks = true);
+
+    /**
+     * @brief Change the concurrency quota
+     *
+     * Raising it dispatches waiting tasks immediately; lowering it takes
+     * effect as running tasks finish.
+     */
+    void setQuota(int quota);
+
+    int getQuota() const;
+
+    /**
+     * @brief Get number of tasks waiting for a slot or running
+     */
+    int getPendingTaskCount() const;
+
+    ThreadPool& getPool() const { return pool_; }
+
+    /**
+     * @brief Metrics for this executor's tasks only
+     *
+     * activeThreads reports running tasks (slots in use), not pool threads.
+     */
+    const ThreadPoolMetrics& getMetrics() const { return metrics_; }
+    void resetMetrics() { metrics_.reset(); }
+
+private:
+    struct Entry {
+        std::function<void()> fn;
+        std::chrono::steady_clock::time_point enqueuedAt;
+        TaskOptions options;
+    };
+
+    static constexpr int kPriorityCount = 3;
+
+    ThreadPool& pool_;
+    std::string name_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable idleCondition_;
+    std::deque<Entry> waiting_[kPriorityCount];  // One lane per TaskPriority
+    int waitingCount_ = 0;
+    int quota_;
+    int maxQueueSize_;
+    int running_ = 0;            // Slots holding a pool task
+    int runningBackground_ = 0;  // Of which background priority
+    int runningInline_ = 0;      // Entries run by waitHelp() on the caller
+    bool stopped_ = false;
+
+    ThreadPoolMetrics metrics_;
+
+    void dispatch(Entry entry, bool fair);
+    void runEntry(Entry& entry);
+    void releaseSlot(TaskPriority finished);
+    bool tryRunWaiting();
+    bool canStartLocked(TaskPriority priority) const;
+    bool popNextLocked(Entry& entry, bool allowBackground);
+    void notifyIfIdleLocked();
+};
+
+// Template implementation
+
+template<typename F, typename... Args, typename>
+auto QuotaExecutor::submit(F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type> {
+    return submit(TaskOptions{}, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<typename F, typename... Args>
+auto QuotaExecutor::submit(const TaskOptions& options, F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type> {
+
+    using ReturnType = typename std::invoke_result<F, Args...>::type;
+
+    auto task = std::make_shared<std::packaged_task<ReturnType()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+
+    std::future<ReturnType> result = task->get_future();
+    execute(options, [task]() {
+        (*task)();
+    });
+
+    return result;
+}
+
+template<typename T>
+void QuotaExecutor::waitHelp(const std::future<T>& future) {
+    if (!pool_.isWorkerThread()) {
+        future.wait();
+        return;
+    }
+
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (tryRunWaiting() || pool_.tryRunPendingTask()) {
+            continue;
+        }
+        future.wait_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // QUOTA_EXECUTOR_H
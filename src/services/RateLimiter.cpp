@@ -0,0 +1,124 @@
+#include "RateLimiter.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+namespace FranchiseAI {
+namespace Services {
+
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RateLimiter::RateLimiter(double requestsPerSecond) {
+    setRate(requestsPerSecond);
+}
+
+std::shared_ptr<RateLimiter> RateLimiter::shared(const std::string& upstream, double requestsPerSecond) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<RateLimiter>> limiters;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& limiter = limiters[upstream];
+    if (!limiter) {
+        limiter = std::make_shared<RateLimiter>(requestsPerSecond);
+    } else {
+        limiter->setRate(requestsPerSecond);
+    }
+    return limiter;
+}
+
+std::string RateLimiter::hostOf(const std::string& url) {
+    size_t start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    size_t end = url.find_first_of(":/?#", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+void RateLimiter::setRate(double requestsPerSecond) {
+    if (requestsPerSecond <= 0) {
+        intervalNs_ = 0;
+        burstNs_ = 0;
+        return;
+    }
+
+    int64_t interval = static_cast<int64_t>(1e9 / requestsPerSecond);
+    // At least one token at a time, so a rate of 1/s is exactly one per second
+    int64_t burstTokens = std::max<int64_t>(1, static_cast<int64_t>(requestsPerSecond * kBurstSeconds));
+    intervalNs_ = interval;
+    burstNs_ = (burstTokens - 1) * interval;
+}
+
+double RateLimiter::getRate() const {
+    int64_t interval = intervalNs_.load();
+    return interval > 0 ? 1e9 / interval : 0.0;
+}
+
+std::chrono::milliseconds RateLimiter::reserve() {
+    stats_.requests++;
+
+    int64_t interval = intervalNs_.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return std::chrono::milliseconds(0);
+    }
+    int64_t burst = burstNs_.load(std::memory_order_relaxed);
+    int64_t now = steadyNowNs();
+
+    // The token is usable once the schedule is no further than burst ahead
+    // of now; taking it moves the schedule one interval on
+    int64_t nextFree = nextFreeNs_.load();
+    int64_t sendAt;
+    do {
+        sendAt = std::max(now, nextFree - burst);
+    } while (!nextFreeNs_.compare_exchange_weak(nextFree, std::max(nextFree, sendAt) + interval));
+
+    // Round up so the request is never sent early
+    int64_t waitMs = (sendAt - now + 999999) / 1000000;
+    if (waitMs > 0) {
+        stats_.delayed++;
+        stats_.totalDelayMs += waitMs;
+    }
+    return std::chrono::milliseconds(waitMs);
+}
+
+void RateLimiter::pause(std::chrono::milliseconds duration) {
+    stats_.pauses++;
+
+    int64_t burst = burstNs_.load(std::memory_order_relaxed);
+    int64_t resumeAt = steadyNowNs() +
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+    // No token before resumeAt, and no burst right after it
+    int64_t nextFree = nextFreeNs_.load();
+    while (nextFree < resumeAt + burst &&
+           !nextFreeNs_.compare_exchange_weak(nextFree, resumeAt + burst)) {
+    }
+}
+
+std::chrono::milliseconds RateLimiter::backoff(int attempt, std::chrono::milliseconds base) {
+    thread_local std::mt19937 random(std::random_device{}());
+
+    int64_t ceiling = std::max<int64_t>(base.count(), 1);
+    for (int i = 0; i < attempt && ceiling < kMaxBackoff.count(); ++i) {
+        ceiling *= 2;
+    }
+    ceiling = std::min<int64_t>(ceiling, kMaxBackoff.count());
+
+    // Equal jitter: retries of requests that failed together spread out,
+    // but none comes back sooner than half the backoff
+    std::uniform_int_distribution<int64_t> jitter(0, ceiling / 2);
+    return std::chrono::milliseconds(ceiling - ceiling / 2 + jitter(random));
+}
+
+std::chrono::milliseconds RateLimiter::retryDelay(const HttpResponse& response, int attempt,
+                                                  std::chrono::milliseconds base) {
+    if (response.retryAfterSeconds > 0) {
+        return std::min(std::chrono::milliseconds(response.retryAfterSeconds * 1000), kMaxBackoff);
+    }
+    return backoff(attempt, base);
+}
+
+} // namespace Services
+} // namespace FranchiseAI
@@ -0,0 +1,128 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "HttpClient.h"
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Counters for a RateLimiter
+ */
+struct RateLimiterStats {
+    std::atomic<int> requests{0};           // Tokens handed out
+    std::atomic<int> delayed{0};            // Requests that had to wait for their token
+    std::atomic<int64_t> totalDelayMs{0};
+    std::atomic<int> pauses{0};             // Rate limit responses that paused the upstream
+
+    double getAverageDelayMs() const {
+        int total = requests.load();
+        if (total == 0) return 0.0;
+        return static_cast<double>(totalDelayMs.load()) / total;
+    }
+
+    void reset() {
+        requests = 0;
+        delayed = 0;
+        totalDelayMs = 0;
+        pauses = 0;
+    }
+};
+
+/**
+ * @brief Token bucket spacing the requests sent to one upstream API
+ *
+ * reserve() takes the next token and returns how long the caller must
+ * hold its request back; it never blocks. Requests on the HttpClient
+ * reactor pass that as the performAsync() delay, so a burst of lookups
+ * queues on the reactor instead of occupying worker threads, and leaves
+ * at maxRequestsPerSecond after an initial burst of kBurstSeconds worth
+ * of tokens.
+ *
+ * The bucket is one atomic: the time the next token becomes free
+ * (GCRA), advanced with compare-and-swap, so concurrent callers from
+ * every session never take a lock.
+ *
+ * shared() returns one limiter per upstream for the whole process. When
+ * the upstream answers "too many requests", pause() pushes every later
+ * token back by the Retry-After time, or by a jittered exponential
+ * backoff when the response has none.
+ */
+class RateLimiter {
+public:
+    // Tokens that may be spent at once after an idle period
+    static constexpr double kBurstSeconds = 0.2;
+
+    /**
+     * @param requestsPerSecond 0 or less = unlimited
+     */
+    explicit RateLimiter(double requestsPerSecond);
+
+    // Non-copyable
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Process-wide limiter for an upstream
+     * @param upstream Usually hostOf() the endpoint; APIs with separate
+     *        quotas on one host add a suffix
+     * @param requestsPerSecond Applied to the limiter (the latest setting wins)
+     */
+    static std::shared_ptr<RateLimiter> shared(const std::string& upstream, double requestsPerSecond);
+
+    /**
+     * @brief Host part of a URL ("nominatim.openstreetmap.org")
+     */
+    static std::string hostOf(const std::string& url);
+
+    void setRate(double requestsPerSecond);
+    double getRate() const;
+
+    /**
+     * @brief Take the next token
+     * @return How long to wait before sending (zero if a token is free now)
+     */
+    std::chrono::milliseconds reserve();
+
+    /**
+     * @brief Hold back every token not yet handed out for duration
+     *
+     * Requests that already reserved a token are not recalled.
+     */
+    void pause(std::chrono::milliseconds duration);
+
+    /**
+     * @brief Exponential backoff with equal jitter
+     * @return A random delay between half and all of min(base * 2^attempt, kMaxBackoff)
+     */
+    static std::chrono::milliseconds backoff(int attempt, std::chrono::milliseconds base);
+
+    /**
+     * @brief Delay before retrying a failed or rate-limited response
+     *
+     * The server's Retry-After when it sent one, otherwise backoff().
+     */
+    static std::chrono::milliseconds retryDelay(const HttpResponse& response, int attempt,
+                                                std::chrono::milliseconds base);
+
+    static constexpr std::chrono::milliseconds kMaxBackoff{30000};
+
+    const RateLimiterStats& getStats() const { return stats_; }
+    void resetStats() { stats_.reset(); }
+
+private:
+    std::atomic<int64_t> intervalNs_{0};    // Time between tokens (0 = unlimited)
+    std::atomic<int64_t> burstNs_{0};       // How far ahead of the schedule tokens may be spent
+    std::atomic<int64_t> nextFreeNs_{0};    // When the next token is due (steady clock)
+    RateLimiterStats stats_;
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // RATE_LIMITER_H
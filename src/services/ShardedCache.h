@@ -0,0 +1,534 @@
+#ifndef SHARDED_CACHE_H
+#define SHARDED_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace FranchiseAI {
+namespace Services {
+
+/**
+ * @brief Size and eviction counters for ShardedCache
+ *
+ * bytes and entries are current levels; the others count events.
+ */
+struct ShardedCacheStats {
+    std::atomic<int64_t> bytes{0};       // Weighed size of the entries held
+    std::atomic<int> entries{0};
+    std::atomic<int> evictions{0};       // Entries dropped to stay within the byte budget
+    std::atomic<int> rejections{0};      // New entries refused because they were used less than the victim
+    std::atomic<int> expirations{0};     // Entries dropped after their expiry time
+
+    void resetCounters() {
+        evictions = 0;
+        rejections = 0;
+        expirations = 0;
+    }
+};
+
+/**
+ * @brief Heap bytes owned by a string, for cache weighers
+ */
+inline size_t heapBytes(const std::string& text) {
+    // Short strings live inside the object (small string optimization)
+    return text.capacity() > 15 ? text.capacity() + 1 : 0;
+}
+
+inline size_t heapBytes(const std::vector<std::string>& texts) {
+    size_t bytes = texts.capacity() * sizeof(std::string);
+    for (const auto& text : texts) {
+        bytes += heapBytes(text);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Approximate access counts of recently used keys (count-min sketch)
+ *
+ * Four rows of saturating 4-bit counters. All counters are halved once
+ * 10 x width accesses have been recorded, so old popularity fades.
+ */
+class FrequencySketch {
+public:
+    explicit FrequencySketch(size_t width = 64) {
+        size_t rounded = 64;
+        while (rounded < width) {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        sampleSize_ = rounded * 10;
+        table_.assign(rounded * kRows, 0);
+    }
+
+    void increment(uint64_t hash) {
+        bool added = false;
+        for (size_t row = 0; row < kRows; ++row) {
+            uint8_t& counter = table_[indexOf(hash, row)];
+            if (counter < 15) {
+                ++counter;
+                added = true;
+            }
+        }
+        if (added && ++additions_ >= sampleSize_) {
+            for (auto& counter : table_) {
+                counter >>= 1;
+            }
+            additions_ /= 2;
+        }
+    }
+
+    int frequency(uint64_t hash) const {
+        int frequency = 15;
+        for (size_t row = 0; row < kRows; ++row) {
+            frequency = std::min<int>(frequency, table_[indexOf(hash, row)]);
+        }
+        return frequency;
+    }
+
+private:
+    static constexpr size_t kRows = 4;
+
+    size_t indexOf(uint64_t hash, size_t row) const {
+        static constexpr uint64_t kSeeds[kRows] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+            0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+        };
+        uint64_t mixed = (hash + kSeeds[row]) * 0x9e3779b97f4a7c15ULL;
+        return row * (mask_ + 1) + ((mixed >> 32) & mask_);
+    }
+
+    std::vector<uint8_t> table_;
+    size_t mask_ = 0;
+    size_t sampleSize_ = 0;
+    size_t additions_ = 0;
+};
+
+/**
+ * @brief Concurrent cache bounded by a byte budget, with W-TinyLFU admission
+ *
+ * Keys are spread over independently locked shards, so threads working on
+ * different keys rarely wait for each other. Each shard gets an equal
+ * share of the byte budget and runs Window-TinyLFU:
+ *  - New entries enter a small LRU window (1% of the shard).
+ *  - Entries leaving the window become candidates for the main area,
+ *    a segmented LRU of probation and protected (80%) entries. An entry
+ *    read again while in probation moves to protected.
+ *  - When the shard is over budget, the newest candidate competes with
+ *    the least recently used probation entry. The one read less often
+ *    according to the shard's FrequencySketch is dropped, so a burst of
+ *    one-off keys cannot flush entries that are read again and again.
+ *
+ * Entry sizes come from the weigher plus a fixed per-node overhead.
+ * Entries may carry an expiry time. An expired entry is dropped when it
+ * is read, and each shard sweeps out all its expired entries at most once
+ * a minute, from the first write after that minute. sweepExpired() runs
+ * the sweep on every shard at once.
+ *
+ * Safe to use from any thread.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedCache {
+public:
+    using Weigher = std::function<size_t(const Key& key, const Value& value)>;
+
+    static constexpr size_t kDefaultShards = 16;
+    static constexpr size_t kNodeOverhead = 96;     // List node, index slot and bookkeeping
+    static constexpr int kSweepIntervalSeconds = 60;
+
+    /**
+     * @param maxBytes Budget for all shards together
+     * @param weigher Heap bytes of an entry (nullptr = sizeof(Value))
+     * @param stats Counters to update (nullptr = the cache's own)
+     * @param shardCount Number of independently locked shards
+     */
+    explicit ShardedCache(size_t maxBytes, Weigher weigher = nullptr,
+                          ShardedCacheStats* stats = nullptr,
+                          size_t shardCount = kDefaultShards)
+        : weigher_(std::move(weigher)),
+          stats_(stats ? stats : &ownStats_) {
+        shards_.reserve(std::max<size_t>(shardCount, 1));
+        for (size_t i = 0; i < std::max<size_t>(shardCount, 1); ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+        setMaxBytes(maxBytes);
+    }
+
+    // Non-copyable
+    ShardedCache(const ShardedCache&) = delete;
+    ShardedCache& operator=(const ShardedCache&) = delete;
+
+    /**
+     * @brief Copy of an entry, recording the read
+     */
+    bool get(const Key& key, Value& value) {
+        uint64_t hash = hashOf(key);
+        Shard& shard = shardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.sketch.increment(hash);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        if (expired(*it->second, std::time(nullptr))) {
+            removeLocked(shard, it->second);
+            stats_->expirations++;
+            return false;
+        }
+        touchLocked(shard, it->second);
+        value = it->second->value;
+        return true;
+    }
+
+    /**
+     * @brief Copy of an entry without recording a read
+     */
+    bool peek(const Key& key, Value& value) const {
+        const Shard& shard = shardFor(hashOf(key));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end() || expired(*it->second, std::time(nullptr))) {
+            return false;
+        }
+        value = it->second->value;
+        return true;
+    }
+
+    /**
+     * @brief Modify an entry in place under its shard's lock
+     * @param fn Called as fn(Value&); the entry is weighed again afterwards
+     * @return false if the key is not cached or has expired
+     */
+    template<typename Fn>
+    bool update(const Key& key, Fn&& fn) {
+        Shard& shard = shardFor(hashOf(key));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        if (expired(*it->second, std::time(nullptr))) {
+            removeLocked(shard, it->second);
+            stats_->expirations++;
+            return false;
+        }
+        Node& node = *it->second;
+        fn(node.value);
+        resizeLocked(shard, node, weigh(key, node.value));
+        evictLocked(shard);
+        return true;
+    }
+
+    /**
+     * @brief Add or replace an entry
+     * @param expiresAt Time after which the entry is dropped (0 = never)
+     * @return Whether the entry is cached after admission and eviction
+     */
+    bool put(const Key& key, Value value, time_t expiresAt = 0) {
+        uint64_t hash = hashOf(key);
+        size_t bytes = weigh(key, value);
+        Shard& shard = shardFor(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        time_t now = std::time(nullptr);
+        if (now >= shard.nextSweep) {
+            sweepLocked(shard, now);
+        }
+        shard.sketch.increment(hash);
+
+        auto it = shard.index.find(key);
+        if (bytes > shard.capacity) {
+            if (it != shard.index.end()) {
+                removeLocked(shard, it->second);
+            }
+            stats_->rejections++;
+            return false;
+        }
+
+        if (it != shard.index.end()) {
+            Node& node = *it->second;
+            node.value = std::move(value);
+            node.expiresAt = expiresAt;
+            resizeLocked(shard, node, bytes);
+            touchLocked(shard, it->second);
+        } else {
+            shard.window.push_front(Node{key, std::move(value), bytes, expiresAt, Segment::Window});
+            shard.index.emplace(key, shard.window.begin());
+            shard.windowBytes += bytes;
+            shard.bytes += bytes;
+            stats_->bytes += static_cast<int64_t>(bytes);
+            stats_->entries++;
+        }
+
+        evictLocked(shard);
+        return shard.index.find(key) != shard.index.end();
+    }
+
+    bool erase(const Key& key) {
+        Shard& shard = shardFor(hashOf(key));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        removeLocked(shard, it->second);
+        return true;
+    }
+
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats_->bytes -= static_cast<int64_t>(shard->bytes);
+            stats_->entries -= static_cast<int>(shard->index.size());
+            shard->index.clear();
+            shard->window.clear();
+            shard->probation.clear();
+            shard->protectedList.clear();
+            shard->windowBytes = shard->probationBytes = shard->protectedBytes = shard->bytes = 0;
+        }
+    }
+
+    /**
+     * @brief Change the byte budget; a smaller one evicts at once
+     *
+     * Calls are serialized, so every shard ends up with the capacity of
+     * the last one.
+     */
+    void setMaxBytes(size_t maxBytes) {
+        std::lock_guard<std::mutex> resizeLock(resizeMutex_);
+        maxBytes_ = maxBytes;
+        size_t capacity = maxBytes / shards_.size();
+        // Sized for entries of about 512 bytes; larger entries just leave it sparse
+        size_t sketchWidth = std::min<size_t>(std::max<size_t>(capacity / 512, 64), 16384);
+
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->capacity = capacity;
+            shard->windowCapacity = capacity / 100;
+            shard->protectedCapacity = (capacity - shard->windowCapacity) / 10 * 8;
+            if (shard->sketchWidth != sketchWidth) {
+                shard->sketch = FrequencySketch(sketchWidth);
+                shard->sketchWidth = sketchWidth;
+            }
+            evictLocked(*shard);
+        }
+    }
+
+    /**
+     * @brief Drop every expired entry now instead of waiting for the next sweep
+     */
+    void sweepExpired() {
+        time_t now = std::time(nullptr);
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            sweepLocked(*shard, now);
+        }
+    }
+
+    size_t maxBytes() const { return maxBytes_.load(); }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->index.size();
+        }
+        return total;
+    }
+
+    size_t bytes() const {
+        return static_cast<size_t>(std::max<int64_t>(stats_->bytes.load(), 0));
+    }
+
+    /**
+     * @brief Call fn(const Key&, const Value&) for every unexpired entry, one shard at a time
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        time_t now = std::time(nullptr);
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            for (const auto& entry : shard->index) {
+                if (!expired(*entry.second, now)) {
+                    fn(entry.first, entry.second->value);
+                }
+            }
+        }
+    }
+
+    const ShardedCacheStats& getStats() const { return *stats_; }
+
+private:
+    enum class Segment : uint8_t { Window, Probation, Protected };
+
+    struct Node {
+        Key key;
+        Value value;
+        size_t bytes;
+        time_t expiresAt;
+        Segment segment;
+    };
+
+    using List = std::list<Node>;
+    using Position = typename List::iterator;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, Position, Hash> index;
+        List window;                // Front = most recently used
+        List probation;
+        List protectedList;
+        size_t windowBytes = 0;
+        size_t probationBytes = 0;
+        size_t protectedBytes = 0;
+        size_t bytes = 0;
+        size_t capacity = 0;
+        size_t windowCapacity = 0;
+        size_t protectedCapacity = 0;
+        FrequencySketch sketch;
+        size_t sketchWidth = 0;
+        time_t nextSweep = 0;
+
+        List& list(Segment segment) {
+            return segment == Segment::Window ? window
+                 : segment == Segment::Probation ? probation : protectedList;
+        }
+
+        size_t& bytesOf(Segment segment) {
+            return segment == Segment::Window ? windowBytes
+                 : segment == Segment::Probation ? probationBytes : protectedBytes;
+        }
+    };
+
+    static uint64_t hashOf(const Key& key) {
+        // Spread weak std::hash values (identity for integers) over all bits
+        uint64_t h = static_cast<uint64_t>(Hash()(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    Shard& shardFor(uint64_t hash) { return *shards_[(hash >> 40) % shards_.size()]; }
+    const Shard& shardFor(uint64_t hash) const { return *shards_[(hash >> 40) % shards_.size()]; }
+
+    static bool expired(const Node& node, time_t now) {
+        return node.expiresAt != 0 && now >= node.expiresAt;
+    }
+
+    size_t weigh(const Key& key, const Value& value) const {
+        return kNodeOverhead + (weigher_ ? weigher_(key, value) : sizeof(Value));
+    }
+
+    void moveLocked(Shard& shard, Position position, Segment to) {
+        Node& node = *position;
+        shard.bytesOf(node.segment) -= node.bytes;
+        shard.bytesOf(to) += node.bytes;
+        shard.list(to).splice(shard.list(to).begin(), shard.list(node.segment), position);
+        node.segment = to;
+    }
+
+    void touchLocked(Shard& shard, Position position) {
+        if (position->segment == Segment::Probation) {
+            // Read again: promote, demoting the oldest protected entries if needed
+            moveLocked(shard, position, Segment::Protected);
+            while (shard.protectedBytes > shard.protectedCapacity && shard.protectedList.size() > 1) {
+                moveLocked(shard, std::prev(shard.protectedList.end()), Segment::Probation);
+            }
+        } else {
+            List& list = shard.list(position->segment);
+            list.splice(list.begin(), list, position);
+        }
+    }
+
+    void resizeLocked(Shard& shard, Node& node, size_t bytes) {
+        shard.bytesOf(node.segment) += bytes - node.bytes;
+        shard.bytes += bytes - node.bytes;
+        stats_->bytes += static_cast<int64_t>(bytes) - static_cast<int64_t>(node.bytes);
+        node.bytes = bytes;
+    }
+
+    void removeLocked(Shard& shard, Position position) {
+        Node& node = *position;
+        shard.bytesOf(node.segment) -= node.bytes;
+        shard.bytes -= node.bytes;
+        stats_->bytes -= static_cast<int64_t>(node.bytes);
+        stats_->entries--;
+        shard.index.erase(node.key);
+        shard.list(node.segment).erase(position);
+    }
+
+    void evictLocked(Shard& shard) {
+        // Entries pushed out of the window become candidates for the main area
+        while (shard.windowBytes > shard.windowCapacity && shard.window.size() > 1) {
+            moveLocked(shard, std::prev(shard.window.end()), Segment::Probation);
+        }
+
+        while (shard.bytes > shard.capacity) {
+            if (shard.probation.empty()) {
+                if (!shard.protectedList.empty()) {
+                    moveLocked(shard, std::prev(shard.protectedList.end()), Segment::Probation);
+                } else {
+                    removeLocked(shard, std::prev(shard.window.end()));
+                    stats_->evictions++;
+                }
+                continue;
+            }
+
+            Position victim = std::prev(shard.probation.end());
+            Position candidate = shard.probation.begin();
+            if (victim == candidate) {
+                removeLocked(shard, victim);
+                stats_->evictions++;
+                continue;
+            }
+
+            // The candidate must have been read more often than the victim
+            if (shard.sketch.frequency(hashOf(candidate->key)) >
+                shard.sketch.frequency(hashOf(victim->key))) {
+                removeLocked(shard, victim);
+                stats_->evictions++;
+            } else {
+                removeLocked(shard, candidate);
+                stats_->rejections++;
+            }
+        }
+    }
+
+    void sweepLocked(Shard& shard, time_t now) {
+        shard.nextSweep = now + kSweepIntervalSeconds;
+        for (List* list : {&shard.window, &shard.probation, &shard.protectedList}) {
+            for (auto it = list->begin(); it != list->end();) {
+                auto next = std::next(it);
+                if (expired(*it, now)) {
+                    removeLocked(shard, it);
+                    stats_->expirations++;
+                }
+                it = next;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    Weigher weigher_;
+    ShardedCacheStats ownStats_;
+    ShardedCacheStats* stats_;
+    std::atomic<size_t> maxBytes_{0};
+    std::mutex resizeMutex_;    // Serializes setMaxBytes()
+};
+
+} // namespace Services
+} // namespace FranchiseAI
+
+#endif // SHARDED_CACHE_H
@@ -4,14 +4,56 @@
 namespace FranchiseAI {
 namespace Services {
 
+// Identifies the pool and deque owned by the calling worker thread
+static thread_local const ThreadPool* tlsCurrentPool = nullptr;
+static thread_local int tlsWorkerIndex = -1;
+
+// Priority of the task currently running on this thread (any pool)
+static thread_local TaskPriority tlsRunningPriority = TaskPriority::Normal;
+
+// Shared pool configuration, fixed once the shared pool is created
+static std::mutex sharedPoolMutex;
+static bool sharedPoolCreated = false;
+
+static ThreadPoolConfig& sharedPoolConfig() {
+    static ThreadPoolConfig config = [] {
+        ThreadPoolConfig defaults;
+        defaults.threadCount = ThreadPoolConfig::getOptimalThreadCount();
+        defaults.minThreads = 2;
+        defaults.maxThreads = defaults.threadCount * 2;
+        defaults.enableAutoScaling = true;
+        defaults.maxQueueSize = 0;  // Bounded per client by QuotaExecutor
+        return defaults;
+    }();
+    return config;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool([] {
+        std::lock_guard<std::mutex> lock(sharedPoolMutex);
+        sharedPoolCreated = true;
+        return sharedPoolConfig();
+    }());
+    return pool;
+}
+
+bool ThreadPool::configureShared(const ThreadPoolConfig& config) {
+    std::lock_guard<std::mutex> lock(sharedPoolMutex);
+    if (sharedPoolCreated) {
+        return false;
+    }
+    sharedPoolConfig() = config;
+    return true;
+}
+
 ThreadPool::ThreadPool(int threadCount) {
-    config_.threadCount = std::max(1, threadCount);
+    config_.threadCount = std::max(1, std::min(threadCount, ThreadPoolConfig::kMaxThreads));
     createWorkers(config_.threadCount);
 }
 
 ThreadPool::ThreadPool(const ThreadPoolConfig& config)
     : config_(config) {
-    config_.threadCount = std::max(1, config_.threadCount);
+    config_.threadCount = std::max(1, std::min(config_.threadCount, ThreadPoolConfig::kMaxThreads));
     createWorkers(config_.threadCount);
 }
 
@@ -20,82 +62,450 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::createWorkers(int count) {
-    workers_.reserve(count);
+    // Slots must all exist before any worker starts stealing
+    slots_.reserve(ThreadPoolConfig::kMaxThreads);
+    for (int i = 0; i < ThreadPoolConfig::kMaxThreads; ++i) {
+        slots_.push_back(std::make_unique<WorkerSlot>());
+    }
+
+    std::lock_guard<std::mutex> lock(resizeMutex_);
     for (int i = 0; i < count; ++i) {
-        workers_.emplace_back(&ThreadPool::workerThread, this);
+        spawnWorker();
     }
 }
 
-void ThreadPool::workerThread() {
-    while (true) {
-        std::function<void()> task;
+bool ThreadPool::spawnWorker() {
+    // Caller holds resizeMutex_
+    if (stopped_ || workerCount_.load() >= ThreadPoolConfig::kMaxThreads) {
+        return false;
+    }
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
+    for (int i = 0; i < ThreadPoolConfig::kMaxThreads; ++i) {
+        WorkerSlot& slot = *slots_[i];
+        if (slot.active.load()) {
+            continue;
+        }
 
-            condition_.wait(lock, [this] {
-                return stopped_ || !tasks_.empty();
-            });
+        // Reap the previous (already exited) occupant
+        if (slot.thread.joinable()) {
+            slot.thread.join();
+        }
 
-            if (stopped_ && tasks_.empty()) {
-                return;
-            }
+        slot.retire = false;
+        slot.active = true;
+        if (i + 1 > slotHighWater_.load()) {
+            slotHighWater_ = i + 1;
+        }
 
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
-                metrics_.currentQueueSize = static_cast<int>(tasks_.size());
-                metrics_.activeThreads++;
-            }
+        ++workerCount_;
+        slot.thread = std::thread(&ThreadPool::workerThread, this, static_cast<size_t>(i));
+        return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::retireWorker() {
+    // Caller holds resizeMutex_. Retire the highest live slot so that
+    // the low slots stay densely packed.
+    for (int i = slotHighWater_.load() - 1; i >= 0; --i) {
+        WorkerSlot& slot = *slots_[i];
+        if (slot.active.load() && !slot.retire.load()) {
+            slot.retire = true;
+            --workerCount_;
+            return true;
         }
+    }
 
-        if (task) {
-            auto startTime = std::chrono::high_resolution_clock::now();
+    return false;
+}
 
-            try {
-                task();
-                metrics_.tasksCompleted++;
-            } catch (...) {
-                metrics_.tasksFailed++;
-            }
+void ThreadPool::adjustWorkerCount(int target) {
+    // Caller holds resizeMutex_
+    while (workerCount_.load() < target && spawnWorker()) {
+        metrics_.workersAdded++;
+    }
 
-            auto endTime = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                endTime - startTime).count();
-            metrics_.totalProcessingTimeMs += duration;
+    bool retired = false;
+    while (workerCount_.load() > target && retireWorker()) {
+        retired = true;
+    }
 
-            metrics_.activeThreads--;
-            --pendingTasks_;
+    if (retired) {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        condition_.notify_all();
+    }
+}
 
-            completionCondition_.notify_all();
+void ThreadPool::maybeScaleUp() {
+    int workers = workerCount_.load();
+    if (queuedTasks_.load() <= workers * std::max(1, config_.scaleUpQueueDepth)) {
+        return;
+    }
+
+    // Never block a submitter on a concurrent resize
+    std::unique_lock<std::mutex> lock(resizeMutex_, std::try_to_lock);
+    if (!lock.owns_lock() || workerCount_.load() >= config_.getMaxThreads()) {
+        return;
+    }
+
+    if (spawnWorker()) {
+        metrics_.workersAdded++;
+    }
+}
+
+bool ThreadPool::tryRetireIdleWorker(size_t index) {
+    std::lock_guard<std::mutex> lock(resizeMutex_);
+
+    WorkerSlot& slot = *slots_[index];
+    if (slot.retire.load()) {
+        return true;
+    }
+
+    if (stopped_ || queuedTasks_.load() > 0 ||
+        workerCount_.load() <= config_.getMinThreads()) {
+        return false;
+    }
+
+    slot.retire = true;
+    --workerCount_;
+    return true;
+}
+
+void ThreadPool::handOffLocalTasks(size_t index) {
+    std::deque<Task> orphaned;
+    {
+        WorkerSlot& slot = *slots_[index];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        orphaned.swap(slot.tasks);
+    }
+
+    if (orphaned.empty()) {
+        return;
+    }
+
+    // queuedTasks_ already counts these; they just change queues
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        for (auto& task : orphaned) {
+            lanes_[static_cast<int>(task.options.priority)].push_back(std::move(task));
         }
     }
+
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    condition_.notify_all();
 }
 
-void ThreadPool::execute(std::function<void()> task) {
+int ThreadPool::currentWorkerIndex() const {
+    return tlsCurrentPool == this ? tlsWorkerIndex : -1;
+}
+
+void ThreadPool::workerThread(size_t index) {
+    tlsCurrentPool = this;
+    tlsWorkerIndex = static_cast<int>(index);
+
+    WorkerSlot& slot = *slots_[index];
+
+    while (!slot.retire.load()) {
+        Task task;
+
+        if (tryAcquireTask(index, task, false)) {
+            runTask(task);
+            continue;
+        }
+
+        bool idleTimedOut = false;
+        {
+            std::unique_lock<std::mutex> lock(idleMutex_);
+            ++idleWorkers_;
+            auto ready = [this, &slot] {
+                return stopped_ || hasRunnableWork() || slot.retire.load();
+            };
+            if (config_.enableAutoScaling) {
+                idleTimedOut = !condition_.wait_for(
+                    lock, std::chrono::milliseconds(config_.idleRetireMs), ready);
+            } else {
+                condition_.wait(lock, ready);
+            }
+            --idleWorkers_;
+        }
+
+        if (stopped_ && queuedTasks_.load() == 0) {
+            break;
+        }
+
+        if (idleTimedOut && tryRetireIdleWorker(index)) {
+            break;
+        }
+    }
+
+    if (slot.retire.load()) {
+        handOffLocalTasks(index);
+        metrics_.workersRetired++;
+    }
+
+    tlsCurrentPool = nullptr;
+    tlsWorkerIndex = -1;
+    slot.active = false;
+}
+
+bool ThreadPool::tryAcquireTask(size_t index, Task& task, bool helping) {
+    // 1. Interactive lane, oldest first
     {
-        std::unique_lock<std::mutex> lock(queueMutex_);
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto& interactive = lanes_[static_cast<int>(TaskPriority::Interactive)];
+        if (!interactive.empty()) {
+            task = std::move(interactive.front());
+            interactive.pop_front();
+            --queuedTasks_;
+            return true;
+        }
+    }
 
-        if (stopped_) {
-            throw std::runtime_error("Cannot execute on stopped thread pool");
+    // 2. Own deque, newest first (keeps nested fan-out cache-warm)
+    if (config_.enableWorkStealing) {
+        WorkerSlot& own = *slots_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queuedTasks_;
+            metrics_.localTasksExecuted++;
+            return true;
+        }
+    }
+
+    // 3. Normal lane, oldest first
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto& normal = lanes_[static_cast<int>(TaskPriority::Normal)];
+        if (!normal.empty()) {
+            task = std::move(normal.front());
+            normal.pop_front();
+            --queuedTasks_;
+            return true;
+        }
+    }
+
+    // 4. Steal from a sibling
+    if (config_.enableWorkStealing && trySteal(index, task)) {
+        return true;
+    }
+
+    // 5. Background lane, only while foreground capacity stays reserved
+    return tryAcquireBackground(task, helping);
+}
+
+bool ThreadPool::tryAcquireBackground(Task& task, bool helping) {
+    if (queuedBackground_.load() == 0) {
+        return false;
+    }
+
+    // A waiting background task may run its own kind inline (it already
+    // holds a background slot); foreground waiters never pick them up.
+    if (helping && tlsRunningPriority != TaskPriority::Background) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    auto& background = lanes_[static_cast<int>(TaskPriority::Background)];
+    if (background.empty() || (!helping && !canStartBackground())) {
+        return false;
+    }
+
+    task = std::move(background.front());
+    background.pop_front();
+    --queuedBackground_;
+    --queuedTasks_;
+    ++runningBackground_;
+    return true;
+}
+
+bool ThreadPool::canStartBackground() const {
+    if (stopped_) {
+        return true;  // Drain everything on shutdown
+    }
+    int limit = std::max(1, workerCount_.load() - config_.reservedForegroundThreads);
+    return runningBackground_.load() < limit;
+}
+
+bool ThreadPool::hasRunnableWork() const {
+    int background = queuedBackground_.load();
+    return queuedTasks_.load() > background ||
+           (background > 0 && canStartBackground());
+}
+
+bool ThreadPool::trySteal(size_t thiefIndex, Task& task) {
+    // Retired slots may still hold tasks briefly while being handed off
+    size_t count = static_cast<size_t>(slotHighWater_.load());
+    for (size_t offset = 1; offset < count; ++offset) {
+        WorkerSlot& victim = *slots_[(thiefIndex + offset) % count];
+
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queuedTasks_;
+        metrics_.tasksStolen++;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::runTask(Task& task) {
+    metrics_.currentQueueSize = queuedTasks_.load();
+    metrics_.activeThreads++;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (task.options.isExpired(startTime)) {
+        // Dropping the closure breaks the submitter's promise
+        task.fn = nullptr;
+        metrics_.tasksExpired++;
+    } else {
+        TaskPriority outerPriority = tlsRunningPriority;
+        tlsRunningPriority = task.options.priority;
+
+        try {
+            task.fn();
+            metrics_.tasksCompleted++;
+        } catch (...) {
+            metrics_.tasksFailed++;
         }
 
-        if (config_.maxQueueSize > 0 &&
-            static_cast<int>(tasks_.size()) >= config_.maxQueueSize) {
-            throw std::runtime_error("Thread pool queue is full");
+        tlsRunningPriority = outerPriority;
+
+        auto endTime = std::chrono::steady_clock::now();
+        auto runMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+            endTime - startTime).count();
+        metrics_.totalProcessingTimeMs += runMicros / 1000;
+
+        if (config_.enableMetrics) {
+            auto waitMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                startTime - task.enqueuedAt).count();
+            metrics_.queueWaitMicros.record(static_cast<uint64_t>(std::max<int64_t>(0, waitMicros)));
+            metrics_.runTimeMicros.record(static_cast<uint64_t>(runMicros));
         }
+    }
+
+    metrics_.activeThreads--;
 
-        tasks_.emplace(std::move(task));
-        ++pendingTasks_;
-        metrics_.tasksSubmitted++;
-        metrics_.currentQueueSize = static_cast<int>(tasks_.size());
+    if (task.options.priority == TaskPriority::Background) {
+        --runningBackground_;
+        if (queuedBackground_.load() > 0) {
+            wakeWorker();  // A capped background task may start now
+        }
     }
 
-    condition_.notify_one();
+    if (--pendingTasks_ == 0) {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        completionCondition_.notify_all();
+    }
+}
+
+void ThreadPool::wakeWorker() {
+    // queuedTasks_ is published before idleWorkers_ is read, and a worker
+    // registers as idle before re-checking queuedTasks_, so skipping the
+    // lock when nobody is asleep cannot lose a wakeup.
+    if (idleWorkers_.load() > 0) {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        condition_.notify_one();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> fn, const TaskOptions& options,
+                         bool allowLocal, const char* stoppedMessage) {
+    if (stopped_) {
+        throw std::runtime_error(stoppedMessage);
+    }
+
+    // Count the task before it becomes visible: a worker may take, run and
+    // uncount it as soon as it is pushed. One increment both reserves the
+    // queue slot and checks the limit, so concurrent submitters cannot
+    // overshoot maxQueueSize.
+    int queued = ++queuedTasks_;
+    if (config_.maxQueueSize > 0 && queued > config_.maxQueueSize) {
+        --queuedTasks_;
+        throw std::runtime_error("Thread pool queue is full");
+    }
+    ++pendingTasks_;
+
+    Task task{std::move(fn), std::chrono::steady_clock::now(), options};
+    bool background = options.priority == TaskPriority::Background;
+
+    int worker = (allowLocal && !background && config_.enableWorkStealing)
+        ? currentWorkerIndex() : -1;
+    if (worker >= 0 && !slots_[worker]->retire.load()) {
+        WorkerSlot& own = *slots_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (stopped_) {
+            --queuedTasks_;
+            if (--pendingTasks_ == 0) {
+                std::lock_guard<std::mutex> completionLock(completionMutex_);
+                completionCondition_.notify_all();
+            }
+            throw std::runtime_error(stoppedMessage);
+        }
+        lanes_[static_cast<int>(options.priority)].push_back(std::move(task));
+        if (background) {
+            ++queuedBackground_;
+        }
+    }
+
+    metrics_.currentQueueSize = queuedTasks_.load();
+    metrics_.tasksSubmitted++;
+
+    wakeWorker();
+
+    if (config_.enableAutoScaling) {
+        maybeScaleUp();
+    }
+}
+
+void ThreadPool::execute(std::function<void()> task) {
+    enqueue(std::move(task), TaskOptions{}, true, "Cannot execute on stopped thread pool");
+}
+
+void ThreadPool::execute(const TaskOptions& options, std::function<void()> task) {
+    enqueue(std::move(task), options, true, "Cannot execute on stopped thread pool");
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    enqueue(std::move(task), TaskOptions{}, false, "Cannot execute on stopped thread pool");
+}
+
+void ThreadPool::post(const TaskOptions& options, std::function<void()> task) {
+    enqueue(std::move(task), options, false, "Cannot execute on stopped thread pool");
+}
+
+TaskPriority ThreadPool::currentTaskPriority() {
+    return tlsRunningPriority;
+}
+
+bool ThreadPool::tryRunPendingTask() {
+    int index = currentWorkerIndex();
+    if (index < 0) {
+        return false;
+    }
+
+    Task task;
+    if (!tryAcquireTask(static_cast<size_t>(index), task, true)) {
+        return false;
+    }
+
+    runTask(task);
+    return true;
 }
 
 void ThreadPool::waitAll() {
-    std::unique_lock<std::mutex> lock(queueMutex_);
+    std::unique_lock<std::mutex> lock(completionMutex_);
     completionCondition_.wait(lock, [this] {
         return pendingTasks_.load() == 0;
     });
@@ -103,6 +513,10 @@ void ThreadPool::waitAll() {
 
 void ThreadPool::shutdown(bool waitForTasks) {
     {
+        // Holding resizeMutex_ while setting stopped_ guarantees no worker
+        // is spawned afterwards; it is released before joining because an
+        // idle worker may be waiting on it to retire itself.
+        std::lock_guard<std::mutex> resizeLock(resizeMutex_);
         std::unique_lock<std::mutex> lock(queueMutex_);
 
         if (stopped_) {
@@ -111,24 +525,43 @@ void ThreadPool::shutdown(bool waitForTasks) {
 
         if (!waitForTasks) {
             // Clear pending tasks
-            while (!tasks_.empty()) {
-                tasks_.pop();
+            int dropped = 0;
+            for (auto& lane : lanes_) {
+                dropped += static_cast<int>(lane.size());
+                lane.clear();
             }
-            pendingTasks_ = 0;
+            queuedBackground_ = 0;
+
+            for (auto& slot : slots_) {
+                std::lock_guard<std::mutex> slotLock(slot->mutex);
+                dropped += static_cast<int>(slot->tasks.size());
+                slot->tasks.clear();
+            }
+
+            queuedTasks_ -= dropped;
+            pendingTasks_ -= dropped;
         }
 
         stopped_ = true;
     }
 
-    condition_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        condition_.notify_all();
+    }
 
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+    for (auto& slot : slots_) {
+        if (slot->thread.joinable()) {
+            slot->thread.join();
         }
     }
 
-    workers_.clear();
+    workerCount_ = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        completionCondition_.notify_all();
+    }
 }
 
 int ThreadPool::getPendingTaskCount() const {
@@ -136,23 +569,23 @@ int ThreadPool::getPendingTaskCount() const {
 }
 
 void ThreadPool::resize(int newThreadCount) {
-    newThreadCount = std::max(1, newThreadCount);
+    newThreadCount = std::max(1, std::min(newThreadCount, ThreadPoolConfig::kMaxThreads));
 
-    if (newThreadCount == static_cast<int>(workers_.size())) {
-        return;
-    }
+    std::lock_guard<std::mutex> lock(resizeMutex_);
 
-    // Shutdown existing pool
-    shutdown(true);
+    config_.threadCount = newThreadCount;
+    if (config_.minThreads > newThreadCount) {
+        config_.minThreads = newThreadCount;
+    }
+    if (config_.maxThreads > 0 && config_.maxThreads < newThreadCount) {
+        config_.maxThreads = newThreadCount;
+    }
 
-    // Reset state
-    stopped_ = false;
-    pendingTasks_ = 0;
-    metrics_.reset();
+    if (stopped_) {
+        return;
+    }
 
-    // Create new workers
-    config_.threadCount = newThreadCount;
-    createWorkers(newThreadCount);
+    adjustWorkerCount(newThreadCount);
 }
 
 } // namespace Services
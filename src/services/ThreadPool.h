@@ -1,8 +1,9 @@
 #ifndef THREAD_POOL_H
 #define THREAD_POOL_H
 
+#include <algorithm>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -10,7 +11,10 @@
 #include <future>
 #include <memory>
 #include <atomic>
+#include <chrono>
 #include <stdexcept>
+#include <type_traits>
+#include "LatencyHistogram.h"
 
 namespace FranchiseAI {
 namespace Services {
@@ -19,9 +23,37 @@ namespace Services {
  * @brief Thread pool configuration with memory recommendations
  */
 struct ThreadPoolConfig {
+    static constexpr int kMaxThreads = 64;  // Hard cap on live workers per pool
+
     int threadCount = 4;                  // Number of worker threads
     int maxQueueSize = 1000;              // Maximum pending tasks
     bool enableMetrics = true;            // Track performance metrics
+    bool enableWorkStealing = true;       // Per-worker deques with stealing (false = single FIFO queue)
+
+    // Live sizing: workers are added/retired one at a time, never torn down
+    int minThreads = 1;                   // Lower bound for shrinking
+    int maxThreads = 0;                   // Upper bound for growing (0 = threadCount)
+    bool enableAutoScaling = false;       // Grow on queue depth, retire idle extras
+    int scaleUpQueueDepth = 2;            // Queued tasks per worker before adding one
+    int idleRetireMs = 30000;             // Idle time before a worker above minThreads retires
+
+    // Priority lanes: background tasks never occupy the last N workers
+    int reservedForegroundThreads = 1;
+
+    /**
+     * @brief Effective lower bound on live workers
+     */
+    int getMinThreads() const {
+        return std::max(1, std::min(minThreads, kMaxThreads));
+    }
+
+    /**
+     * @brief Effective upper bound on live workers
+     */
+    int getMaxThreads() const {
+        int upper = maxThreads > 0 ? maxThreads : threadCount;
+        return std::min(kMaxThreads, std::max(getMinThreads(), upper));
+    }
 
     /**
      * @brief Get recommended memory in MB for the thread pool
@@ -104,6 +136,46 @@ struct ThreadPoolConfig {
     }
 };
 
+/**
+ * @brief Scheduling class of a task
+ *
+ * Interactive is work a user is waiting on (the current search);
+ * Background is speculative or bulk work such as cache prewarming and
+ * batch geocoding.
+ */
+enum class TaskPriority {
+    Interactive = 0,
+    Normal = 1,
+    Background = 2
+};
+
+/**
+ * @brief Per-task scheduling options
+ */
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::Normal;
+    std::chrono::steady_clock::time_point deadline{};  // Epoch = no deadline
+
+    static TaskOptions interactive() { return TaskOptions{TaskPriority::Interactive, {}}; }
+    static TaskOptions background() { return TaskOptions{TaskPriority::Background, {}}; }
+
+    /**
+     * @brief Drop the task if it has not started within the timeout
+     */
+    TaskOptions& withTimeout(std::chrono::milliseconds timeout) {
+        deadline = std::chrono::steady_clock::now() + timeout;
+        return *this;
+    }
+
+    bool hasDeadline() const {
+        return deadline != std::chrono::steady_clock::time_point{};
+    }
+
+    bool isExpired(std::chrono::steady_clock::time_point now) const {
+        return hasDeadline() && now > deadline;
+    }
+};
+
 /**
  * @brief Thread pool performance metrics
  */
@@ -112,20 +184,51 @@ struct ThreadPoolMetrics {
     std::atomic<uint64_t> tasksCompleted{0};
     std::atomic<uint64_t> tasksFailed{0};
     std::atomic<uint64_t> totalProcessingTimeMs{0};
+    std::atomic<uint64_t> tasksStolen{0};        // Tasks taken from another worker's deque
+    std::atomic<uint64_t> localTasksExecuted{0};  // Tasks popped from the worker's own deque
+    std::atomic<uint64_t> workersAdded{0};        // Workers spawned by resize/auto-scaling
+    std::atomic<uint64_t> workersRetired{0};      // Workers retired by resize/auto-scaling
+    std::atomic<uint64_t> tasksExpired{0};        // Dropped unrun because their deadline passed
     std::atomic<int> currentQueueSize{0};
     std::atomic<int> activeThreads{0};
 
+    // Microsecond latency distributions
+    LatencyHistogram queueWaitMicros;  // Submit -> start of execution
+    LatencyHistogram runTimeMicros;    // Start -> end of execution
+
+    // Start of the measurement window for wall-clock throughput
+    std::atomic<int64_t> windowStartUs{nowMicros()};
+
+    static int64_t nowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
     double getAverageProcessingTimeMs() const {
+        if (runTimeMicros.getCount() > 0) {
+            return runTimeMicros.getMeanMicros() / 1000.0;
+        }
         uint64_t completed = tasksCompleted.load();
         if (completed == 0) return 0.0;
         return static_cast<double>(totalProcessingTimeMs.load()) / completed;
     }
 
+    /**
+     * @brief Completed tasks per wall-clock second since the last reset
+     */
     double getThroughputPerSecond() const {
-        uint64_t completed = tasksCompleted.load();
-        uint64_t totalTimeMs = totalProcessingTimeMs.load();
-        if (totalTimeMs == 0) return 0.0;
-        return (completed * 1000.0) / totalTimeMs;
+        int64_t elapsedUs = nowMicros() - windowStartUs.load();
+        if (elapsedUs <= 0) return 0.0;
+        return tasksCompleted.load() * 1000000.0 / elapsedUs;
+    }
+
+    /**
+     * @brief Percentage of executed tasks that were stolen from another worker
+     */
+    double getStealRate() const {
+        uint64_t executed = tasksCompleted.load() + tasksFailed.load();
+        if (executed == 0) return 0.0;
+        return static_cast<double>(tasksStolen.load()) / executed * 100.0;
     }
 
     void reset() {
@@ -133,7 +236,15 @@ struct ThreadPoolMetrics {
         tasksCompleted = 0;
         tasksFailed = 0;
         totalProcessingTimeMs = 0;
+        tasksStolen = 0;
+        localTasksExecuted = 0;
+        workersAdded = 0;
+        workersRetired = 0;
+        tasksExpired = 0;
         currentQueueSize = 0;
+        queueWaitMicros.reset();
+        runTimeMicros.reset();
+        windowStartUs = nowMicros();
     }
 };
 
@@ -143,6 +254,21 @@ struct ThreadPoolMetrics {
  * Provides a configurable pool of worker threads for executing
  * asynchronous tasks. Designed for I/O-bound operations like
  * geocoding API calls.
+ *
+ * In work-stealing mode each worker owns a deque. Tasks submitted from
+ * a worker thread (nested fan-out) go to that worker's deque and are
+ * popped LIFO by the owner; tasks submitted from outside the pool go to
+ * a shared injection queue. An idle worker drains the injection queue
+ * and then steals the oldest task from another worker's deque, so the
+ * shared lock is only touched by external submissions.
+ *
+ * The injection queue is split into interactive, normal and background
+ * lanes. Workers take interactive work first and background work last,
+ * and background tasks may never occupy the last
+ * reservedForegroundThreads workers, so a large batch cannot delay a
+ * search the user is waiting on. Tasks whose deadline has passed by the
+ * time a worker picks them up are dropped without running; the future
+ * returned by submit() then reports std::future_errc::broken_promise.
  */
 class ThreadPool {
 public:
@@ -163,6 +289,22 @@ public:
      */
     ~ThreadPool();
 
+    /**
+     * @brief Process-wide I/O pool shared by all services and sessions
+     *
+     * Services should not own threads; they wrap this pool in a
+     * QuotaExecutor that caps their share of it. Created on first use,
+     * auto-scaling between 2 and twice the optimal thread count.
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Override the shared pool configuration
+     * @param config Configuration to use when the shared pool is created
+     * @return false if the shared pool already exists (config ignored)
+     */
+    static bool configureShared(const ThreadPoolConfig& config);
+
     // Non-copyable, non-movable
     ThreadPool(const ThreadPool&) = delete;
     ThreadPool& operator=(const ThreadPool&) = delete;
@@ -174,21 +316,83 @@ public:
      * @param task Function to execute
      * @return Future for the task result
      */
-    template<typename F, typename... Args>
+    template<typename F, typename... Args,
+             typename = std::enable_if_t<!std::is_same<std::decay_t<F>, TaskOptions>::value>>
     auto submit(F&& f, Args&&... args)
         -> std::future<typename std::invoke_result<F, Args...>::type>;
 
+    /**
+     * @brief Submit a task with a priority and/or deadline
+     * @param options Scheduling options
+     * @param f Function to execute
+     * @return Future for the task result (broken_promise if it expired)
+     */
+    template<typename F, typename... Args>
+    auto submit(const TaskOptions& options, F&& f, Args&&... args)
+        -> std::future<typename std::invoke_result<F, Args...>::type>;
+
     /**
      * @brief Submit a task without waiting for result
      * @param task Function to execute
      */
     void execute(std::function<void()> task);
 
+    /**
+     * @brief Submit a task with scheduling options without waiting for result
+     */
+    void execute(const TaskOptions& options, std::function<void()> task);
+
+    /**
+     * @brief Submit a task to the shared injection queue
+     *
+     * Unlike execute(), a call from a worker thread does not push onto
+     * that worker's own deque, so the task queues behind work already
+     * submitted by other producers. Used to keep independent clients of
+     * a shared pool interleaved fairly.
+     * @param task Function to execute
+     */
+    void post(std::function<void()> task);
+    void post(const TaskOptions& options, std::function<void()> task);
+
+    /**
+     * @brief Priority of the task running on the calling thread
+     * @return Normal when not called from inside a pool task
+     */
+    static TaskPriority currentTaskPriority();
+
     /**
      * @brief Wait for all pending tasks to complete
+     *
+     * Must not be called from a worker thread (it would wait on itself);
+     * use waitHelp() on the child futures instead.
      */
     void waitAll();
 
+    /**
+     * @brief Wait for a future, running queued tasks while it is not ready
+     *
+     * Fork/join helper for nested fan-out. When called from one of this
+     * pool's workers, the worker executes pending tasks (its own children
+     * first) instead of sleeping, so a task that submits sub-tasks and
+     * waits on them cannot starve the pool. From any other thread this
+     * is a plain wait.
+     * @param future Future of a task submitted to this pool
+     */
+    template<typename T>
+    void waitHelp(const std::future<T>& future);
+
+    /**
+     * @brief Check if the calling thread is one of this pool's workers
+     */
+    bool isWorkerThread() const { return currentWorkerIndex() >= 0; }
+
+    /**
+     * @brief Run one queued task on the calling worker thread
+     * @return true if a task was run, false if none was available or the
+     *         caller is not a worker of this pool
+     */
+    bool tryRunPendingTask();
+
     /**
      * @brief Stop the thread pool gracefully
      * @param waitForTasks If true, wait for pending tasks to complete
@@ -206,9 +410,14 @@ public:
     int getPendingTaskCount() const;
 
     /**
-     * @brief Get number of worker threads
+     * @brief Check if work-stealing scheduling is enabled
      */
-    int getThreadCount() const { return static_cast<int>(workers_.size()); }
+    bool isWorkStealingEnabled() const { return config_.enableWorkStealing; }
+
+    /**
+     * @brief Get number of live (non-retiring) worker threads
+     */
+    int getThreadCount() const { return workerCount_.load(); }
 
     /**
      * @brief Get thread pool metrics
@@ -221,33 +430,101 @@ public:
     void resetMetrics() { metrics_.reset(); }
 
     /**
-     * @brief Resize the thread pool
+     * @brief Resize the thread pool without stopping it
+     *
+     * Workers are spawned or retired one at a time. A retiring worker
+     * finishes its current task and hands its queued tasks back to the
+     * injection queue, so in-flight work keeps draining and metrics are
+     * preserved. The new count becomes the baseline and widens the
+     * min/max bounds if it falls outside them.
      * @param newThreadCount New number of threads
      */
     void resize(int newThreadCount);
 
 private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
+    /**
+     * @brief Queued unit of work
+     */
+    struct Task {
+        std::function<void()> fn;
+        std::chrono::steady_clock::time_point enqueuedAt;
+        TaskOptions options;
+    };
+
+    static constexpr int kPriorityCount = 3;
 
+    /**
+     * @brief Worker thread and its task deque (owner uses the back, thieves the front)
+     *
+     * Slots are allocated once and reused, so stealing can scan them
+     * without locking the worker list while the pool is resized.
+     */
+    struct WorkerSlot {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+        std::atomic<bool> active{false};   // A worker owns this slot
+        std::atomic<bool> retire{false};   // Worker exits after its current task
+    };
+
+    std::vector<std::unique_ptr<WorkerSlot>> slots_;
+    std::atomic<int> slotHighWater_{0};    // Slots [0, high water) have been used
+    std::atomic<int> workerCount_{0};      // Live workers not asked to retire
+    std::mutex resizeMutex_;               // Serialises spawning/retiring
+
+    // Injection queue for tasks submitted from outside the pool, one lane
+    // per TaskPriority. Background tasks always use their lane.
+    std::deque<Task> lanes_[kPriorityCount];
     mutable std::mutex queueMutex_;
+    std::atomic<int> queuedBackground_{0};
+    std::atomic<int> runningBackground_{0};
+
+    // Idle workers sleep here; producers only lock when someone is asleep
+    std::mutex idleMutex_;
     std::condition_variable condition_;
+    std::atomic<int> idleWorkers_{0};
+
+    std::mutex completionMutex_;
     std::condition_variable completionCondition_;
 
     std::atomic<bool> stopped_{false};
     std::atomic<int> pendingTasks_{0};
+    std::atomic<int> queuedTasks_{0};
 
     ThreadPoolConfig config_;
     ThreadPoolMetrics metrics_;
 
-    void workerThread();
+    void workerThread(size_t index);
     void createWorkers(int count);
+    bool spawnWorker();
+    bool retireWorker();
+    void adjustWorkerCount(int target);
+    void maybeScaleUp();
+    bool tryRetireIdleWorker(size_t index);
+    void handOffLocalTasks(size_t index);
+    void enqueue(std::function<void()> fn, const TaskOptions& options,
+                 bool allowLocal, const char* stoppedMessage);
+    bool tryAcquireTask(size_t index, Task& task, bool helping);
+    bool tryAcquireBackground(Task& task, bool helping);
+    bool canStartBackground() const;
+    bool hasRunnableWork() const;
+    bool trySteal(size_t thiefIndex, Task& task);
+    void runTask(Task& task);
+    void wakeWorker();
+    int currentWorkerIndex() const;
 };
 
 // Template implementation
-template<typename F, typename... Args>
+template<typename F, typename... Args, typename>
 auto ThreadPool::submit(F&& f, Args&&... args)
     -> std::future<typename std::invoke_result<F, Args...>::type>
+{
+    return submit(TaskOptions{}, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<typename F, typename... Args>
+auto ThreadPool::submit(const TaskOptions& options, F&& f, Args&&... args)
+    -> std::future<typename std::invoke_result<F, Args...>::type>
 {
     using return_type = typename std::invoke_result<F, Args...>::type;
 
@@ -257,29 +534,26 @@ auto ThreadPool::submit(F&& f, Args&&... args)
 
     std::future<return_type> result = task->get_future();
 
-    {
-        std::unique_lock<std::mutex> lock(queueMutex_);
-
-        if (stopped_) {
-            throw std::runtime_error("Cannot submit to stopped thread pool");
-        }
-
-        if (config_.maxQueueSize > 0 &&
-            static_cast<int>(tasks_.size()) >= config_.maxQueueSize) {
-            throw std::runtime_error("Thread pool queue is full");
-        }
+    enqueue([task]() {
+        (*task)();
+    }, options, true, "Cannot submit to stopped thread pool");
 
-        tasks_.emplace([task, this]() {
-            (*task)();
-        });
+    return result;
+}
 
-        ++pendingTasks_;
-        metrics_.tasksSubmitted++;
-        metrics_.currentQueueSize = static_cast<int>(tasks_.size());
+template<typename T>
+void ThreadPool::waitHelp(const std::future<T>& future) {
+    if (currentWorkerIndex() < 0) {
+        future.wait();
+        return;
     }
 
-    condition_.notify_one();
-    return result;
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!tryRunPendingTask()) {
+            // Child is running elsewhere; nothing to help with right now
+            future.wait_for(std::chrono::milliseconds(1));
+        }
+    }
 }
 
 } // namespace Services
@@ -1,4 +1,5 @@
 #include "AuditTrailPage.h"
+#include "../services/JsonReader.h"
 #include <Wt/WApplication.h>
 #include <Wt/WBreak.h>
 #include <Wt/WLabel.h>
@@ -308,71 +309,29 @@ void AuditTrailPage::onPageChange(int page) {
 std::vector<AuditLogEntry> AuditTrailPage::parseAuditLogs(const std::string& jsonResponse) {
     std::vector<AuditLogEntry> entries;
 
-    // Simple JSON parsing - look for audit log entries in the response
     // Format: {"data":[{"id":"...", "attributes":{...}}, ...]}
+    Services::JsonValue root = Services::JsonValue::parse(jsonResponse);
 
-    size_t pos = 0;
-    while ((pos = jsonResponse.find("\"id\":", pos)) != std::string::npos) {
+    root["data"].forEachElement([&entries](const Services::JsonValue& record) {
         AuditLogEntry entry;
-
-        // Extract ID
-        size_t idStart = jsonResponse.find("\"", pos + 5) + 1;
-        size_t idEnd = jsonResponse.find("\"", idStart);
-        if (idStart != std::string::npos && idEnd != std::string::npos) {
-            entry.id = jsonResponse.substr(idStart, idEnd - idStart);
+        entry.id = record["id"].asString();
+        if (entry.id.empty()) {
+            return;
         }
 
-        // Helper lambda to extract field
-        auto extractField = [&jsonResponse, pos](const std::string& fieldName) -> std::string {
-            std::string searchKey = "\"" + fieldName + "\":";
-            size_t fieldPos = jsonResponse.find(searchKey, pos);
-            if (fieldPos == std::string::npos || fieldPos > pos + 2000) return "";
-
-            size_t valueStart = fieldPos + searchKey.length();
-            while (valueStart < jsonResponse.length() &&
-                   (jsonResponse[valueStart] == ' ' || jsonResponse[valueStart] == '"')) {
-                valueStart++;
-            }
-
-            // Check if it's a quoted string
-            if (jsonResponse[valueStart - 1] == '"') {
-                size_t valueEnd = jsonResponse.find("\"", valueStart);
-                if (valueEnd != std::string::npos) {
-                    return jsonResponse.substr(valueStart, valueEnd - valueStart);
-                }
-            } else {
-                // Non-quoted value (null, number, boolean)
-                size_t valueEnd = jsonResponse.find_first_of(",}]", valueStart);
-                if (valueEnd != std::string::npos) {
-                    std::string val = jsonResponse.substr(valueStart, valueEnd - valueStart);
-                    if (val == "null") return "";
-                    return val;
-                }
-            }
-            return "";
-        };
-
-        entry.userId = extractField("user_id");
-        entry.eventType = extractField("event_type");
-        entry.ipAddress = extractField("ip_address");
-        entry.userAgent = extractField("user_agent");
-        entry.createdAt = extractField("created_at");
-
-        // Parse event_details if present (it's a JSON object)
-        size_t detailsPos = jsonResponse.find("\"event_details\":", pos);
-        if (detailsPos != std::string::npos && detailsPos < pos + 2000) {
-            size_t detailsStart = jsonResponse.find("{", detailsPos);
-            if (detailsStart != std::string::npos) {
-                // Find matching closing brace
-                int braceCount = 1;
-                size_t detailsEnd = detailsStart + 1;
-                while (braceCount > 0 && detailsEnd < jsonResponse.length()) {
-                    if (jsonResponse[detailsEnd] == '{') braceCount++;
-                    else if (jsonResponse[detailsEnd] == '}') braceCount--;
-                    detailsEnd++;
-                }
-                entry.eventDetails = jsonResponse.substr(detailsStart, detailsEnd - detailsStart);
-            }
+        Services::JsonObject attributes(record["attributes"]);
+        entry.userId = attributes["user_id"].asString();
+        entry.eventType = attributes["event_type"].asString();
+        entry.ipAddress = attributes["ip_address"].asString();
+        entry.userAgent = attributes["user_agent"].asString();
+        entry.createdAt = attributes["created_at"].asString();
+
+        // event_details is a JSON object; keep its source text for display
+        Services::JsonValue details = attributes["event_details"];
+        if (details.isObject()) {
+            entry.eventDetails = std::string(details.raw());
+        } else {
+            entry.eventDetails = details.asString();
         }
 
         // Look up user info (in a real app, this would be joined in the query)
@@ -382,12 +341,8 @@ std::vector<AuditLogEntry> AuditTrailPage::parseAuditLogs(const std::string& jso
             entry.userEmail = entry.userId.substr(0, 8) + "...";
         }
 
-        if (!entry.id.empty()) {
-            entries.push_back(entry);
-        }
-
-        pos = idEnd + 1;
-    }
+        entries.push_back(std::move(entry));
+    });
 
     // Sort by created_at descending (most recent first)
     std::sort(entries.begin(), entries.end(), [](const AuditLogEntry& a, const AuditLogEntry& b) {
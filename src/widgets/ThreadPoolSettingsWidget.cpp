@@ -151,6 +151,19 @@ void ThreadPoolSettingsWidget::setupUI() {
     timeLayout->addWidget(std::make_unique<Wt::WText>("Throughput: "));
     throughputText_ = timeLayout->addWidget(std::make_unique<Wt::WText>("0/sec"));
 
+    // Latency percentiles
+    auto waitRow = metricsLayout->addWidget(std::make_unique<Wt::WContainerWidget>());
+    auto waitLayout = waitRow->setLayout(std::make_unique<Wt::WHBoxLayout>());
+    waitLayout->addWidget(std::make_unique<Wt::WText>("Queue Wait (p50 / p90 / p99 / max): "));
+    queueWaitPercentilesText_ = waitLayout->addWidget(std::make_unique<Wt::WText>("-"));
+    waitLayout->addStretch(1);
+
+    auto runRow = metricsLayout->addWidget(std::make_unique<Wt::WContainerWidget>());
+    auto runLayout = runRow->setLayout(std::make_unique<Wt::WHBoxLayout>());
+    runLayout->addWidget(std::make_unique<Wt::WText>("Run Time (p50 / p90 / p99 / max): "));
+    runTimePercentilesText_ = runLayout->addWidget(std::make_unique<Wt::WText>("-"));
+    runLayout->addStretch(1);
+
     // Queue utilization
     auto queueRow = metricsLayout->addWidget(std::make_unique<Wt::WContainerWidget>());
     auto queueLayout = queueRow->setLayout(std::make_unique<Wt::WHBoxLayout>());
@@ -279,11 +292,37 @@ void ThreadPoolSettingsWidget::updateMetrics(const Services::ThreadPoolMetrics&
     throughput << std::fixed << std::setprecision(1) << metrics.getThroughputPerSecond() << "/sec";
     throughputText_->setText(throughput.str());
 
+    queueWaitPercentilesText_->setText(formatPercentiles(metrics.queueWaitMicros));
+    runTimePercentilesText_->setText(formatPercentiles(metrics.runTimeMicros));
+
     // Queue utilization (assuming max 100 queue size)
     int queuePercent = std::min(100, metrics.currentQueueSize.load());
     queueUtilizationBar_->setValue(queuePercent);
 }
 
+std::string ThreadPoolSettingsWidget::formatMicros(uint64_t micros) {
+    std::ostringstream out;
+    if (micros < 1000) {
+        out << micros << " us";
+    } else if (micros < 1000000) {
+        out << std::fixed << std::setprecision(1) << micros / 1000.0 << " ms";
+    } else {
+        out << std::fixed << std::setprecision(2) << micros / 1000000.0 << " s";
+    }
+    return out.str();
+}
+
+std::string ThreadPoolSettingsWidget::formatPercentiles(const Services::LatencyHistogram& histogram) {
+    if (histogram.getCount() == 0) {
+        return "-";
+    }
+
+    return formatMicros(histogram.getPercentileMicros(50.0)) + " / " +
+           formatMicros(histogram.getPercentileMicros(90.0)) + " / " +
+           formatMicros(histogram.getPercentileMicros(99.0)) + " / " +
+           formatMicros(histogram.getMaxMicros());
+}
+
 void ThreadPoolSettingsWidget::setEnabled(bool enabled) {
     threadSlider_->setEnabled(enabled);
 }
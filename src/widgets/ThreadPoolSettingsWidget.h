@@ -72,6 +72,9 @@ private:
     void updateRecommendations();
     void onSliderChanged();
 
+    static std::string formatMicros(uint64_t micros);
+    static std::string formatPercentiles(const Services::LatencyHistogram& histogram);
+
     int minThreads_ = 1;
     int maxThreads_ = 16;
     int currentThreads_ = 4;
@@ -91,6 +94,8 @@ private:
     Wt::WText* tasksFailedText_ = nullptr;
     Wt::WText* avgProcessingTimeText_ = nullptr;
     Wt::WText* throughputText_ = nullptr;
+    Wt::WText* queueWaitPercentilesText_ = nullptr;
+    Wt::WText* runTimePercentilesText_ = nullptr;
     Wt::WProgressBar* queueUtilizationBar_ = nullptr;
 
     // Memory gauge
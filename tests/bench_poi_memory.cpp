@@ -0,0 +1,214 @@
+// ============================================================================
+// OSMPoi Memory Benchmark
+// Measures the heap cost of a cached POI with the compact tag layout
+// (OSMTagList + OSMStringInterner) against the previous layout of a tag
+// map plus a copy of the common tags in std::string fields
+// ============================================================================
+
+#include <malloc.h>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/services/OpenStreetMapAPI.h"
+
+using namespace FranchiseAI::Services;
+
+static const int kElementCount = 5000;
+
+// ============================================================================
+// Heap accounting: every allocation is counted at its usable size. Kept out
+// of line so the compiler does not pair the inlined free() with new.
+// ============================================================================
+static std::atomic<size_t> gHeapBytes{0};
+static std::atomic<size_t> gAllocations{0};
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    gHeapBytes += malloc_usable_size(p);
+    gAllocations++;
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    gHeapBytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+struct HeapSnapshot {
+    size_t bytes = gHeapBytes.load();
+    size_t allocations = gAllocations.load();
+};
+
+// ============================================================================
+// Synthetic Overpass response: typical business POIs with 8-12 tags
+// ============================================================================
+static std::string buildOverpassResponse(int elementCount) {
+    static const char* amenities[] = {"restaurant", "cafe", "hospital", "school", "fast_food"};
+    static const char* offices[] = {"company", "government", "insurance", "it", "lawyer"};
+    static const char* cities[] = {"Cleveland", "Lakewood", "Parma", "Euclid"};
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(7);
+    json << "{\"version\": 0.6, \"elements\": [\n";
+
+    for (int i = 0; i < elementCount; ++i) {
+        double lat = 41.40 + (i % 100) * 0.001;
+        double lon = -81.80 + (i / 100) * 0.001;
+
+        json << (i ? ",\n" : "") << "{\"type\": \"node\", \"id\": " << (1000000000LL + i)
+             << ", \"lat\": " << lat << ", \"lon\": " << lon << ", \"tags\": {"
+             << "\"name\": \"Business " << i << " Holdings\", "
+             << "\"amenity\": \"" << amenities[i % 5] << "\", "
+             << "\"office\": \"" << offices[i % 5] << "\", "
+             << "\"addr:housenumber\": \"" << (100 + i % 900) << "\", "
+             << "\"addr:street\": \"Main Street\", "
+             << "\"addr:city\": \"" << cities[i % 4] << "\", "
+             << "\"addr:postcode\": \"441" << (10 + i % 40) << "\", "
+             << "\"addr:state\": \"OH\"";
+        if (i % 2 == 0) {
+            json << ", \"phone\": \"+1 216 555 " << (1000 + i % 9000) << "\""
+                 << ", \"website\": \"https://business-" << i << ".example.com/\"";
+        }
+        if (i % 3 == 0) {
+            json << ", \"opening_hours\": \"Mo-Fr 08:00-17:00\"";
+        }
+        json << "}}";
+    }
+
+    json << "\n]}\n";
+    return json.str();
+}
+
+// ============================================================================
+// Previous layout, rebuilt from the parsed POIs
+// ============================================================================
+namespace Legacy {
+
+struct OSMPoi {
+    int64_t osmId = 0;
+    std::string osmType;
+    std::string name;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    std::map<std::string, std::string> tags;
+    std::string amenity, building, office, shop, tourism, healthcare;
+    std::string street, houseNumber, city, postcode, state, country;
+    std::string phone, website, email, openingHours;
+};
+
+static OSMPoi fromCompact(const FranchiseAI::Services::OSMPoi& compact) {
+    OSMPoi poi;
+    poi.osmId = compact.osmId;
+    poi.osmType = compact.osmType;
+    poi.latitude = compact.latitude;
+    poi.longitude = compact.longitude;
+    compact.tags.forEach([&poi](std::string_view key, std::string_view value) {
+        poi.tags.emplace(std::string(key), std::string(value));
+    });
+    poi.name = std::string(compact.name());
+    poi.amenity = std::string(compact.amenity());
+    poi.building = std::string(compact.building());
+    poi.office = std::string(compact.office());
+    poi.shop = std::string(compact.shop());
+    poi.tourism = std::string(compact.tourism());
+    poi.healthcare = std::string(compact.healthcare());
+    poi.street = std::string(compact.street());
+    poi.houseNumber = std::string(compact.houseNumber());
+    poi.city = std::string(compact.city());
+    poi.postcode = std::string(compact.postcode());
+    poi.state = std::string(compact.state());
+    poi.country = std::string(compact.country());
+    poi.phone = std::string(compact.phone());
+    poi.website = std::string(compact.website());
+    poi.email = std::string(compact.email());
+    poi.openingHours = std::string(compact.openingHours());
+    return poi;
+}
+
+} // namespace Legacy
+
+// ============================================================================
+// Cost of one cache entry: copy the POIs as the tile cache stores them
+// ============================================================================
+struct EntryCost {
+    double bytesPerPoi = 0.0;
+    double allocationsPerPoi = 0.0;
+};
+
+template<typename Poi>
+static EntryCost measureCacheEntry(const std::vector<Poi>& pois) {
+    HeapSnapshot before;
+    auto* entry = new std::vector<Poi>(pois);
+    HeapSnapshot after;
+
+    EntryCost cost;
+    cost.bytesPerPoi = static_cast<double>(after.bytes - before.bytes) / pois.size();
+    cost.allocationsPerPoi = static_cast<double>(after.allocations - before.allocations) / pois.size();
+    delete entry;
+    return cost;
+}
+
+int main() {
+    std::cout << "\n=== OSMPoi Memory Benchmark ===" << std::endl;
+
+    std::string json = buildOverpassResponse(kElementCount);
+
+    OSMAPIConfig config;
+    config.maxResultsPerQuery = kElementCount;
+    OpenStreetMapAPI api(config);
+
+    std::vector<OSMPoi> compact = api.parseOverpassResponse(json);
+    std::vector<Legacy::OSMPoi> legacy;
+    legacy.reserve(compact.size());
+    for (const auto& poi : compact) {
+        legacy.push_back(Legacy::fromCompact(poi));
+    }
+
+    EntryCost compactCost = measureCacheEntry(compact);
+    EntryCost legacyCost = measureCacheEntry(legacy);
+
+    const OSMStringInterner& strings = OSMStringInterner::instance();
+
+    std::cout << "  POIs per entry: " << compact.size() << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Compact layout:  " << std::setw(7) << compactCost.bytesPerPoi << " bytes/POI, "
+              << compactCost.allocationsPerPoi << " allocations/POI (sizeof "
+              << sizeof(OSMPoi) << ")" << std::endl;
+    std::cout << "  Previous layout: " << std::setw(7) << legacyCost.bytesPerPoi << " bytes/POI, "
+              << legacyCost.allocationsPerPoi << " allocations/POI (sizeof "
+              << sizeof(Legacy::OSMPoi) << ")" << std::endl;
+    std::cout << "  Shared interner: " << strings.size() << " strings, "
+              << strings.memoryBytes() / 1024 << " KB (once per process)" << std::endl;
+    if (compactCost.bytesPerPoi > 0.0) {
+        std::cout << "  Reduction: " << legacyCost.bytesPerPoi / compactCost.bytesPerPoi << "x" << std::endl;
+    }
+
+    // The accessors must return what the tags held
+    bool matches = compact.size() == static_cast<size_t>(kElementCount);
+    for (size_t i = 0; matches && i < compact.size(); ++i) {
+        matches = compact[i].name() == legacy[i].name &&
+                  compact[i].city() == legacy[i].city &&
+                  compact[i].phone() == legacy[i].phone &&
+                  compact[i].tags.size() == legacy[i].tags.size();
+    }
+
+    if (!matches || compactCost.bytesPerPoi >= legacyCost.bytesPerPoi) {
+        std::cout << "  ✗ FAIL: compact POIs are missing tags or not smaller" << std::endl;
+        return 1;
+    }
+
+    std::cout << "  ✓ PASS: compact layout is smaller and complete" << std::endl;
+    return 0;
+}
@@ -0,0 +1,296 @@
+// ============================================================================
+// ApiCache Test Cases
+// Tests for load coalescing, negative TTL, stale-while-revalidate and shutdown
+// ============================================================================
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/services/ApiCache.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+using StringCache = ApiCache<std::string>;
+
+/**
+ * @brief Loader whose loads complete only when the test says so
+ */
+struct DeferredLoader {
+    std::mutex mutex;
+    std::vector<StringCache::Done> pending;
+    std::atomic<int> calls{0};
+
+    StringCache::Loader loader() {
+        return [this](StringCache::Done done) {
+            calls++;
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(done));
+        };
+    }
+
+    void completeAll(const std::string& value, bool ok) {
+        std::vector<StringCache::Done> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.swap(pending);
+        }
+        for (auto& fn : done) {
+            fn(value, ok);
+        }
+    }
+};
+
+// Entry lifetimes are whole seconds; wait until the clock passes t
+static void sleepUntil(time_t t) {
+    while (std::time(nullptr) < t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+static StringCache::Outcome fetchValue(StringCache& cache, const std::string& key,
+                                       const StringCache::Loader& load,
+                                       std::string& value, bool& ok) {
+    return cache.fetch(key, load, [&value, &ok](const std::string& v, bool loadedOk) {
+        value = v;
+        ok = loadedOk;
+    });
+}
+
+// ============================================================================
+// Test Case 1: Concurrent Requests for One Key Share One Fetch
+// ============================================================================
+void test_concurrent_requests_coalesce() {
+    std::cout << "\n=== Test Case 1: Concurrent Requests for One Key Share One Fetch ===" << std::endl;
+
+    StringCache cache(ApiCachePolicy{60, 0, 0});
+    DeferredLoader upstream;
+    auto load = upstream.loader();
+
+    // Every caller arrives while the first load is still running
+    const int callers = 16;
+    std::atomic<int> answered{0};
+    std::atomic<int> correct{0};
+    std::atomic<int> loaded{0};
+    std::atomic<int> coalesced{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < callers; ++i) {
+        threads.emplace_back([&]() {
+            auto outcome = cache.fetch("address", load, [&](const std::string& value, bool ok) {
+                answered++;
+                if (ok && value == "40.0,-105.0") correct++;
+            });
+            if (outcome == ApiCacheOutcome::Loaded) loaded++;
+            if (outcome == ApiCacheOutcome::Coalesced) coalesced++;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TEST_ASSERT(upstream.calls.load() == 1, "Only one upstream fetch for concurrent callers");
+    TEST_ASSERT(loaded.load() == 1 && coalesced.load() == callers - 1,
+                "One caller loads, the others join its flight");
+    TEST_ASSERT(answered.load() == 0, "Nobody is answered before the fetch completes");
+
+    upstream.completeAll("40.0,-105.0", true);
+    TEST_ASSERT(answered.load() == callers && correct.load() == callers,
+                "Every caller gets the one result");
+
+    std::string value;
+    bool ok = false;
+    auto outcome = fetchValue(cache, "address", load, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::Hit && value == "40.0,-105.0", "Next call is a fresh hit");
+    TEST_ASSERT(upstream.calls.load() == 1, "The hit does not fetch again");
+
+    // The blocking form coalesces too
+    std::atomic<int> syncLoads{0};
+    std::atomic<int> syncCorrect{0};
+    std::vector<std::thread> syncThreads;
+    for (int i = 0; i < 8; ++i) {
+        syncThreads.emplace_back([&]() {
+            std::string result;
+            bool found = cache.fetchSync("other", result,
+                [&syncLoads](std::string& loadedValue) {
+                    syncLoads++;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                    loadedValue = "shared";
+                    return true;
+                },
+                [](std::function<void()> task) { task(); });
+            if (found && result == "shared") syncCorrect++;
+        });
+    }
+    for (auto& thread : syncThreads) {
+        thread.join();
+    }
+    TEST_ASSERT(syncLoads.load() == 1, "fetchSync() callers share one load");
+    TEST_ASSERT(syncCorrect.load() == 8, "Every fetchSync() caller gets the result");
+}
+
+// ============================================================================
+// Test Case 2: Negative TTL
+// ============================================================================
+void test_negative_ttl() {
+    std::cout << "\n=== Test Case 2: Negative TTL ===" << std::endl;
+
+    StringCache cache(ApiCachePolicy{60, 0, 2});
+    std::atomic<int> calls{0};
+    StringCache::Loader failing = [&calls](StringCache::Done done) {
+        calls++;
+        done(std::string(), false);
+    };
+
+    std::string value;
+    bool ok = true;
+    time_t failedAt = std::time(nullptr);
+    auto outcome = fetchValue(cache, "nowhere", failing, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::Loaded && !ok, "First call loads and fails");
+
+    outcome = fetchValue(cache, "nowhere", failing, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::NegativeHit && !ok, "Failure is remembered");
+    TEST_ASSERT(calls.load() == 1, "Remembered failure does not call upstream");
+    TEST_ASSERT(cache.getStats().negativeHits.load() == 1, "negativeHits counts it");
+
+    // Once negativeTtlSeconds has passed the key is tried again
+    sleepUntil(failedAt + 3);
+    outcome = fetchValue(cache, "nowhere", failing, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::Loaded, "Failure expires after negativeTtlSeconds");
+    TEST_ASSERT(calls.load() == 2, "Expired failure calls upstream again");
+
+    // Without a negative TTL every call retries
+    StringCache uncached(ApiCachePolicy{60, 0, 0});
+    fetchValue(uncached, "nowhere", failing, value, ok);
+    outcome = fetchValue(uncached, "nowhere", failing, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::Loaded && calls.load() == 4,
+                "negativeTtlSeconds = 0 retries every call");
+}
+
+// ============================================================================
+// Test Case 3: Stale-While-Revalidate
+// ============================================================================
+void test_stale_while_revalidate() {
+    std::cout << "\n=== Test Case 3: Stale-While-Revalidate ===" << std::endl;
+
+    StringCache cache(ApiCachePolicy{1, 60, 5});
+    DeferredLoader upstream;
+    auto load = upstream.loader();
+
+    std::string value;
+    bool ok = false;
+    time_t storedAt = std::time(nullptr);
+    fetchValue(cache, "key", load, value, ok);
+    upstream.completeAll("v1", true);
+
+    sleepUntil(storedAt + 2);
+
+    // The stale value is returned at once and one refresh starts
+    value.clear();
+    auto outcome = fetchValue(cache, "key", load, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::StaleHit && ok && value == "v1",
+                "Expired entry is served stale without waiting");
+    TEST_ASSERT(upstream.calls.load() == 2, "Stale hit starts a refresh");
+
+    outcome = fetchValue(cache, "key", load, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::StaleHit && value == "v1",
+                "Second stale hit during the refresh is still answered at once");
+    TEST_ASSERT(upstream.calls.load() == 2, "Only one refresh runs per key");
+
+    time_t refreshedAt = std::time(nullptr);
+    upstream.completeAll("v2", true);
+    outcome = fetchValue(cache, "key", load, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::Hit && value == "v2", "Refreshed value is served fresh");
+
+    // A failed refresh keeps serving the stale value
+    sleepUntil(refreshedAt + 2);
+    fetchValue(cache, "key", load, value, ok);
+    upstream.completeAll(std::string(), false);
+    int callsAfterFailure = upstream.calls.load();
+    outcome = fetchValue(cache, "key", load, value, ok);
+    TEST_ASSERT(outcome == ApiCacheOutcome::StaleHit && ok && value == "v2",
+                "Failed refresh keeps the stale value");
+    TEST_ASSERT(upstream.calls.load() == callsAfterFailure,
+                "Failed refresh is not retried before negativeTtlSeconds");
+    TEST_ASSERT(cache.getStats().refreshes.load() == 2, "refreshes counts both refreshes");
+}
+
+// ============================================================================
+// Test Case 4: Destructor Waits for In-Flight Fetches
+// ============================================================================
+void test_destructor_waits_for_fetches() {
+    std::cout << "\n=== Test Case 4: Destructor Waits for In-Flight Fetches ===" << std::endl;
+
+    std::atomic<bool> callbackRan{false};
+    std::thread upstream;
+
+    auto* cache = new StringCache(ApiCachePolicy{60, 0, 0});
+    cache->fetch("slow",
+        [&](StringCache::Done done) {
+            // Completes later from another thread, like an HTTP reactor
+            upstream = std::thread([&, done]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                done("late", true);
+            });
+        },
+        [&](const std::string& value, bool ok) {
+            callbackRan = ok && value == "late";
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    delete cache;
+    auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Checked before joining: the callback must have run inside the wait
+    TEST_ASSERT(callbackRan.load(), "In-flight fetch delivered its result before the destructor returned");
+    TEST_ASSERT(waited >= 200, "Destructor blocked until the fetch finished");
+    upstream.join();
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "ApiCache Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_concurrent_requests_coalesce();
+    test_negative_ttl();
+    test_stale_while_revalidate();
+    test_destructor_waits_for_fetches();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
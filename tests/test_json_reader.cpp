@@ -0,0 +1,228 @@
+// ============================================================================
+// JsonReader Test Cases
+// Tests for JsonValue lookups, iteration, escapes, numbers and malformed input
+// ============================================================================
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/services/JsonReader.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// ============================================================================
+// Test Case 1: Types and Member Lookup
+// ============================================================================
+void test_parse_and_lookup() {
+    std::cout << "\n=== Test Case 1: Types and Member Lookup ===" << std::endl;
+
+    const std::string json =
+        " { \"name\" : \"Denver\", \"population\": 715522, \"capital\": true,"
+        "   \"nickname\": null, \"coords\": {\"lat\": 39.7392, \"lon\": -104.9903},"
+        "   \"zips\": [\"80202\", \"80203\"], \"name_ext\": \"not this one\" } ";
+    JsonValue root = JsonValue::parse(json);
+
+    TEST_ASSERT(root.isObject(), "Top-level object is recognized past leading whitespace");
+    TEST_ASSERT(root["name"].isString() && root["name"].asString() == "Denver", "String member");
+    TEST_ASSERT(root["population"].isNumber() && root["population"].asInt() == 715522, "Number member");
+    TEST_ASSERT(root["capital"].isBool() && root["capital"].asBool(), "Bool member");
+    TEST_ASSERT(root["nickname"].isNull() && root["nickname"].exists(), "Null member exists and is null");
+    TEST_ASSERT(root["nickname"].asString("none") == "none", "Null falls back in asString()");
+    TEST_ASSERT(!root["missing"].exists(), "Absent member is missing");
+    TEST_ASSERT(root["missing"]["deeper"].asString("x") == "x", "Lookups through a missing value stay missing");
+    TEST_ASSERT(root["coords"]["lat"].asDouble() == 39.7392, "Nested object member");
+    TEST_ASSERT(root["zips"].isArray() && root["zips"].size() == 2, "Array member and size()");
+    TEST_ASSERT(root["zips"]["0"].exists() == false, "operator[] on an array is missing");
+    TEST_ASSERT(root.size() == 7, "size() counts object members");
+    TEST_ASSERT(root["coords"].raw() == "{\"lat\": 39.7392, \"lon\": -104.9903}", "raw() spans the value's source");
+
+    // A key is matched whole, not as a prefix
+    TEST_ASSERT(root["name_ext"].asString() == "not this one" && root["name"].asString() == "Denver",
+                "Keys sharing a prefix are told apart");
+
+    JsonObject fields(root);
+    TEST_ASSERT(fields.size() == 7, "JsonObject indexes every member");
+    TEST_ASSERT(fields["population"].asInt64() == 715522 && fields.contains("zips"),
+                "JsonObject lookups match JsonValue lookups");
+    TEST_ASSERT(!fields.contains("missing"), "JsonObject reports absent keys");
+}
+
+// ============================================================================
+// Test Case 2: forEachElement and forEachMember
+// ============================================================================
+void test_iteration() {
+    std::cout << "\n=== Test Case 2: forEachElement and forEachMember ===" << std::endl;
+
+    JsonValue array = JsonValue::parse("[1, \"two\", [3, [4]], {\"five\": 5}, null, false]");
+    std::vector<JsonValue::Type> types;
+    array.forEachElement([&types](const JsonValue& value) {
+        types.push_back(value.type());
+    });
+    std::vector<JsonValue::Type> expected = {
+        JsonValue::Type::Number, JsonValue::Type::String, JsonValue::Type::Array,
+        JsonValue::Type::Object, JsonValue::Type::Null, JsonValue::Type::Bool
+    };
+    TEST_ASSERT(types == expected, "Every element is visited once, nested values skipped whole");
+
+    int visited = 0;
+    array.forEachElement([&visited](const JsonValue&) {
+        return ++visited < 2;
+    });
+    TEST_ASSERT(visited == 2, "Returning false stops forEachElement");
+
+    std::vector<std::string> keys;
+    int sum = 0;
+    JsonValue::parse("{\"a\": 1, \"b\": {\"x\": 100}, \"c\": 3}")
+        .forEachMember([&](std::string_view key, const JsonValue& value) {
+            keys.emplace_back(key);
+            sum += value.asInt();
+        });
+    TEST_ASSERT((keys == std::vector<std::string>{"a", "b", "c"}), "Members are visited in order");
+    TEST_ASSERT(sum == 4, "Object values read as 0 through asInt()");
+
+    int calls = 0;
+    JsonValue::parse("[]").forEachElement([&calls](const JsonValue&) { calls++; });
+    JsonValue::parse("{}").forEachMember([&calls](std::string_view, const JsonValue&) { calls++; });
+    JsonValue::parse("\"scalar\"").forEachElement([&calls](const JsonValue&) { calls++; });
+    TEST_ASSERT(calls == 0, "Empty containers and scalars yield nothing");
+}
+
+// ============================================================================
+// Test Case 3: Strings and Escapes
+// ============================================================================
+void test_strings_and_escapes() {
+    std::cout << "\n=== Test Case 3: Strings and Escapes ===" << std::endl;
+
+    JsonValue root = JsonValue::parse(
+        "{\"plain\": \"Main St\", \"quoted\": \"say \\\"hi\\\"\", \"slashes\": \"a\\\\b\\/c\","
+        " \"controls\": \"1\\n2\\t3\", \"accent\": \"caf\\u00e9\", \"emoji\": \"\\ud83d\\ude00\","
+        " \"key \\\"q\\\"\": 7}");
+
+    TEST_ASSERT(root["plain"].asStringView() == "Main St", "asStringView() of a plain string");
+    TEST_ASSERT(root["quoted"].asStringView() == "say \\\"hi\\\"", "asStringView() leaves escapes as-is");
+    TEST_ASSERT(root["quoted"].asString() == "say \"hi\"", "asString() unescapes quotes");
+    TEST_ASSERT(root["slashes"].asString() == "a\\b/c", "Backslash and solidus escapes");
+    TEST_ASSERT(root["controls"].asString() == "1\n2\t3", "Control character escapes");
+    TEST_ASSERT(root["accent"].asString() == "caf\xC3\xA9", "\\u escape decodes to UTF-8");
+    TEST_ASSERT(root["emoji"].asString() == "\xF0\x9F\x98\x80", "Surrogate pair decodes to one code point");
+    TEST_ASSERT(root["number"].asStringView().empty(), "asStringView() of a missing value is empty");
+
+    // Keys are compared raw
+    TEST_ASSERT(root["key \\\"q\\\""].asInt() == 7, "Keys with escapes are matched raw");
+    TEST_ASSERT(jsonUnescape("tab\\there") == "tab\there", "jsonUnescape() on its own");
+
+    // Scalars read as text
+    JsonValue numbers = JsonValue::parse("[12.5, true]");
+    std::vector<std::string> texts;
+    numbers.forEachElement([&texts](const JsonValue& value) { texts.push_back(value.asString()); });
+    TEST_ASSERT(texts.size() == 2 && texts[0] == "12.5" && texts[1] == "true",
+                "asString() returns the text of numbers and bools");
+}
+
+// ============================================================================
+// Test Case 4: Numbers
+// ============================================================================
+void test_numbers() {
+    std::cout << "\n=== Test Case 4: Numbers ===" << std::endl;
+
+    JsonValue root = JsonValue::parse(
+        "{\"int\": 42, \"neg\": -17, \"frac\": -104.9903, \"exp\": 1.5e3, \"big\": 9007199254740993,"
+        " \"zero\": 0, \"text\": \"40.7128\", \"word\": \"abc\", \"flag\": 1, \"yes\": \"true\"}");
+
+    TEST_ASSERT(root["int"].asInt() == 42 && root["int"].asDouble() == 42.0, "Integer");
+    TEST_ASSERT(root["neg"].asInt() == -17, "Negative integer");
+    TEST_ASSERT(root["frac"].asDouble() == -104.9903, "Negative fraction");
+    TEST_ASSERT(root["exp"].asDouble() == 1500.0, "Exponent");
+    TEST_ASSERT(root["big"].asInt64() == 9007199254740993LL, "asInt64() keeps integers past 2^53");
+    TEST_ASSERT(root["zero"].asDouble(5.0) == 0.0, "Zero is not the fallback");
+    TEST_ASSERT(root["text"].asDouble() == 40.7128, "Numeric string parses as a number");
+    TEST_ASSERT(root["word"].asDouble(-1.0) == -1.0, "Non-numeric string falls back");
+    TEST_ASSERT(root["missing"].asInt(-1) == -1, "Missing value falls back");
+    TEST_ASSERT(root["flag"].asBool() && root["yes"].asBool(), "1 and \"true\" read as true");
+}
+
+// ============================================================================
+// Test Case 5: Malformed and Truncated Input
+// ============================================================================
+void test_malformed_input() {
+    std::cout << "\n=== Test Case 5: Malformed and Truncated Input ===" << std::endl;
+
+    TEST_ASSERT(!JsonValue::parse("").exists(), "Empty input is missing");
+    TEST_ASSERT(!JsonValue::parse("   ").exists(), "Whitespace only is missing");
+    TEST_ASSERT(!JsonValue::parse("nonsense")["key"].exists(), "Garbage has no members");
+
+    // A cut-off array yields every complete element before the cut; the
+    // cut-off object is kept so its complete leading members can be read
+    JsonValue cut = JsonValue::parse("[{\"id\": 1}, {\"id\": 2}, {\"id\": 3, \"name\": \"tru");
+    std::vector<int> ids;
+    std::vector<bool> named;
+    cut.forEachElement([&](const JsonValue& value) {
+        ids.push_back(value["id"].asInt());
+        named.push_back(value["name"].exists());
+    });
+    TEST_ASSERT((ids == std::vector<int>{1, 2, 3}), "Truncated array yields the elements before the cut");
+    TEST_ASSERT(named.size() == 3 && !named[2], "The member cut off mid-string is missing");
+
+    JsonValue object = JsonValue::parse("{\"a\": 1, \"b\": \"unterminated");
+    TEST_ASSERT(object["a"].asInt() == 1, "Members before the cut are still found");
+    TEST_ASSERT(!object["b"].exists(), "The cut-off member is missing");
+
+    // Mismatched and stray brackets do not crash or loop
+    int visited = 0;
+    JsonValue::parse("[1, 2}").forEachElement([&visited](const JsonValue&) { visited++; });
+    JsonValue::parse("[1,, 2]").forEachElement([&visited](const JsonValue&) { visited++; });
+    JsonValue::parse("{\"a\" 1}").forEachMember([&visited](std::string_view, const JsonValue&) { visited++; });
+    JsonValue::parse("[[[[[[").forEachElement([&visited](const JsonValue&) { visited++; });
+    TEST_ASSERT(visited <= 4, "Malformed containers yield at most their leading elements");
+
+    // A bad escape does not read past the string
+    JsonValue badEscape = JsonValue::parse("{\"s\": \"\\u12\"}");
+    TEST_ASSERT(badEscape["s"].isString(), "Short \\u escape still ends at the closing quote");
+    std::string unescaped = badEscape["s"].asString();
+    TEST_ASSERT(unescaped.size() <= 4, "Short \\u escape decodes to at most its own characters");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "JsonReader Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_parse_and_lookup();
+    test_iteration();
+    test_strings_and_escapes();
+    test_numbers();
+    test_malformed_input();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
@@ -0,0 +1,416 @@
+// ============================================================================
+// MarketHeatmap Test Cases
+// Tests for building a raster over a local extract, save()/load() round
+// trips, surface() and scoreAt(), and the read-once shared() instances
+// ============================================================================
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include "../src/services/MarketHeatmap.h"
+#include "../src/services/OSMExtractStore.h"
+
+using namespace FranchiseAI::Services;
+using FranchiseAI::Models::GeoBoundingBox;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// ============================================================================
+// Fixture: a .osm.pbf of tagged dense nodes, crowded toward the south-west
+// ============================================================================
+
+static std::string varint(uint64_t value) {
+    std::string out;
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+    return out;
+}
+
+static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static std::string varintField(int number, uint64_t value) {
+    return varint(static_cast<uint64_t>(number) << 3) + varint(value);
+}
+
+static std::string bytesField(int number, const std::string& bytes) {
+    return varint((static_cast<uint64_t>(number) << 3) | 2) + varint(bytes.size()) + bytes;
+}
+
+static std::string packed(const std::vector<uint64_t>& values) {
+    std::string out;
+    for (uint64_t value : values) {
+        out += varint(value);
+    }
+    return out;
+}
+
+// Length-prefixed BlobHeader followed by a zlib-compressed Blob
+static std::string blob(const std::string& type, const std::string& data) {
+    uLongf compressedSize = compressBound(data.size());
+    std::string compressed(compressedSize, '\0');
+    compress(reinterpret_cast<Bytef*>(&compressed[0]), &compressedSize,
+             reinterpret_cast<const Bytef*>(data.data()), data.size());
+    compressed.resize(compressedSize);
+
+    std::string body = varintField(2, data.size()) + bytesField(3, compressed);
+    std::string header = bytesField(1, type) + varintField(3, body.size());
+    uint32_t length = static_cast<uint32_t>(header.size());
+    std::string prefix = {static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                          static_cast<char>(length >> 8), static_cast<char>(length)};
+    return prefix + header + body;
+}
+
+// Extract bounds, in 1e-7 degrees
+static const int32_t kSouthE7 = 414000000, kNorthE7 = 416000000;
+static const int32_t kWestE7 = -818000000, kEastE7 = -816000000;
+
+/**
+ * @brief Write the fixture extract
+ *
+ * Offices, hotels, hospitals and schools whose density falls off away
+ * from the south-west corner, so the cells of a heatmap score differently.
+ */
+static void writeFixture(const std::string& path) {
+    std::vector<std::string> strings = {"", "office", "company", "tourism", "hotel",
+                                        "amenity", "hospital", "school"};
+    const uint64_t kinds[][2] = {{1, 2}, {3, 4}, {5, 6}, {5, 7}};
+
+    std::mt19937 random(19);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<uint64_t> ids, latValues, lonValues, keysVals;
+    int64_t lastId = 0, lastLat = 0, lastLon = 0;
+    for (int i = 0; i < 4000; ++i) {
+        int64_t id = 1000 + i;
+        double u = unit(random), v = unit(random);
+        int32_t lat = kSouthE7 + static_cast<int32_t>(u * u * u * (kNorthE7 - kSouthE7));
+        int32_t lon = kWestE7 + static_cast<int32_t>(v * v * v * (kEastE7 - kWestE7));
+        ids.push_back(zigzag(id - lastId));
+        latValues.push_back(zigzag(lat - lastLat));
+        lonValues.push_back(zigzag(lon - lastLon));
+        lastId = id;
+        lastLat = lat;
+        lastLon = lon;
+
+        const uint64_t* kind = kinds[i % 4];
+        keysVals.insert(keysVals.end(), {kind[0], kind[1], 0});
+    }
+    std::string dense = bytesField(1, packed(ids)) + bytesField(8, packed(latValues)) +
+                        bytesField(9, packed(lonValues)) + bytesField(10, packed(keysVals));
+
+    std::string table;
+    for (const auto& s : strings) {
+        table += bytesField(1, s);
+    }
+
+    std::string bbox = varintField(1, zigzag(int64_t(kWestE7) * 100)) +
+                       varintField(2, zigzag(int64_t(kEastE7) * 100)) +
+                       varintField(3, zigzag(int64_t(kNorthE7) * 100)) +
+                       varintField(4, zigzag(int64_t(kSouthE7) * 100));
+    std::string headerBlock = bytesField(1, bbox) + bytesField(4, "OsmSchema-V0.6") +
+                              bytesField(4, "DenseNodes");
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << blob("OSMHeader", headerBlock)
+        << blob("OSMData", bytesField(1, table) + bytesField(2, bytesField(2, dense)));
+}
+
+static bool fileExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+static void writeFile(const std::string& path, const std::string& data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << data;
+}
+
+static GeoBoundingBox box(double south, double west, double north, double east) {
+    GeoBoundingBox bounds;
+    bounds.minLat = south;
+    bounds.minLon = west;
+    bounds.maxLat = north;
+    bounds.maxLon = east;
+    return bounds;
+}
+
+static bool sameCells(const MarketHeatmap& a, const MarketHeatmap& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+        return false;
+    }
+    GeoBoundingBox everything = box(-90.0, -180.0, 90.0, 180.0);
+    MarketHeatmap::Surface first = a.surface(everything);
+    MarketHeatmap::Surface second = b.surface(everything);
+    return first.scores == second.scores && first.south == second.south && first.west == second.west &&
+           first.cellLat == second.cellLat && first.cellLon == second.cellLon;
+}
+
+static std::string tempDir;
+static OSMAPIConfig osmConfig;
+static std::shared_ptr<const MarketHeatmap> built;
+
+// ============================================================================
+// Test Case 1: Build Over a Local Extract
+// ============================================================================
+void test_build() {
+    std::cout << "\n=== Test Case 1: Build Over a Local Extract ===" << std::endl;
+
+    // Cells inside the extract are counted in-process; the last column
+    // overhangs its east edge and falls back to an Overpass endpoint
+    // that refuses the connection, so it has no data
+    MarketHeatmapConfig config;
+    config.cellKm = 2.0;
+    config.sampleRadiusKm = 1.0;
+    GeoBoundingBox metro = box(41.42, -81.78, 41.58, -81.60);
+
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    built = MarketHeatmap::build(osmConfig, metro, config, error);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(built && error.empty(), "Heatmap builds");
+    if (!built) {
+        std::cout << "    error: " << error << std::endl;
+        return;
+    }
+    std::cout << "    " << built->rows() << "x" << built->cols() << " cells in " << seconds << " s" << std::endl;
+
+    TEST_ASSERT(built->rows() == 9 && built->cols() == 8, "Grid spans the area in 2 km cells");
+    TEST_ASSERT(built->sampleRadiusKm() == 1.0 && built->builtAt() > 0, "Sample radius and build time are kept");
+
+    // Every cell matches the area statistics of its center
+    OpenStreetMapAPI api(osmConfig);
+    MarketHeatmap::Surface all = built->surface(metro);
+    TEST_ASSERT(all.rows == built->rows() && all.cols == built->cols(), "surface() of the whole area covers the grid");
+
+    bool cellsMatch = true;
+    int withData = 0, noData = 0;
+    std::vector<int> distinct;
+    for (int row = 0; row < all.rows; ++row) {
+        for (int col = 0; col < all.cols; ++col) {
+            double latitude = all.south + (row + 0.5) * all.cellLat;
+            double longitude = all.west + (col + 0.5) * all.cellLon;
+            int score = built->scoreAt(latitude, longitude);
+            uint8_t cell = all.at(row, col);
+            if (cell == MarketHeatmap::kNoData) {
+                ++noData;
+                cellsMatch = cellsMatch && score == -1 && col == all.cols - 1;
+                continue;
+            }
+            ++withData;
+            std::string cellError;
+            OSMAreaStats stats = api.getAreaStatisticsSync(latitude, longitude, 1.0, &cellError);
+            cellsMatch = cellsMatch && cellError.empty() && score == cell &&
+                         cell == stats.marketPotentialScore;
+            if (std::find(distinct.begin(), distinct.end(), cell) == distinct.end()) {
+                distinct.push_back(cell);
+            }
+        }
+    }
+    TEST_ASSERT(cellsMatch, "Each cell holds the score of its center, or no data past the extract");
+    TEST_ASSERT(withData == 9 * 7 && noData == 9, "Only the column past the extract has no data");
+    TEST_ASSERT(distinct.size() >= 3, "Scores vary across the grid");
+
+    TEST_ASSERT(built->scoreAt(41.0, -81.7) == -1 && built->scoreAt(41.5, -82.5) == -1,
+                "scoreAt() outside the grid is -1");
+    TEST_ASSERT(built->surface(box(40.0, -90.0, 40.5, -89.5)).empty(),
+                "surface() of a viewport off the grid is empty");
+
+    // A viewport inside the grid returns the overlapping cells
+    MarketHeatmap::Surface part = built->surface(box(
+        all.south + 2.5 * all.cellLat, all.west + 1.5 * all.cellLon,
+        all.south + 4.5 * all.cellLat, all.west + 3.5 * all.cellLon));
+    bool partMatches = part.rows == 3 && part.cols == 3;
+    for (int row = 0; partMatches && row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            partMatches = partMatches && part.at(row, col) == all.at(row + 2, col + 1);
+        }
+    }
+    TEST_ASSERT(partMatches, "surface() of a viewport returns the overlapping cells");
+
+    // Nothing computable
+    std::shared_ptr<const MarketHeatmap> none = MarketHeatmap::build(
+        osmConfig, box(41.5, -81.7, 41.5, -81.7), config, error);
+    TEST_ASSERT(!none && !error.empty(), "Empty area fails the build");
+}
+
+// ============================================================================
+// Test Case 2: save() and load()
+// ============================================================================
+void test_save_and_load() {
+    std::cout << "\n=== Test Case 2: save() and load() ===" << std::endl;
+    if (!built) {
+        TEST_ASSERT(false, "Needs the heatmap of Test Case 1");
+        return;
+    }
+
+    std::string path = tempDir + "/saved.heatmap";
+    std::string error;
+    TEST_ASSERT(built->save(path, error) && error.empty(), "Heatmap saves");
+    TEST_ASSERT(!fileExists(path + ".tmp"), "No temporary file is left behind");
+
+    auto loaded = MarketHeatmap::load(path, &error);
+    TEST_ASSERT(loaded && sameCells(*built, *loaded), "Loaded raster has the same grid and cells");
+    TEST_ASSERT(loaded && loaded->sampleRadiusKm() == built->sampleRadiusKm() &&
+                loaded->builtAt() == built->builtAt(), "Loaded raster keeps radius and build time");
+    TEST_ASSERT(loaded && loaded->scoreAt(41.45, -81.75) == built->scoreAt(41.45, -81.75),
+                "scoreAt() agrees after the round trip");
+
+    // Saving again replaces the file
+    TEST_ASSERT(built->save(path, error), "Existing file is replaced");
+
+    // Missing, truncated and foreign files are rejected
+    error.clear();
+    TEST_ASSERT(!MarketHeatmap::load(tempDir + "/missing.heatmap", &error) && !error.empty(),
+                "Missing file fails the load");
+
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    writeFile(tempDir + "/truncated.heatmap", data.substr(0, data.size() - 1));
+    error.clear();
+    TEST_ASSERT(!MarketHeatmap::load(tempDir + "/truncated.heatmap", &error) && !error.empty(),
+                "Truncated file fails the load");
+
+    writeFile(tempDir + "/foreign.heatmap", "NOTAHEATMAP" + std::string(200, '\0'));
+    TEST_ASSERT(!MarketHeatmap::load(tempDir + "/foreign.heatmap"), "File without the magic fails the load");
+}
+
+// ============================================================================
+// Test Case 3: shared() Reads Each Path Once
+// ============================================================================
+void test_shared() {
+    std::cout << "\n=== Test Case 3: shared() Reads Each Path Once ===" << std::endl;
+    if (!built) {
+        TEST_ASSERT(false, "Needs the heatmap of Test Case 1");
+        return;
+    }
+
+    OSMAPIConfig noExtract;
+    std::string error;
+
+    // An existing file is loaded once and kept, even after it is removed
+    std::string path = tempDir + "/shared.heatmap";
+    built->save(path, error);
+    auto first = MarketHeatmap::shared(path, noExtract);
+    TEST_ASSERT(first && sameCells(*first, *built), "shared() loads the saved raster");
+    std::remove(path.c_str());
+    TEST_ASSERT(MarketHeatmap::shared(path, noExtract) == first, "Later calls return the same instance");
+    TEST_ASSERT(!MarketHeatmap::shared("", noExtract), "Empty path has no heatmap");
+
+    // A missing file without an extract is not looked for again
+    std::string missing = tempDir + "/appears-later.heatmap";
+    TEST_ASSERT(!MarketHeatmap::shared(missing, noExtract), "Missing file and no extract: no heatmap");
+    built->save(missing, error);
+    TEST_ASSERT(!MarketHeatmap::shared(missing, noExtract), "File written later is not read again");
+
+    // A missing file with an extract starts one background build
+    std::string background = tempDir + "/background.heatmap";
+    TEST_ASSERT(!MarketHeatmap::shared(background, osmConfig), "Build is started, not waited for");
+
+    std::shared_ptr<const MarketHeatmap> result;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (!result && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        result = MarketHeatmap::shared(background, osmConfig);
+    }
+    TEST_ASSERT(result && result->rows() > 0 && result->cols() > 0, "Background build is picked up once finished");
+    TEST_ASSERT(MarketHeatmap::shared(background, osmConfig) == result, "Built heatmap is kept");
+
+    auto saved = MarketHeatmap::load(background, &error);
+    TEST_ASSERT(result && saved && sameCells(*saved, *result), "Background build is saved to the path");
+
+    // The extract is inset by the sample radius plus a cell, so every cell has data
+    bool allData = result != nullptr;
+    if (result) {
+        MarketHeatmap::Surface all = result->surface(box(-90.0, -180.0, 90.0, 180.0));
+        for (uint8_t score : all.scores) {
+            allData = allData && score != MarketHeatmap::kNoData;
+        }
+    }
+    TEST_ASSERT(allData, "Every cell of the background build lies inside the extract");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "MarketHeatmap Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    char dirTemplate[] = "/tmp/market_heatmap_test_XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::cout << "  ✗ FAIL: cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    tempDir = dirTemplate;
+
+    std::string pbfPath = tempDir + "/fixture.osm.pbf";
+    std::string storePath = tempDir + "/fixture.store";
+    std::string error;
+    writeFixture(pbfPath);
+    if (!OSMExtractStore::importPbf(pbfPath, storePath, error)) {
+        std::cout << "  ✗ FAIL: fixture import: " << error << std::endl;
+        return 1;
+    }
+
+    // Cells outside the extract fail at once instead of reaching Overpass
+    osmConfig.extractStorePath = storePath;
+    osmConfig.overpassEndpoint = "http://127.0.0.1:9/api/interpreter";
+    osmConfig.overpassRequestsPerSecond = 0;
+    osmConfig.maxRetries = 0;
+    osmConfig.enableCaching = false;
+
+    // Run test cases
+    test_build();
+    test_save_and_load();
+    test_shared();
+
+    for (const char* name : {"fixture.osm.pbf", "fixture.store", "saved.heatmap", "truncated.heatmap",
+                             "foreign.heatmap", "shared.heatmap", "appears-later.heatmap",
+                             "background.heatmap"}) {
+        std::remove((tempDir + "/" + name).c_str());
+    }
+    rmdir(tempDir.c_str());
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
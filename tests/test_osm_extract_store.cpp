@@ -0,0 +1,468 @@
+// ============================================================================
+// OSMExtractStore Test Cases
+// Tests for PBF import, reopening the mapped store, area counts and the
+// once-only background import
+// ============================================================================
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <zlib.h>
+#include "../src/services/OSMExtractStore.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// ============================================================================
+// Fixture: a small .osm.pbf written with a minimal protobuf encoder
+// ============================================================================
+
+static std::string varint(uint64_t value) {
+    std::string out;
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+    return out;
+}
+
+static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static std::string varintField(int number, uint64_t value) {
+    return varint(static_cast<uint64_t>(number) << 3) + varint(value);
+}
+
+static std::string bytesField(int number, const std::string& bytes) {
+    return varint((static_cast<uint64_t>(number) << 3) | 2) + varint(bytes.size()) + bytes;
+}
+
+static std::string packed(const std::vector<uint64_t>& values) {
+    std::string out;
+    for (uint64_t value : values) {
+        out += varint(value);
+    }
+    return out;
+}
+
+// Length-prefixed BlobHeader followed by a zlib-compressed Blob
+static std::string blob(const std::string& type, const std::string& data) {
+    uLongf compressedSize = compressBound(data.size());
+    std::string compressed(compressedSize, '\0');
+    compress(reinterpret_cast<Bytef*>(&compressed[0]), &compressedSize,
+             reinterpret_cast<const Bytef*>(data.data()), data.size());
+    compressed.resize(compressedSize);
+
+    std::string body = varintField(2, data.size()) + bytesField(3, compressed);
+    std::string header = bytesField(1, type) + varintField(3, body.size());
+    uint32_t length = static_cast<uint32_t>(header.size());
+    std::string prefix = {static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                          static_cast<char>(length >> 8), static_cast<char>(length)};
+    return prefix + header + body;
+}
+
+struct FixturePoi {
+    int64_t id;
+    bool way;
+    int32_t latE7;
+    int32_t lonE7;
+    std::map<std::string, std::string> tags;
+};
+
+// Extract bounds, in 1e-7 degrees
+static const int32_t kSouthE7 = 414000000, kNorthE7 = 416000000;
+static const int32_t kWestE7 = -818000000, kEastE7 = -816000000;
+
+/**
+ * @brief Write the fixture extract and return the POIs the import must keep
+ *
+ * Tagged nodes of several kinds (one of which is not a POI), untagged
+ * nodes, and building ways over untagged nodes that become POIs at the
+ * center of their bounding box.
+ */
+static std::vector<FixturePoi> writeFixture(const std::string& path) {
+    static const std::pair<const char*, const char*> kinds[] = {
+        {"office", "company"}, {"tourism", "hotel"}, {"amenity", "restaurant"},
+        {"amenity", "cafe"}, {"amenity", "bench"}, {"highway", "bus_stop"},
+        {"shop", "bakery"}, {"amenity", "hospital"}, {"amenity", "school"},
+    };
+
+    std::vector<std::string> strings = {"", "name", "building", "commercial", "addr:city", "Cleveland"};
+    auto stringIndex = [&strings](const std::string& s) {
+        for (size_t i = 0; i < strings.size(); ++i) {
+            if (strings[i] == s) return static_cast<uint64_t>(i);
+        }
+        strings.push_back(s);
+        return static_cast<uint64_t>(strings.size() - 1);
+    };
+
+    std::vector<FixturePoi> pois;
+    std::map<int64_t, std::pair<int32_t, int32_t>> nodes;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int32_t> lats(kSouthE7, kNorthE7);
+    std::uniform_int_distribution<int32_t> lons(kWestE7, kEastE7);
+
+    // Dense nodes: every third one tagged
+    std::vector<uint64_t> ids, latValues, lonValues, keysVals;
+    int64_t lastId = 0, lastLat = 0, lastLon = 0;
+    for (int i = 0; i < 3000; ++i) {
+        int64_t id = 1000 + i;
+        int32_t lat = lats(random), lon = lons(random);
+        nodes[id] = {lat, lon};
+        ids.push_back(zigzag(id - lastId));
+        latValues.push_back(zigzag(lat - lastLat));
+        lonValues.push_back(zigzag(lon - lastLon));
+        lastId = id;
+        lastLat = lat;
+        lastLon = lon;
+
+        if (i % 3 == 0) {
+            const auto& kind = kinds[(i / 3) % (sizeof(kinds) / sizeof(kinds[0]))];
+            std::string name = "Business " + std::to_string(i);
+            keysVals.insert(keysVals.end(), {stringIndex(kind.first), stringIndex(kind.second),
+                                             stringIndex("name"), stringIndex(name),
+                                             stringIndex("addr:city"), stringIndex("Cleveland")});
+            if (std::string(kind.second) != "bench") {
+                pois.push_back({id, false, lat, lon,
+                                {{kind.first, kind.second}, {"name", name}, {"addr:city", "Cleveland"}}});
+            }
+        }
+        keysVals.push_back(0);
+    }
+    std::string dense = bytesField(1, packed(ids)) + bytesField(8, packed(latValues)) +
+                        bytesField(9, packed(lonValues)) + bytesField(10, packed(keysVals));
+
+    // Commercial buildings outlining four untagged nodes each
+    std::string ways;
+    for (int w = 0; w < 40; ++w) {
+        int64_t first = 1001 + 3 * w;   // Untagged: never a multiple of three from 1000
+        std::vector<int64_t> refs = {first, first + 1, first + 3, first + 4, first};
+        int32_t minLat = INT32_MAX, maxLat = INT32_MIN, minLon = INT32_MAX, maxLon = INT32_MIN;
+        std::vector<uint64_t> deltas;
+        int64_t last = 0;
+        for (int64_t ref : refs) {
+            deltas.push_back(zigzag(ref - last));
+            last = ref;
+            minLat = std::min(minLat, nodes[ref].first);
+            maxLat = std::max(maxLat, nodes[ref].first);
+            minLon = std::min(minLon, nodes[ref].second);
+            maxLon = std::max(maxLon, nodes[ref].second);
+        }
+        std::string name = "Building " + std::to_string(w);
+        std::string way = varintField(1, 500000 + w) +
+                          bytesField(2, packed({stringIndex("building"), stringIndex("name")})) +
+                          bytesField(3, packed({stringIndex("commercial"), stringIndex(name)})) +
+                          bytesField(8, packed(deltas));
+        ways += bytesField(3, way);
+        pois.push_back({500000 + w, true,
+                        static_cast<int32_t>((int64_t(minLat) + maxLat) / 2),
+                        static_cast<int32_t>((int64_t(minLon) + maxLon) / 2),
+                        {{"building", "commercial"}, {"name", name}}});
+    }
+
+    std::string table;
+    for (const auto& s : strings) {
+        table += bytesField(1, s);
+    }
+    std::string stringTable = bytesField(1, table);
+
+    std::string bbox = varintField(1, zigzag(int64_t(kWestE7) * 100)) +
+                       varintField(2, zigzag(int64_t(kEastE7) * 100)) +
+                       varintField(3, zigzag(int64_t(kNorthE7) * 100)) +
+                       varintField(4, zigzag(int64_t(kSouthE7) * 100));
+    std::string headerBlock = bytesField(1, bbox) + bytesField(4, "OsmSchema-V0.6") +
+                              bytesField(4, "DenseNodes");
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << blob("OSMHeader", headerBlock)
+        << blob("OSMData", stringTable + bytesField(2, bytesField(2, dense)))
+        << blob("OSMData", stringTable + bytesField(2, ways));
+    return pois;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::string& data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << data;
+}
+
+static bool fileExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+static void setMtime(const std::string& path, time_t mtime) {
+    struct utimbuf times = {mtime, mtime};
+    utime(path.c_str(), &times);
+}
+
+// ============================================================================
+// Brute-force reference
+// ============================================================================
+
+static double distanceMeters(double lat1, double lon1, double lat2, double lon2) {
+    const double earthRadius = 6371000.0;
+    double dLat = (lat2 - lat1) * M_PI / 180.0;
+    double dLon = (lon2 - lon1) * M_PI / 180.0;
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+               std::cos(lat1 * M_PI / 180.0) * std::cos(lat2 * M_PI / 180.0) *
+               std::sin(dLon / 2) * std::sin(dLon / 2);
+    return earthRadius * 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+}
+
+static bool within(const FixturePoi& poi, double lat, double lon, double radiusMeters) {
+    return distanceMeters(lat, lon, poi.latE7 / 1e7, poi.lonE7 / 1e7) <= radiusMeters;
+}
+
+static OSMAreaCounts bruteForceCounts(const std::vector<FixturePoi>& pois,
+                                      double lat, double lon, double radiusMeters) {
+    OSMAreaCounts counts = {};
+    for (const auto& poi : pois) {
+        if (!within(poi, lat, lon, radiusMeters)) continue;
+        uint32_t mask = OSMAreaStats::classify([&poi](std::string_view key) {
+            auto it = poi.tags.find(std::string(key));
+            return it == poi.tags.end() ? std::string_view() : std::string_view(it->second);
+        });
+        for (size_t stat = 0; stat < counts.size(); ++stat) {
+            if (mask & (1u << stat)) ++counts[stat];
+        }
+    }
+    return counts;
+}
+
+struct Circle {
+    double lat, lon, radiusMeters;
+};
+
+// Small, mid-size and large circles, all inside the extract
+static const Circle kCircles[] = {
+    {41.50, -81.70, 800.0},
+    {41.47, -81.74, 2500.0},
+    {41.52, -81.68, 6000.0},
+};
+
+static bool countsMatch(const OSMExtractStore& store, const std::vector<FixturePoi>& pois) {
+    for (const auto& circle : kCircles) {
+        if (store.countWithin(circle.lat, circle.lon, circle.radiusMeters) !=
+            bruteForceCounts(pois, circle.lat, circle.lon, circle.radiusMeters)) {
+            std::cout << "    counts differ at " << circle.lat << "," << circle.lon
+                      << " r=" << circle.radiusMeters << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string tempDir;
+
+// ============================================================================
+// Test Case 1: Import a PBF Extract
+// ============================================================================
+void test_import_pbf() {
+    std::cout << "\n=== Test Case 1: Import a PBF Extract ===" << std::endl;
+
+    std::string pbfPath = tempDir + "/fixture.osm.pbf";
+    std::string storePath = tempDir + "/fixture.store";
+    auto pois = writeFixture(pbfPath);
+
+    std::string error;
+    bool imported = OSMExtractStore::importPbf(pbfPath, storePath, error);
+    TEST_ASSERT(imported && error.empty(), "Fixture imports");
+
+    auto store = OSMExtractStore::open(storePath, &error);
+    TEST_ASSERT(store != nullptr, "Imported store opens");
+    if (!store) return;
+
+    TEST_ASSERT(store->size() == pois.size(), "Every POI node and way is kept, nothing else");
+    TEST_ASSERT(countsMatch(*store, pois), "countWithin() matches a brute-force count");
+
+    // forEachWithin() visits exactly the POIs inside the circle
+    const Circle& circle = kCircles[1];
+    size_t expected = 0;
+    for (const auto& poi : pois) {
+        if (within(poi, circle.lat, circle.lon, circle.radiusMeters)) ++expected;
+    }
+    size_t visited = 0;
+    bool wayCentered = false;
+    store->forEachWithin(circle.lat, circle.lon, circle.radiusMeters, [&](const OSMPoiView& poi) {
+        ++visited;
+        for (const auto& fixture : pois) {
+            if (fixture.way && fixture.id == poi.osmId()) {
+                wayCentered = std::string(poi.osmType()) == "way" &&
+                              std::abs(poi.latitude() - fixture.latE7 / 1e7) < 1e-6 &&
+                              std::abs(poi.longitude() - fixture.lonE7 / 1e7) < 1e-6 &&
+                              poi.tag("building") == "commercial";
+            }
+        }
+    });
+    TEST_ASSERT(visited == expected && expected > 0, "forEachWithin() visits every POI in the circle");
+    TEST_ASSERT(wayCentered, "Ways are placed at the center of their nodes' bounding box");
+
+    TEST_ASSERT(store->covers(41.50, -81.70, 1000.0), "Circle inside the extract is covered");
+    TEST_ASSERT(!store->covers(41.41, -81.79, 5000.0), "Circle over the extract's edge is not covered");
+
+    // A truncated extract fails the import instead of writing a partial store
+    std::string truncatedPath = tempDir + "/truncated.osm.pbf";
+    std::string bytes = readFile(pbfPath);
+    writeFile(truncatedPath, bytes.substr(0, bytes.size() - 100));
+    std::string truncatedStore = tempDir + "/truncated.store";
+    error.clear();
+    bool truncatedImported = OSMExtractStore::importPbf(truncatedPath, truncatedStore, error);
+    TEST_ASSERT(!truncatedImported && !error.empty(), "Truncated extract fails the import");
+    TEST_ASSERT(!fileExists(truncatedStore), "No store is written for a failed import");
+}
+
+// ============================================================================
+// Test Case 2: Reopen the Mapped Store
+// ============================================================================
+void test_reopen_store() {
+    std::cout << "\n=== Test Case 2: Reopen the Mapped Store ===" << std::endl;
+
+    std::string pbfPath = tempDir + "/fixture.osm.pbf";
+    std::string storePath = tempDir + "/fixture.store";
+    auto pois = writeFixture(pbfPath);
+
+    auto first = OSMExtractStore::open(storePath);
+    auto second = OSMExtractStore::open(storePath);
+    TEST_ASSERT(first && first == second, "Open stores are shared per path");
+
+    // Once every reference is gone the next open maps the file again
+    first.reset();
+    second.reset();
+    auto reopened = OSMExtractStore::open(storePath);
+    TEST_ASSERT(reopened && reopened->size() == pois.size(), "Reopened store has every POI");
+    TEST_ASSERT(reopened && countsMatch(*reopened, pois), "Reopened store answers the same counts");
+
+    std::string error;
+    auto invalid = OSMExtractStore::open(pbfPath, &error);
+    TEST_ASSERT(!invalid && !error.empty(), "A file that is not a store is refused");
+}
+
+// ============================================================================
+// Test Case 3: Background Import Runs Once
+// ============================================================================
+void test_background_import() {
+    std::cout << "\n=== Test Case 3: Background Import Runs Once ===" << std::endl;
+
+    std::string pbfPath = tempDir + "/background.osm.pbf";
+    std::string storePath = tempDir + "/background.store";
+    auto pois = writeFixture(pbfPath);
+
+    // The first call only queues the import
+    bool importing = false;
+    std::string error;
+    auto store = OSMExtractStore::openOrStartImport(storePath, pbfPath, &error, &importing);
+    TEST_ASSERT(!store && importing, "openOrStartImport() does not wait for the import");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!store && importing && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        store = OSMExtractStore::openOrStartImport(storePath, pbfPath, &error, &importing);
+    }
+    TEST_ASSERT(store && !importing, "Store is picked up once the background import finishes");
+    TEST_ASSERT(store && countsMatch(*store, pois), "Background-imported store answers counts");
+
+    // A corrupt extract fails once and is not imported again while unchanged
+    std::string badPbf = tempDir + "/corrupt.osm.pbf";
+    std::string badStore = tempDir + "/corrupt.store";
+    std::string good = readFile(pbfPath);
+    std::string corrupt = good;
+    for (size_t i = corrupt.size() / 2; i < corrupt.size() / 2 + 64; ++i) {
+        corrupt[i] = static_cast<char>(~corrupt[i]);
+    }
+    writeFile(badPbf, corrupt);
+    time_t mtime = std::time(nullptr) - 60;
+    setMtime(badPbf, mtime);
+
+    error.clear();
+    auto failed = OSMExtractStore::openOrImport(badStore, badPbf, &error);
+    TEST_ASSERT(!failed && !error.empty(), "Corrupt extract fails the import");
+
+    // Same size and mtime: still remembered as failed, even though the
+    // content is now valid
+    writeFile(badPbf, good);
+    setMtime(badPbf, mtime);
+    std::string rememberedError;
+    importing = true;
+    failed = OSMExtractStore::openOrStartImport(badStore, badPbf, &rememberedError, &importing);
+    TEST_ASSERT(!failed && !importing && rememberedError == error,
+                "Failed import is remembered while the extract is unchanged");
+    TEST_ASSERT(!fileExists(badStore), "Unchanged extract is not imported again");
+
+    // A changed extract is imported again
+    setMtime(badPbf, mtime + 30);
+    auto fixed = OSMExtractStore::openOrImport(badStore, badPbf, &error);
+    TEST_ASSERT(fixed && fixed->size() == pois.size(), "Changed extract is imported again");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "OSMExtractStore Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    char dirTemplate[] = "/tmp/osm_extract_test_XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::cout << "  ✗ FAIL: cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    tempDir = dirTemplate;
+
+    // Run test cases
+    test_import_pbf();
+    test_reopen_store();
+    test_background_import();
+
+    for (const char* name : {"fixture.osm.pbf", "fixture.store", "truncated.osm.pbf",
+                             "background.osm.pbf", "background.store",
+                             "corrupt.osm.pbf", "corrupt.store"}) {
+        std::remove((tempDir + "/" + name).c_str());
+    }
+    rmdir(tempDir.c_str());
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
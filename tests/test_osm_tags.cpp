@@ -0,0 +1,304 @@
+// ============================================================================
+// OSMTags Test Cases
+// Tests for the string interner, OSMTagList get/set/erase and the tile
+// encoding round-trip through the on-disk cache
+// ============================================================================
+
+#include <iostream>
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../src/services/OSMPoiIndex.h"
+#include "../src/services/OSMTags.h"
+#include "../src/services/PersistentCache.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+static std::string tempDir;
+
+static std::map<std::string, std::string> tagsOf(const OSMTagList& tags) {
+    std::map<std::string, std::string> result;
+    tags.forEach([&result](std::string_view key, std::string_view value) {
+        result.emplace(std::string(key), std::string(value));
+    });
+    return result;
+}
+
+// ============================================================================
+// Test Case 1: String Interner
+// ============================================================================
+void test_interner() {
+    std::cout << "\n=== Test Case 1: String Interner ===" << std::endl;
+
+    OSMStringInterner& strings = OSMStringInterner::instance();
+
+    TEST_ASSERT(strings.find("name") == static_cast<uint32_t>(OSMKey::Name) &&
+                strings.find("opening_hours") == static_cast<uint32_t>(OSMKey::OpeningHours),
+                "Well-known keys sit at their OSMKey ids");
+    TEST_ASSERT(strings.lookup(static_cast<uint32_t>(OSMKey::AddrCity)) == "addr:city",
+                "lookup() of a well-known id");
+
+    TEST_ASSERT(strings.find("test:never-interned") == OSMStringInterner::kNotFound,
+                "find() does not add a string");
+    size_t before = strings.size();
+    uint32_t id = strings.intern("test:interned");
+    TEST_ASSERT(id != OSMStringInterner::kNotFound && strings.lookup(id) == "test:interned",
+                "intern() adds a string that lookup() returns");
+    TEST_ASSERT(strings.intern(std::string("test:") + "interned") == id && strings.find("test:interned") == id,
+                "Equal strings share one id");
+    TEST_ASSERT(strings.size() == before + 1, "size() counts the new string once");
+
+    TEST_ASSERT(strings.internsValuesOf(static_cast<uint32_t>(OSMKey::Amenity)),
+                "amenity values are interned");
+    TEST_ASSERT(!strings.internsValuesOf(static_cast<uint32_t>(OSMKey::Name)),
+                "name values stay with the POI");
+    TEST_ASSERT(!strings.internsValuesOf(id), "Other keys' values stay with the POI");
+
+    // Concurrent interning of the same strings agrees on the ids
+    const int threads = 8;
+    const int count = 500;
+    std::vector<std::vector<uint32_t>> ids(threads, std::vector<uint32_t>(count));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&ids, t, count]() {
+            for (int i = 0; i < count; ++i) {
+                ids[t][i] = OSMStringInterner::instance().intern("test:concurrent:" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    bool agree = true;
+    for (int t = 1; t < threads; ++t) {
+        agree = agree && ids[t] == ids[0];
+    }
+    bool readable = true;
+    for (int i = 0; i < count; ++i) {
+        readable = readable && strings.lookup(ids[0][i]) == "test:concurrent:" + std::to_string(i);
+    }
+    TEST_ASSERT(agree, "Concurrent intern() calls return the same ids");
+    TEST_ASSERT(readable, "Every concurrently interned string reads back");
+    TEST_ASSERT(strings.memoryBytes() > 0, "memoryBytes() reports the table");
+}
+
+// ============================================================================
+// Test Case 2: OSMTagList get/set/erase
+// ============================================================================
+void test_tag_list() {
+    std::cout << "\n=== Test Case 2: OSMTagList get/set/erase ===" << std::endl;
+
+    OSMTagList tags;
+    TEST_ASSERT(tags.empty() && tags.get(OSMKey::Name).empty(), "New list is empty");
+
+    tags.set(OSMKey::Name, "Blue Sky Cafe");
+    tags.set(OSMKey::Amenity, "cafe");
+    tags.set("cuisine", "coffee_shop");
+    tags.set("test:custom", "custom value");
+    TEST_ASSERT(tags.size() == 4, "size() counts each tag");
+    TEST_ASSERT(tags.get(OSMKey::Name) == "Blue Sky Cafe" && tags.get("name") == "Blue Sky Cafe",
+                "Local value by OSMKey and by string");
+    TEST_ASSERT(tags.get(OSMKey::Amenity) == "cafe", "Interned value");
+    TEST_ASSERT(tags.get("test:custom") == "custom value", "Value of a key outside the well-known table");
+    TEST_ASSERT(tags.has("cuisine") && !tags.has("shop") && !tags.has("test:never-interned"),
+                "has() for present, absent and never-seen keys");
+
+    // Replacing values
+    tags.set(OSMKey::Amenity, "restaurant");
+    tags.set(OSMKey::Name, "Blue Sky");
+    TEST_ASSERT(tags.get(OSMKey::Amenity) == "restaurant", "Interned value replaced");
+    TEST_ASSERT(tags.get(OSMKey::Name) == "Blue Sky", "Shorter local value replaced in place");
+    tags.set(OSMKey::Name, "Blue Sky Cafe and Roastery");
+    TEST_ASSERT(tags.get(OSMKey::Name) == "Blue Sky Cafe and Roastery", "Longer local value replaced");
+    TEST_ASSERT(tags.get("test:custom") == "custom value", "Other local values survive the replacement");
+    TEST_ASSERT(tags.size() == 4, "Replacing does not add tags");
+
+    // A value read from the list itself
+    tags.set(OSMKey::Website, tags.get(OSMKey::Name));
+    tags.set(OSMKey::Name, tags.get("test:custom"));
+    TEST_ASSERT(tags.get(OSMKey::Website) == "Blue Sky Cafe and Roastery" &&
+                tags.get(OSMKey::Name) == "custom value", "Values taken from the same list");
+
+    // Values are read back as C strings
+    tags.set(OSMKey::Phone, std::string_view("555-0100\0junk", 13));
+    TEST_ASSERT(tags.get(OSMKey::Phone) == "555-0100", "Embedded NUL ends the value");
+
+    // Erase
+    TEST_ASSERT(tags.erase(OSMKey::Name), "erase() of a present tag");
+    TEST_ASSERT(!tags.erase(OSMKey::Name) && !tags.erase("test:never-interned"),
+                "erase() of an absent or never-seen key");
+    TEST_ASSERT(tags.get(OSMKey::Name).empty() && tags.size() == 5, "Erased tag is gone");
+    auto expected = std::map<std::string, std::string>{
+        {"amenity", "restaurant"}, {"cuisine", "coffee_shop"}, {"phone", "555-0100"},
+        {"test:custom", "custom value"}, {"website", "Blue Sky Cafe and Roastery"}};
+    TEST_ASSERT(tagsOf(tags) == expected, "Remaining values are intact after erase()");
+
+    // Growing past the inline tags, then copying and moving
+    OSMTagList many;
+    for (int i = 0; i < 20; ++i) {
+        many.set("test:key" + std::to_string(i), "value number " + std::to_string(i));
+    }
+    bool all = many.size() == 20;
+    for (int i = 0; i < 20; ++i) {
+        all = all && many.get("test:key" + std::to_string(i)) == "value number " + std::to_string(i);
+    }
+    TEST_ASSERT(all, "List grows past kInlineTags");
+    OSMTagList copy(many);
+    OSMTagList moved(std::move(many));
+    copy.shrinkToFit();
+    TEST_ASSERT(tagsOf(copy) == tagsOf(moved) && moved.size() == 20, "Copy and move keep every tag");
+    TEST_ASSERT(many.empty(), "Moved-from list is empty");
+}
+
+// ============================================================================
+// Test Case 3: Repeated Updates Do Not Grow the List
+// ============================================================================
+void test_overwrite_reclaims_text() {
+    std::cout << "\n=== Test Case 3: Repeated Updates Do Not Grow the List ===" << std::endl;
+
+    OSMTagList tags;
+    tags.set(OSMKey::Name, "A name long enough to live on the heap");
+    tags.set(OSMKey::AddrStreet, "Some Street With A Long Name");
+    tags.set(OSMKey::Website, "https://example.com/a/long/path");
+    size_t initial = tags.heapBytes();
+
+    // Values that fit reuse the old text
+    for (int i = 0; i < 1000; ++i) {
+        tags.set(OSMKey::Name, "Name " + std::to_string(i));
+    }
+    TEST_ASSERT(tags.heapBytes() == initial, "Shorter updates reuse the old value's text");
+    TEST_ASSERT(tags.get(OSMKey::Name) == "Name 999", "Last update wins");
+
+    // Values that do not fit release the old text
+    std::string grown = "x";
+    for (int i = 0; i < 1000; ++i) {
+        grown = (i % 2) ? std::string(10 + i % 50, 'a') : std::string(60 - i % 50, 'b');
+        tags.set(OSMKey::AddrStreet, grown);
+    }
+    tags.shrinkToFit();
+    TEST_ASSERT(tags.heapBytes() < initial + 128, "Alternating updates stay within a bounded size");
+    TEST_ASSERT(tags.get(OSMKey::AddrStreet) == grown, "Last alternating update wins");
+    TEST_ASSERT(tags.get(OSMKey::Website) == "https://example.com/a/long/path" &&
+                tags.get(OSMKey::Name) == "Name 999", "Other values are untouched");
+}
+
+// ============================================================================
+// Test Case 4: Tile Encoding Round-Trip
+// ============================================================================
+void test_tile_round_trip() {
+    std::cout << "\n=== Test Case 4: Tile Encoding Round-Trip ===" << std::endl;
+
+    std::string path = tempDir + "/tiles.log";
+    auto store = PersistentCache::shared(path, 16u << 20);
+    store->waitUntilLoaded();
+
+    OSMPoiIndex::Policy policy;
+    policy.maxAgeSeconds = 3600;
+    policy.staleSeconds = 3600;
+    auto tile = OSMPoiIndex::tileAt(39.7392, -104.9903);
+    OSMPoiIndex::TileRange range;
+    range.xMin = range.xMax = tile.x;
+    range.yMin = range.yMax = tile.y;
+
+    std::vector<OSMPoi> pois;
+    for (int i = 0; i < 50; ++i) {
+        OSMPoi poi;
+        poi.osmId = 1000 + i;
+        poi.osmType = (i % 3 == 0) ? "way" : "node";
+        poi.latitude = 39.7392 + i * 1e-5;
+        poi.longitude = -104.9903 - i * 1e-5;
+        poi.tags.set(OSMKey::Name, "Place " + std::to_string(i));
+        poi.tags.set(OSMKey::Amenity, (i % 2) ? "cafe" : "restaurant");
+        poi.tags.set("test:note", "line one\nline \"two\" " + std::to_string(i));
+        if (i % 5 == 0) {
+            poi.tags.set(OSMKey::AddrCity, "Denver");
+            poi.tags.set(OSMKey::OpeningHours, "Mo-Fr 07:00-18:00");
+        }
+        pois.push_back(std::move(poi));
+    }
+
+    {
+        OSMPoiIndex writer;
+        writer.persistTo(store);
+        auto claim = writer.claim(range, policy);
+        TEST_ASSERT(claim.fetch.size() == 1, "Empty index claims the tile for fetching");
+        writer.insert(tile, pois);
+    }
+
+    // A fresh index has nothing in memory, so the tile is decoded from the store
+    OSMPoiIndex reader;
+    reader.persistTo(store);
+    auto claim = reader.claim(range, policy);
+    TEST_ASSERT(claim.fetch.empty() && claim.cached.size() == 1 && claim.cached[0],
+                "Tile is restored from the store");
+    TEST_ASSERT(reader.getStats().diskHits.load() == 1, "Restore counts one disk hit");
+
+    bool same = claim.cached.size() == 1 && claim.cached[0] && claim.cached[0]->size() == pois.size();
+    for (size_t i = 0; same && i < pois.size(); ++i) {
+        const OSMPoi& a = pois[i];
+        const OSMPoi& b = (*claim.cached[0])[i];
+        same = a.osmId == b.osmId && a.osmType == b.osmType &&
+               a.latitude == b.latitude && a.longitude == b.longitude &&
+               tagsOf(a.tags) == tagsOf(b.tags);
+    }
+    TEST_ASSERT(same, "Every POI and tag survives the round-trip");
+
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "OSMTags Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    char dirTemplate[] = "/tmp/osm_tags_test_XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::cout << "  ✗ FAIL: cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    tempDir = dirTemplate;
+
+    // Run test cases
+    test_interner();
+    test_tag_list();
+    test_overwrite_reclaims_text();
+    test_tile_round_trip();
+
+    rmdir(tempDir.c_str());
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
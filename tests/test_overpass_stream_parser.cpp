@@ -0,0 +1,260 @@
+// ============================================================================
+// OverpassStreamParser Test Cases
+// Tests that chunked parsing matches the one-shot parser, and covers the
+// "remark" field, early stops and truncated responses
+// ============================================================================
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/services/OpenStreetMapAPI.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+/**
+ * @brief Overpass-style response with nodes, ways and skipped elements
+ *
+ * Tag values contain braces, brackets, escaped quotes, backslashes and
+ * \u escapes, so a chunk boundary can land inside any of them.
+ */
+static std::string buildResponse(int elements, const std::string& remark = "") {
+    std::ostringstream json;
+    json << "{\n  \"version\": 0.6,\n  \"generator\": \"Overpass API {test} [x]\",\n"
+         << "  \"osm3s\": {\"timestamp_osm_base\": \"2024-01-01T00:00:00Z\", \"copyright\": \"ODbL\"},\n"
+         << "  \"elements\": [\n";
+    for (int i = 0; i < elements; ++i) {
+        if (i > 0) {
+            json << ",\n";
+        }
+        double lat = 39.7 + i * 0.0001;
+        double lon = -104.9 - i * 0.0001;
+        if (i % 7 == 6) {
+            // A relation without a center has no coordinates and is skipped
+            json << "  {\"type\": \"relation\", \"id\": " << (900000 + i)
+                 << ", \"members\": [{\"type\": \"way\", \"ref\": 1, \"role\": \"outer\"}],"
+                 << " \"tags\": {\"name\": \"Skipped } ]\"}}";
+        } else if (i % 3 == 0) {
+            json << "  {\"type\": \"way\", \"id\": " << (500000 + i)
+                 << ", \"center\": {\"lat\": " << lat << ", \"lon\": " << lon << "},"
+                 << " \"nodes\": [1, 2, 3], \"tags\": {\"building\": \"office\","
+                 << " \"name\": \"Tower \\\"" << i << "\\\" {east} [wing]\"}}";
+        } else {
+            json << "  {\"type\": \"node\", \"id\": " << (100000 + i)
+                 << ", \"lat\": " << lat << ", \"lon\": " << lon << ", \"tags\": {"
+                 << "\"amenity\": \"" << (i % 2 ? "cafe" : "restaurant") << "\", "
+                 << "\"name\": \"Caf\\u00e9 " << i << " \\\\ back\\\\slash\", "
+                 << "\"note\": \"elements: [\\\"not\\\", {\\\"a\\\": \\\"key\\\"}]\", "
+                 << "\"addr:city\": \"Denver\"}}";
+        }
+    }
+    json << "\n  ]";
+    if (!remark.empty()) {
+        json << ",\n  \"remark\": \"" << remark << "\"";
+    }
+    json << "\n}\n";
+    return json.str();
+}
+
+static std::map<std::string, std::string> tagsOf(const OSMPoi& poi) {
+    std::map<std::string, std::string> result;
+    poi.tags.forEach([&result](std::string_view key, std::string_view value) {
+        result.emplace(std::string(key), std::string(value));
+    });
+    return result;
+}
+
+static bool samePois(const std::vector<OSMPoi>& a, const std::vector<OSMPoi>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].osmId != b[i].osmId || a[i].osmType != b[i].osmType ||
+            a[i].latitude != b[i].latitude || a[i].longitude != b[i].longitude ||
+            tagsOf(a[i]) != tagsOf(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief A parser collecting every POI it is given
+ */
+struct CollectingParser {
+    std::vector<OSMPoi> pois;
+    OverpassStreamParser parser{[this](OSMPoi&& poi) {
+        pois.push_back(std::move(poi));
+        return true;
+    }};
+
+    // Feed text in chunks of random sizes between 1 and maxChunk
+    void feedInChunks(const std::string& text, std::mt19937& random, size_t maxChunk) {
+        std::uniform_int_distribution<size_t> sizes(1, maxChunk);
+        for (size_t pos = 0; pos < text.size();) {
+            size_t size = std::min(sizes(random), text.size() - pos);
+            parser.feed(std::string_view(text).substr(pos, size));
+            pos += size;
+        }
+    }
+};
+
+// ============================================================================
+// Test Case 1: Random Chunk Splits Match the One-Shot Parse
+// ============================================================================
+void test_random_chunks_match_one_shot() {
+    std::cout << "\n=== Test Case 1: Random Chunk Splits Match the One-Shot Parse ===" << std::endl;
+
+    OpenStreetMapAPI api;
+    const std::string json = buildResponse(200);
+    std::vector<OSMPoi> expected = api.parseOverpassResponse(json, 100000);
+
+    TEST_ASSERT(expected.size() == 200 - 200 / 7, "One-shot parse drops only the elements without coordinates");
+    TEST_ASSERT(!expected.empty() && expected[1].name() == "Caf\xC3\xA9 1 \\ back\\slash",
+                "Escapes in tag values are decoded");
+
+    // Whole response in one feed
+    std::mt19937 random(7);
+    CollectingParser whole;
+    whole.parser.feed(json);
+    TEST_ASSERT(samePois(whole.pois, expected), "Single feed matches the one-shot parse");
+    TEST_ASSERT(whole.parser.sawElements() && whole.parser.count() == expected.size() &&
+                whole.parser.remark().empty(), "count() and sawElements() after a complete response");
+
+    // Byte by byte
+    CollectingParser bytes;
+    bytes.feedInChunks(json, random, 1);
+    TEST_ASSERT(samePois(bytes.pois, expected), "One byte per feed matches the one-shot parse");
+
+    // Many random splits, small and large
+    bool allMatch = true;
+    for (int round = 0; round < 200 && allMatch; ++round) {
+        CollectingParser chunked;
+        chunked.feedInChunks(json, random, (round % 2) ? 16 : 4096);
+        if (!samePois(chunked.pois, expected)) {
+            allMatch = false;
+            std::cout << "    round " << round << ": " << chunked.pois.size() << " POIs" << std::endl;
+        }
+    }
+    TEST_ASSERT(allMatch, "200 random chunkings all match the one-shot parse");
+}
+
+// ============================================================================
+// Test Case 2: Remark
+// ============================================================================
+void test_remark() {
+    std::cout << "\n=== Test Case 2: Remark ===" << std::endl;
+
+    const std::string remark = "runtime error: Query timed out in \\\"query\\\" at line 3 after 25 seconds.";
+    const std::string json = buildResponse(20, remark);
+
+    std::mt19937 random(11);
+    bool allFound = true;
+    for (int round = 0; round < 50; ++round) {
+        CollectingParser chunked;
+        chunked.feedInChunks(json, random, (round % 2) ? 3 : 64);
+        allFound = allFound && chunked.parser.remark() ==
+                   "runtime error: Query timed out in \"query\" at line 3 after 25 seconds." &&
+                   chunked.pois.size() == 20 - 20 / 7;
+    }
+    TEST_ASSERT(allFound, "remark() is read and unescaped across chunk boundaries");
+
+    // Only the top-level "remark" counts, not a tag of that name
+    const std::string tagged =
+        "{\"elements\": [{\"type\": \"node\", \"id\": 1, \"lat\": 1.5, \"lon\": 2.5,"
+        " \"tags\": {\"remark\": \"just a tag\"}}]}";
+    OverpassStreamParser parser([](OSMPoi&&) { return true; });
+    parser.feed(tagged);
+    TEST_ASSERT(parser.remark().empty() && parser.count() == 1, "A \"remark\" tag is not the server remark");
+}
+
+// ============================================================================
+// Test Case 3: Early Stop and Truncated Input
+// ============================================================================
+void test_stop_and_truncation() {
+    std::cout << "\n=== Test Case 3: Early Stop and Truncated Input ===" << std::endl;
+
+    const std::string json = buildResponse(50);
+    OpenStreetMapAPI api;
+    std::vector<OSMPoi> expected = api.parseOverpassResponse(json, 100000);
+
+    // The sink can stop the parse
+    std::vector<OSMPoi> firstFive;
+    OverpassStreamParser stopping([&firstFive](OSMPoi&& poi) {
+        firstFive.push_back(std::move(poi));
+        return firstFive.size() < 5;
+    });
+    bool more = stopping.feed(json);
+    TEST_ASSERT(!more && stopping.stopped() && firstFive.size() == 5, "Sink returning false stops the parse");
+    TEST_ASSERT(!stopping.feed("{}") && firstFive.size() == 5, "Later feeds are ignored once stopped");
+
+    // Cut inside an element: every complete element before the cut is delivered
+    size_t cut = json.find("\"id\": 100010");
+    std::string truncated = json.substr(0, cut + 5);
+    std::mt19937 random(3);
+    CollectingParser cutShort;
+    cutShort.feedInChunks(truncated, random, 32);
+    const auto& pois = cutShort.pois;
+    std::vector<OSMPoi> before(expected.begin(), expected.begin() + std::min(pois.size(), expected.size()));
+    TEST_ASSERT(cutShort.parser.sawElements() && !pois.empty() && samePois(pois, before),
+                "Truncated response yields the complete elements before the cut");
+    // Elements 0-9 precede the cut; element 6 is a relation without coordinates
+    TEST_ASSERT(pois.size() == 9 && cutShort.parser.count() == 9,
+                "The element cut in half is not delivered");
+
+    // Cut before the array: nothing, and no elements seen
+    CollectingParser header;
+    header.feedInChunks(json.substr(0, json.find("\"elements\"")), random, 8);
+    TEST_ASSERT(header.pois.empty() && !header.parser.sawElements(),
+                "Response cut before \"elements\" yields nothing");
+
+    // An error document without elements
+    OverpassStreamParser errors([](OSMPoi&&) { return true; });
+    errors.feed("{\"version\": 0.6, \"error\": \"runtime error: out of memory\"}");
+    TEST_ASSERT(errors.count() == 0 && !errors.sawElements(), "Error response has no elements");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "OverpassStreamParser Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_random_chunks_match_one_shot();
+    test_remark();
+    test_stop_and_truncation();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
@@ -0,0 +1,387 @@
+// ============================================================================
+// PersistentCache Test Cases
+// Tests for reload after restart, torn/corrupt tails, tombstones and compaction
+// ============================================================================
+
+#include <iostream>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../src/services/PersistentCache.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// Layout of the log, for the tests that damage it on purpose
+static const off_t kLogHeaderBytes = 16;
+static const off_t kRecordHeaderBytes = 32;
+
+/**
+ * @brief Run body as one run of the application, in a child process
+ *
+ * PersistentCache::shared() keeps a store open for the life of the
+ * process, so a restart has to be a new process. The child's pass/fail
+ * counts come back through a pipe.
+ */
+static void runProcess(const std::function<void()>& body) {
+    std::cout.flush();
+    int fds[2];
+    if (pipe(fds) != 0) {
+        TEST_ASSERT(false, "pipe() for the child process");
+        return;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        body();
+        std::cout.flush();
+        int counts[2] = {tests_passed, tests_failed};
+        ssize_t written = write(fds[1], counts, sizeof(counts));
+        _exit(written == static_cast<ssize_t>(sizeof(counts)) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    int counts[2] = {0, 0};
+    ssize_t received = read(fds[0], counts, sizeof(counts));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    if (received != static_cast<ssize_t>(sizeof(counts)) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        TEST_ASSERT(false, "Child process finished cleanly");
+        return;
+    }
+    tests_passed = counts[0];
+    tests_failed = counts[1];
+}
+
+static std::shared_ptr<PersistentCache> openStore(const std::string& path, size_t maxBytes = 64u << 20) {
+    auto store = PersistentCache::shared(path, maxBytes);
+    if (store) {
+        store->waitUntilLoaded();
+    }
+    return store;
+}
+
+static bool hasValue(PersistentCache& store, const std::string& key, const std::string& expected) {
+    std::string value;
+    time_t storedAt = 0;
+    return store.get(key, value, storedAt) && value == expected;
+}
+
+static bool hasKey(PersistentCache& store, const std::string& key) {
+    std::string value;
+    time_t storedAt = 0;
+    return store.get(key, value, storedAt);
+}
+
+static off_t fileSize(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? info.st_size : -1;
+}
+
+// Fixed-width keys, so every record of a test has the same length
+static std::string numberedKey(int i) {
+    return "key:" + std::string(i < 10 ? "0" : "") + std::to_string(i);
+}
+
+// ============================================================================
+// Test Case 1: Reload After Restart
+// ============================================================================
+void test_reload_after_restart(const std::string& dir) {
+    std::cout << "\n=== Test Case 1: Reload After Restart ===" << std::endl;
+
+    std::string path = dir + "/reload.log";
+    time_t now = std::time(nullptr);
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        TEST_ASSERT(store != nullptr, "Store opens on a new file");
+        if (!store) return;
+
+        store->put("alpha", "first", now - 20, now + 3600);
+        store->put("alpha", "second", now - 10, now + 3600);
+        store->put("beta", std::string(5000, 'b'), now, now + 3600);
+        store->put("gone", "expired", now - 100, now - 1);
+        TEST_ASSERT(store->getStats().entries.load() == 2, "Expired record is not indexed");
+    });
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        TEST_ASSERT(store != nullptr, "Store reopens after restart");
+        if (!store) return;
+
+        std::string value;
+        time_t storedAt = 0;
+        bool found = store->get("alpha", value, storedAt);
+        TEST_ASSERT(found && value == "second", "Latest value of an overwritten key is reloaded");
+        TEST_ASSERT(storedAt == now - 10, "Storage time survives the restart");
+        TEST_ASSERT(hasValue(*store, "beta", std::string(5000, 'b')), "Large value is reloaded intact");
+        TEST_ASSERT(!hasKey(*store, "gone"), "Expired record stays gone");
+        TEST_ASSERT(store->getStats().entries.load() == 2, "Index holds the two live keys");
+    });
+}
+
+// ============================================================================
+// Test Case 2: Torn and Corrupt Tails Are Cut Off
+// ============================================================================
+void test_torn_and_corrupt_tail(const std::string& dir) {
+    std::cout << "\n=== Test Case 2: Torn and Corrupt Tails Are Cut Off ===" << std::endl;
+
+    time_t now = std::time(nullptr);
+    const std::string payload(100, 'p');
+    const off_t recordBytes = kRecordHeaderBytes + static_cast<off_t>(numberedKey(0).size() + payload.size());
+
+    auto writeRecords = [&](const std::string& path) {
+        runProcess([&]() {
+            auto store = openStore(path);
+            if (!store) return;
+            for (int i = 0; i < 10; ++i) {
+                store->put(numberedKey(i), payload, now, now + 3600);
+            }
+        });
+    };
+
+    // A crash in the middle of the last append leaves half a record
+    std::string tornPath = dir + "/torn.log";
+    writeRecords(tornPath);
+    off_t fullSize = fileSize(tornPath);
+    TEST_ASSERT(fullSize == kLogHeaderBytes + 10 * recordBytes, "Ten records written");
+    TEST_ASSERT(truncate(tornPath.c_str(), fullSize - 10) == 0, "Log truncated mid-record");
+
+    runProcess([&]() {
+        auto store = openStore(tornPath);
+        if (!store) return;
+        bool earlierKept = true;
+        for (int i = 0; i < 9; ++i) {
+            earlierKept = earlierKept && hasValue(*store, numberedKey(i), payload);
+        }
+        TEST_ASSERT(earlierKept, "Records before the torn one are reloaded");
+        TEST_ASSERT(!hasKey(*store, numberedKey(9)), "Torn record is dropped");
+        TEST_ASSERT(fileSize(tornPath) == kLogHeaderBytes + 9 * recordBytes,
+                    "File is cut back to the last valid record");
+
+        store->put("after", "appended", now, now + 3600);
+    });
+
+    runProcess([&]() {
+        auto store = openStore(tornPath);
+        if (!store) return;
+        TEST_ASSERT(hasValue(*store, "after", "appended"), "Record appended after the cut reloads");
+        TEST_ASSERT(store->getStats().entries.load() == 10, "Nine old records plus the new one");
+    });
+
+    // A flipped byte inside a record fails its CRC; the scan stops there
+    std::string corruptPath = dir + "/corrupt.log";
+    writeRecords(corruptPath);
+    off_t damaged = kLogHeaderBytes + 4 * recordBytes + kRecordHeaderBytes + 20;
+    int fd = open(corruptPath.c_str(), O_RDWR);
+    char byte = 0;
+    bool flipped = fd >= 0 && pread(fd, &byte, 1, damaged) == 1;
+    byte ^= 0x5a;
+    flipped = flipped && pwrite(fd, &byte, 1, damaged) == 1;
+    if (fd >= 0) close(fd);
+    TEST_ASSERT(flipped, "One byte of the fifth record flipped");
+
+    runProcess([&]() {
+        auto store = openStore(corruptPath);
+        if (!store) return;
+        bool earlierKept = true;
+        for (int i = 0; i < 4; ++i) {
+            earlierKept = earlierKept && hasValue(*store, numberedKey(i), payload);
+        }
+        bool laterDropped = true;
+        for (int i = 4; i < 10; ++i) {
+            laterDropped = laterDropped && !hasKey(*store, numberedKey(i));
+        }
+        TEST_ASSERT(earlierKept, "Records before the corrupt one are reloaded");
+        TEST_ASSERT(laterDropped, "Corrupt record and everything after it are dropped");
+        TEST_ASSERT(fileSize(corruptPath) == kLogHeaderBytes + 4 * recordBytes,
+                    "File is cut back to the last valid record");
+    });
+}
+
+// ============================================================================
+// Test Case 3: Tombstones
+// ============================================================================
+void test_tombstones(const std::string& dir) {
+    std::cout << "\n=== Test Case 3: Tombstones ===" << std::endl;
+
+    std::string path = dir + "/tombstones.log";
+    time_t now = std::time(nullptr);
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        if (!store) return;
+
+        store->put("erased", "value", now, now + 3600);
+        store->put("revived", "old", now, now + 3600);
+        store->put("kept", "value", now, now + 3600);
+        store->put("places:1", "a", now, now + 3600);
+        store->put("places:2", "b", now, now + 3600);
+        store->put("geocode:1", "c", now, now + 3600);
+
+        store->erase("erased");
+        store->erase("revived");
+        store->put("revived", "new", now, now + 3600);
+        store->eraseAll("places:");
+
+        TEST_ASSERT(!hasKey(*store, "erased"), "Erased key misses at once");
+        TEST_ASSERT(!hasKey(*store, "places:1") && !hasKey(*store, "places:2"),
+                    "eraseAll() removes every key with the prefix");
+
+        int64_t before = store->getStats().writes.load();
+        store->erase("never-stored");
+        TEST_ASSERT(store->getStats().writes.load() == before, "Erasing a missing key writes nothing");
+    });
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        if (!store) return;
+
+        TEST_ASSERT(!hasKey(*store, "erased"), "Tombstone survives the restart");
+        TEST_ASSERT(!hasKey(*store, "places:1") && !hasKey(*store, "places:2"),
+                    "Prefix tombstones survive the restart");
+        TEST_ASSERT(hasValue(*store, "revived", "new"), "Put after a tombstone wins on reload");
+        TEST_ASSERT(hasValue(*store, "kept", "value") && hasValue(*store, "geocode:1", "c"),
+                    "Other keys are untouched");
+        TEST_ASSERT(store->getStats().entries.load() == 3, "Index holds only the live keys");
+    });
+}
+
+// ============================================================================
+// Test Case 4: Compaction
+// ============================================================================
+void test_compaction(const std::string& dir) {
+    std::cout << "\n=== Test Case 4: Compaction ===" << std::endl;
+
+    std::string path = dir + "/compact.log";
+    time_t now = std::time(nullptr);
+    const int keys = 100;
+    const int rounds = 6;
+    auto valueFor = [](int key, int round) {
+        return std::string(10000, static_cast<char>('a' + round)) + std::to_string(key);
+    };
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        if (!store) return;
+
+        // About 6 MB written, 1 MB of it live: dead records outweigh live ones
+        for (int round = 0; round < rounds; ++round) {
+            for (int i = 0; i < keys; ++i) {
+                store->put(numberedKey(i), valueFor(i, round), now, now + 3600);
+            }
+        }
+        for (int i = 0; i < 100 && store->getStats().compactions.load() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        TEST_ASSERT(store->getStats().compactions.load() > 0, "Mostly dead log is compacted in the background");
+
+        TEST_ASSERT(store->compact(), "compact() succeeds");
+        const auto& stats = store->getStats();
+        TEST_ASSERT(stats.fileBytes.load() == kLogHeaderBytes + stats.liveBytes.load(),
+                    "Compacted log holds only live records");
+        TEST_ASSERT(fileSize(path) == stats.fileBytes.load(), "File on disk matches fileBytes");
+        TEST_ASSERT(fileSize(path + ".compact") < 0, "No temporary file left behind");
+
+        bool latest = true;
+        for (int i = 0; i < keys; ++i) {
+            latest = latest && hasValue(*store, numberedKey(i), valueFor(i, rounds - 1));
+        }
+        TEST_ASSERT(latest, "Every key keeps its latest value through compaction");
+    });
+
+    runProcess([&]() {
+        auto store = openStore(path);
+        if (!store) return;
+        bool latest = true;
+        for (int i = 0; i < keys; ++i) {
+            latest = latest && hasValue(*store, numberedKey(i), valueFor(i, rounds - 1));
+        }
+        TEST_ASSERT(latest, "Compacted log reloads with the latest values");
+        TEST_ASSERT(store->getStats().entries.load() == keys, "Every key is indexed after reload");
+    });
+
+    // Live data alone over budget: compaction keeps the newest entries
+    std::string budgetPath = dir + "/budget.log";
+    const size_t maxBytes = 512 * 1024;
+    runProcess([&]() {
+        auto store = openStore(budgetPath, maxBytes);
+        if (!store) return;
+
+        for (int i = 0; i < keys; ++i) {
+            store->put(numberedKey(i), valueFor(i, 0), now - keys + i, now + 3600);
+        }
+        TEST_ASSERT(store->compact(), "compact() succeeds over budget");
+
+        const auto& stats = store->getStats();
+        TEST_ASSERT(static_cast<size_t>(stats.liveBytes.load()) <= maxBytes / 4 * 3,
+                    "Live data is trimmed to 3/4 of maxBytes");
+        TEST_ASSERT(hasKey(*store, numberedKey(keys - 1)), "Newest entry is kept");
+        TEST_ASSERT(!hasKey(*store, numberedKey(0)), "Oldest entry is dropped");
+    });
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "PersistentCache Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    char dirTemplate[] = "/tmp/test_persistent_cache.XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::cout << "  ✗ Cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    std::string dir = dirTemplate;
+
+    // Run test cases
+    test_reload_after_restart(dir);
+    test_torn_and_corrupt_tail(dir);
+    test_tombstones(dir);
+    test_compaction(dir);
+
+    for (const char* name : {"reload.log", "torn.log", "corrupt.log", "tombstones.log",
+                             "compact.log", "budget.log"}) {
+        std::remove((dir + "/" + name).c_str());
+    }
+    rmdir(dir.c_str());
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
@@ -0,0 +1,190 @@
+// ============================================================================
+// RateLimiter Test Cases
+// Tests for the initial burst, spacing, pause() and retry delays
+// ============================================================================
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../src/services/RateLimiter.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// reserve() never blocks, so the delays it hands out can be checked without
+// sleeping. Each check allows for the time the test itself takes to run.
+static const long kSlackMs = 20;
+
+static bool near(std::chrono::milliseconds actual, long expectedMs) {
+    return actual.count() <= expectedMs && actual.count() >= expectedMs - kSlackMs;
+}
+
+// ============================================================================
+// Test Case 1: Initial Burst, Then Even Spacing
+// ============================================================================
+void test_burst_then_spacing() {
+    std::cout << "\n=== Test Case 1: Initial Burst, Then Even Spacing ===" << std::endl;
+
+    // 10/s with kBurstSeconds = 0.2 allows two tokens at once
+    RateLimiter limiter(10);
+    std::vector<std::chrono::milliseconds> delays;
+    for (int i = 0; i < 8; ++i) {
+        delays.push_back(limiter.reserve());
+    }
+
+    TEST_ASSERT(delays[0].count() == 0 && delays[1].count() == 0, "Burst of two tokens is free at once");
+    TEST_ASSERT(near(delays[2], 100), "Third token waits one interval");
+
+    bool spaced = true;
+    for (size_t i = 3; i < delays.size(); ++i) {
+        long gap = (delays[i] - delays[i - 1]).count();
+        if (gap < 100 - kSlackMs || gap > 100 + kSlackMs) {
+            spaced = false;
+            std::cout << "    token " << i << " gap " << gap << " ms" << std::endl;
+        }
+    }
+    TEST_ASSERT(spaced, "Later tokens are one interval apart");
+    TEST_ASSERT(near(delays[7], 600), "Eighth token is six intervals out");
+    TEST_ASSERT(limiter.getStats().requests.load() == 8, "requests counts every token");
+    TEST_ASSERT(limiter.getStats().delayed.load() == 6, "delayed counts the tokens past the burst");
+
+    // A rate of 1/s still allows one token at once, but not two
+    RateLimiter slow(1);
+    TEST_ASSERT(slow.reserve().count() == 0, "Rate 1/s: first token is free");
+    TEST_ASSERT(near(slow.reserve(), 1000), "Rate 1/s: second token waits a second");
+
+    // 0 means unlimited
+    RateLimiter unlimited(0);
+    bool allFree = true;
+    for (int i = 0; i < 100; ++i) {
+        allFree = allFree && unlimited.reserve().count() == 0;
+    }
+    TEST_ASSERT(allFree, "Rate 0 never delays");
+    TEST_ASSERT(unlimited.getRate() == 0.0, "getRate() reports 0 for unlimited");
+}
+
+// ============================================================================
+// Test Case 2: pause() Holds Back Later Tokens
+// ============================================================================
+void test_pause() {
+    std::cout << "\n=== Test Case 2: pause() Holds Back Later Tokens ===" << std::endl;
+
+    RateLimiter limiter(10);
+    TEST_ASSERT(limiter.reserve().count() == 0, "Token before the pause is free");
+
+    limiter.pause(std::chrono::milliseconds(500));
+    TEST_ASSERT(near(limiter.reserve(), 500), "First token after pause() waits out the pause");
+    TEST_ASSERT(near(limiter.reserve(), 600), "No burst right after the pause");
+    TEST_ASSERT(limiter.getStats().pauses.load() == 1, "pauses counts the call");
+
+    // A shorter pause does not pull the schedule forward
+    limiter.pause(std::chrono::milliseconds(100));
+    TEST_ASSERT(near(limiter.reserve(), 700), "Shorter pause leaves the later schedule alone");
+}
+
+// ============================================================================
+// Test Case 3: retryDelay() Honors Retry-After
+// ============================================================================
+void test_retry_delay() {
+    std::cout << "\n=== Test Case 3: retryDelay() Honors Retry-After ===" << std::endl;
+
+    const std::chrono::milliseconds base(1000);
+
+    HttpResponse tooMany;
+    tooMany.ok = true;
+    tooMany.statusCode = 429;
+    tooMany.retryAfterSeconds = 3;
+    TEST_ASSERT(tooMany.isRateLimited(), "429 response is rate limited");
+    TEST_ASSERT(RateLimiter::retryDelay(tooMany, 0, base).count() == 3000,
+                "Retry-After is used as is");
+    TEST_ASSERT(RateLimiter::retryDelay(tooMany, 5, base).count() == 3000,
+                "Retry-After wins over the attempt count");
+
+    tooMany.retryAfterSeconds = 600;
+    TEST_ASSERT(RateLimiter::retryDelay(tooMany, 0, base) == RateLimiter::kMaxBackoff,
+                "Retry-After is capped at kMaxBackoff");
+
+    // Without Retry-After: half to all of base * 2^attempt
+    HttpResponse failed;
+    failed.ok = true;
+    failed.statusCode = 503;
+    bool inRange = true;
+    for (int i = 0; i < 200; ++i) {
+        long first = RateLimiter::retryDelay(failed, 0, base).count();
+        long third = RateLimiter::retryDelay(failed, 2, base).count();
+        long late = RateLimiter::retryDelay(failed, 20, base).count();
+        inRange = inRange && first >= 500 && first <= 1000 &&
+                  third >= 2000 && third <= 4000 &&
+                  late >= RateLimiter::kMaxBackoff.count() / 2 && late <= RateLimiter::kMaxBackoff.count();
+    }
+    TEST_ASSERT(inRange, "Backoff stays within half to all of the exponential ceiling");
+
+    // Pausing the limiter with the delay holds the next token back by it
+    RateLimiter limiter(10);
+    tooMany.retryAfterSeconds = 2;
+    limiter.pause(RateLimiter::retryDelay(tooMany, 0, base));
+    TEST_ASSERT(near(limiter.reserve(), 2000), "Token after a 429 waits out Retry-After");
+}
+
+// ============================================================================
+// Test Case 4: shared() and hostOf()
+// ============================================================================
+void test_shared_limiters() {
+    std::cout << "\n=== Test Case 4: shared() and hostOf() ===" << std::endl;
+
+    TEST_ASSERT(RateLimiter::hostOf("https://nominatim.openstreetmap.org/search?q=x") ==
+                "nominatim.openstreetmap.org", "hostOf() drops scheme and path");
+    TEST_ASSERT(RateLimiter::hostOf("http://localhost:8080/api") == "localhost", "hostOf() drops the port");
+    TEST_ASSERT(RateLimiter::hostOf("overpass-api.de") == "overpass-api.de", "hostOf() accepts a bare host");
+
+    auto first = RateLimiter::shared("test.example", 5);
+    auto second = RateLimiter::shared("test.example", 20);
+    auto other = RateLimiter::shared("other.example", 5);
+    TEST_ASSERT(first == second, "shared() returns one limiter per upstream");
+    TEST_ASSERT(first != other, "Different upstreams get different limiters");
+    TEST_ASSERT(first->getRate() > 19.9 && first->getRate() < 20.1, "Latest rate setting wins");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "RateLimiter Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_burst_then_spacing();
+    test_pause();
+    test_retry_delay();
+    test_shared_limiters();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
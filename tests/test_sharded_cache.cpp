@@ -0,0 +1,189 @@
+// ============================================================================
+// ShardedCache Test Cases
+// Tests for the byte budget, W-TinyLFU admission and expiry sweeping
+// ============================================================================
+
+#include <iostream>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+#include "../src/services/ShardedCache.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+using StringCache = ShardedCache<std::string, std::string>;
+
+static size_t weighString(const std::string& key, const std::string& value) {
+    return heapBytes(key) + heapBytes(value);
+}
+
+// Sum of what the cache should be charging for its entries
+static size_t weighedBytes(const StringCache& cache) {
+    size_t total = 0;
+    cache.forEach([&total](const std::string& key, const std::string& value) {
+        total += StringCache::kNodeOverhead + weighString(key, value);
+    });
+    return total;
+}
+
+// ============================================================================
+// Test Case 1: Byte Budget Holds Under Mixed Entry Sizes
+// ============================================================================
+void test_byte_budget_mixed_sizes() {
+    std::cout << "\n=== Test Case 1: Byte Budget Holds Under Mixed Entry Sizes ===" << std::endl;
+
+    const size_t budget = 256 * 1024;
+    StringCache cache(budget, weighString);
+
+    // Values from a few bytes (inside the string object) to several KB
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> sizes(1, 8000);
+
+    bool withinBudget = true;
+    for (int i = 0; i < 5000; ++i) {
+        cache.put("key:" + std::to_string(i), std::string(sizes(random), 'x'));
+        if (cache.bytes() > budget) {
+            withinBudget = false;
+            std::cout << "    after put " << i << ": " << cache.bytes() << " bytes" << std::endl;
+            break;
+        }
+    }
+
+    TEST_ASSERT(withinBudget, "bytes() never exceeds the budget");
+    TEST_ASSERT(cache.getStats().evictions.load() + cache.getStats().rejections.load() > 0,
+                "Entries were dropped to make room");
+    TEST_ASSERT(cache.bytes() == weighedBytes(cache), "bytes() matches the weight of the entries held");
+    TEST_ASSERT(static_cast<size_t>(cache.getStats().entries.load()) == cache.size(),
+                "entries counter matches size()");
+
+    // Growing an entry in place is charged too
+    std::string key;
+    cache.forEach([&key](const std::string& k, const std::string&) {
+        if (key.empty()) key = k;
+    });
+    cache.update(key, [](std::string& value) { value.append(4000, 'y'); });
+    TEST_ASSERT(cache.bytes() <= budget, "Budget holds after an entry grows in place");
+    TEST_ASSERT(cache.bytes() == weighedBytes(cache), "bytes() follows an in-place update");
+
+    // An entry larger than a shard's share is refused outright
+    bool stored = cache.put("huge", std::string(budget, 'z'));
+    std::string value;
+    TEST_ASSERT(!stored && !cache.peek("huge", value), "Entry larger than a shard is not cached");
+
+    // Shrinking the budget evicts at once
+    cache.setMaxBytes(budget / 4);
+    TEST_ASSERT(cache.bytes() <= budget / 4, "setMaxBytes() evicts down to the smaller budget");
+    TEST_ASSERT(cache.bytes() == weighedBytes(cache), "bytes() is exact after shrinking");
+}
+
+// ============================================================================
+// Test Case 2: A Frequently Read Entry Survives a Scan
+// ============================================================================
+void test_frequent_entry_survives_scan() {
+    std::cout << "\n=== Test Case 2: A Frequently Read Entry Survives a Scan ===" << std::endl;
+
+    // One shard, so the hot key competes with every key in the scan
+    const size_t budget = 1024 * 1024;
+    StringCache cache(budget, weighString, nullptr, 1);
+    const std::string payload(1000, 'v');
+
+    cache.put("hot", payload);
+    cache.put("cold", payload);
+    std::string value;
+    for (int i = 0; i < 10; ++i) {
+        cache.get("hot", value);
+    }
+
+    // Several times the cache's capacity in keys that are written once
+    // and never read
+    const int scanKeys = 5000;
+    for (int i = 0; i < scanKeys; ++i) {
+        cache.put("scan:" + std::to_string(i), payload);
+    }
+
+    TEST_ASSERT(cache.peek("hot", value), "Frequently read entry is still cached after the scan");
+    TEST_ASSERT(!cache.peek("cold", value), "Entry that was never read is evicted by the scan");
+    TEST_ASSERT(cache.size() < static_cast<size_t>(scanKeys), "Scan did not fit in the cache");
+    TEST_ASSERT(cache.getStats().rejections.load() > 0, "Admission turned away one-off keys");
+    TEST_ASSERT(cache.bytes() <= budget, "Budget holds through the scan");
+}
+
+// ============================================================================
+// Test Case 3: Expired Entries Are Swept
+// ============================================================================
+void test_expired_entries_swept() {
+    std::cout << "\n=== Test Case 3: Expired Entries Are Swept ===" << std::endl;
+
+    StringCache cache(1024 * 1024, weighString);
+    const std::string payload(200, 'e');
+
+    time_t expiresAt = std::time(nullptr) + 1;
+    for (int i = 0; i < 100; ++i) {
+        cache.put("short:" + std::to_string(i), payload, expiresAt);
+    }
+    for (int i = 0; i < 50; ++i) {
+        cache.put("long:" + std::to_string(i), payload);
+    }
+    TEST_ASSERT(cache.size() == 150, "All entries cached before expiry");
+
+    while (std::time(nullptr) < expiresAt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    // A read drops the expired entry it finds
+    std::string value;
+    TEST_ASSERT(!cache.get("short:0", value), "Expired entry is not returned");
+    TEST_ASSERT(cache.getStats().expirations.load() == 1, "Read of an expired entry counts one expiration");
+
+    // The sweep drops the rest without anyone reading them
+    cache.sweepExpired();
+    TEST_ASSERT(cache.size() == 50, "Sweep removes every expired entry");
+    TEST_ASSERT(cache.getStats().expirations.load() == 100, "Each expired entry counted once");
+    TEST_ASSERT(cache.peek("long:0", value), "Entries without an expiry are kept");
+    TEST_ASSERT(cache.bytes() == weighedBytes(cache), "bytes() released the swept entries");
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "ShardedCache Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_byte_budget_mixed_sizes();
+    test_frequent_entry_survives_scan();
+    test_expired_entries_swept();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}
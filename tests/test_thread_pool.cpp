@@ -0,0 +1,324 @@
+// ============================================================================
+// ThreadPool / QuotaExecutor Test Cases
+// Tests for waitAll, nested waitHelp, deadlines, resizing and quotas
+// ============================================================================
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/services/ThreadPool.h"
+#include "../src/services/QuotaExecutor.h"
+
+using namespace FranchiseAI::Services;
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    if (condition) { \
+        std::cout << "  ✓ PASS: " << message << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  ✗ FAIL: " << message << std::endl; \
+        tests_failed++; \
+    }
+
+// A future that is not ready after this long is treated as a deadlock
+static const auto kDeadlockTimeout = std::chrono::seconds(10);
+
+// ============================================================================
+// Test Case 1: waitAll() Under Contention
+// ============================================================================
+void test_wait_all_under_contention() {
+    std::cout << "\n=== Test Case 1: waitAll() Under Contention ===" << std::endl;
+
+    ThreadPoolConfig config;
+    config.threadCount = 4;
+    config.maxQueueSize = 0;
+    ThreadPool pool(config);
+
+    const int submitters = 4;
+    const int tasksPerSubmitter = 250;
+    const int rounds = 20;
+
+    bool allRoundsComplete = true;
+    for (int round = 0; round < rounds; ++round) {
+        std::atomic<int> completed{0};
+
+        // Several threads enqueue at once, so counting races show up here
+        std::vector<std::thread> threads;
+        for (int s = 0; s < submitters; ++s) {
+            threads.emplace_back([&pool, &completed, tasksPerSubmitter]() {
+                for (int i = 0; i < tasksPerSubmitter; ++i) {
+                    pool.post([&completed]() { completed++; });
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        pool.waitAll();
+        if (completed.load() != submitters * tasksPerSubmitter) {
+            allRoundsComplete = false;
+            std::cout << "    round " << round << ": " << completed.load() << " tasks done" << std::endl;
+        }
+    }
+
+    TEST_ASSERT(allRoundsComplete, "waitAll() returns only after every submitted task ran");
+    TEST_ASSERT(pool.getPendingTaskCount() == 0, "No tasks pending after waitAll()");
+    TEST_ASSERT(pool.getMetrics().tasksCompleted.load() ==
+                static_cast<uint64_t>(submitters * tasksPerSubmitter * rounds),
+                "tasksCompleted matches the number of tasks posted");
+}
+
+// ============================================================================
+// Test Case 2: Nested waitHelp() Does Not Deadlock
+// ============================================================================
+void test_nested_wait_help() {
+    std::cout << "\n=== Test Case 2: Nested waitHelp() Does Not Deadlock ===" << std::endl;
+
+    // Fewer workers than outer tasks: every worker ends up waiting on
+    // children that are still queued
+    ThreadPool pool(2);
+
+    const int outerTasks = 8;
+    const int childrenPerTask = 4;
+
+    std::vector<std::future<int>> outer;
+    for (int i = 0; i < outerTasks; ++i) {
+        outer.push_back(pool.submit([&pool, childrenPerTask]() {
+            std::vector<std::future<int>> children;
+            for (int c = 0; c < childrenPerTask; ++c) {
+                children.push_back(pool.submit([c]() { return c + 1; }));
+            }
+            int sum = 0;
+            for (auto& child : children) {
+                pool.waitHelp(child);
+                sum += child.get();
+            }
+            return sum;
+        }));
+    }
+
+    bool finished = true;
+    int total = 0;
+    for (auto& future : outer) {
+        if (future.wait_for(kDeadlockTimeout) != std::future_status::ready) {
+            finished = false;
+            break;
+        }
+        total += future.get();
+    }
+
+    TEST_ASSERT(finished, "Outer tasks finish while their children share the pool");
+    if (finished) {
+        TEST_ASSERT(total == outerTasks * (1 + 2 + 3 + 4), "Every child result reached its parent");
+    }
+}
+
+// ============================================================================
+// Test Case 3: An Expired Deadline Drops the Task
+// ============================================================================
+void test_expired_deadline_drops_task() {
+    std::cout << "\n=== Test Case 3: An Expired Deadline Drops the Task ===" << std::endl;
+
+    ThreadPoolConfig config;
+    config.threadCount = 1;
+    config.enableWorkStealing = false;
+    ThreadPool pool(config);
+
+    // Hold the only worker so the deadline passes while the task is queued
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    pool.post([released]() { released.wait(); });
+
+    std::atomic<bool> ran{false};
+    auto expiring = pool.submit(TaskOptions().withTimeout(std::chrono::milliseconds(1)),
+                                [&ran]() { ran = true; return 1; });
+    auto patient = pool.submit([]() { return 2; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release.set_value();
+    pool.waitAll();
+
+    bool brokenPromise = false;
+    try {
+        expiring.get();
+    } catch (const std::future_error& e) {
+        brokenPromise = e.code() == std::future_errc::broken_promise;
+    }
+
+    TEST_ASSERT(!ran.load(), "Expired task did not run");
+    TEST_ASSERT(brokenPromise, "Expired task's future reports broken_promise");
+    TEST_ASSERT(pool.getMetrics().tasksExpired.load() == 1, "tasksExpired counts the dropped task");
+    TEST_ASSERT(patient.get() == 2, "Task without a deadline still runs");
+}
+
+// ============================================================================
+// Test Case 4: Resizing While Tasks Are Queued Loses No Tasks
+// ============================================================================
+void test_resize_keeps_queued_tasks() {
+    std::cout << "\n=== Test Case 4: Resizing While Tasks Are Queued Loses No Tasks ===" << std::endl;
+
+    ThreadPoolConfig config;
+    config.threadCount = 3;
+    config.maxQueueSize = 0;
+    ThreadPool pool(config);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    for (int i = 0; i < 3; ++i) {
+        pool.post([released]() { released.wait(); });
+    }
+
+    // Queue work behind the blocked workers, then shrink and grow the pool
+    // while it is still waiting
+    const int queuedTasks = 300;
+    std::atomic<int> completed{0};
+    for (int i = 0; i < queuedTasks; ++i) {
+        pool.post([&completed]() { completed++; });
+        if (i == queuedTasks / 3) {
+            pool.resize(1);
+        } else if (i == 2 * queuedTasks / 3) {
+            pool.resize(5);
+        }
+    }
+    pool.resize(2);
+
+    release.set_value();
+    pool.waitAll();
+
+    TEST_ASSERT(completed.load() == queuedTasks, "Every queued task ran after resizing");
+    TEST_ASSERT(pool.getThreadCount() == 2, "Pool settles at the last requested size");
+    TEST_ASSERT(pool.getPendingTaskCount() == 0, "No tasks pending after waitAll()");
+}
+
+// ============================================================================
+// Test Case 5: QuotaExecutor
+// ============================================================================
+void test_quota_executor() {
+    std::cout << "\n=== Test Case 5: QuotaExecutor ===" << std::endl;
+
+    ThreadPool pool(4);
+
+    // The quota caps concurrency below the pool's size
+    {
+        QuotaExecutor executor(pool, 2, 0, "test executor");
+        std::atomic<int> running{0};
+        std::atomic<int> maxRunning{0};
+        std::atomic<int> completed{0};
+
+        for (int i = 0; i < 40; ++i) {
+            executor.execute([&]() {
+                int now = ++running;
+                int seen = maxRunning.load();
+                while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                running--;
+                completed++;
+            });
+        }
+        executor.waitAll();
+
+        TEST_ASSERT(completed.load() == 40, "waitAll() waits for every executor task");
+        TEST_ASSERT(maxRunning.load() <= 2, "No more than quota tasks run at once");
+        TEST_ASSERT(executor.getPendingTaskCount() == 0, "No executor tasks pending after waitAll()");
+    }
+
+    // A task that waits on a sibling it submitted must not wait for its own slot
+    {
+        QuotaExecutor executor(pool, 1, 0, "nested executor");
+        auto outer = executor.submit([&executor]() {
+            auto inner = executor.submit([]() { return 21; });
+            executor.waitHelp(inner);
+            return inner.get() * 2;
+        });
+
+        bool finished = outer.wait_for(kDeadlockTimeout) == std::future_status::ready;
+        TEST_ASSERT(finished, "Nested waitHelp() with a quota of one does not deadlock");
+        if (finished) {
+            TEST_ASSERT(outer.get() == 42, "Nested task result reached its parent");
+        }
+    }
+
+    // A full waiting queue rejects new work
+    {
+        QuotaExecutor executor(pool, 1, 2, "bounded executor");
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+
+        executor.execute([released]() { released.wait(); });
+        executor.execute([]() {});
+        executor.execute([]() {});
+
+        bool rejected = false;
+        try {
+            executor.execute([]() {});
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        release.set_value();
+        executor.waitAll();
+
+        TEST_ASSERT(rejected, "Executor throws once maxQueueSize tasks are waiting");
+    }
+
+    // Shutdown drains queued work, then refuses more
+    {
+        QuotaExecutor executor(pool, 1, 0, "stopping executor");
+        std::atomic<int> completed{0};
+        for (int i = 0; i < 10; ++i) {
+            executor.execute([&completed]() { completed++; });
+        }
+        executor.shutdown(true);
+
+        bool rejected = false;
+        try {
+            executor.execute([]() {});
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+
+        TEST_ASSERT(completed.load() == 10, "shutdown(true) lets queued tasks finish");
+        TEST_ASSERT(rejected, "Stopped executor rejects new tasks");
+    }
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+int main() {
+    std::cout << "============================================" << std::endl;
+    std::cout << "ThreadPool / QuotaExecutor Test Suite" << std::endl;
+    std::cout << "============================================" << std::endl;
+
+    // Run test cases
+    test_wait_all_under_contention();
+    test_nested_wait_help();
+    test_expired_deadline_drops_task();
+    test_resize_keeps_queued_tasks();
+    test_quota_executor();
+
+    // Print summary
+    std::cout << "\n============================================" << std::endl;
+    std::cout << "Test Summary" << std::endl;
+    std::cout << "============================================" << std::endl;
+    std::cout << "  Passed: " << tests_passed << std::endl;
+    std::cout << "  Failed: " << tests_failed << std::endl;
+    std::cout << "  Total:  " << (tests_passed + tests_failed) << std::endl;
+
+    if (tests_failed > 0) {
+        std::cout << "\n  ✗ SOME TESTS FAILED" << std::endl;
+        return 1;
+    } else {
+        std::cout << "\n  ✓ ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+}